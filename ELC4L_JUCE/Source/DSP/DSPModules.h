@@ -7,8 +7,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SilenceDetector.h"
+#include "DenormalGuard.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 namespace ELC4L {
 
@@ -36,6 +39,7 @@ enum Parameters {
     kParamBand2Mode,
     kParamBand3Mode,
     kParamBand4Mode,
+    kParamQuality,          // 처리 품질: Eco / Standard / High (ProcessingQuality)
     kNumParams
 };
 
@@ -75,44 +79,89 @@ struct TapeSaturator {
 };
 
 //=======================================================================
-// 폴리페이즈 FIR 오버샘플러 (4x)
+// 완전히 언롤된 내적 (인덱스 순서로 합산: 일반 루프와 같은 반올림)
+//=======================================================================
+template <int N>
+struct UnrolledDot {
+    static inline float run(const float* a, const float* b) {
+        return UnrolledDot<N - 1>::run(a, b) + a[N - 1] * b[N - 1];
+    }
+};
+
+template <>
+struct UnrolledDot<1> {
+    static inline float run(const float* a, const float* b) { return a[0] * b[0]; }
+};
+
+//=======================================================================
+// 폴리페이즈 FIR 오버샘플러 (4x, 또는 한 페이즈씩 건너뛴 2x)
 // 32-tap Linear Phase FIR / 4 Phases
+// 모든 배율이 4x 커널의 그룹 딜레이(~4 샘플 @ 기본 레이트)를 유지 (2x는 1/8 샘플 이내)
 //=======================================================================
 class PolyphaseOversampler {
 public:
     PolyphaseOversampler() { reset(); }
 
     void reset() {
-        for (int i = 0; i < kTapLength; ++i) state[i] = 0.0f;
+        for (int i = 0; i < 2 * kTapsPerPhase; ++i) state[i] = 0.0f;
         ptr = 0;
     }
 
-    // 업샘플 1 -> 4
-    void processUpsample(float input, float* outBuffer4x) {
-        state[ptr] = input;
-        for (int phase = 0; phase < 4; ++phase) {
-            float sum = 0.0f;
-            const float* coeffs = &kCoeffs[phase * kTapsPerPhase];
-            for (int i = 0; i < kTapsPerPhase; ++i) {
-                int idx = (ptr - i + kTapLength) % kTapLength;
-                sum += state[idx] * coeffs[i];
-            }
-            outBuffer4x[phase] = sum;
+    // 모든 탭이 threshold 미만이면 true (0 입력 시 출력도 ~0)
+    bool isIdle(float threshold) const {
+        return bufferPeak(state, kTapsPerPhase) < threshold;
+    }
+
+    void flushDenormals() { ELC4L::flushDenormals(state, 2 * kTapsPerPhase); }
+
+    // 업샘플 1 -> Factor (히스토리를 미러링해 탭을 연속 구간으로 읽음)
+    template <int Factor = 4>
+    void processUpsample(float input, float* outBuffer) {
+        static_assert(Factor == 2 || Factor == 4, "PolyphaseOversampler는 2x 또는 4x");
+        const float* history = pushSample(input);
+        for (int phase = 0; phase < Factor; ++phase) {
+            const float* coeffs = &kCoeffs[phase * (4 / Factor) * kTapsPerPhase];
+            outBuffer[phase] = UnrolledDot<kTapsPerPhase>::run(history, coeffs);
         }
-        ptr = (ptr + 1) % kTapLength;
     }
 
-    // 다운샘플 4 -> 1
-    float processDownsample(const float* inBuffer4x) {
-        return inBuffer4x[0] * 0.1f + inBuffer4x[1] * 0.4f + 
-               inBuffer4x[2] * 0.4f + inBuffer4x[3] * 0.1f;
+    // 다운샘플 Factor -> 1 (2x는 4x 가중치를 둘씩 합침)
+    template <int Factor = 4>
+    float processDownsample(const float* inBuffer) {
+        static_assert(Factor == 2 || Factor == 4, "PolyphaseOversampler는 2x 또는 4x");
+        if (Factor == 4) return UnrolledDot<4>::run(inBuffer, kDecimation4x);
+        return UnrolledDot<2>::run(inBuffer, kDecimation2x);
+    }
+
+    // processUpsample() + processDownsample()와 같은 선형 응답의 1x 필터
+    // (다운샘플 가중치를 페이즈에 접어 넣음). 탭 상태는 processUpsample()과 공유
+    float processLinearEquivalent(float input) {
+        return UnrolledDot<kTapsPerPhase>::run(pushSample(input), folded.c);
     }
 
     static constexpr int kTapsPerPhase = 8;
     static constexpr int kTapLength = 32;
 
 private:
-    float state[kTapLength];
+    struct LinearEquivalentCoeffs {
+        float c[kTapsPerPhase];
+        constexpr LinearEquivalentCoeffs() : c() {
+            for (int i = 0; i < kTapsPerPhase; ++i) {
+                for (int phase = 0; phase < 4; ++phase) c[i] += kDecimation4x[phase] * kCoeffs[phase * kTapsPerPhase + i];
+            }
+        }
+    };
+    static const LinearEquivalentCoeffs folded;     // 상수 초기화 (클래스 아래에서 정의)
+
+    // 최신 샘플이 맨 앞: history[i]는 i 샘플 전 입력
+    inline const float* pushSample(float input) {
+        ptr = (ptr == 0 ? kTapsPerPhase : ptr) - 1;
+        state[ptr] = input;
+        state[ptr + kTapsPerPhase] = input;
+        return &state[ptr];
+    }
+
+    float state[2 * kTapsPerPhase];
     int ptr = 0;
     
     // Kaiser 윈도우 싱크 계수
@@ -126,8 +175,107 @@ private:
         // Phase 3
         -0.004f, 0.012f, -0.045f, 0.220f, 0.550f, 0.280f, -0.045f, 0.012f
     };
+    static constexpr float kDecimation4x[4] = { 0.1f, 0.4f, 0.4f, 0.1f };
+    static constexpr float kDecimation2x[2] = { 0.5f, 0.5f };
 };
 
+inline constexpr PolyphaseOversampler::LinearEquivalentCoeffs PolyphaseOversampler::folded;
+
+//=======================================================================
+// 윈도우 싱크 8x 오버샘플러 (High 품질)
+// 기본 레이트 나이퀴스트 바로 아래에서 자르는 64탭 Blackman 윈도우 싱크 하나를
+// 8페이즈 보간 필터와 데시메이션 필터로 함께 사용 (총 그룹 딜레이 7 샘플 @ 기본 레이트)
+//=======================================================================
+class SincOversampler8x {
+public:
+    static constexpr int kFactor = 8;
+    static constexpr int kTapsPerPhase = 8;
+    static constexpr int kTapLength = kFactor * kTapsPerPhase;
+
+    SincOversampler8x() { reset(); }
+
+    void reset() {
+        for (int i = 0; i < 2 * kTapsPerPhase; ++i) input[i] = 0.0f;
+        for (int i = 0; i < 2 * kTapLength; ++i) upsampled[i] = 0.0f;
+        inputPos = 0;
+        upsampledPos = 0;
+    }
+
+    bool isIdle(float threshold) const {
+        return bufferPeak(input, kTapsPerPhase) < threshold
+            && bufferPeak(upsampled, kTapLength) < threshold;
+    }
+
+    void flushDenormals() {
+        ELC4L::flushDenormals(input, 2 * kTapsPerPhase);
+        ELC4L::flushDenormals(upsampled, 2 * kTapLength);
+    }
+
+    // 업샘플 1 -> 8 (히스토리를 두 번 기록해 탭이 연속 구간을 읽음)
+    void processUpsample(float sample, float* outBuffer8x) {
+        inputPos = (inputPos == 0 ? kTapsPerPhase : inputPos) - 1;
+        input[inputPos] = sample;
+        input[inputPos + kTapsPerPhase] = sample;
+        const float* history = &input[inputPos];
+        for (int phase = 0; phase < kFactor; ++phase) {
+            const float* coeffs = kernel.phases[phase];
+            float sum = 0.0f;
+            for (int i = 0; i < kTapsPerPhase; ++i) sum += history[i] * coeffs[i];
+            outBuffer8x[phase] = sum;
+        }
+    }
+
+    // 다운샘플 8 -> 1
+    float processDownsample(const float* inBuffer8x) {
+        for (int phase = 0; phase < kFactor; ++phase) {
+            upsampledPos = (upsampledPos == 0 ? kTapLength : upsampledPos) - 1;
+            upsampled[upsampledPos] = inBuffer8x[phase];
+            upsampled[upsampledPos + kTapLength] = inBuffer8x[phase];
+        }
+        const float* history = &upsampled[upsampledPos];
+        float sum = 0.0f;
+        for (int i = 0; i < kTapLength; ++i) sum += history[i] * kernel.decimator[i];
+        return sum;
+    }
+
+private:
+    struct Kernel {
+        float phases[kFactor][kTapsPerPhase];   // 보간 필터, 페이즈별 DC 게인 1
+        float decimator[kTapLength];            // DC 게인 1
+        Kernel() {
+            const double pi = juce::MathConstants<double>::pi;
+            const double cutoff = 0.45 / kFactor;   // 오버샘플 레이트 기준 (cycles/sample)
+            double prototype[kTapLength];
+            double total = 0.0;
+            for (int k = 0; k < kTapLength; ++k) {
+                const double t = k - 0.5 * (kTapLength - 1);
+                const double sinc = 2.0 * cutoff * ((t == 0.0) ? 1.0 : std::sin(2.0 * pi * cutoff * t) / (2.0 * pi * cutoff * t));
+                const double window = 0.42 - 0.5 * std::cos(2.0 * pi * k / (kTapLength - 1))
+                                    + 0.08 * std::cos(4.0 * pi * k / (kTapLength - 1));
+                prototype[k] = sinc * window;
+                total += prototype[k];
+            }
+            for (int k = 0; k < kTapLength; ++k) decimator[k] = static_cast<float>(prototype[k] / total);
+            for (int phase = 0; phase < kFactor; ++phase) {
+                double phaseSum = 0.0;
+                for (int i = 0; i < kTapsPerPhase; ++i) phaseSum += prototype[phase + i * kFactor];
+                for (int i = 0; i < kTapsPerPhase; ++i)
+                    phases[phase][i] = static_cast<float>(prototype[phase + i * kFactor] / phaseSum);
+            }
+        }
+    };
+
+    // 로드 시 한 번 생성 (탭마다 sin/cos), 오디오 스레드에서는 만들지 않음
+    static const Kernel kernel;
+
+    float input[2 * kTapsPerPhase];
+    float upsampled[2 * kTapLength];
+    int inputPos = 0;
+    int upsampledPos = 0;
+};
+
+inline const SincOversampler8x::Kernel SincOversampler8x::kernel;
+
 //=======================================================================
 // Lookahead 리미터 (VST2와 완전히 동일한 알고리즘)
 // - 64 샘플 lookahead (~1.5ms @ 44.1kHz)
@@ -135,12 +283,24 @@ private:
 // - 심플하고 투명한 리미팅
 //=======================================================================
 struct LookaheadLimiter {
-    static constexpr int kLookaheadSamples = 64;  // ~1.5ms at 44.1kHz
+    static constexpr int kLookaheadSamples = 64;           // ~1.5ms at 44.1kHz
+    static constexpr int kExtendedLookaheadSamples = 128;  // ~2.9ms at 44.1kHz (High 품질)
+    static constexpr int kMaxLookaheadSamples = kExtendedLookaheadSamples;
     
     // 딜레이 버퍼
-    float delayL[kLookaheadSamples];
-    float delayR[kLookaheadSamples];
+    float delayL[kMaxLookaheadSamples];
+    float delayR[kMaxLookaheadSamples];
     int delayIndex = 0;
+    int lookaheadSamples = kLookaheadSamples;
+
+    // 확장 모드: 딜레이 라인 전체 구간의 입력 피크 최대값으로 게인 계산 (단조 큐 슬라이딩 최대값)
+    // -> 피크가 딜레이를 빠져나가기 전에 게인이 내려가 있음
+    bool peakHoldEnabled = false;
+    float holdPeak[kMaxLookaheadSamples + 1];
+    uint32_t holdExpiry[kMaxLookaheadSamples + 1];
+    int holdHead = 0;
+    int holdCount = 0;
+    uint32_t holdClock = 0;
     
     // 엔벨로프 팔로워
     float envelope = 0.0f;
@@ -164,15 +324,33 @@ struct LookaheadLimiter {
     }
     
     void reset() {
-        for (int i = 0; i < kLookaheadSamples; ++i) {
+        for (int i = 0; i < kMaxLookaheadSamples; ++i) {
             delayL[i] = 0.0f;
             delayR[i] = 0.0f;
         }
         delayIndex = 0;
+        holdHead = 0;
+        holdCount = 0;
         envelope = 0.0f;
         lastGain = 1.0f;
         gainReductionDb = 0.0f;
     }
+
+    // 표준 (64 샘플) 또는 확장 (128 샘플 + 피크 홀드) 룩어헤드
+    // 레이턴시가 바뀌고 딜레이 라인이 비워짐; 블록 사이에서 호출
+    void setExtendedLookahead(bool enabled) {
+        const int samples = enabled ? kExtendedLookaheadSamples : kLookaheadSamples;
+        if (samples == lookaheadSamples && enabled == peakHoldEnabled) return;
+        lookaheadSamples = samples;
+        peakHoldEnabled = enabled;
+        reset();
+    }
+
+    int getLookaheadSamples() const { return lookaheadSamples; }
+
+    static int getLookaheadSamples(bool extended) {
+        return extended ? kExtendedLookaheadSamples : kLookaheadSamples;
+    }
     
     void setSampleRate(float sr) {
         sampleRate = sr;
@@ -213,8 +391,39 @@ struct LookaheadLimiter {
         if (makeupGain > 4.0f) makeupGain = 4.0f;
     }
     
+    // 딜레이 라인에 남아 있는 샘플 (빠져나가는 샘플 포함) 의 슬라이딩 최대값
+    float holdPeakOverLookahead(float peak) {
+        const int size = kMaxLookaheadSamples + 1;
+        while (holdCount > 0 && holdPeak[(holdHead + holdCount - 1) % size] <= peak) --holdCount;
+        const int tail = (holdHead + holdCount) % size;
+        holdPeak[tail] = peak;
+        holdExpiry[tail] = holdClock + static_cast<uint32_t>(lookaheadSamples) + 1u;
+        ++holdCount;
+        ++holdClock;
+        while (static_cast<int32_t>(holdExpiry[holdHead] - holdClock) <= 0) {
+            holdHead = (holdHead + 1) % size;
+            --holdCount;
+        }
+        return holdPeak[holdHead];
+    }
+
     // VST2와 완전히 동일한 process 함수
     void process(float& left, float& right) {
+        if (peakHoldEnabled) processSample<true>(left, right);
+        else processSample<false>(left, right);
+    }
+
+    // 블록 프로세서용: 피크 홀드 여부를 청크마다 한 번만 판단
+    void processChunk(float* left, float* right, int numSamples) {
+        if (peakHoldEnabled) {
+            for (int i = 0; i < numSamples; ++i) processSample<true>(left[i], right[i]);
+        } else {
+            for (int i = 0; i < numSamples; ++i) processSample<false>(left[i], right[i]);
+        }
+    }
+
+    template <bool PeakHold>
+    inline void processSample(float& left, float& right) {
         // 딜레이된 샘플 가져오기
         float delayedL = delayL[delayIndex];
         float delayedR = delayR[delayIndex];
@@ -222,12 +431,13 @@ struct LookaheadLimiter {
         // 현재 샘플 딜레이 버퍼에 저장
         delayL[delayIndex] = left;
         delayR[delayIndex] = right;
-        delayIndex = (delayIndex + 1) % kLookaheadSamples;
+        if (++delayIndex >= lookaheadSamples) delayIndex = 0;
         
         // 피크 감지
         float peakL = std::abs(left);
         float peakR = std::abs(right);
         float peak = (peakL > peakR) ? peakL : peakR;
+        if constexpr (PeakHold) peak = holdPeakOverLookahead(peak);
         
         // 듀얼 엔벨로프 (VST2 ARC 스타일)
         float fastEnv = envelope;
@@ -271,43 +481,96 @@ struct LookaheadLimiter {
     }
 
     float getGainReductionDb() const { return gainReductionDb; }
+
+    // 게인 리덕션 없음 + 룩어헤드 딜레이가 모두 비워짐
+    bool isIdle(float level) const {
+        if (envelope > threshold) return false;
+        return bufferPeak(delayL, lookaheadSamples) < level
+            && bufferPeak(delayR, lookaheadSamples) < level;
+    }
+
+    // 디노멀 폴백 (블록당 1회); 딜레이 라인은 입력 샘플만 보관
+    void flushDenormals() { flushDenormal(envelope); }
 };
 
 //=======================================================================
 // LA-2A 스타일 옵토 컴프레서 (밴드별)
 //=======================================================================
 struct OptoCompressor {
-    float sampleRate = 44100.0f;
+    // 핫: 샘플 루프가 읽고 쓰는 값을 앞쪽에 연속으로 (인스턴스는 프로세서의 StateArena에서 캐시 라인
+    // 경계에서 시작)
     float envelope = 0.0f;
     float fastEnvelope = 0.0f;
     float slowEnvelope = 0.0f;
+    float peakHold = 0.0f;
+    float lastGain = 1.0f;
+    float gainReductionDb = 0.0f;
+    float currentGain = 1.0f;
+
+    // 게인 컴퓨터 주기: 프로그램 의존 릴리즈와 게인 커브를 N 샘플마다 계산 (1 = 매 샘플)
+    // 디텍터, 엔벨로프, 게인 스무딩은 항상 매 샘플
+    int gainComputerInterval = 1;
+    int gainComputerCountdown = 0;
+    float dynamicSlowCoeff = 0.0f;
+    float targetGain = 1.0f;
+    float targetGrDb = 0.0f;
+
     float attackCoeff = 0.0f;
     float fastReleaseCoeff = 0.0f;
     float slowReleaseCoeff = 0.0f;
+    float peakDecay = 0.0f;
     float threshold = 1.0f;
     float makeupGain = 1.0f;
-    float lastGain = 1.0f;
-    float gainReductionDb = 0.0f;
-    float peakHold = 0.0f;
-    float peakDecay = 0.0f;
-    
-    // 튜브 새츄레이션 파라미터
-    float saturationDrive = 0.3f;
-    bool saturationEnabled = true;
-    float currentGain = 1.0f;
 
-    // 오버샘플링 + 새츄레이터
-    TapeSaturator saturator;
-    PolyphaseOversampler oversamplerL;
-    PolyphaseOversampler oversamplerR;
-    float upBufferL[4];
-    float upBufferR[4];
+    // 조용한 신호 빠른 경로: quietLevel 아래에서는 게인 컴퓨터 결과가 정확히 0 dB GR이고
+    // (스레숄드 아래에서는 릴리즈도 정확히 기본값), log/exp/pow 계산을 건너뜀.
+    // 게인 컴퓨터 갱신마다 판단하므로 빠져나올 때 이음새가 없음
+    float quietLevel = 0.0f;
 
     // 사이드체인 HPF 상태
     bool sidechainEnabled = false;
     float scFilterCoeff = 0.0f;
     float scFilterState = 0.0f;
 
+    // 튜브 새츄레이션 파라미터
+    float saturationDrive = 0.3f;
+    bool saturationEnabled = true;
+    int saturationFactor = 4;               // 사용 중인 오버샘플링 배율: 설정 배율을 88.2 kHz 이상에서 낮춘 값
+    int fadeFromFactor = 4;                 // 페이드 중 사라지는 경로
+    float saturationFadeMix = 1.0f;         // 페이드 중 saturationFactor 경로의 비중
+    float saturationFadeStep = 0.0f;
+    int saturationFadeRemaining = 0;
+    bool saturationPathStale = false;   // processDetectorChunk에서 설정, processSaturationChunk에서 해제
+
+    // 8x 경로는 1x/2x/4x 경로보다 이만큼 더 늦음 (기본 레이트에서 7 대 ~4 샘플). 선택한 품질이 8x로
+    // 동작하는 동안 나머지 경로를 그 차이만큼 지연해, 과부하 단계 하강과 그 크로스페이드의 위상이
+    // 맞고 보고 레이턴시도 유지됨
+    static constexpr int kSinc8xAlignSamples = 3;
+    bool alignToSinc8x = false;
+    int alignPos = 0;
+    float alignDelayL[kSinc8xAlignSamples] = {};
+    float alignDelayR[kSinc8xAlignSamples] = {};
+
+    // 새츄레이터
+    TapeSaturator saturator;
+    float upBufferL[SincOversampler8x::kFactor];
+    float upBufferR[SincOversampler8x::kFactor];
+
+    // 콜드: 세터만 읽는 설정
+    float sampleRate = 44100.0f;
+    int requestedSaturationFactor = 4;      // 1: 같은 커브를 1x로 (Eco, 과부하 단계), 4, 8
+    int latencyFactor = 4;                  // 선택한 품질의 최대 단계 배율 (setLatencyFactor)
+
+    // 오버샘플러 필터 메모리는 맨 뒤: 샘플마다 실행 중인 배율의 한 쌍만 접근
+    PolyphaseOversampler oversamplerL;
+    PolyphaseOversampler oversamplerR;
+    PolyphaseOversampler oversampler2xL;    // 2x 경로 (88.2/96 kHz에서 4x 설정 시)
+    PolyphaseOversampler oversampler2xR;
+    PolyphaseOversampler linearL;           // 1x 경로 상태 (경로 간 크로스페이드를 위해 분리)
+    PolyphaseOversampler linearR;
+    SincOversampler8x sincL;                // 8x 경로 (High 품질)
+    SincOversampler8x sincR;
+
     // LA-2A 상수
     static constexpr float kMinRatio = 3.0f;
     static constexpr float kMaxRatio = 100.0f;
@@ -316,8 +579,13 @@ struct OptoCompressor {
     static constexpr float kFastReleaseMs = 60.0f;
     static constexpr float kSlowReleaseBase = 500.0f;
     static constexpr float kSlowReleaseMax = 5000.0f;
+    static constexpr float kQuietMarginDb = 0.5f;   // -knee/2 아래 여유 (dB 계산의 float 오차보다 훨씬 큼)
+    static constexpr float kDetectorFloor = 1.0e-6f;  // 디텍터 1e-12 바이어스의 제곱근: 무음에서 엔벨로프 정지값
 
-    OptoCompressor() { updateCoefficients(); }
+    OptoCompressor() {
+        updateCoefficients();
+        setThresholdDb(0.0f);
+    }
 
     void reset() {
         envelope = 0.0f;
@@ -328,16 +596,40 @@ struct OptoCompressor {
         peakHold = 0.0f;
         oversamplerL.reset();
         oversamplerR.reset();
+        oversampler2xL.reset();
+        oversampler2xR.reset();
+        linearL.reset();
+        linearR.reset();
+        sincL.reset();
+        sincR.reset();
         scFilterState = 0.0f;
+        gainComputerCountdown = 0;
+        targetGain = 1.0f;
+        targetGrDb = 0.0f;
     }
 
     void setSampleRate(float sr) {
         sampleRate = sr;
         updateCoefficients();
+        setLatencyFactor(latencyFactor);
+        setSaturationFactor(requestedSaturationFactor);
+    }
+
+    static int clampSaturationFactor(int factor) {
+        return (factor >= 8) ? 8 : (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
+    }
+
+    // 배율은 44.1/48 kHz 기준으로 요청: 높은 레이트에서는 같은 오버샘플 대역폭에 더 낮은 배율이면 충분
+    // (4x 요청은 88.2/96 kHz에서 2x, 176.4 kHz부터 1x; 8x는 4x, 2x)
+    static int rateAdaptedSaturationFactor(int factor, float sr) {
+        const int rateMultiple = (sr > 140000.0f) ? 4 : (sr > 70000.0f) ? 2 : 1;
+        factor = clampSaturationFactor(factor) / rateMultiple;
+        return (factor < 1) ? 1 : factor;
     }
 
     void setThresholdDb(float db) {
         threshold = std::pow(10.0f, db / 20.0f);
+        quietLevel = std::pow(10.0f, (db - kKneeDb * 0.5f - kQuietMarginDb) / 20.0f);
     }
 
     void setMakeupDb(float db) {
@@ -352,6 +644,65 @@ struct OptoCompressor {
         saturationEnabled = enabled;
     }
 
+    // 새츄레이션 오버샘플링 배율 (44.1/48 kHz 기준 1, 4, 8) 즉시 전환
+    void setSaturationFactor(int factor) {
+        requestedSaturationFactor = clampSaturationFactor(factor);
+        factor = rateAdaptedSaturationFactor(factor, sampleRate);
+        if (factor != saturationFactor) resetSaturationPath(factor);
+        saturationFactor = factor;
+        fadeFromFactor = factor;
+        saturationFadeMix = 1.0f;
+        saturationFadeRemaining = 0;
+    }
+
+    // 모든 경로에 있는 ~4 샘플 위에 새츄레이션이 더하는 지연: 이 레이트에서 8x로 동작하면
+    // kSinc8xAlignSamples. 래퍼가 보고 레이턴시에 더함
+    static int getSaturationLatency(int factor, float sr) {
+        return (rateAdaptedSaturationFactor(factor, sr) == 8) ? kSinc8xAlignSamples : 0;
+    }
+
+    int getSaturationLatency() const { return alignToSinc8x ? kSinc8xAlignSamples : 0; }
+
+    // 선택한 품질의 최대 단계 배율 (레이턴시 보고 기준). 정렬이 바뀌면 true: 출력이 차이만큼
+    // 움직이므로 호출 측은 페이드 없이, 레이턴시가 바뀌는 블록 경계에서 경로를 전환
+    bool setLatencyFactor(int factor) {
+        latencyFactor = clampSaturationFactor(factor);
+        const bool align = getSaturationLatency(latencyFactor, sampleRate) > 0;
+        if (align == alignToSinc8x) return false;
+        alignToSinc8x = align;
+        resetAlignDelay();
+        return true;
+    }
+
+    // 새츄레이션 경로 전환 (선형 크로스페이드, 페이드 중에는 두 경로 모두 처리)
+    // 정렬 지연으로 페이드 중에도 8x 경로와 나머지 경로의 위상이 맞음
+    void fadeSaturationFactor(int factor, int fadeSamples) {
+        requestedSaturationFactor = clampSaturationFactor(factor);
+        factor = rateAdaptedSaturationFactor(factor, sampleRate);
+        if (factor == saturationFactor) return;
+        if (fadeSamples <= 0) {
+            setSaturationFactor(factor);
+            return;
+        }
+        if (saturationFadeRemaining > 0 && factor == fadeFromFactor) {
+            // 페이드 도중 되돌림: 현재 믹스에서 이어서 진행
+            saturationFadeMix = 1.0f - saturationFadeMix;
+        } else {
+            resetSaturationPath(factor);
+            saturationFadeMix = 0.0f;
+        }
+        fadeFromFactor = saturationFactor;
+        saturationFactor = factor;
+        saturationFadeRemaining = fadeSamples;
+        saturationFadeStep = (1.0f - saturationFadeMix) / static_cast<float>(fadeSamples);
+    }
+
+    int getSaturationFactor() const { return saturationFactor; }
+
+    void setGainComputerInterval(int samples) {
+        gainComputerInterval = juce::jlimit(1, 64, samples);
+    }
+
     void setSidechainEnabled(bool enabled) { sidechainEnabled = enabled; }
     
     void setSidechainFreq(float fc) {
@@ -367,11 +718,90 @@ struct OptoCompressor {
     }
 
     void process(float& left, float& right) {
+        processDynamics(left, right);
+        processSaturation(left, right);
+    }
+
+    // 디텍터, 엔벨로프, 게인 계산 후 게인과 메이크업 적용
+    void processDynamics(float& left, float& right) {
+        if (sidechainEnabled) processDynamicsSample<true>(left, right);
+        else processDynamicsSample<false>(left, right);
+    }
+
+    // 블록 프로세서용 청크 버전: 사이드체인, 새츄레이션 배율, 크로스페이드를 청크마다 한 번만 판단해
+    // 샘플 루프에는 신호에 따른 분기만 남김. gains에는 샘플별 컴프레서 게인(getCurrentGain)을 기록
+    void processDynamicsChunk(float* left, float* right, float* gains, int numSamples) {
+        if (sidechainEnabled) {
+            for (int i = 0; i < numSamples; ++i) {
+                processDynamicsSample<true>(left[i], right[i]);
+                gains[i] = currentGain;
+            }
+        } else {
+            for (int i = 0; i < numSamples; ++i) {
+                processDynamicsSample<false>(left[i], right[i]);
+                gains[i] = currentGain;
+            }
+        }
+    }
+
+    void processSaturationChunk(float* left, float* right, int numSamples) {
+        if (saturationPathStale) {
+            // 뮤트 전에 남은 필터 메모리가 재생되면 클릭이 생김
+            resetSaturationPath(saturationFactor);
+            if (saturationFadeRemaining > 0) resetSaturationPath(fadeFromFactor);
+            saturationPathStale = false;
+        }
+        if (!saturationEnabled) return;
+        if (saturationFadeRemaining > 0) {
+            // 품질 전환 크로스페이드 중 (~20ms): 샘플 단위 경로
+            for (int i = 0; i < numSamples; ++i) processSaturation(left[i], right[i]);
+            return;
+        }
+
+        const float drive = 1.0f + saturationDrive * 3.0f;
+        const float bias = saturationDrive * 0.1f;
+        switch (saturationFactor) {
+            case 4:
+                for (int i = 0; i < numSamples; ++i)
+                    saturateOversampled<4>(oversamplerL, oversamplerR, left[i], right[i], drive, bias);
+                break;
+            case 2:
+                for (int i = 0; i < numSamples; ++i)
+                    saturateOversampled<2>(oversampler2xL, oversampler2xR, left[i], right[i], drive, bias);
+                break;
+            case 8:
+                for (int i = 0; i < numSamples; ++i) saturateSinc8x(left[i], right[i], drive, bias);
+                return;
+            default:
+                for (int i = 0; i < numSamples; ++i) saturateLinear(left[i], right[i], drive, bias);
+                break;
+        }
+        if (alignToSinc8x) {
+            for (int i = 0; i < numSamples; ++i) alignToSinc8xPath(left[i], right[i]);
+        }
+    }
+
+    // 믹스에 들어가지 않는 밴드(뮤트 / 솔로 제외)용 디텍터 전용 업데이트: 엔벨로프, 게인 계산
+    // (kDetectorOnlyInterval 샘플마다), 게인 스무딩은 계속 따라가므로 언뮤트 시 바로 맞는 게인으로
+    // 시작. 오디오는 건드리지 않고 새츄레이션도 생략하며, 필터는 다시 들릴 때 무음에서 재시작
+    static constexpr int kDetectorOnlyInterval = 16;
+
+    void processDetectorChunk(const float* left, const float* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            float l = left[i], r = right[i];
+            if (sidechainEnabled) processDynamicsSample<true, false>(l, r);
+            else processDynamicsSample<false, false>(l, r);
+        }
+        saturationPathStale = true;
+    }
+
+    template <bool Sidechain, bool AudioPath = true>
+    inline void processDynamicsSample(float& left, float& right) {
         // 사이드체인 HPF
         float monoIn = 0.5f * (left + right);
         float detectorSignal = monoIn;
 
-        if (sidechainEnabled) {
+        if constexpr (Sidechain) {
             scFilterState = scFilterState * scFilterCoeff + monoIn * (1.0f - scFilterCoeff);
             detectorSignal = monoIn - scFilterState;
         }
@@ -394,12 +824,22 @@ struct OptoCompressor {
             fastEnvelope = fastReleaseCoeff * fastEnvelope + (1.0f - fastReleaseCoeff) * detector;
         }
 
-        // 프로그램 의존 슬로우 릴리즈
-        float overDb = 20.0f * std::log10((peakHold / threshold) + 1.0e-12f);
-        if (overDb < 0.0f) overDb = 0.0f;
-        float releaseScale = juce::jlimit(1.0f, 10.0f, 1.0f + (overDb * 0.15f));
-        float slowRelMs = std::min(kSlowReleaseBase * releaseScale, kSlowReleaseMax);
-        float dynamicSlowCoeff = std::exp(-1.0f / (sampleRate * slowRelMs / 1000.0f));
+        const bool computeGain = (--gainComputerCountdown <= 0);
+        if (computeGain) {
+            gainComputerCountdown = (AudioPath || gainComputerInterval > kDetectorOnlyInterval)
+                                        ? gainComputerInterval : kDetectorOnlyInterval;
+
+            // 프로그램 의존 슬로우 릴리즈 (스레숄드 아래에서는 기본 릴리즈)
+            if (peakHold < threshold) {
+                dynamicSlowCoeff = slowReleaseCoeff;
+            } else {
+                float overDb = 20.0f * std::log10((peakHold / threshold) + 1.0e-12f);
+                if (overDb < 0.0f) overDb = 0.0f;
+                float releaseScale = juce::jlimit(1.0f, 10.0f, 1.0f + (overDb * 0.15f));
+                float slowRelMs = std::min(kSlowReleaseBase * releaseScale, kSlowReleaseMax);
+                dynamicSlowCoeff = std::exp(-1.0f / (sampleRate * slowRelMs / 1000.0f));
+            }
+        }
 
         if (detector > slowEnvelope) {
             slowEnvelope = attackCoeff * slowEnvelope + (1.0f - attackCoeff) * detector;
@@ -410,61 +850,190 @@ struct OptoCompressor {
         // 복합 엔벨로프
         envelope = 0.3f * fastEnvelope + 0.7f * slowEnvelope;
 
-        // 게인 계산 (가변 레이시오)
-        float levelDb = 20.0f * std::log10(envelope + 1.0e-12f);
-        float threshDb = 20.0f * std::log10(threshold + 1.0e-12f);
-        float overThresh = levelDb - threshDb;
+        if (computeGain && envelope < quietLevel) {
+            // 조용한 신호 빠른 경로: 니 아래 충분히 낮음
+            targetGain = 1.0f;
+            targetGrDb = 0.0f;
+        } else if (computeGain) {
+            // 게인 계산 (가변 레이시오)
+            float levelDb = 20.0f * std::log10(envelope + 1.0e-12f);
+            float threshDb = 20.0f * std::log10(threshold + 1.0e-12f);
+            float overThresh = levelDb - threshDb;
+
+            float dynamicRatio = kMinRatio;
+            if (overThresh > 0.0f) {
+                float ratioBlend = juce::jlimit(0.0f, 1.0f, overThresh / 20.0f);
+                dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
+            }
 
-        float dynamicRatio = kMinRatio;
-        if (overThresh > 0.0f) {
-            float ratioBlend = juce::jlimit(0.0f, 1.0f, overThresh / 20.0f);
-            dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
-        }
+            // 소프트 니
+            float grDb = 0.0f;
+            if (overThresh <= -kKneeDb * 0.5f) {
+                grDb = 0.0f;
+            } else if (overThresh >= kKneeDb * 0.5f) {
+                grDb = overThresh - (overThresh / dynamicRatio);
+            } else {
+                float x = overThresh + kKneeDb * 0.5f;
+                grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
+            }
 
-        // 소프트 니
-        float grDb = 0.0f;
-        if (overThresh <= -kKneeDb * 0.5f) {
-            grDb = 0.0f;
-        } else if (overThresh >= kKneeDb * 0.5f) {
-            grDb = overThresh - (overThresh / dynamicRatio);
-        } else {
-            float x = overThresh + kKneeDb * 0.5f;
-            grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
+            targetGain = std::pow(10.0f, -grDb / 20.0f);
+            targetGrDb = grDb;
         }
 
-        float gain = std::pow(10.0f, -grDb / 20.0f);
         float gainSmooth = 0.995f;
-        gain = gainSmooth * lastGain + (1.0f - gainSmooth) * gain;
+        float gain = gainSmooth * lastGain + (1.0f - gainSmooth) * targetGain;
 
         currentGain = gain;
 
-        left *= gain * makeupGain;
-        right *= gain * makeupGain;
+        if constexpr (AudioPath) {
+            left *= gain * makeupGain;
+            right *= gain * makeupGain;
+        }
+
+        lastGain = gain;
+        gainReductionDb = targetGrDb;
+    }
 
-        // 4x 오버샘플링 + 테이프 새츄레이션
+    // 오버샘플링 (1x / 4x / 8x) + 테이프 새츄레이션
+    void processSaturation(float& left, float& right) {
         if (saturationEnabled) {
             float drive = 1.0f + saturationDrive * 3.0f; 
             float bias = saturationDrive * 0.1f;
 
-            // 좌채널
-            oversamplerL.processUpsample(left, upBufferL);
-            for (int i = 0; i < 4; ++i) 
-                upBufferL[i] = saturator.process(upBufferL[i], drive, bias);
-            left = oversamplerL.processDownsample(upBufferL) / drive;
+            if (saturationFadeRemaining > 0) {
+                float fromL = left, fromR = right;
+                saturateAt(fadeFromFactor, fromL, fromR, drive, bias);
+                saturateAt(saturationFactor, left, right, drive, bias);
+                saturationFadeMix += saturationFadeStep;
+                if (--saturationFadeRemaining == 0) saturationFadeMix = 1.0f;
+                left = fromL + (left - fromL) * saturationFadeMix;
+                right = fromR + (right - fromR) * saturationFadeMix;
+            } else {
+                saturateAt(saturationFactor, left, right, drive, bias);
+            }
+        }
+    }
+
+    inline void saturateAt(int factor, float& left, float& right, float drive, float bias) {
+        if (factor == 8) {
+            saturateSinc8x(left, right, drive, bias);
+            return;
+        }
+        if (factor == 4) saturateOversampled<4>(oversamplerL, oversamplerR, left, right, drive, bias);
+        else if (factor == 2) saturateOversampled<2>(oversampler2xL, oversampler2xR, left, right, drive, bias);
+        else saturateLinear(left, right, drive, bias);
+        if (alignToSinc8x) alignToSinc8xPath(left, right);
+    }
 
-            // 우채널
-            oversamplerR.processUpsample(right, upBufferR);
-            for (int i = 0; i < 4; ++i) 
-                upBufferR[i] = saturator.process(upBufferR[i], drive, bias);
-            right = oversamplerR.processDownsample(upBufferR) / drive;
+    // 1x/2x/4x 경로 출력에 kSinc8xAlignSamples 지연 (정렬 중에는 하나만 동작:
+    // High의 과부하 단계는 8x에서 바로 1x로 내려감)
+    inline void alignToSinc8xPath(float& left, float& right) {
+        const float delayedL = alignDelayL[alignPos];
+        const float delayedR = alignDelayR[alignPos];
+        alignDelayL[alignPos] = left;
+        alignDelayR[alignPos] = right;
+        alignPos = (alignPos + 1 == kSinc8xAlignSamples) ? 0 : alignPos + 1;
+        left = delayedL;
+        right = delayedR;
+    }
+
+    void resetAlignDelay() {
+        for (int i = 0; i < kSinc8xAlignSamples; ++i) {
+            alignDelayL[i] = 0.0f;
+            alignDelayR[i] = 0.0f;
         }
+        alignPos = 0;
+    }
 
-        lastGain = gain;
-        gainReductionDb = grDb;
+    template <int Factor>
+    inline void saturateOversampled(PolyphaseOversampler& osL, PolyphaseOversampler& osR,
+                                    float& left, float& right, float drive, float bias) {
+        // 좌채널
+        osL.processUpsample<Factor>(left, upBufferL);
+        for (int i = 0; i < Factor; ++i) 
+            upBufferL[i] = saturator.process(upBufferL[i], drive, bias);
+        left = osL.processDownsample<Factor>(upBufferL) / drive;
+
+        // 우채널
+        osR.processUpsample<Factor>(right, upBufferR);
+        for (int i = 0; i < Factor; ++i) 
+            upBufferR[i] = saturator.process(upBufferR[i], drive, bias);
+        right = osR.processDownsample<Factor>(upBufferR) / drive;
+    }
+
+    inline void saturateSinc8x(float& left, float& right, float drive, float bias) {
+        sincL.processUpsample(left, upBufferL);
+        for (int i = 0; i < SincOversampler8x::kFactor; ++i)
+            upBufferL[i] = saturator.process(upBufferL[i], drive, bias);
+        left = sincL.processDownsample(upBufferL) / drive;
+
+        sincR.processUpsample(right, upBufferR);
+        for (int i = 0; i < SincOversampler8x::kFactor; ++i)
+            upBufferR[i] = saturator.process(upBufferR[i], drive, bias);
+        right = sincR.processDownsample(upBufferR) / drive;
+    }
+
+    // 페이드 인되는 경로는 마지막으로 떠날 때의 상태가 아닌 무음에서 시작
+    void resetSaturationPath(int factor) {
+        if (factor == 4) {
+            oversamplerL.reset();
+            oversamplerR.reset();
+        } else if (factor == 2) {
+            oversampler2xL.reset();
+            oversampler2xR.reset();
+        } else if (factor == 8) {
+            sincL.reset();
+            sincR.reset();
+        } else {
+            linearL.reset();
+            linearR.reset();
+        }
+        if (factor != 8) resetAlignDelay();
+    }
+
+    // 같은 커브와 필터 응답을 1x로 (에일리어싱은 감수)
+    inline void saturateLinear(float& left, float& right, float drive, float bias) {
+        left = linearL.processLinearEquivalent(saturator.process(left, drive, bias)) / drive;
+        right = linearR.processLinearEquivalent(saturator.process(right, drive, bias)) / drive;
     }
 
     float getGainReductionDb() const { return gainReductionDb; }
     float getCurrentGain() const { return currentGain; }
+
+    // 게인이 1로 복귀하고, 디텍터 엔벨로프가 무음 정지값에서 threshold 이내로 감쇠했으며,
+    // 사이드체인/오버샘플러 메모리가 비워짐 (더 일찍 리셋하면 다음 온셋의 어택이 달라짐)
+    bool isIdle(float threshold) const {
+        if (gainReductionDb > 0.0f || lastGain < 0.9999f) return false;
+        const float level = kDetectorFloor + threshold;
+        if (envelope >= level || fastEnvelope >= level || slowEnvelope >= level || peakHold >= level) return false;
+        if (std::abs(scFilterState) >= threshold) return false;
+        if (bufferPeak(alignDelayL, kSinc8xAlignSamples) >= threshold
+            || bufferPeak(alignDelayR, kSinc8xAlignSamples) >= threshold) return false;
+        return oversamplerL.isIdle(threshold) && oversamplerR.isIdle(threshold)
+            && oversampler2xL.isIdle(threshold) && oversampler2xR.isIdle(threshold)
+            && linearL.isIdle(threshold) && linearR.isIdle(threshold)
+            && sincL.isIdle(threshold) && sincR.isIdle(threshold);
+    }
+
+    // 디노멀 폴백 (블록당 1회): 디텍터 엔벨로프와 필터 메모리
+    void flushDenormals() {
+        flushDenormal(envelope);
+        flushDenormal(fastEnvelope);
+        flushDenormal(slowEnvelope);
+        flushDenormal(peakHold);
+        flushDenormal(scFilterState);
+        oversamplerL.flushDenormals();
+        oversamplerR.flushDenormals();
+        oversampler2xL.flushDenormals();
+        oversampler2xR.flushDenormals();
+        linearL.flushDenormals();
+        linearR.flushDenormals();
+        sincL.flushDenormals();
+        sincR.flushDenormals();
+        ELC4L::flushDenormals(alignDelayL, kSinc8xAlignSamples);
+        ELC4L::flushDenormals(alignDelayR, kSinc8xAlignSamples);
+    }
 };
 
 //=======================================================================
@@ -500,78 +1069,347 @@ struct LufsMeter {
         momentaryLufs = -0.691f + 10.0f * std::log10(safeEnergy);
     }
 
+    // process(0, 0)을 numSamples번 호출한 것과 동일
+    void processSilence(int numSamples) {
+        momentaryEnergy *= std::pow(momentaryCoeff, static_cast<float>(numSamples));
+        float safeEnergy = std::max(momentaryEnergy, 1.0e-12f);
+        momentaryLufs = -0.691f + 10.0f * std::log10(safeEnergy);
+    }
+
+    void flushDenormals() { flushDenormal(momentaryEnergy); }
+
     float getMomentary() const { return momentaryLufs; }
 };
 
 //=======================================================================
-// Linkwitz-Riley 4차 크로스오버 (4밴드)
+// CompressorBank<NumBands> - 크로스오버 밴드마다 OptoCompressor 하나, 앞단 크로스오버와 같은 N
+// (Crossover<NumBands>::kNumBands). 밴드별 설정은 operator[]로, 수명 주기 호출은 뱅크 전체를
+// 컴파일러가 펼치는 루프로 처리
 //=======================================================================
-struct CrossoverDSP {
+template <int NumBands>
+struct CompressorBank {
+    static constexpr int kNumBands = NumBands;
+
+    OptoCompressor bands[NumBands];
+
+    OptoCompressor& operator[](int band) { return bands[band]; }
+    const OptoCompressor& operator[](int band) const { return bands[band]; }
+
+    void setSampleRate(float sr) {
+        for (int b = 0; b < NumBands; ++b) bands[b].setSampleRate(sr);
+    }
+
+    void reset() {
+        for (int b = 0; b < NumBands; ++b) bands[b].reset();
+    }
+
+    bool isIdle(float threshold) const {
+        for (int b = 0; b < NumBands; ++b) {
+            if (!bands[b].isIdle(threshold)) return false;
+        }
+        return true;
+    }
+
+    void flushDenormals() {
+        for (int b = 0; b < NumBands; ++b) bands[b].flushDenormals();
+    }
+
+    int getSaturationLatency() const { return bands[0].getSaturationLatency(); }
+};
+
+//=======================================================================
+// Crossover<NumBands> - Linkwitz-Riley 4차 크로스오버, 2 ~ kMaxCrossoverBands 밴드
+// 분할 트리를 컴파일 타임에 구성: 분할 k는 밴드 k와 k + 1 사이, 노드마다 별도 인스턴스라 밴드마다
+// 바이쿼드 경로가 고정되어 샘플 코드가 완전히 펼쳐지고, 2밴드 체인은 분할 하나만 실행
+// - 보상 (기본): 균형 트리. 각 가지가 반대편 분할들의 2차 올패스 (LPF + HPF)를 함께 거치므로
+//   모든 밴드의 위상 응답이 같고 밴드 합이 올패스
+// - 비보상: 올패스 없는 직렬 캐스케이드 (분할 0의 HPF가 분할 1로 ...). 분할 지점 부근에서 밴드
+//   위상이 달라 처리 전 합이 꺼짐 (기본 4밴드 지점에서 0.45 dB, 6밴드 1.5 dB). CrossoverDSP가
+//   이 구성: 등가성 기준이 고정한 출시 4밴드 응답
+// 계수는 double로 설계; 필터는 double (기본) 또는 float (Eco 품질)로 동작
+// 정밀도 전환 시 필터 메모리를 옮겨 담으므로 클릭 없음
+//=======================================================================
+constexpr int kMaxCrossoverBands = 8;
+
+template <int NumBands, bool Compensated = true>
+struct Crossover {
+    static_assert(NumBands >= 2 && NumBands <= kMaxCrossoverBands, "Crossover: 2 to 8 bands");
+
+    static constexpr int kNumBands = NumBands;
+    static constexpr int kNumSplits = NumBands - 1;
+
+    // 트리 모양: count개 밴드 노드는 아래쪽 lowCount(count)개 밴드 다음에서 분할; 두 가지가
+    // 합쳐 count - 2개 올패스를 거침 (각각 반대편의 분할)
+    static constexpr int lowCount(int count) { return Compensated ? count / 2 : 1; }
+    static constexpr int nodeAllpasses(int count) { return Compensated ? count - 2 : 0; }
+    static constexpr int treeAllpasses(int count) {
+        return (count < 2) ? 0
+             : nodeAllpasses(count) + treeAllpasses(lowCount(count)) + treeAllpasses(count - lowCount(count));
+    }
+    static constexpr int kNumAllpasses = treeAllpasses(NumBands);
+
+    template <typename T>
     struct BiquadCoeffs {
-        double b0, b1, b2;
-        double a1, a2;
+        T b0 = 0, b1 = 0, b2 = 0;
+        T a1 = 0, a2 = 0;
     };
     
-    struct BiquadState {
-        double x1[2] = {}, x2[2] = {};
-        double y1[2] = {}, y2[2] = {};
+    // 채널 쌍 (x1[0], x1[1] ...)을 벡터 하나로 읽고 쓰므로 16바이트 정렬: 캐시 라인에 걸치지 않음
+    template <typename T>
+    struct alignas(16) BiquadState {
+        T x1[2] = {}, x2[2] = {};
+        T y1[2] = {}, y2[2] = {};
         
         void reset() {
-            x1[0] = x1[1] = x2[0] = x2[1] = 0.0;
-            y1[0] = y1[1] = y2[0] = y2[1] = 0.0;
+            x1[0] = x1[1] = x2[0] = x2[1] = 0;
+            y1[0] = y1[1] = y2[0] = y2[1] = 0;
+        }
+
+        bool isIdle(double threshold) const {
+            for (int ch = 0; ch < 2; ++ch) {
+                if (std::abs(x1[ch]) >= threshold || std::abs(x2[ch]) >= threshold) return false;
+                if (std::abs(y1[ch]) >= threshold || std::abs(y2[ch]) >= threshold) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int ch = 0; ch < 2; ++ch) {
+                flushDenormal(x1[ch]); flushDenormal(x2[ch]);
+                flushDenormal(y1[ch]); flushDenormal(y2[ch]);
+            }
+        }
+
+        template <typename U>
+        void copyFrom(const BiquadState<U>& other) {
+            for (int ch = 0; ch < 2; ++ch) {
+                x1[ch] = static_cast<T>(other.x1[ch]); x2[ch] = static_cast<T>(other.x2[ch]);
+                y1[ch] = static_cast<T>(other.y1[ch]); y2[ch] = static_cast<T>(other.y2[ch]);
+            }
+        }
+    };
+
+    // 분할 지점 하나: LR4 LPF와 HPF (버터워스 바이쿼드 2단씩). 계수와 메모리를 샘플 루프가 방문하는
+    // 순서로 두어, 네트워크 전체에 흩어진 배열 6개 대신 분할마다 연속된 캐시 라인 한 덩어리
+    template <typename T>
+    struct Split {
+        BiquadCoeffs<T> lowpass;
+        BiquadState<T> lpStateA, lpStateB;
+        BiquadCoeffs<T> highpass;
+        BiquadState<T> hpStateA, hpStateB;
+
+        void reset() {
+            lpStateA.reset(); lpStateB.reset();
+            hpStateA.reset(); hpStateB.reset();
+        }
+
+        bool isIdle(double threshold) const {
+            return lpStateA.isIdle(threshold) && lpStateB.isIdle(threshold)
+                && hpStateA.isIdle(threshold) && hpStateB.isIdle(threshold);
+        }
+
+        void flushDenormals() {
+            lpStateA.flushDenormals(); lpStateB.flushDenormals();
+            hpStateA.flushDenormals(); hpStateB.flushDenormals();
+        }
+    };
+
+    // 보상 올패스 메모리, 트리 순서 (2밴드와 직렬 캐스케이드는 없음)
+    template <typename T, int Count>
+    struct AllpassStates {
+        BiquadState<T> states[Count];
+    };
+
+    template <typename T>
+    struct AllpassStates<T, 0> {
+        static constexpr BiquadState<T>* states = nullptr;
+    };
+
+    template <typename T>
+    struct Network;
+
+    // 밴드 [First, First + Count) 노드, 올패스 메모리는 Offset부터: 입력을 분할하고 두 가지를
+    // 보상한 뒤 자식 노드로 넘김
+    template <int First, int Count, int Offset>
+    struct Node {
+        static constexpr int kLowCount = lowCount(Count);
+        static constexpr int kSplit = First + kLowCount - 1;
+        static constexpr int kLowChildOffset = Offset + nodeAllpasses(Count);
+        static constexpr int kHighChildOffset = kLowChildOffset + treeAllpasses(kLowCount);
+
+        template <typename T>
+        static inline void process(Network<T>& net, T inL, T inR, float* bandL, float* bandR) {
+            Split<T>& split = net.splits[kSplit];
+            T lpL = Network<T>::processBiquad(inL, 0, split.lowpass, split.lpStateA);
+            T lpR = Network<T>::processBiquad(inR, 1, split.lowpass, split.lpStateA);
+            T lowL = Network<T>::processBiquad(lpL, 0, split.lowpass, split.lpStateB);
+            T lowR = Network<T>::processBiquad(lpR, 1, split.lowpass, split.lpStateB);
+
+            T hpL = Network<T>::processBiquad(inL, 0, split.highpass, split.hpStateA);
+            T hpR = Network<T>::processBiquad(inR, 1, split.highpass, split.hpStateA);
+            T highL = Network<T>::processBiquad(hpL, 0, split.highpass, split.hpStateB);
+            T highR = Network<T>::processBiquad(hpR, 1, split.highpass, split.hpStateB);
+
+            if constexpr (Compensated) {
+                // 아래 가지: 위쪽 분할들, 위 가지: 아래쪽 분할들
+                int allpass = Offset;
+                for (int k = kSplit + 1; k < First + Count - 1; ++k, ++allpass) {
+                    lowL = Network<T>::processAllpass(lowL, 0, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                    lowR = Network<T>::processAllpass(lowR, 1, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                }
+                for (int k = First; k < kSplit; ++k, ++allpass) {
+                    highL = Network<T>::processAllpass(highL, 0, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                    highR = Network<T>::processAllpass(highR, 1, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                }
+            }
+
+            Node<First, kLowCount, kLowChildOffset>::process(net, lowL, lowR, bandL, bandR);
+            Node<First + kLowCount, Count - kLowCount, kHighChildOffset>::process(net, highL, highR, bandL, bandR);
+        }
+    };
+
+    template <int First, int Offset>
+    struct Node<First, 1, Offset> {
+        template <typename T>
+        static inline void process(Network<T>&, T inL, T inR, float* bandL, float* bandR) {
+            bandL[First] = static_cast<float>(inL);
+            bandR[First] = static_cast<float>(inR);
+        }
+    };
+
+    // 한 정밀도의 모든 분할 지점과 보상 올패스
+    template <typename T>
+    struct Network {
+        Split<T> splits[kNumSplits];
+        AllpassStates<T, kNumAllpasses> allpasses;
+
+        static inline T processBiquad(T input, int channel, const BiquadCoeffs<T>& c, BiquadState<T>& s) {
+            T output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
+                     - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+
+            s.x2[channel] = s.x1[channel];
+            s.x1[channel] = input;
+            s.y2[channel] = s.y1[channel];
+            s.y1[channel] = output;
+
+            return output;
+        }
+
+        // 분할의 LR4 LPF + HPF: 버터워스 분모와 그 뒤집은 분자이므로 분할의 LPF 계수를 읽음
+        static inline T processAllpass(T input, int channel, const BiquadCoeffs<T>& c, BiquadState<T>& s) {
+            T output = c.a2 * input + c.a1 * s.x1[channel] + s.x2[channel]
+                     - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+
+            s.x2[channel] = s.x1[channel];
+            s.x1[channel] = input;
+            s.y2[channel] = s.y1[channel];
+            s.y1[channel] = output;
+
+            return output;
+        }
+
+        inline void process(float inL, float inR, float* bandL, float* bandR) {
+            Node<0, NumBands, 0>::process(*this, static_cast<T>(inL), static_cast<T>(inR), bandL, bandR);
+        }
+
+        void reset() {
+            for (int k = 0; k < kNumSplits; ++k) splits[k].reset();
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].reset();
+        }
+
+        bool isIdle(double threshold) const {
+            for (int k = 0; k < kNumSplits; ++k) {
+                if (!splits[k].isIdle(threshold)) return false;
+            }
+            for (int a = 0; a < kNumAllpasses; ++a) {
+                if (!allpasses.states[a].isIdle(threshold)) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int k = 0; k < kNumSplits; ++k) splits[k].flushDenormals();
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].flushDenormals();
+        }
+
+        // 분할 지점 하나의 계수 (그 올패스도 같은 계수를 읽음)
+        template <typename U>
+        void copyCoefficientsFrom(const Network<U>& other, int k) {
+            const BiquadCoeffs<U>* src[2] = { &other.splits[k].lowpass, &other.splits[k].highpass };
+            BiquadCoeffs<T>* dst[2] = { &splits[k].lowpass, &splits[k].highpass };
+            for (int f = 0; f < 2; ++f) {
+                dst[f]->b0 = static_cast<T>(src[f]->b0); dst[f]->b1 = static_cast<T>(src[f]->b1);
+                dst[f]->b2 = static_cast<T>(src[f]->b2);
+                dst[f]->a1 = static_cast<T>(src[f]->a1); dst[f]->a2 = static_cast<T>(src[f]->a2);
+            }
+        }
+
+        template <typename U>
+        void copyStateFrom(const Network<U>& other) {
+            for (int k = 0; k < kNumSplits; ++k) {
+                const Split<U>& src = other.splits[k];
+                Split<T>& dst = splits[k];
+                dst.lpStateA.copyFrom(src.lpStateA); dst.lpStateB.copyFrom(src.lpStateB);
+                dst.hpStateA.copyFrom(src.hpStateA); dst.hpStateB.copyFrom(src.hpStateB);
+            }
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].copyFrom(other.allpasses.states[a]);
         }
     };
-    
-    // 3개 크로스오버 포인트에 대한 필터 쌍
-    BiquadCoeffs lowpass1a, lowpass1b;
-    BiquadCoeffs highpass1a, highpass1b;
-    BiquadState lp1StateA, lp1StateB;
-    BiquadState hp1StateA, hp1StateB;
-
-    BiquadCoeffs lowpass2a, lowpass2b;
-    BiquadCoeffs highpass2a, highpass2b;
-    BiquadState lp2StateA, lp2StateB;
-    BiquadState hp2StateA, hp2StateB;
-
-    BiquadCoeffs lowpass3a, lowpass3b;
-    BiquadCoeffs highpass3a, highpass3b;
-    BiquadState lp3StateA, lp3StateB;
-    BiquadState hp3StateA, hp3StateB;
+
+    Network<double> precise;
+    Network<float> fast;
+    bool doublePrecision = true;
 
     float sampleRate = 44100.0f;
-    float xover1 = 120.0f;
-    float xover2 = 800.0f;
-    float xover3 = 4000.0f;
+    float frequencies[kNumSplits];
     
-    CrossoverDSP() { updateCoefficients(); }
+    Crossover() {
+        for (int k = 0; k < kNumSplits; ++k) frequencies[k] = getDefaultFrequency(k);
+        updateCoefficients();
+    }
+
+    // 4밴드는 120 / 800 / 4000 Hz, 그 외 밴드 수는 100 Hz - 8 kHz 로그 간격
+    static float getDefaultFrequency(int k) {
+        static const float fourBand[3] = { 120.0f, 800.0f, 4000.0f };
+        if (NumBands == 4) return fourBand[k];
+        if (kNumSplits == 1) return 800.0f;
+        return 100.0f * std::pow(80.0f, static_cast<float>(k) / static_cast<float>(kNumSplits - 1));
+    }
     
     void setSampleRate(float sr) {
         sampleRate = sr;
         updateCoefficients();
     }
     
-    void setXover1(float freq) { xover1 = freq; updateCoefficients(); }
-    void setXover2(float freq) { xover2 = freq; updateCoefficients(); }
-    void setXover3(float freq) { xover3 = freq; updateCoefficients(); }
+    // 분할 k의 필터 쌍만 다시 계산
+    void setFrequency(int k, float freq) {
+        frequencies[k] = freq;
+        updateSplitCoefficients(k);
+    }
+
+    float getFrequency(int k) const { return frequencies[k]; }
+
+    // 오디오 스레드 (샘플 사이): 동작 중인 네트워크의 메모리를 다른 정밀도로 옮김
+    void setDoublePrecision(bool enabled) {
+        if (enabled == doublePrecision) return;
+        if (enabled) precise.copyStateFrom(fast);
+        else fast.copyStateFrom(precise);
+        doublePrecision = enabled;
+    }
     
     void updateCoefficients() {
-        calculateButterworthLP(lowpass1a, xover1, sampleRate);
-        lowpass1b = lowpass1a;
-        calculateButterworthHP(highpass1a, xover1, sampleRate);
-        highpass1b = highpass1a;
-
-        calculateButterworthLP(lowpass2a, xover2, sampleRate);
-        lowpass2b = lowpass2a;
-        calculateButterworthHP(highpass2a, xover2, sampleRate);
-        highpass2b = highpass2a;
+        for (int k = 0; k < kNumSplits; ++k) {
+            updateSplitCoefficients(k);
+        }
+    }
 
-        calculateButterworthLP(lowpass3a, xover3, sampleRate);
-        lowpass3b = lowpass3a;
-        calculateButterworthHP(highpass3a, xover3, sampleRate);
-        highpass3b = highpass3a;
+    void updateSplitCoefficients(int k) {
+        calculateButterworthLP(precise.splits[k].lowpass, frequencies[k], sampleRate);
+        calculateButterworthHP(precise.splits[k].highpass, frequencies[k], sampleRate);
+        fast.copyCoefficientsFrom(precise, k);
     }
     
-    void calculateButterworthLP(BiquadCoeffs& c, float freq, float sr) {
+    void calculateButterworthLP(BiquadCoeffs<double>& c, float freq, float sr) {
         const double w0 = 2.0 * juce::MathConstants<double>::pi * freq / sr;
         const double cosw0 = std::cos(w0);
         const double sinw0 = std::sin(w0);
@@ -586,7 +1424,7 @@ struct CrossoverDSP {
         c.a2 = (1.0 - alpha) / a0;
     }
     
-    void calculateButterworthHP(BiquadCoeffs& c, float freq, float sr) {
+    void calculateButterworthHP(BiquadCoeffs<double>& c, float freq, float sr) {
         const double w0 = 2.0 * juce::MathConstants<double>::pi * freq / sr;
         const double cosw0 = std::cos(w0);
         const double sinw0 = std::sin(w0);
@@ -601,79 +1439,32 @@ struct CrossoverDSP {
         c.a2 = (1.0 - alpha) / a0;
     }
     
-    inline double processBiquad(double input, int channel, const BiquadCoeffs& c, BiquadState& s) {
-        double output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
-                       - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
-        
-        s.x2[channel] = s.x1[channel];
-        s.x1[channel] = input;
-        s.y2[channel] = s.y1[channel];
-        s.y1[channel] = output;
-        
-        return output;
-    }
-    
-    void processSample(float inL, float inR,
-                       float& band1L, float& band1R,
-                       float& band2L, float& band2R,
-                       float& band3L, float& band3R,
-                       float& band4L, float& band4R) {
-        // 밴드 1: LPF1 -> LPF1 (저역)
-        double lp1L = processBiquad(inL, 0, lowpass1a, lp1StateA);
-        double lp1R = processBiquad(inR, 1, lowpass1a, lp1StateA);
-        double band1OutL = processBiquad(lp1L, 0, lowpass1b, lp1StateB);
-        double band1OutR = processBiquad(lp1R, 1, lowpass1b, lp1StateB);
-
-        // 크로스오버 1 이상
-        double hp1L = processBiquad(inL, 0, highpass1a, hp1StateA);
-        double hp1R = processBiquad(inR, 1, highpass1a, hp1StateA);
-        double highFrom1L = processBiquad(hp1L, 0, highpass1b, hp1StateB);
-        double highFrom1R = processBiquad(hp1R, 1, highpass1b, hp1StateB);
-
-        // 밴드 2: 크로스오버 1-2 사이
-        double lp2L = processBiquad(highFrom1L, 0, lowpass2a, lp2StateA);
-        double lp2R = processBiquad(highFrom1R, 1, lowpass2a, lp2StateA);
-        double band2OutL = processBiquad(lp2L, 0, lowpass2b, lp2StateB);
-        double band2OutR = processBiquad(lp2R, 1, lowpass2b, lp2StateB);
-
-        // 크로스오버 2 이상
-        double hp2L = processBiquad(highFrom1L, 0, highpass2a, hp2StateA);
-        double hp2R = processBiquad(highFrom1R, 1, highpass2a, hp2StateA);
-        double highFrom2L = processBiquad(hp2L, 0, highpass2b, hp2StateB);
-        double highFrom2R = processBiquad(hp2R, 1, highpass2b, hp2StateB);
-
-        // 밴드 3: 크로스오버 2-3 사이
-        double lp3L = processBiquad(highFrom2L, 0, lowpass3a, lp3StateA);
-        double lp3R = processBiquad(highFrom2R, 1, lowpass3a, lp3StateA);
-        double band3OutL = processBiquad(lp3L, 0, lowpass3b, lp3StateB);
-        double band3OutR = processBiquad(lp3R, 1, lowpass3b, lp3StateB);
-
-        // 밴드 4: 크로스오버 3 이상 (고역)
-        double hp3L = processBiquad(highFrom2L, 0, highpass3a, hp3StateA);
-        double hp3R = processBiquad(highFrom2R, 1, highpass3a, hp3StateA);
-        double band4OutL = processBiquad(hp3L, 0, highpass3b, hp3StateB);
-        double band4OutR = processBiquad(hp3R, 1, highpass3b, hp3StateB);
-
-        band1L = static_cast<float>(band1OutL);
-        band1R = static_cast<float>(band1OutR);
-        band2L = static_cast<float>(band2OutL);
-        band2R = static_cast<float>(band2OutR);
-        band3L = static_cast<float>(band3OutL);
-        band3R = static_cast<float>(band3OutR);
-        band4L = static_cast<float>(band4OutL);
-        band4R = static_cast<float>(band4OutR);
+    // bandL / bandR: 밴드마다 한 샘플씩 kNumBands개, 낮은 밴드부터
+    inline void processSample(float inL, float inR, float* bandL, float* bandR) {
+        if (doublePrecision) precise.process(inL, inR, bandL, bandR);
+        else fast.process(inL, inR, bandL, bandR);
     }
     
     void reset() {
-        lp1StateA.reset(); lp1StateB.reset();
-        hp1StateA.reset(); hp1StateB.reset();
-        lp2StateA.reset(); lp2StateB.reset();
-        hp2StateA.reset(); hp2StateB.reset();
-        lp3StateA.reset(); lp3StateB.reset();
-        hp3StateA.reset(); hp3StateB.reset();
+        precise.reset();
+        fast.reset();
+    }
+
+    // 모든 바이쿼드 메모리가 threshold 미만
+    bool isIdle(double threshold) const {
+        return doublePrecision ? precise.isIdle(threshold) : fast.isIdle(threshold);
+    }
+
+    // 디노멀 폴백 (블록당 1회): MXCSR을 리셋하는 호스트 대비
+    void flushDenormals() {
+        if (doublePrecision) precise.flushDenormals();
+        else fast.flushDenormals();
     }
 };
 
+// 플러그인의 4밴드 크로스오버: 직렬 캐스케이드, 지금까지와 비트 단위로 같은 출력
+using CrossoverDSP = Crossover<4, false>;
+
 //=======================================================================
 // 유틸리티 함수
 //=======================================================================
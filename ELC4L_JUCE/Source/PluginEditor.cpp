@@ -50,6 +50,7 @@ ELC4LAudioProcessorEditor::ELC4LAudioProcessorEditor(ELC4LAudioProcessor& p)
         audioProcessor.getAPVTS(), "xover3", xover3Slider);
     
     // HPF 패널
+    headerBar.attachToParameters(audioProcessor.getAPVTS());
     hpfPanel.attachToParameters(audioProcessor.getAPVTS());
     hpfPanel.setInterceptsMouseClicks(true, true);
     addAndMakeVisible(hpfPanel);
@@ -79,15 +80,25 @@ ELC4LAudioProcessorEditor::ELC4LAudioProcessorEditor(ELC4LAudioProcessor& p)
     // 글로벌 정보 패널
     addAndMakeVisible(infoPanel);
     
+    // 진단 오버레이 (Ctrl+Shift+D로 표시, 표시 중에만 프로파일링)
+    addChildComponent(diagnosticsOverlay);
+    setWantsKeyboardFocus(true);
+    
     // 윈도우 크기 설정
     setSize(ELC4L::Layout::WindowW, ELC4L::Layout::WindowH);
     
+    // 분석기 상태는 에디터가 열려 있는 동안만 할당
+    audioProcessor.subscribeAnalyzer();
+
     // 타이머 시작 (30fps 업데이트)
     startTimerHz(30);
 }
 
 ELC4LAudioProcessorEditor::~ELC4LAudioProcessorEditor()
 {
+    stopTimer();
+    audioProcessor.setProfilingEnabled(false);
+    audioProcessor.unsubscribeAnalyzer();
     setLookAndFeel(nullptr);
 }
 
@@ -133,6 +144,7 @@ void ELC4LAudioProcessorEditor::resized()
     // 스펙트럼 영역
     topArea.removeFromRight(8);
     spectrumAnalyzer.setBounds(topArea);
+    diagnosticsOverlay.setBounds(topArea.getX() + 40, topArea.getY() + 16, 440, 170);
     
     // 간격
     bounds.removeFromTop(8);
@@ -164,10 +176,27 @@ void ELC4LAudioProcessorEditor::resized()
                              juce::jmin(limiterWidth, ELC4L::Layout::LimiterW), bandHeight);
 }
 
+//==============================================================================
+bool ELC4LAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
+{
+    // Ctrl+Shift+D: 진단 오버레이 토글
+    const auto mods = juce::ModifierKeys::ctrlModifier | juce::ModifierKeys::shiftModifier;
+    if (key == juce::KeyPress('d', mods, 0) || key == juce::KeyPress('D', mods, 0)) {
+        const bool show = !diagnosticsOverlay.isVisible();
+        audioProcessor.setProfilingEnabled(show);
+        diagnosticsOverlay.setVisible(show);
+        if (show) diagnosticsOverlay.toFront(false);
+        return true;
+    }
+    return false;
+}
+
 //==============================================================================
 void ELC4LAudioProcessorEditor::timerCallback()
 {
     updateMeters();
+    headerBar.setQualityTier(audioProcessor.getQualityTier());
+    if (diagnosticsOverlay.isVisible()) diagnosticsOverlay.refresh(audioProcessor);
 }
 
 //==============================================================================
@@ -37,6 +37,33 @@ public:
         versionLabel.setFont(juce::Font(juce::FontOptions().withHeight(9.0f)));
         versionLabel.setColour(juce::Label::textColourId, ELC4L::Colours::textDim);
         addAndMakeVisible(versionLabel);
+
+        // CPU 과부하 품질 단계 (최고 품질이면 숨김)
+        qualityLabel.setFont(juce::Font(juce::FontOptions().withHeight(10.0f).withStyle("Bold")));
+        qualityLabel.setColour(juce::Label::textColourId, ELC4L::Colours::limiter);
+        qualityLabel.setJustificationType(juce::Justification::centredRight);
+        addChildComponent(qualityLabel);
+
+        // 처리 품질 선택 (Eco / Standard / High)
+        qualityBox.addItemList({ "Eco", "Standard", "High" }, 1);
+        qualityBox.setColour(juce::ComboBox::backgroundColourId, ELC4L::Colours::bgInput);
+        qualityBox.setColour(juce::ComboBox::textColourId, ELC4L::Colours::textValue);
+        qualityBox.setColour(juce::ComboBox::outlineColourId, ELC4L::Colours::border);
+        qualityBox.setTooltip("Processing quality: Eco saves CPU, High adds 8x saturation and a longer lookahead");
+        addAndMakeVisible(qualityBox);
+    }
+
+    void attachToParameters(juce::AudioProcessorValueTreeState& apvts) {
+        qualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            apvts, "quality", qualityBox);
+    }
+
+    void setQualityTier(int tier) {
+        if (tier == shownQualityTier) return;
+        shownQualityTier = tier;
+        qualityLabel.setText(juce::String("CPU SAVE: ") + ELC4L::getQualityTierName(tier),
+                             juce::dontSendNotification);
+        qualityLabel.setVisible(tier != ELC4L::kQualityFull);
     }
     
     void paint(juce::Graphics& g) override {
@@ -59,10 +86,16 @@ public:
         bounds.removeFromLeft(5);
         subtitleLabel.setBounds(bounds.removeFromLeft(140));
         versionLabel.setBounds(bounds.removeFromRight(50));
+        bounds.removeFromRight(8);
+        qualityBox.setBounds(bounds.removeFromRight(90));
+        qualityLabel.setBounds(bounds.removeFromRight(180));
     }
     
 private:
-    juce::Label titleLabel, subtitleLabel, versionLabel;
+    juce::Label titleLabel, subtitleLabel, versionLabel, qualityLabel;
+    juce::ComboBox qualityBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> qualityAttachment;
+    int shownQualityTier = ELC4L::kQualityFull;
 };
 
 //==============================================================================
@@ -207,6 +240,85 @@ private:
     float grValue = 0.0f;
 };
 
+//==============================================================================
+// 진단 오버레이 (숨김, Ctrl+Shift+D로 토글) - 스테이지별 블록당 CPU 시간
+//==============================================================================
+class DiagnosticsOverlay : public juce::Component
+{
+public:
+    DiagnosticsOverlay() {
+        setInterceptsMouseClicks(false, false);
+    }
+    
+    void paint(juce::Graphics& g) override {
+        auto bounds = getLocalBounds();
+        
+        // 배경
+        g.setColour(ELC4L::Colours::bgDark.withAlpha(0.92f));
+        g.fillRoundedRectangle(bounds.toFloat(), 3.0f);
+        g.setColour(ELC4L::Colours::accentCyan);
+        g.drawRoundedRectangle(bounds.toFloat().reduced(0.5f), 3.0f, 1.0f);
+        
+        bounds = bounds.reduced(10, 8);
+        g.setFont(juce::Font(juce::FontOptions().withHeight(11.0f)));
+        
+        if (!hasProfile) {
+            g.setColour(ELC4L::Colours::textDim);
+            g.drawText("DSP PROFILE - collecting...", bounds.removeFromTop(16), juce::Justification::centredLeft, false);
+            return;
+        }
+        
+        // 요약: 부하, 블록당 예산
+        g.setColour(ELC4L::Colours::accentCyan);
+        g.drawText("DSP PROFILE   load " + juce::String(profile.loadPercent, 1) + "%   budget "
+                       + juce::String(profile.blockBudgetUs, 0) + " us/block   "
+                       + juce::String((int)profile.numBlocks) + " blocks",
+                   bounds.removeFromTop(16), juce::Justification::centredLeft, false);
+        bounds.removeFromTop(4);
+        
+        const char* const titles[5] = { "stage (us)", "min", "avg", "p99", "max" };
+        drawRow(g, bounds.removeFromTop(16), titles, nullptr, ELC4L::Colours::textDim);
+        
+        for (int row = 0; row <= ELC4L::kNumProfileStages; ++row) {
+            const bool isTotal = (row == ELC4L::kNumProfileStages);
+            const ELC4L::StageStats& stats = isTotal ? profile.block : profile.stages[row];
+            const float values[4] = { stats.minUs, stats.avgUs, stats.p99Us, stats.maxUs };
+            const char* name[1] = { isTotal ? "Block total" : ELC4L::getProfileStageName(row) };
+            drawRow(g, bounds.removeFromTop(16), name, values,
+                    isTotal ? ELC4L::Colours::textValue : ELC4L::Colours::textDim);
+        }
+    }
+    
+    // 메시지 스레드 타이머에서 호출
+    void refresh(const ELC4LAudioProcessor& processor) {
+        if (processor.getStageProfile(profile)) hasProfile = true;
+        repaint();
+    }
+    
+private:
+    // 첫 칸은 이름, 나머지 4칸은 값 (values가 없으면 제목 행)
+    void drawRow(juce::Graphics& g, juce::Rectangle<int> row, const char* const* labels,
+                 const float* values, juce::Colour colour) {
+        const int nameW = 110;
+        const int valueW = (row.getWidth() - nameW) / 4;
+        g.setColour(colour);
+        g.drawText(labels[0], row.removeFromLeft(nameW), juce::Justification::centredLeft, false);
+        for (int c = 0; c < 4; ++c) {
+            auto cell = row.removeFromLeft(valueW);
+            if (values == nullptr) {
+                g.drawText(labels[c + 1], cell, juce::Justification::centredRight, false);
+                continue;
+            }
+            // 블록 예산을 넘는 값은 빨간색
+            g.setColour(values[c] > profile.blockBudgetUs ? ELC4L::Colours::clipRed : colour);
+            g.drawText(juce::String(values[c], 1), cell, juce::Justification::centredRight, false);
+        }
+    }
+    
+    ELC4L::StageProfileSnapshot profile {};
+    bool hasProfile = false;
+};
+
 //==============================================================================
 // 메인 에디터 클래스
 //==============================================================================
@@ -219,6 +331,7 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
+    bool keyPressed(const juce::KeyPress& key) override;
     
     // 마우스 이벤트가 올바른 컴포넌트로 전달되도록 보장
     bool hitTest(int x, int y) override { return true; }
@@ -259,6 +372,9 @@ private:
     
     // 글로벌 정보 패널
     GlobalInfoPanel infoPanel;
+    
+    // 진단 오버레이 (숨김)
+    DiagnosticsOverlay diagnosticsOverlay;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ELC4LAudioProcessorEditor)
 };
@@ -5,6 +5,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "RealtimeGuard.h"
 
 //==============================================================================
 ELC4LAudioProcessor::ELC4LAudioProcessor()
@@ -30,17 +31,31 @@ ELC4LAudioProcessor::ELC4LAudioProcessor()
     apvts.addParameterListener("limiterRelease", this);
     apvts.addParameterListener("sidechainFreq", this);
     apvts.addParameterListener("sidechainActive", this);
+    apvts.addParameterListener("quality", this);
 
-    // 원자적 변수 초기화
-    for (int i = 0; i < 4; ++i) {
-        bandGrDb[i].store(0.0f);
+    // 파라미터 포인터 캐시
+    for (int i = 0; i < kNumBands; ++i) {
+        bandThreshParams[i] = apvts.getRawParameterValue("band" + juce::String(i + 1) + "Thresh");
+        bandMakeupParams[i] = apvts.getRawParameterValue("band" + juce::String(i + 1) + "Makeup");
+        bandMakeupGains[i] = 1.0f;
+    }
+    for (int i = 0; i < kNumBands - 1; ++i) {
+        xoverParams[i] = apvts.getRawParameterValue("xover" + juce::String(i + 1));
     }
+    limiterThreshParam = apvts.getRawParameterValue("limiterThresh");
+    limiterCeilingParam = apvts.getRawParameterValue("limiterCeiling");
+    limiterReleaseParam = apvts.getRawParameterValue("limiterRelease");
+    sidechainFreqParam = apvts.getRawParameterValue("sidechainFreq");
+    sidechainActiveParam = apvts.getRawParameterValue("sidechainActive");
+    qualityParam = apvts.getRawParameterValue("quality");
 
-    // 스펙트럼 초기화
-    for (int i = 0; i < ELC4L::kDisplayBins; ++i) {
-        spectrumIn[i] = -90.0f;
-        spectrumOut[i] = -90.0f;
+    // 원자적 변수 초기화
+    for (int i = 0; i < kNumBands; ++i) {
+        meters.bandGrDb[i].store(0.0f);
     }
+
+    // 텔레메트리 (환경 변수 ELC4L_TELEMETRY가 있을 때만 슬롯 확보)
+    telemetry.open(ELC4L::kTelemetryWrapperJuce);
 }
 
 ELC4LAudioProcessor::~ELC4LAudioProcessor()
@@ -61,6 +76,9 @@ ELC4LAudioProcessor::~ELC4LAudioProcessor()
     apvts.removeParameterListener("limiterRelease", this);
     apvts.removeParameterListener("sidechainFreq", this);
     apvts.removeParameterListener("sidechainActive", this);
+    apvts.removeParameterListener("quality", this);
+
+    ELC4L_RT_REPORT();
 }
 
 //==============================================================================
@@ -143,6 +161,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout ELC4LAudioProcessor::createP
         "Sidechain Active",
         false));
 
+    // 처리 품질 (상태에 저장됨; High는 리미터 룩어헤드가 길어져 레이턴시가 바뀜)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("quality", 1),
+        "Quality",
+        juce::StringArray { "Eco", "Standard", "High" },
+        ELC4L::kProcessingStandard));
+
     return { params.begin(), params.end() };
 }
 
@@ -159,6 +184,54 @@ void ELC4LAudioProcessor::parameterChanged(const juce::String& parameterID, floa
     else if (parameterID.contains("limiter")) {
         updateLimiter();
     }
+    else if (parameterID == "quality") {
+        updateLatency();
+    }
+}
+
+//==============================================================================
+// 분석기: 에디터가 열려 있는 동안만 할당 (헤드리스 인스턴스는 ~66KB와 FFT를 생략)
+void ELC4LAudioProcessor::subscribeAnalyzer()
+{
+    analyzerLink.subscribe([this](ELC4LAnalyzerState& state) {
+        // 새 상태: 오디오 스레드가 보기 전에 고정 (ELC4L_LOCK_MEMORY)
+        if (memoryLockMode == ELC4L::kMemoryLockOff)
+            return;
+        const ELC4L::MemoryRegion region = { &state, sizeof(state) };
+        analyzerMemoryLock.lock(memoryLockMode, &region, 1);
+        ELC4L::MemoryLock::printReport("ELC4L JUCE analyzer", memoryLockMode,
+                                       analyzerMemoryLock.getReport());
+    });
+}
+
+void ELC4LAudioProcessor::unsubscribeAnalyzer()
+{
+    analyzerLink.unsubscribe();
+    if (!analyzerLink.isAllocated())
+        analyzerMemoryLock.unlock();
+}
+
+// 분석기 상태가 없을 때 보여 줄 바닥
+static const float* getSilentSpectrum()
+{
+    static const std::array<float, ELC4L::kDisplayBins> silent = [] {
+        std::array<float, ELC4L::kDisplayBins> bins;
+        bins.fill(-90.0f);
+        return bins;
+    }();
+    return silent.data();
+}
+
+const float* ELC4LAudioProcessor::getSpectrumIn() const
+{
+    const ELC4LAnalyzerState* state = analyzerLink.get();
+    return state != nullptr ? state->spectrumIn : getSilentSpectrum();
+}
+
+const float* ELC4LAudioProcessor::getSpectrumOut() const
+{
+    const ELC4LAnalyzerState* state = analyzerLink.get();
+    return state != nullptr ? state->spectrumOut : getSilentSpectrum();
 }
 
 //==============================================================================
@@ -167,28 +240,57 @@ void ELC4LAudioProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock
     float sr = static_cast<float>(sampleRate);
     
     crossover.setSampleRate(sr);
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].setSampleRate(sr);
-    }
+    bandComps.setSampleRate(sr);
     limiter.setSampleRate(sr);
     lufsMeter.setSampleRate(sr);
+    spectrumBinMap = ELC4L::SharedTable<ELC4L::SpectrumBinMap>::acquire(
+        ELC4L::SpectrumBinMap::Key(sr, ELC4L::kFftSize, ELC4L::kDisplayBins));
+    profiler.prepare(sampleRate);
+    governor.prepare(sampleRate);
+    hostBypass.prepare(sampleRate);
+    hostBypass.setLatency(limiter.getLookaheadSamples() + bandComps.getSaturationLatency());
 
     updateCompressors();
     updateFrequencies();
     updateLimiter();
 
     // 레이턴시 설정
-    setLatencySamples(ELC4L::LookaheadLimiter::kLookaheadSamples);
+    updateLatency();
+
+    lockDspMemory();
+}
+
+// 아레나 (스테이지, 미터)와 인스턴스 자체 (호스트 바이패스 딜레이 라인, 프로파일러, 플래그)
+void ELC4LAudioProcessor::lockDspMemory()
+{
+    if (memoryLockMode == ELC4L::kMemoryLockOff)
+        return;
+    const ELC4L::MemoryRegion regions[] = {
+        { dspArena.data(), dspArena.size() },
+        { this, sizeof(*this) }
+    };
+    memoryLock.lock(memoryLockMode, regions, 2);
+    ELC4L::MemoryLock::printReport("ELC4L JUCE", memoryLockMode, memoryLock.getReport());
+}
+
+void ELC4LAudioProcessor::updateLatency()
+{
+    const auto settings = ELC4L::getQualitySettings(getProcessingQuality(), ELC4L::kQualityFull);
+    setLatencySamples(ELC4L::LookaheadLimiter::getLookaheadSamples(settings.extendedLookahead)
+                      + ELC4L::OptoCompressor::getSaturationLatency(settings.saturationFactor,
+                                                                    static_cast<float>(getSampleRate())));
 }
 
 void ELC4LAudioProcessor::releaseResources()
 {
+    ELC4L_RT_REPORT();
+    memoryLock.unlock();
+
     crossover.reset();
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].reset();
-    }
+    bandComps.reset();
     limiter.reset();
     lufsMeter.reset();
+    dspSleeping = false;
 }
 
 bool ELC4LAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
@@ -204,7 +306,23 @@ bool ELC4LAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
 //==============================================================================
 void ELC4LAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
+    hostBypass.setBypassed(false);
+    renderBlock(buffer);
+}
+
+// 호스트 바이패스: 기본 구현은 레이턴시를 무시하므로, 룩어헤드만큼 지연된 드라이 경로로
+// 크로스페이드한 뒤 DSP를 생략 (ELC4L::HostBypass)
+void ELC4LAudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    hostBypass.setBypassed(true);
+    renderBlock(buffer);
+}
+
+void ELC4LAudioProcessor::renderBlock(juce::AudioBuffer<float>& buffer)
+{
+    ELC4L_RT_SCOPE("ELC4LAudioProcessor::processBlock");
     juce::ScopedNoDenormals noDenormals;
+    const ELC4L::LazyEditorState<ELC4LAnalyzerState>::AudioAccess analyzerAccess(analyzerLink, analyzer);
 
     auto* inL = buffer.getReadPointer(0);
     auto* inR = buffer.getReadPointer(1);
@@ -212,106 +330,105 @@ void ELC4LAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     auto* outR = buffer.getWritePointer(1);
     
     int numSamples = buffer.getNumSamples();
-
-    // 솔로 체크
-    bool anySolo = bandSolo[0] || bandSolo[1] || bandSolo[2] || bandSolo[3];
-
-    // 메이크업 게인 미리 계산
-    float makeupGains[4];
-    for (int b = 0; b < 4; ++b) {
-        float makeupDb = *apvts.getRawParameterValue("band" + juce::String(b + 1) + "Makeup");
-        makeupGains[b] = ELC4L::dbToLinear(makeupDb);
+    profiler.beginBlock();
+    const int64_t telemetryStart = telemetry.beginBlock();
+    const int64_t governorStart = governor.beginBlock();
+    const float sampleRate = static_cast<float>(getSampleRate());
+
+    // 바이패스 크로스페이드가 끝나면 드라이 경로의 딜레이 라인만 실행
+    if (!hostBypass.beginBlock()) {
+        if (hostBypass.takeFlushRequest()) enterSilenceSleep();
+        hostBypass.processDry(inL, inR, outL, outR, numSamples);
+        profiler.endBlock(numSamples);
+        applyQuality(processingQuality, governor.endBlock(governorStart, numSamples));
+        const float noGr[kNumBands] = {};
+        telemetry.endBlock(telemetryStart, outL, outR, numSamples, sampleRate, noGr, 0.0f,
+                           lufsMeter.getMomentary());
+        return;
     }
 
-    for (int i = 0; i < numSamples; ++i) {
-        float b1L, b1R, b2L, b2R, b3L, b3R, b4L, b4R;
-
-        // 1. 4밴드로 분리
-        crossover.processSample(inL[i], inR[i], b1L, b1R, b2L, b2R, b3L, b3R, b4L, b4R);
-
-        // 델타용 원본 저장
-        float bandInputL[4] = { b1L, b2L, b3L, b4L };
-        float bandInputR[4] = { b1R, b2R, b3R, b4R };
-
-        // 2. 밴드별 컴프레서 처리
-        float* bands[4][2] = { {&b1L, &b1R}, {&b2L, &b2R}, {&b3L, &b3R}, {&b4L, &b4R} };
-        
-        for (int b = 0; b < 4; ++b) {
-            if (!bandBypass[b]) {
-                bandComps[b].process(*bands[b][0], *bands[b][1]);
-            } else {
-                *bands[b][0] *= makeupGains[b];
-                *bands[b][1] *= makeupGains[b];
+    // 무음 슬립: 입력이 무음이고 테일이 모두 소진된 상태면 DSP 전체 생략
+    const bool inputSilent = ELC4L::isBlockSilent(inL, inR, numSamples, ELC4L::kSilenceInputThreshold);
+    if (inputSilent && dspSleeping) {
+        buffer.clear();  // hasBeenCleared() = 호스트에 무음 출력 알림
+        lufsMeter.processSilence(numSamples);
+        meters.lufsMomentary.store(lufsMeter.getMomentary());
+        hostBypass.advanceSilent(numSamples);
+        profiler.endBlock(numSamples);
+        applyQuality(processingQuality, governor.endBlock(governorStart, numSamples));
+        const float noGr[kNumBands] = {};
+        telemetry.endBlock(telemetryStart, outL, outR, numSamples, sampleRate, noGr, 0.0f,
+                           lufsMeter.getMomentary());
+        return;
+    }
+    dspSleeping = false;
+    applyQuality(getProcessingQuality(), qualityTier);
+
+    // 모니터링 스위치는 블록마다 한 번만 판단: 밴드별로 바이패스/델타 조합에 특화된 커널을 고르고
+    // (들리지 않는 밴드는 디텍터만 유지), 믹스는 들리는 밴드만 더하며, 출력 커널은 리미터 바이패스와
+    // 분석기 동작 여부로 특화
+    bool anySolo = false;
+    for (int b = 0; b < kNumBands; ++b)
+        anySolo |= bandSolo[b];
+    BandKernel kernels[kNumBands];
+    int playedBands[kNumBands];
+    int numPlayed = 0;
+    for (int b = 0; b < kNumBands; ++b) {
+        bandMakeupGains[b] = ELC4L::dbToLinear(bandMakeupParams[b]->load());
+        int flags = 0;
+        if (bandBypass[b]) flags |= kBandKernelBypass;
+        if (bandDelta[b]) flags |= kBandKernelDelta;
+        if (anySolo ? bandSolo[b] : !bandMute[b]) playedBands[numPlayed++] = b;
+        else flags = kBandKernelMuted | (flags & kBandKernelBypass);
+        kernels[b] = bandKernels[flags];
+    }
+    const int outputFlags = (limiterBypass ? 1 : 0) | (analyzerHopSize > 0 && analyzer != nullptr ? 2 : 0);
+    const OutputKernel outputKernel = outputKernels[outputFlags];
+
+    float bandL[kNumBands][kChunkSize], bandR[kNumBands][kChunkSize];
+    float mixL[kChunkSize], mixR[kChunkSize];
+    for (int start = 0; start < numSamples; start += kChunkSize) {
+        const int n = juce::jmin(kChunkSize, numSamples - start);
+        profiler.beginChunk(n);
+        hostBypass.pushInput(inL + start, inR + start, n);
+
+        // 1. 밴드로 분리
+        for (int i = 0; i < n; ++i) {
+            float sampleL[kNumBands], sampleR[kNumBands];
+            crossover.processSample(inL[start + i], inR[start + i], sampleL, sampleR);
+            for (int b = 0; b < kNumBands; ++b) {
+                bandL[b][i] = sampleL[b];
+                bandR[b][i] = sampleR[b];
             }
         }
-        
-        float bandOutL[4] = { b1L, b2L, b3L, b4L };
-        float bandOutR[4] = { b1R, b2R, b3R, b4R };
+        profiler.lap(ELC4L::kStageCrossover);
 
-        // 3. 델타/뮤트/솔로 로직
-        float mixL = 0.0f;
-        float mixR = 0.0f;
-        
-        for (int b = 0; b < 4; ++b) {
-            float outBandL, outBandR;
-            
-            if (bandDelta[b]) {
-                // 델타: 컴프레서가 줄인 양만 재생
-                float reductionAmount = 0.0f;
-                if (!bandBypass[b]) {
-                    reductionAmount = 1.0f - bandComps[b].getCurrentGain();
-                }
-                outBandL = bandInputL[b] * reductionAmount;
-                outBandR = bandInputR[b] * reductionAmount;
-            } else {
-                outBandL = bandOutL[b];
-                outBandR = bandOutR[b];
-            }
-            
-            // 솔로/뮤트
-            bool playBand = false;
-            if (anySolo) {
-                playBand = bandSolo[b];
-            } else {
-                playBand = !bandMute[b];
-            }
-            
-            if (playBand) {
-                mixL += outBandL;
-                mixR += outBandR;
-            }
-        }
+        // 2. 밴드별 컴프레서 (뮤트된 밴드는 게인이 어긋나지 않도록 디텍터만)
+        for (int b = 0; b < kNumBands; ++b)
+            (this->*kernels[b])(b, bandL[b], bandR[b], n);
 
-        // 4. 리미터 적용
-        if (!limiterBypass) {
-            limiter.process(mixL, mixR);
+        // 3. 뮤트/솔로: 들리는 밴드만 합산
+        for (int i = 0; i < n; ++i) {
+            mixL[i] = 0.0f;
+            mixR[i] = 0.0f;
         }
-        lufsMeter.process(mixL, mixR);
-
-        outL[i] = mixL;
-        outR[i] = mixR;
-
-        // 스펙트럼 분석기 버퍼 채우기
-        float inMono = 0.5f * (inL[i] + inR[i]);
-        float outMono = 0.5f * (mixL + mixR);
-        fftBufferIn[fftWritePos] = inMono;
-        fftBufferOut[fftWritePos] = outMono;
-        fftWritePos++;
-
-        if (fftWritePos >= ELC4L::kFftSize) {
-            computeSpectrum(fftBufferIn, spectrumIn);
-            computeSpectrum(fftBufferOut, spectrumOut);
-            
-            // 버퍼 시프트 (75% 오버랩)
-            for (int j = 0; j < ELC4L::kFftSize - ELC4L::kFftHopSize; ++j) {
-                fftBufferIn[j] = fftBufferIn[j + ELC4L::kFftHopSize];
-                fftBufferOut[j] = fftBufferOut[j + ELC4L::kFftHopSize];
+        for (int p = 0; p < numPlayed; ++p) {
+            const float* l = bandL[playedBands[p]];
+            const float* r = bandR[playedBands[p]];
+            for (int i = 0; i < n; ++i) {
+                mixL[i] += l[i];
+                mixR[i] += r[i];
             }
-            fftWritePos = ELC4L::kFftSize - ELC4L::kFftHopSize;
         }
+        profiler.lap(ELC4L::kStageCompressors);
+
+        // 4. 리미터, LUFS, 출력, 분석기
+        (this->*outputKernel)(inL + start, inR + start, mixL, mixR, outL + start, outR + start, n);
+        hostBypass.mixOutput(outL + start, outR + start, n);
     }
 
     // 미터 업데이트
+    const int64_t meterStart = profiler.beginExact();
     float inRms = 0.0f, outRms = 0.0f;
     for (int i = 0; i < numSamples; ++i) {
         inRms += inL[i] * inL[i] + inR[i] * inR[i];
@@ -320,83 +437,243 @@ void ELC4LAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     inRms = std::sqrt(inRms / (2.0f * numSamples));
     outRms = std::sqrt(outRms / (2.0f * numSamples));
 
-    inputDb.store(20.0f * std::log10(inRms + 1.0e-12f));
-    outputDb.store(20.0f * std::log10(outRms + 1.0e-12f));
+    meters.inputDb.store(20.0f * std::log10(inRms + 1.0e-12f));
+    meters.outputDb.store(20.0f * std::log10(outRms + 1.0e-12f));
 
-    for (int b = 0; b < 4; ++b) {
-        bandGrDb[b].store(bandComps[b].getGainReductionDb());
+    float grDb[kNumBands];
+    for (int b = 0; b < kNumBands; ++b) {
+        grDb[b] = bandComps[b].getGainReductionDb();
+        meters.bandGrDb[b].store(grDb[b]);
     }
-    limiterGrDb.store(limiter.getGainReductionDb());
-    lufsMomentary.store(lufsMeter.getMomentary());
+    meters.limiterGrDb.store(limiter.getGainReductionDb());
+    meters.lufsMomentary.store(lufsMeter.getMomentary());
+    profiler.endExact(ELC4L::kStageMetering, meterStart);
+
+    // ScopedNoDenormals 폴백: MXCSR을 리셋하는 호스트에서도 상태가 디노멀에 머물지 않도록
+    crossover.flushDenormals();
+    bandComps.flushDenormals();
+    limiter.flushDenormals();
+    lufsMeter.flushDenormals();
+
+    // 무음 입력이라도 크로스오버/컴프레서/리미터 테일이 소진될 때까지는 계속 처리
+    if (inputSilent && isDspIdle()) {
+        enterSilenceSleep();
+    }
+    profiler.endBlock(numSamples);
+    applyQuality(processingQuality, governor.endBlock(governorStart, numSamples));
+    telemetry.endBlock(telemetryStart, outL, outR, numSamples, sampleRate, grDb, limiter.getGainReductionDb(),
+                       lufsMeter.getMomentary());
 }
 
 //==============================================================================
-void ELC4LAudioProcessor::computeSpectrum(const float* input, float* output)
+// 처리 품질 + 과부하 단계: 새츄레이션 경로는 크로스페이드, 나머지는 블록 경계에서 전환
+// (룩어헤드가 바뀌면 리미터 딜레이 라인이 비워짐)
+void ELC4LAudioProcessor::applyQuality(int quality, int tier)
 {
-    // FFT 버퍼 준비
-    std::array<float, ELC4L::kFftSize * 2> fftData;
-    
-    // 윈도우 적용
-    for (int i = 0; i < ELC4L::kFftSize; ++i) {
-        fftData[i] = input[i];
+    if (quality == processingQuality && tier == qualityTier) return;
+    processingQuality = quality;
+    qualityTier = tier;
+
+    const auto settings = ELC4L::getQualitySettings(quality, tier);
+    const int latencyFactor = ELC4L::getQualitySettings(quality, ELC4L::kQualityFull).saturationFactor;
+    crossover.setDoublePrecision(settings.doublePrecisionCrossover);
+    for (int b = 0; b < kNumBands; ++b) {
+        // 8x 정렬이 바뀌면 출력이 룩어헤드 변경처럼 움직이므로 경로도 그때 함께 (페이드 없이) 전환
+        const bool realigned = bandComps[b].setLatencyFactor(latencyFactor);
+        bandComps[b].fadeSaturationFactor(settings.saturationFactor, realigned ? 0 : governor.getCrossfadeSamples());
+        bandComps[b].setGainComputerInterval(settings.gainComputerInterval);
     }
-    window.multiplyWithWindowingTable(fftData.data(), ELC4L::kFftSize);
-    
-    // 나머지 0으로 채우기
-    for (int i = ELC4L::kFftSize; i < ELC4L::kFftSize * 2; ++i) {
-        fftData[i] = 0.0f;
+    limiter.setExtendedLookahead(settings.extendedLookahead);
+    hostBypass.setLatency(limiter.getLookaheadSamples() + bandComps.getSaturationLatency());
+    analyzerHopSize = ELC4L::kFftHopSize * settings.analyzerHopScale;
+    telemetry.setQualityTier(tier);
+}
+
+//==============================================================================
+bool ELC4LAudioProcessor::isDspIdle() const
+{
+    if (!crossover.isIdle(ELC4L::kSilenceStateThreshold)) return false;
+    if (!bandComps.isIdle(ELC4L::kSilenceStateThreshold)) return false;
+    return limiterBypass || limiter.isIdle(ELC4L::kSilenceStateThreshold);
+}
+
+void ELC4LAudioProcessor::enterSilenceSleep()
+{
+    // 잔여 상태는 -120dB 미만: 깨끗한 상태에서 다음 신호를 시작하도록 초기화
+    crossover.reset();
+    bandComps.reset();
+    for (int b = 0; b < kNumBands; ++b) {
+        meters.bandGrDb[b].store(0.0f);
+    }
+    limiter.reset();
+    meters.limiterGrDb.store(0.0f);
+
+    meters.inputDb.store(-120.0f);
+    meters.outputDb.store(-120.0f);
+
+    // 분석기는 마지막 프레임에 멈추지 않고 바닥으로 떨어뜨림
+    if (analyzer != nullptr)
+        analyzer->reset();
+
+    dspSleeping = true;
+}
+
+//==============================================================================
+// 특화 청크 커널 (processBlock에서 블록마다 선택)
+const ELC4LAudioProcessor::BandKernel ELC4LAudioProcessor::bandKernels[kNumBandKernels] = {
+    &ELC4LAudioProcessor::processBandChunk<0>, &ELC4LAudioProcessor::processBandChunk<1>,
+    &ELC4LAudioProcessor::processBandChunk<2>, &ELC4LAudioProcessor::processBandChunk<3>,
+    &ELC4LAudioProcessor::processBandChunk<4>, &ELC4LAudioProcessor::processBandChunk<5>,
+    &ELC4LAudioProcessor::processBandChunk<6>, &ELC4LAudioProcessor::processBandChunk<7>
+};
+
+const ELC4LAudioProcessor::OutputKernel ELC4LAudioProcessor::outputKernels[4] = {
+    &ELC4LAudioProcessor::processOutputChunk<false, false>, &ELC4LAudioProcessor::processOutputChunk<true, false>,
+    &ELC4LAudioProcessor::processOutputChunk<false, true>, &ELC4LAudioProcessor::processOutputChunk<true, true>
+};
+
+// 한 밴드의 청크 (제자리 처리): 컴프레서 + 새츄레이션(별도 스테이지로 측정), 바이패스면 메이크업만.
+// 델타는 컴프레서가 줄인 양으로 출력을 대체. 들리지 않는 밴드는 디텍터만 갱신 (버퍼는 버려짐)
+template <int Flags>
+void ELC4LAudioProcessor::processBandChunk(int band, float* left, float* right, int numSamples)
+{
+    constexpr bool bypass = (Flags & kBandKernelBypass) != 0;
+    constexpr bool delta = (Flags & kBandKernelDelta) != 0;
+    constexpr bool muted = (Flags & kBandKernelMuted) != 0;
+
+    if constexpr (muted) {
+        // 바이패스된 컴프레서는 유지할 상태가 없음
+        if constexpr (!bypass)
+            bandComps[band].processDetectorChunk(left, right, numSamples);
+        profiler.lap(ELC4L::kStageCompressors);
+    } else if constexpr (bypass) {
+        // 바이패스된 밴드는 줄인 양이 없으므로 델타는 무음
+        const float makeup = delta ? 0.0f : bandMakeupGains[band];
+        for (int i = 0; i < numSamples; ++i) {
+            left[i] *= makeup;
+            right[i] *= makeup;
+        }
+        profiler.lap(ELC4L::kStageCompressors);
+    } else {
+        auto& comp = bandComps[band];
+        float inputL[kChunkSize], inputR[kChunkSize];   // 델타용 원본
+        float gains[kChunkSize];
+        if constexpr (delta) {
+            for (int i = 0; i < numSamples; ++i) {
+                inputL[i] = left[i];
+                inputR[i] = right[i];
+            }
+        }
+
+        comp.processDynamicsChunk(left, right, gains, numSamples);
+        profiler.lap(ELC4L::kStageCompressors);
+        comp.processSaturationChunk(left, right, numSamples);
+        profiler.lap(ELC4L::kStageSaturation);
+
+        if constexpr (delta) {
+            for (int i = 0; i < numSamples; ++i) {
+                const float reductionAmount = 1.0f - gains[i];
+                left[i] = inputL[i] * reductionAmount;
+                right[i] = inputR[i] * reductionAmount;
+            }
+        }
+    }
+}
+
+// 리미터(바이패스면 생략), LUFS, 출력과 분석기 버퍼 채우기
+// (에디터가 닫혀 있거나 과부하 단계에서는 분석기 정지, 화면은 마지막 프레임 유지. Eco는 홉 2배 = 50% 오버랩)
+template <bool LimiterBypass, bool Analyzer>
+void ELC4LAudioProcessor::processOutputChunk(const float* inL, const float* inR, float* mixL, float* mixR,
+                                             float* outL, float* outR, int numSamples)
+{
+    if constexpr (!LimiterBypass)
+        limiter.processChunk(mixL, mixR, numSamples);
+    profiler.lap(ELC4L::kStageLimiter);
+
+    for (int i = 0; i < numSamples; ++i) {
+        lufsMeter.process(mixL[i], mixR[i]);
+        outL[i] = mixL[i];
+        outR[i] = mixR[i];
+
+        if constexpr (Analyzer) {
+            ELC4LAnalyzerState& state = *analyzer;
+            float inMono = 0.5f * (inL[i] + inR[i]);
+            float outMono = 0.5f * (mixL[i] + mixR[i]);
+            state.fftBufferIn[state.fftWritePos] = inMono;
+            state.fftBufferOut[state.fftWritePos] = outMono;
+            state.fftWritePos++;
+
+            if (state.fftWritePos >= ELC4L::kFftSize) {
+                const int64_t analyzerStart = profiler.beginExact();
+                computeSpectrum(state, state.fftBufferIn, state.spectrumIn);
+                computeSpectrum(state, state.fftBufferOut, state.spectrumOut);
+
+                // 버퍼 시프트 (75% 오버랩)
+                for (int j = 0; j < ELC4L::kFftSize - analyzerHopSize; ++j) {
+                    state.fftBufferIn[j] = state.fftBufferIn[j + analyzerHopSize];
+                    state.fftBufferOut[j] = state.fftBufferOut[j + analyzerHopSize];
+                }
+                state.fftWritePos = ELC4L::kFftSize - analyzerHopSize;
+                profiler.endExact(ELC4L::kStageAnalyzer, analyzerStart);
+            }
+        }
+    }
+    profiler.lap(ELC4L::kStageMetering);
+}
+
+//==============================================================================
+void ELC4LAudioProcessor::computeSpectrum(ELC4LAnalyzerState& state, const float* input, float* output)
+{
+    // FFT 버퍼 준비 + 윈도우 적용 (단위 평균 이득으로 정규화한 Blackman-Harris)
+    float* fftRe = state.fftRe;
+    float* fftIm = state.fftIm;
+    const float* window = fftTables->window.data();
+    const float windowGain = fftTables->windowNormalization;
+    for (int i = 0; i < ELC4L::kFftSize; ++i) {
+        fftRe[i] = input[i] * (window[i] * windowGain);
+        fftIm[i] = 0.0f;
     }
 
     // FFT 수행
-    fft.performFrequencyOnlyForwardTransform(fftData.data());
+    ELC4L::performFft(*fftTables, fftRe, fftIm);
 
-    // 로그 스케일 빈 매핑 + 핑크 노이즈 틸트 보정
+    // 로그 스케일 빈 매핑 + 핑크 노이즈 틸트 보정 (준비되지 않은 샘플레이트면 스택에 맵 생성)
     float sr = static_cast<float>(getSampleRate());
     if (sr <= 0.0f) sr = 44100.0f;
-    
-    const float minLogFreq = std::log10(20.0f);
-    const float maxLogFreq = std::log10(20000.0f);
-    const float logRange = maxLogFreq - minLogFreq;
 
+    const ELC4L::SpectrumBinMap* map = spectrumBinMap.get();
+    if (map == nullptr || !map->matches(sr, ELC4L::kFftSize, ELC4L::kDisplayBins)) {
+        const ELC4L::SpectrumBinMap local(ELC4L::SpectrumBinMap::Key(sr, ELC4L::kFftSize, ELC4L::kDisplayBins));
+        mapSpectrumBins(local, fftRe, fftIm, output);
+    } else {
+        mapSpectrumBins(*map, fftRe, fftIm, output);
+    }
+}
+
+void ELC4LAudioProcessor::mapSpectrumBins(const ELC4L::SpectrumBinMap& map, const float* re, const float* im,
+                                          float* output)
+{
     for (int bin = 0; bin < ELC4L::kDisplayBins; ++bin) {
-        float t = static_cast<float>(bin) / static_cast<float>(ELC4L::kDisplayBins - 1);
-        float logFreq = minLogFreq + t * logRange;
-        float freq = std::pow(10.0f, logFreq);
-        
-        int fftBin = static_cast<int>(freq * ELC4L::kFftSize / sr);
-        fftBin = juce::jlimit(1, ELC4L::kFftSize / 2 - 1, fftBin);
+        const ELC4L::SpectrumBinMap::Bin& b = map.bins[bin];
 
-        // 주변 빈 평균
+        // 주변 빈 크기 평균
         float sumMag = 0.0f;
-        int avgCount = 0;
-        int spread = (fftBin < 30) ? 1 : (fftBin < 100 ? 2 : (fftBin < 400 ? 3 : 4));
-        
-        for (int k = -spread; k <= spread; ++k) {
-            int idx = fftBin + k;
-            if (idx >= 1 && idx < ELC4L::kFftSize / 2) {
-                sumMag += fftData[idx];
-                avgCount++;
-            }
-        }
+        for (int idx = b.first; idx < b.first + b.count; ++idx)
+            sumMag += std::sqrt(re[idx] * re[idx] + im[idx] * im[idx]);
 
-        float mag = (avgCount > 0) ? (sumMag / avgCount) : fftData[fftBin];
+        float mag = sumMag / b.count;
         float db = 20.0f * std::log10(mag + 1.0e-9f);
 
         // 핑크 노이즈 틸트 보정 (+3dB/Octave)
-        if (freq > 20.0f) {
-            db += 3.0f * std::log2(freq / 1000.0f);
-        }
+        db += b.tiltDb;
 
         db = juce::jlimit(-90.0f, 6.0f, db);
 
         // 비대칭 스무딩
-        float attackCoeff = (freq > 4000.0f) ? 0.50f : 0.35f;
-        float releaseCoeff = (freq > 4000.0f) ? 0.88f : 0.92f;
-        
         if (db > output[bin]) {
-            output[bin] = (1.0f - attackCoeff) * output[bin] + attackCoeff * db;
+            output[bin] = (1.0f - b.attackCoeff) * output[bin] + b.attackCoeff * db;
         } else {
-            output[bin] = releaseCoeff * output[bin] + (1.0f - releaseCoeff) * db;
+            output[bin] = b.releaseCoeff * output[bin] + (1.0f - b.releaseCoeff) * db;
         }
     }
 }
@@ -404,18 +681,18 @@ void ELC4LAudioProcessor::computeSpectrum(const float* input, float* output)
 //==============================================================================
 void ELC4LAudioProcessor::updateCompressors()
 {
-    for (int i = 0; i < 4; ++i) {
-        float threshDb = *apvts.getRawParameterValue("band" + juce::String(i + 1) + "Thresh");
-        float makeupDb = *apvts.getRawParameterValue("band" + juce::String(i + 1) + "Makeup");
+    for (int i = 0; i < kNumBands; ++i) {
+        float threshDb = bandThreshParams[i]->load();
+        float makeupDb = bandMakeupParams[i]->load();
         bandComps[i].setThresholdDb(threshDb);
         bandComps[i].setMakeupDb(makeupDb);
         bandComps[i].updateCoefficients();
     }
 
-    bool scActive = *apvts.getRawParameterValue("sidechainActive") > 0.5f;
-    float scFreq = *apvts.getRawParameterValue("sidechainFreq");
+    bool scActive = sidechainActiveParam->load() > 0.5f;
+    float scFreq = sidechainFreqParam->load();
     
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < kNumBands; ++i) {
         bandComps[i].setSidechainEnabled(scActive);
         bandComps[i].setSidechainFreq(scFreq);
     }
@@ -423,27 +700,28 @@ void ELC4LAudioProcessor::updateCompressors()
 
 void ELC4LAudioProcessor::updateFrequencies()
 {
-    float x1 = *apvts.getRawParameterValue("xover1");
-    float x2 = *apvts.getRawParameterValue("xover2");
-    float x3 = *apvts.getRawParameterValue("xover3");
-
-    // 크로스오버 유효성 검사
-    if (x1 >= x2) x1 = x2 * 0.85f;
-    if (x2 >= x3) x2 = x3 * 0.85f;
+    constexpr int numSplits = kNumBands - 1;
+    float freqs[numSplits];
+    for (int k = 0; k < numSplits; ++k)
+        freqs[k] = xoverParams[k]->load();
+
+    // 크로스오버 유효성 검사: 각 분할 지점은 다음 지점보다 아래
+    for (int k = 0; k + 1 < numSplits; ++k) {
+        if (freqs[k] >= freqs[k + 1]) freqs[k] = freqs[k + 1] * 0.85f;
+    }
 
-    x1 = juce::jlimit(ELC4L::kMinFreq, ELC4L::kMaxFreq, x1);
-    x3 = juce::jlimit(ELC4L::kMinFreq, ELC4L::kMaxFreq, x3);
+    freqs[0] = juce::jlimit(ELC4L::kMinFreq, ELC4L::kMaxFreq, freqs[0]);
+    freqs[numSplits - 1] = juce::jlimit(ELC4L::kMinFreq, ELC4L::kMaxFreq, freqs[numSplits - 1]);
 
-    crossover.setXover1(x1);
-    crossover.setXover2(x2);
-    crossover.setXover3(x3);
+    for (int k = 0; k < numSplits; ++k)
+        crossover.setFrequency(k, freqs[k]);
 }
 
 void ELC4LAudioProcessor::updateLimiter()
 {
-    float threshDb = *apvts.getRawParameterValue("limiterThresh");
-    float ceilingDb = *apvts.getRawParameterValue("limiterCeiling");
-    float releaseMs = *apvts.getRawParameterValue("limiterRelease");
+    float threshDb = limiterThreshParam->load();
+    float ceilingDb = limiterCeilingParam->load();
+    float releaseMs = limiterReleaseParam->load();
     
     limiter.setThreshold(threshDb);
     limiter.setCeiling(ceilingDb);
@@ -7,6 +7,61 @@
 
 #include <JuceHeader.h>
 #include "DSP/DSPModules.h"
+#include "StageProfiler.h"
+#include "Telemetry.h"
+#include "QualityGovernor.h"
+#include "HostBypass.h"
+#include "SharedTables.h"
+#include "LazyEditorState.h"
+#include "StateArena.h"
+#include "MemoryLock.h"
+
+// 스펙트럼 분석기 상태 (히스토리, FFT 스크래치, 표시 빈). 에디터가 열려 있는 동안만 할당
+struct ELC4LAnalyzerState
+{
+    float fftBufferIn[ELC4L::kFftSize] = {};
+    float fftBufferOut[ELC4L::kFftSize] = {};
+    float fftRe[ELC4L::kFftSize] = {};
+    float fftIm[ELC4L::kFftSize] = {};
+    float spectrumIn[ELC4L::kDisplayBins];
+    float spectrumOut[ELC4L::kDisplayBins];
+    int fftWritePos = 0;
+
+    ELC4LAnalyzerState() { reset(); }
+
+    // 빈 히스토리, 스펙트럼은 바닥
+    void reset()
+    {
+        std::fill(std::begin(fftBufferIn), std::end(fftBufferIn), 0.0f);
+        std::fill(std::begin(fftBufferOut), std::end(fftBufferOut), 0.0f);
+        std::fill(std::begin(spectrumIn), std::end(spectrumIn), -90.0f);
+        std::fill(std::begin(spectrumOut), std::end(spectrumOut), -90.0f);
+        fftWritePos = 0;
+    }
+};
+
+// 샘플마다 쓰는 DSP 상태를 캐시 라인 정렬 아레나 하나에 (StateArena.h): 처리 순서대로 스테이지마다
+// 라인 경계에서 시작하고, UI 스레드가 읽는 미터 atomic은 맨 뒤 별도 라인에
+struct ELC4LProcessingState
+{
+    // 밴드 수는 크로스오버 타입이 결정 (파라미터 레이아웃과 에디터는 4밴드)
+    static constexpr int kNumBands = ELC4L::CrossoverDSP::kNumBands;
+
+    alignas(ELC4L::kCacheLineSize) ELC4L::CrossoverDSP crossover;
+    alignas(ELC4L::kCacheLineSize) ELC4L::CompressorBank<kNumBands> bandComps;
+    alignas(ELC4L::kCacheLineSize) ELC4L::LookaheadLimiter limiter;
+    alignas(ELC4L::kCacheLineSize) ELC4L::LufsMeter lufsMeter;
+
+    struct Meters
+    {
+        std::atomic<float> inputDb{-120.0f};
+        std::atomic<float> outputDb{-120.0f};
+        std::atomic<float> bandGrDb[kNumBands];
+        std::atomic<float> limiterGrDb{0.0f};
+        std::atomic<float> lufsMomentary{-120.0f};
+    };
+    alignas(ELC4L::kCacheLineSize) Meters meters;
+};
 
 class ELC4LAudioProcessor : public juce::AudioProcessor,
                             public juce::AudioProcessorValueTreeState::Listener
@@ -15,6 +70,8 @@ public:
     ELC4LAudioProcessor();
     ~ELC4LAudioProcessor() override;
 
+    static constexpr int kNumBands = ELC4LProcessingState::kNumBands;
+
     //==============================================================================
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
@@ -22,7 +79,9 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
     using AudioProcessor::processBlock;
+    using AudioProcessor::processBlockBypassed;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -56,42 +115,58 @@ public:
 
     //==============================================================================
     // 미터링 데이터 (스레드 안전)
-    float getInputDb() const { return inputDb.load(); }
-    float getOutputDb() const { return outputDb.load(); }
-    float getBandGrDb(int band) const { return (band >= 0 && band < 4) ? bandGrDb[band].load() : 0.0f; }
-    float getLimiterGrDb() const { return limiterGrDb.load(); }
-    float getLufsMomentary() const { return lufsMomentary.load(); }
+    float getInputDb() const { return meters.inputDb.load(); }
+    float getOutputDb() const { return meters.outputDb.load(); }
+    float getBandGrDb(int band) const { return (band >= 0 && band < kNumBands) ? meters.bandGrDb[band].load() : 0.0f; }
+    float getLimiterGrDb() const { return meters.limiterGrDb.load(); }
+    float getLufsMomentary() const { return meters.lufsMomentary.load(); }
     
-    // 스펙트럼 데이터
-    const float* getSpectrumIn() const { return spectrumIn; }
-    const float* getSpectrumOut() const { return spectrumOut; }
+    // 스펙트럼 데이터: 구독 중인 에디터에서 읽음 (구독이 없으면 -90dB 바닥)
+    const float* getSpectrumIn() const;
+    const float* getSpectrumOut() const;
     static constexpr int getSpectrumSize() { return ELC4L::kDisplayBins; }
+
+    // 에디터 생성 / 소멸 시 호출 (메시지 스레드). 분석기 상태는 구독 중에만 존재
+    void subscribeAnalyzer();
+    void unsubscribeAnalyzer();
     
     // 크로스오버 주파수
-    float getXover1Hz() const { return crossover.xover1; }
-    float getXover2Hz() const { return crossover.xover2; }
-    float getXover3Hz() const { return crossover.xover3; }
+    float getXover1Hz() const { return crossover.getFrequency(0); }
+    float getXover2Hz() const { return crossover.getFrequency(1); }
+    float getXover3Hz() const { return crossover.getFrequency(2); }
 
     //==============================================================================
     // 밴드 모니터링 상태
-    bool getBandMute(int band) const { return (band >= 0 && band < 4) ? bandMute[band] : false; }
-    bool getBandSolo(int band) const { return (band >= 0 && band < 4) ? bandSolo[band] : false; }
-    bool getBandDelta(int band) const { return (band >= 0 && band < 4) ? bandDelta[band] : false; }
-    bool getBandBypass(int band) const { return (band >= 0 && band < 4) ? bandBypass[band] : false; }
+    bool getBandMute(int band) const { return (band >= 0 && band < kNumBands) ? bandMute[band] : false; }
+    bool getBandSolo(int band) const { return (band >= 0 && band < kNumBands) ? bandSolo[band] : false; }
+    bool getBandDelta(int band) const { return (band >= 0 && band < kNumBands) ? bandDelta[band] : false; }
+    bool getBandBypass(int band) const { return (band >= 0 && band < kNumBands) ? bandBypass[band] : false; }
     bool getLimiterBypass() const { return limiterBypass; }
 
-    void setBandMute(int band, bool state) { if (band >= 0 && band < 4) bandMute[band] = state; }
-    void setBandSolo(int band, bool state) { if (band >= 0 && band < 4) bandSolo[band] = state; }
-    void setBandDelta(int band, bool state) { if (band >= 0 && band < 4) bandDelta[band] = state; }
-    void setBandBypass(int band, bool state) { if (band >= 0 && band < 4) bandBypass[band] = state; }
+    void setBandMute(int band, bool state) { if (band >= 0 && band < kNumBands) bandMute[band] = state; }
+    void setBandSolo(int band, bool state) { if (band >= 0 && band < kNumBands) bandSolo[band] = state; }
+    void setBandDelta(int band, bool state) { if (band >= 0 && band < kNumBands) bandDelta[band] = state; }
+    void setBandBypass(int band, bool state) { if (band >= 0 && band < kNumBands) bandBypass[band] = state; }
     void setLimiterBypass(bool state) { limiterBypass = state; }
 
-    void toggleBandMute(int band) { if (band >= 0 && band < 4) bandMute[band] = !bandMute[band]; }
-    void toggleBandSolo(int band) { if (band >= 0 && band < 4) bandSolo[band] = !bandSolo[band]; }
-    void toggleBandDelta(int band) { if (band >= 0 && band < 4) bandDelta[band] = !bandDelta[band]; }
-    void toggleBandBypass(int band) { if (band >= 0 && band < 4) bandBypass[band] = !bandBypass[band]; }
+    void toggleBandMute(int band) { if (band >= 0 && band < kNumBands) bandMute[band] = !bandMute[band]; }
+    void toggleBandSolo(int band) { if (band >= 0 && band < kNumBands) bandSolo[band] = !bandSolo[band]; }
+    void toggleBandDelta(int band) { if (band >= 0 && band < kNumBands) bandDelta[band] = !bandDelta[band]; }
+    void toggleBandBypass(int band) { if (band >= 0 && band < kNumBands) bandBypass[band] = !bandBypass[band]; }
     void toggleLimiterBypass() { limiterBypass = !limiterBypass; }
 
+    //==============================================================================
+    // 스테이지별 CPU 프로파일 (에디터의 진단 오버레이가 켜져 있을 때만 측정)
+    void setProfilingEnabled(bool state) { profiler.setEnabled(state); }
+    bool isProfilingEnabled() const { return profiler.isEnabled(); }
+    bool getStageProfile(ELC4L::StageProfileSnapshot& snapshot) const { return profiler.read(snapshot); }
+
+    // CPU 과부하 시 품질 단계 (ELC4L::QualityTier, 0 = 최고 품질)
+    int getQualityTier() const { return governor.getTier(); }
+
+    // 사용자가 선택한 처리 품질 (ELC4L::ProcessingQuality)
+    int getProcessingQuality() const { return static_cast<int>(qualityParam->load()); }
+
 private:
     //==============================================================================
     juce::AudioProcessorValueTreeState apvts;
@@ -101,37 +176,90 @@ private:
     void updateFrequencies();
     void updateLimiter();
 
+    // 파라미터 포인터 캐시 (오디오 스레드에서 juce::String 생성/조회 방지)
+    std::atomic<float>* bandThreshParams[kNumBands] = {};
+    std::atomic<float>* bandMakeupParams[kNumBands] = {};
+    std::atomic<float>* xoverParams[kNumBands - 1] = {};
+    std::atomic<float>* limiterThreshParam = nullptr;
+    std::atomic<float>* limiterCeilingParam = nullptr;
+    std::atomic<float>* limiterReleaseParam = nullptr;
+    std::atomic<float>* sidechainFreqParam = nullptr;
+    std::atomic<float>* sidechainActiveParam = nullptr;
+    std::atomic<float>* qualityParam = nullptr;
+
     //==============================================================================
-    // DSP 모듈
-    ELC4L::CrossoverDSP crossover;
-    ELC4L::OptoCompressor bandComps[4];
-    ELC4L::LookaheadLimiter limiter;
-    ELC4L::LufsMeter lufsMeter;
-
-    // 미터링 데이터 (atomic)
-    std::atomic<float> inputDb{-120.0f};
-    std::atomic<float> outputDb{-120.0f};
-    std::atomic<float> bandGrDb[4];
-    std::atomic<float> limiterGrDb{0.0f};
-    std::atomic<float> lufsMomentary{-120.0f};
-
-    // 스펙트럼 분석기
-    juce::dsp::FFT fft{12};  // 4096 포인트
-    juce::dsp::WindowingFunction<float> window{ELC4L::kFftSize, 
-        juce::dsp::WindowingFunction<float>::blackmanHarris};
-    float fftBufferIn[ELC4L::kFftSize] = {};
-    float fftBufferOut[ELC4L::kFftSize] = {};
-    float spectrumIn[ELC4L::kDisplayBins] = {};
-    float spectrumOut[ELC4L::kDisplayBins] = {};
-    int fftWritePos = 0;
+    // DSP 모듈과 미터링 데이터 (atomic): 인스턴스와 함께 한 번 할당, 아래 이름은 아레나 안을 가리킴
+    ELC4L::StateArena<ELC4LProcessingState> dspArena;
+    ELC4L::CrossoverDSP& crossover = dspArena->crossover;
+    ELC4L::CompressorBank<kNumBands>& bandComps = dspArena->bandComps;
+    ELC4L::LookaheadLimiter& limiter = dspArena->limiter;
+    ELC4L::LufsMeter& lufsMeter = dspArena->lufsMeter;
+    ELC4LProcessingState::Meters& meters = dspArena->meters;
+
+    // 스펙트럼 분석기 (4096 포인트). 윈도우, FFT, 로그 빈 테이블은 프로세스 전체가 공유 (SharedTables.h),
+    // 인스턴스별 상태는 에디터가 열려 있을 때만 할당 (헤드리스 인스턴스는 메모리도 FFT도 없음)
+    std::shared_ptr<const ELC4L::FftTables> fftTables =
+        ELC4L::SharedTable<ELC4L::FftTables>::acquire(ELC4L::kFftSize);
+    std::shared_ptr<const ELC4L::SpectrumBinMap> spectrumBinMap;    // prepareToPlay의 샘플레이트
+    ELC4L::LazyEditorState<ELC4LAnalyzerState> analyzerLink;
+    ELC4LAnalyzerState* analyzer = nullptr;     // 현재 블록 동안 잡은 상태 (오디오 스레드), 그 외 nullptr
+
+    void computeSpectrum(ELC4LAnalyzerState& state, const float* input, float* output);
+    void mapSpectrumBins(const ELC4L::SpectrumBinMap& map, const float* re, const float* im, float* output);
+    void renderBlock(juce::AudioBuffer<float>& buffer);   // processBlock / processBlockBypassed 공통
+
+    // 무음 슬립: 입력이 무음이고 모든 테일이 소진되면 DSP 생략
+    bool dspSleeping = false;
+    bool isDspIdle() const;
+    void enterSilenceSleep();
+
+    ELC4L::StageProfiler profiler;
+    ELC4L::TelemetryPublisher telemetry;     // 공유 메모리 텔레메트리 (ELC4L_TELEMETRY=1)
+
+    // 블록 예산 대비 처리 시간이 길어지면 품질을 단계적으로 낮춤
+    ELC4L::QualityGovernor governor;
+    ELC4L::HostBypass hostBypass;            // 호스트 바이패스: 레이턴시 맞춘 드라이 경로, DSP 생략
+    int qualityTier = ELC4L::kQualityFull;   // DSP에 적용된 단계 (오디오 스레드)
+    int processingQuality = ELC4L::kProcessingStandard;    // DSP에 적용된 처리 품질 (오디오 스레드)
+    int analyzerHopSize = ELC4L::kFftHopSize;               // 0: 분석기 정지
+    void applyQuality(int quality, int tier);
+    void updateLatency();                    // 선택한 품질의 리미터 룩어헤드 = 레이턴시
+
+    // 옵트인 (ELC4L_LOCK_MEMORY): prepareToPlay에서 아레나와 인스턴스를 미리 건드리고 mlock,
+    // releaseResources에서 해제. 분석기 상태는 구독 시 따로 고정. 아레나와 분석기 상태보다 뒤에
+    // 선언되어 그 메모리가 해제되기 전에 먼저 풀림
+    ELC4L::MemoryLockMode memoryLockMode = ELC4L::getMemoryLockModeFromEnvironment();
+    ELC4L::MemoryLock memoryLock;
+    ELC4L::MemoryLock analyzerMemoryLock;
+    void lockDspMemory();
+
+    // 블록 처리는 청크 단위로, 모니터링 스위치에 특화된 커널을 블록마다 한 번 골라서 실행
+    // (비트마스크 -> 테이블). 샘플 루프에는 스위치 분기가 없음
+    static constexpr int kChunkSize = 32;
+    enum BandKernelFlags {
+        kBandKernelBypass = 1 << 0,
+        kBandKernelDelta = 1 << 1,
+        kBandKernelMuted = 1 << 2,     // 믹스에 들어가지 않음 (뮤트 / 다른 밴드 솔로): 디텍터만
+        kNumBandKernels = 1 << 3
+    };
+    using BandKernel = void (ELC4LAudioProcessor::*)(int band, float* left, float* right, int numSamples);
+    using OutputKernel = void (ELC4LAudioProcessor::*)(const float* inL, const float* inR, float* mixL,
+                                                       float* mixR, float* outL, float* outR, int numSamples);
+    static const BandKernel bandKernels[kNumBandKernels];
+    static const OutputKernel outputKernels[4];         // 비트 0: 리미터 바이패스, 비트 1: 분석기 동작
+    float bandMakeupGains[kNumBands] = {};   // 바이패스된 밴드용 (블록마다 갱신)
 
-    void computeSpectrum(const float* input, float* output);
+    template <int Flags>
+    void processBandChunk(int band, float* left, float* right, int numSamples);
+    template <bool LimiterBypass, bool Analyzer>
+    void processOutputChunk(const float* inL, const float* inR, float* mixL, float* mixR,
+                            float* outL, float* outR, int numSamples);
 
     // 밴드 모니터링 상태
-    bool bandMute[4] = { false, false, false, false };
-    bool bandSolo[4] = { false, false, false, false };
-    bool bandDelta[4] = { false, false, false, false };
-    bool bandBypass[4] = { false, false, false, false };
+    bool bandMute[kNumBands] = {};
+    bool bandSolo[kNumBands] = {};
+    bool bandDelta[kNumBands] = {};
+    bool bandBypass[kNumBands] = {};
     bool limiterBypass = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ELC4LAudioProcessor)
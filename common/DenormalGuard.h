@@ -0,0 +1,79 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Denormal protection (shared by VST2 / VST3 / tools)
+// ScopedFlushDenormals: sets FTZ/DAZ (x86 MXCSR) or FZ (AArch64 FPCR) for the duration of an audio
+// callback and restores the host's mode on exit.
+// flushDenormal(): fallback for hosts or platforms where the hardware mode is reset or unavailable.
+// Recursive state (IIR memories, envelopes) is zeroed once per block when it falls below -300 dB,
+// so a decaying tail can never settle in the subnormal range.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ELC4L_DENORMAL_MXCSR 1
+#elif defined(__aarch64__)
+#define ELC4L_DENORMAL_FPCR 1
+#endif
+
+namespace ELC4L {
+
+class ScopedFlushDenormals {
+public:
+#if defined(ELC4L_DENORMAL_MXCSR)
+    static constexpr unsigned int kFlushBits = 0x8040;    // FTZ (bit 15) | DAZ (bit 6)
+
+    ScopedFlushDenormals() : saved(_mm_getcsr()) { _mm_setcsr(saved | kFlushBits); }
+    ~ScopedFlushDenormals() { _mm_setcsr(saved); }
+
+    static bool isActive() { return (_mm_getcsr() & kFlushBits) == kFlushBits; }
+
+private:
+    unsigned int saved;
+#elif defined(ELC4L_DENORMAL_FPCR)
+    static constexpr unsigned long long kFlushBits = 1ull << 24;   // FZ
+
+    ScopedFlushDenormals() : saved(readFpcr()) { writeFpcr(saved | kFlushBits); }
+    ~ScopedFlushDenormals() { writeFpcr(saved); }
+
+    static bool isActive() { return (readFpcr() & kFlushBits) != 0; }
+
+private:
+    static unsigned long long readFpcr() {
+        unsigned long long value;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(value));
+        return value;
+    }
+    static void writeFpcr(unsigned long long value) {
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(value));
+    }
+
+    unsigned long long saved;
+#else
+    ScopedFlushDenormals() {}
+    static bool isActive() { return false; }
+#endif
+
+public:
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+};
+
+// Software fallback: zero recursive state below -300 dB (well above the subnormal range).
+// Written as a compare so it survives -ffast-math, unlike the add/subtract-constant trick.
+constexpr float kDenormalFlushThreshold = 1.0e-15f;
+
+inline void flushDenormal(float& value) {
+    if (std::fabs(value) < kDenormalFlushThreshold) value = 0.0f;
+}
+
+inline void flushDenormal(double& value) {
+    if (std::fabs(value) < (double)kDenormalFlushThreshold) value = 0.0;
+}
+
+inline void flushDenormals(float* data, int size) {
+    for (int i = 0; i < size; ++i) flushDenormal(data[i]);
+}
+
+} // namespace ELC4L
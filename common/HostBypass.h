@@ -0,0 +1,183 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Host bypass with a latency-matched dry path (shared by VST2 / VST3 / JUCE)
+// A bypassed instance only runs a delay line that holds the dry input back by the limiter lookahead,
+// so the host's delay compensation stays valid and the cost is a copy per sample. Switching is
+// crossfaded over kCrossfadeMs:
+//   active -> fading out (DSP + crossfade to dry) -> bypassed (DSP skipped, its state flushed)
+//   bypassed -> warming up (DSP runs, output stays dry until the lookahead holds real signal)
+//            -> fading in -> active
+// A request that arrives mid-fade reverses it from the current mix.
+//
+// setBypassed may be called from any thread. Audio thread: beginBlock once per block; then either
+// processDry for the whole block, or pushInput / mixOutput around every chunk of at most
+// kMaxChunkSamples (pushInput before an in-place DSP overwrites the input, mixOutput once the chunk's
+// output is written), or advanceSilent while the DSP sleeps on silent input.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+
+namespace ELC4L {
+
+class HostBypass {
+public:
+    static constexpr int kMaxLatencySamples = 256;
+    static constexpr int kMaxChunkSamples = 64;
+    static constexpr float kCrossfadeMs = 10.0f;
+
+    HostBypass() { clear(); }
+
+    // Call from prepare / setSampleRate (not concurrently with processing)
+    void prepare(double sampleRate) {
+        fadeStep = 1.0f / (float)((sampleRate > 0.0 ? sampleRate : 44100.0) * kCrossfadeMs * 0.001);
+        const bool bypassed = requested.load(std::memory_order_relaxed);
+        state = bypassed ? kBypassed : kActive;
+        dryMix = bypassed ? 1.0f : 0.0f;
+        flushPending = false;
+        clear();
+    }
+
+    // Audio thread (or prepare): the wet path's latency, which the dry path matches
+    void setLatency(int samples) {
+        latency = (samples < 0) ? 0 : (samples > kMaxLatencySamples) ? kMaxLatencySamples : samples;
+    }
+
+    // Any thread
+    void setBypassed(bool shouldBeBypassed) { requested.store(shouldBeBypassed, std::memory_order_relaxed); }
+    bool isBypassed() const { return requested.load(std::memory_order_relaxed); }
+
+    //---------------------------------------------------------------------------------------------------
+    // Audio thread
+    //---------------------------------------------------------------------------------------------------
+    // Picks up the request; false: skip the DSP and call processDry for the block
+    bool beginBlock() {
+        const bool bypassed = requested.load(std::memory_order_relaxed);
+        switch (state) {
+            case kActive:    if (bypassed) state = kFadingOut; break;
+            case kFadingIn:  if (bypassed) state = kFadingOut; break;
+            case kFadingOut: if (!bypassed) state = kFadingIn; break;
+            case kBypassed:
+                if (!bypassed) {
+                    state = kWarmingUp;
+                    warmupRemaining = latency;
+                }
+                break;
+            case kWarmingUp:
+                if (bypassed) {
+                    state = kBypassed;
+                    flushPending = true;
+                }
+                break;
+        }
+        return state != kBypassed;
+    }
+
+    // True once after the DSP was left: the wrapper clears its DSP state, so that when the bypass
+    // ends the wet path starts from silence instead of replaying what it held
+    bool takeFlushRequest() {
+        const bool flush = flushPending;
+        flushPending = false;
+        return flush;
+    }
+
+    // Whole block while bypassed (in place allowed)
+    void processDry(const float* inL, const float* inR, float* outL, float* outR, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            const float l = inL[i];
+            const float r = inR[i];
+            dryL[writePos] = l;
+            dryR[writePos] = r;
+            const int read = (writePos - latency) & kRingMask;
+            outL[i] = dryL[read];
+            outR[i] = dryR[read];
+            writePos = (writePos + 1) & kRingMask;
+        }
+    }
+
+    // Stores a chunk's input for the dry path
+    void pushInput(const float* inL, const float* inR, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            dryL[(writePos + i) & kRingMask] = inL[i];
+            dryR[(writePos + i) & kRingMask] = inR[i];
+        }
+    }
+
+    // Crossfades the chunk's wet output with the dry input of the same chunk; returns right away
+    // (apart from advancing the ring) while fully active
+    void mixOutput(float* outL, float* outR, int numSamples) {
+        const int start = writePos;
+        writePos = (writePos + numSamples) & kRingMask;
+        if (state == kActive) return;
+
+        for (int i = 0; i < numSamples; ++i) {
+            if (state == kWarmingUp) {
+                if (--warmupRemaining <= 0) state = kFadingIn;
+            } else if (state == kFadingOut) {
+                dryMix += fadeStep;
+                if (dryMix >= 1.0f) {
+                    dryMix = 1.0f;
+                    state = kBypassed;
+                    flushPending = true;
+                }
+            } else if (state == kFadingIn) {
+                dryMix -= fadeStep;
+                if (dryMix <= 0.0f) {
+                    dryMix = 0.0f;
+                    state = kActive;
+                }
+            }
+            const int read = (start + i - latency) & kRingMask;
+            outL[i] += (dryL[read] - outL[i]) * dryMix;
+            outR[i] += (dryR[read] - outR[i]) * dryMix;
+        }
+    }
+
+    // The DSP sleeps on silent input (output is silence): the ring follows with silence and a
+    // pending fade completes at once
+    void advanceSilent(int numSamples) {
+        const int n = (numSamples < kRingSize) ? numSamples : kRingSize;
+        for (int i = 0; i < n; ++i) {
+            dryL[(writePos + i) & kRingMask] = 0.0f;
+            dryR[(writePos + i) & kRingMask] = 0.0f;
+        }
+        writePos = (writePos + numSamples) & kRingMask;
+        if (state == kFadingOut) {
+            dryMix = 1.0f;
+            state = kBypassed;
+            flushPending = true;
+        } else if (state == kFadingIn || state == kWarmingUp) {
+            dryMix = 0.0f;
+            state = kActive;
+        }
+    }
+
+private:
+    static constexpr int kRingSize = 512;      // Power of two >= kMaxLatencySamples + kMaxChunkSamples
+    static constexpr int kRingMask = kRingSize - 1;
+    static_assert(kRingSize >= kMaxLatencySamples + kMaxChunkSamples, "dry ring too short");
+
+    enum State { kActive, kFadingOut, kBypassed, kWarmingUp, kFadingIn };
+
+    void clear() {
+        for (int i = 0; i < kRingSize; ++i) {
+            dryL[i] = 0.0f;
+            dryR[i] = 0.0f;
+        }
+        writePos = 0;
+    }
+
+    std::atomic<bool> requested { false };
+
+    // Audio thread state
+    State state = kActive;
+    float dryMix = 0.0f;            // Weight of the dry path (0: wet only, 1: dry only)
+    float fadeStep = 1.0f / 441.0f;
+    int warmupRemaining = 0;
+    int latency = 0;
+    bool flushPending = false;
+    int writePos = 0;
+    float dryL[kRingSize];
+    float dryR[kRingSize];
+};
+
+} // namespace ELC4L
@@ -0,0 +1,102 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Editor-only state allocated on demand (shared by VST2 / JUCE)
+// The spectrum analyzer's sample history, FFT scratch and display buffers are only ever looked at by
+// an open editor, yet they are the largest part of an instance. LazyEditorState<State> keeps them off
+// the instance: the first editor to subscribe allocates a State and publishes it to the audio thread,
+// the last one to unsubscribe takes it back and frees it. A headless instance (an OBS filter, a
+// render) never allocates it and the audio thread just skips the work.
+//
+// Hand-over: the audio thread announces the pointer it is about to use (a one-slot hazard pointer)
+// and re-checks that it is still published; unsubscribe unpublishes the state and waits until the
+// audio thread no longer announces it before deleting it, which takes at most one block.
+//
+// Message thread (or any non-audio thread): subscribe / unsubscribe / update / get; they take a
+// mutex the RT guard reports if it is ever taken on the audio thread.
+// Audio thread: one AudioAccess per block.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "RealtimeGuard.h"
+
+namespace ELC4L {
+
+template <typename State>
+class LazyEditorState {
+public:
+    LazyEditorState() = default;
+    LazyEditorState(const LazyEditorState&) = delete;
+    LazyEditorState& operator=(const LazyEditorState&) = delete;
+
+    // Not concurrently with processing: the audio thread is gone by the time the instance is
+    ~LazyEditorState() { delete published.load(); }
+
+    // The first subscriber allocates the state; 'init' prepares it before the audio thread can see it
+    template <typename Init>
+    void subscribe(Init&& init) {
+        std::lock_guard<rt::CheckedMutex> lock(mutex);
+        if (subscribers++ > 0) return;
+        State* state = new State();
+        init(*state);
+        published.store(state);
+    }
+
+    // The last subscriber unpublishes the state and frees it once the audio thread has let go
+    void unsubscribe() {
+        std::lock_guard<rt::CheckedMutex> lock(mutex);
+        if (subscribers == 0 || --subscribers > 0) return;
+        State* state = published.exchange(nullptr);
+        while (inUse.load() == state) std::this_thread::yield();
+        delete state;
+    }
+
+    // Settings changes (sample rate) for a state that exists; not concurrently with processing
+    template <typename Fn>
+    void update(Fn&& fn) {
+        std::lock_guard<rt::CheckedMutex> lock(mutex);
+        if (State* state = published.load()) fn(*state);
+    }
+
+    // From a subscriber's thread: valid until that subscriber unsubscribes (nullptr if none)
+    const State* get() const { return published.load(); }
+    bool isAllocated() const { return published.load() != nullptr; }
+
+    // Audio thread: the published state for the duration of one block (nullptr: nobody is looking).
+    // 'slot' receives the pointer and is cleared again at the end of the scope.
+    class AudioAccess {
+    public:
+        AudioAccess(LazyEditorState& owner, State*& slot) : owner(owner), slot(slot) {
+            State* state = owner.published.load();
+            owner.inUse.store(state);
+            // Unpublished between the load and the announcement: sit this block out
+            if (owner.published.load() != state) {
+                owner.inUse.store(nullptr);
+                state = nullptr;
+            }
+            slot = state;
+        }
+
+        ~AudioAccess() {
+            slot = nullptr;
+            owner.inUse.store(nullptr);
+        }
+
+        AudioAccess(const AudioAccess&) = delete;
+        AudioAccess& operator=(const AudioAccess&) = delete;
+
+    private:
+        LazyEditorState& owner;
+        State*& slot;
+    };
+
+private:
+    rt::CheckedMutex mutex { "LazyEditorState mutex" };    // Serializes subscribe / unsubscribe / update
+    int subscribers = 0;
+    std::atomic<State*> published { nullptr };
+    std::atomic<State*> inUse { nullptr };      // Announced by the audio thread
+};
+
+} // namespace ELC4L
@@ -0,0 +1,184 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Prefaulted, locked DSP memory: page touching and mlock (POSIX; touch only on Windows)
+//-------------------------------------------------------------------------------------------------------
+#include "MemoryLock.h"
+#include "RealtimeGuard.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <cerrno>
+#include <map>
+#include <mutex>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ELC4L {
+
+namespace {
+
+size_t getPageSize() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (size_t)info.dwPageSize;
+#else
+    const long size = sysconf(_SC_PAGESIZE);
+    return (size > 0) ? (size_t)size : 4096;
+#endif
+}
+
+// Write-faults one byte of every page the region spans, staying inside the region. The write is an
+// atomic OR with 0 rather than a load and a store, so a concurrent store to the same byte (a
+// parameter or meter atomic another thread owns) cannot be overwritten with a stale value
+inline void touchByte(unsigned char* byte) {
+#if defined(_MSC_VER)
+    _InterlockedOr8(reinterpret_cast<volatile char*>(byte), 0);
+#else
+    __atomic_fetch_or(byte, (unsigned char)0, __ATOMIC_RELAXED);
+#endif
+}
+
+void touchRegion(const MemoryRegion& region, size_t pageSize) {
+    unsigned char* bytes = static_cast<unsigned char*>(region.data);
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(region.data);
+    size_t offset = 0;
+    while (offset < region.bytes) {
+        touchByte(bytes + offset);
+        offset = ((begin + offset) / pageSize + 1) * pageSize - begin;
+    }
+}
+
+#if !defined(_WIN32)
+// mlock is not counted by the kernel: one munlock releases a page whatever locked it. Regions are
+// not page aligned (they include whole plug-in objects), so every lock in the process goes through
+// this count and a page is only mlock()ed by its first holder and munlock()ed by its last.
+class PageLockRegistry {
+public:
+    static PageLockRegistry& get() {
+        static PageLockRegistry registry;
+        return registry;
+    }
+
+    // Locks [first, end) page by page and returns the end of the prefix now held (end on success).
+    // errno is left from the refused mlock otherwise.
+    uintptr_t acquire(uintptr_t first, uintptr_t end, size_t pageSize) {
+        std::lock_guard<std::mutex> guard(mutex);
+        for (uintptr_t page = first; page < end; page += pageSize) {
+            int& holders = counts[page];
+            if (holders == 0 && mlock(reinterpret_cast<void*>(page), pageSize) != 0) {
+                const int error = errno;
+                counts.erase(page);
+                errno = error;
+                return page;
+            }
+            ++holders;
+        }
+        return end;
+    }
+
+    void release(uintptr_t first, uintptr_t end, size_t pageSize) {
+        std::lock_guard<std::mutex> guard(mutex);
+        for (uintptr_t page = first; page < end; page += pageSize) {
+            auto it = counts.find(page);
+            if (it == counts.end()) continue;
+            if (--it->second == 0) {
+                munlock(reinterpret_cast<void*>(page), pageSize);
+                counts.erase(it);
+            }
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::map<uintptr_t, int> counts;    // Page address -> locks holding it
+};
+#endif
+
+} // namespace
+
+MemoryLockMode getMemoryLockModeFromEnvironment() {
+    const char* value = getenv("ELC4L_LOCK_MEMORY");
+    if (!value || value[0] == '\0' || strcmp(value, "0") == 0) return kMemoryLockOff;
+    return (strcmp(value, "prefault") == 0) ? kMemoryLockPrefault : kMemoryLockPin;
+}
+
+bool MemoryLock::lock(MemoryLockMode mode, const MemoryRegion* regions, int numRegions) {
+    ELC4L_RT_CHECK_SYSCALL("MemoryLock::lock (mlock)");
+    unlock();
+    report = MemoryLockReport();
+    if (mode == kMemoryLockOff) return false;
+    if (numRegions > kMaxRegions) numRegions = kMaxRegions;
+
+    const size_t pageSize = getPageSize();
+    bool allLocked = true;
+    for (int i = 0; i < numRegions; ++i) {
+        const MemoryRegion& region = regions[i];
+        if (!region.data || region.bytes == 0) continue;
+
+        const uintptr_t first = reinterpret_cast<uintptr_t>(region.data) / pageSize * pageSize;
+        const uintptr_t end = (reinterpret_cast<uintptr_t>(region.data) + region.bytes + pageSize - 1)
+                            / pageSize * pageSize;
+        report.regionBytes += region.bytes;
+        report.pageBytes += (size_t)(end - first);
+
+        touchRegion(region, pageSize);
+        if (mode != kMemoryLockPin) continue;
+
+#if defined(_WIN32)
+        allLocked = false;      // Working-set locking is not attempted on Windows
+#else
+        const uintptr_t held = PageLockRegistry::get().acquire(first, end, pageSize);
+        if (held < end) {
+            if (report.lockError == 0) report.lockError = errno;
+            allLocked = false;
+        }
+        if (held > first) {
+            locked[numLocked].begin = reinterpret_cast<void*>(first);
+            locked[numLocked].bytes = (size_t)(held - first);
+            ++numLocked;
+            report.lockedBytes += (size_t)(held - first);
+        }
+#endif
+    }
+    return mode == kMemoryLockPin && allLocked;
+}
+
+void MemoryLock::unlock() {
+    if (numLocked > 0) ELC4L_RT_CHECK_SYSCALL("MemoryLock::unlock (munlock)");
+#if !defined(_WIN32)
+    const size_t pageSize = getPageSize();
+    for (int i = 0; i < numLocked; ++i) {
+        const uintptr_t first = reinterpret_cast<uintptr_t>(locked[i].begin);
+        PageLockRegistry::get().release(first, first + locked[i].bytes, pageSize);
+    }
+#endif
+    numLocked = 0;
+    report.lockedBytes = 0;
+}
+
+void MemoryLock::printReport(const char* owner, MemoryLockMode mode, const MemoryLockReport& report) {
+    if (mode == kMemoryLockOff) return;
+    ELC4L_RT_CHECK_SYSCALL("MemoryLock::printReport (fputs)");
+    char line[256];
+    if (mode == kMemoryLockPrefault) {
+        snprintf(line, sizeof(line), "%s: prefaulted %zu bytes (%zu in pages), not locked\n", owner,
+                 report.regionBytes, report.pageBytes);
+    } else if (report.lockError != 0) {
+        snprintf(line, sizeof(line), "%s: locked %zu of %zu bytes, prefaulted the rest (mlock: %s)\n", owner,
+                 report.lockedBytes, report.pageBytes, strerror(report.lockError));
+    } else {
+        snprintf(line, sizeof(line), "%s: locked %zu of %zu bytes\n", owner, report.lockedBytes,
+                 report.pageBytes);
+    }
+    fputs(line, stderr);
+}
+
+} // namespace ELC4L
@@ -0,0 +1,75 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Prefaulted, locked DSP memory (opt-in; shared by VST2 / VST3 / JUCE and the tools)
+// On Linux (JACK / standalone) the first blocks after transport start can page-fault on DSP state
+// that was evicted or never written, and a fault on the audio thread is an xrun. With the environment
+// variable ELC4L_LOCK_MEMORY set, each wrapper's prepare step (VST2 resume, VST3 setupProcessing,
+// JUCE prepareToPlay) hands its DSP regions to a MemoryLock, which writes one byte of every page they
+// span and mlock()s them, then prints one report line with the bytes locked:
+//   ELC4L_LOCK_MEMORY=1        : touch and lock (falls back to touching when mlock is refused, e.g. by
+//                                RLIMIT_MEMLOCK; the report names the error)
+//   ELC4L_LOCK_MEMORY=prefault : touch only
+// Without it nothing is touched, locked or printed.
+//
+// Locks are per page and counted process-wide: a page that two instances' regions share (or that
+// neighbouring objects share with a region) stays locked until the last lock on it is dropped.
+// Never call from the audio thread, nor while it is processing.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+namespace ELC4L {
+
+enum MemoryLockMode {
+    kMemoryLockOff = 0,
+    kMemoryLockPrefault,        // Touch every page
+    kMemoryLockPin              // Touch and mlock
+};
+
+// ELC4L_LOCK_MEMORY: unset, "" or "0" -> off, "prefault" -> touch only, anything else -> touch and lock
+MemoryLockMode getMemoryLockModeFromEnvironment();
+
+struct MemoryRegion {
+    void* data;
+    size_t bytes;
+};
+
+struct MemoryLockReport {
+    size_t regionBytes = 0;     // Sum of the regions as given
+    size_t pageBytes = 0;       // Whole pages they span (what a lock covers)
+    size_t lockedBytes = 0;     // Pages held locked (mlock() accepted, or already held by another lock)
+    int lockError = 0;          // errno of the first refused mlock, 0 if none was refused
+};
+
+class MemoryLock {
+public:
+    static constexpr int kMaxRegions = 8;
+
+    MemoryLock() = default;
+    ~MemoryLock() { unlock(); }
+
+    MemoryLock(const MemoryLock&) = delete;
+    MemoryLock& operator=(const MemoryLock&) = delete;
+
+    // Drops the previous lock, then touches (and for kMemoryLockPin locks) the regions. False when a
+    // lock was refused or the mode is off; the regions are touched either way.
+    bool lock(MemoryLockMode mode, const MemoryRegion* regions, int numRegions);
+    void unlock();
+
+    const MemoryLockReport& getReport() const { return report; }
+
+    // One line on stderr: "<owner>: locked N of M bytes ..." (nothing when the mode is off)
+    static void printReport(const char* owner, MemoryLockMode mode, const MemoryLockReport& report);
+
+private:
+    struct LockedRange {
+        void* begin;
+        size_t bytes;
+    };
+
+    LockedRange locked[kMaxRegions] = {};
+    int numLocked = 0;
+    MemoryLockReport report;
+};
+
+} // namespace ELC4L
@@ -0,0 +1,212 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Adaptive quality under CPU overload (shared by VST2 / VST3 / JUCE)
+// Measures each process call against the block's real-time budget and steps through quality tiers
+// when the load stays high, so a busy machine loses analyzer frames and saturation oversampling
+// before the host's audio graph drops out:
+//   kQualityFull            : everything on
+//   kQualityAnalyzerPaused  : spectrum analyzer stops (no audible change)
+//   kQualityNoOversampling  : tape saturation at 1x instead of 4x (crossfaded in the compressors)
+//   kQualityControlRate     : compressor gain computer every kControlRateInterval samples
+//
+// Hysteresis: the smoothed load has to exceed stepDownPercent (or a single block has to overrun
+// its budget) to step down one tier, after which the governor waits settleSeconds so the next
+// decision sees the cheaper tier. Stepping back up takes the load staying below stepUpPercent for
+// recoverSeconds, one tier at a time.
+//
+// Thresholds: ELC4L_ADAPTIVE_QUALITY=off disables the governor; "down,up" (percent of the block
+// budget, e.g. "35,15") overrides the defaults. Audio thread: beginBlock / endBlock. Any thread:
+// getTier / getTierChanges.
+//
+// The tiers apply on top of the user's processing quality (Eco / Standard / High, saved with the
+// plugin state); getQualitySettings() combines both into what the DSP actually runs.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace ELC4L {
+
+enum QualityTier {
+    kQualityFull = 0,
+    kQualityAnalyzerPaused,
+    kQualityNoOversampling,
+    kQualityControlRate,
+    kNumQualityTiers
+};
+
+inline const char* getQualityTierName(int tier) {
+    static const char* const names[kNumQualityTiers] = {
+        "Full", "Analyzer paused", "Saturation 1x", "Control-rate gain"
+    };
+    return (tier >= 0 && tier < kNumQualityTiers) ? names[tier] : "?";
+}
+
+//-------------------------------------------------------------------------------------------------------
+// User-selected processing quality
+//   Eco      : float crossover, saturation at 1x, control-rate gain computer, analyzer at half rate
+//   Standard : double crossover, 4x saturation, per-sample gain computer, 75% analyzer overlap
+//   High     : Standard with 8x saturation and a longer true-peak-hold limiter lookahead
+//-------------------------------------------------------------------------------------------------------
+enum ProcessingQuality {
+    kProcessingEco = 0,
+    kProcessingStandard,
+    kProcessingHigh,
+    kNumProcessingQualities
+};
+
+inline const char* getProcessingQualityName(int quality) {
+    static const char* const names[kNumProcessingQualities] = { "Eco", "Standard", "High" };
+    return (quality >= 0 && quality < kNumProcessingQualities) ? names[quality] : "?";
+}
+
+// Normalized parameter <-> quality (three equal ranges; the stored values are 0, 0.5 and 1)
+inline int normalizedToProcessingQuality(float normalized) {
+    if (normalized < 1.0f / 3.0f) return kProcessingEco;
+    if (normalized < 2.0f / 3.0f) return kProcessingStandard;
+    return kProcessingHigh;
+}
+
+inline float processingQualityToNormalized(int quality) { return 0.5f * (float)quality; }
+
+// What the DSP runs for one processing quality and overload tier
+struct QualitySettings {
+    bool doublePrecisionCrossover;
+    int saturationFactor;           // 1, 4 or 8
+    int gainComputerInterval;       // Samples between gain computer updates
+    int analyzerHopScale;           // 0: analyzer paused, 1: 75% overlap, 2: 50% overlap
+    bool extendedLookahead;         // Limiter: longer lookahead with peak hold (changes latency)
+};
+
+class QualityGovernor {
+public:
+    static constexpr int kControlRateInterval = 16;    // Gain computer interval at kQualityControlRate
+    static constexpr float kCrossfadeMs = 20.0f;        // Saturation 4x <-> 1x crossfade
+
+    struct Settings {
+        float stepDownPercent = 35.0f;      // Smoothed load that triggers a step down
+        float stepUpPercent = 15.0f;        // Smoothed load that allows a step up
+        float settleSeconds = 0.5f;         // Minimum time between step downs
+        float recoverSeconds = 3.0f;        // Time below stepUpPercent before each step up
+    };
+
+    QualityGovernor() { loadFromEnvironment(); }
+
+    // Call from prepare / setSampleRate (not concurrently with processing)
+    void prepare(double newSampleRate) {
+        sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
+        smoothedLoad = 0.0f;
+        secondsSinceChange = 0.0;
+        secondsRecovered = 0.0;
+        tier.store(kQualityFull, std::memory_order_relaxed);
+    }
+
+    void setSettings(const Settings& newSettings) { settings = newSettings; }
+    const Settings& getSettings() const { return settings; }
+    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    bool isEnabled() const { return enabled; }
+
+    // Any thread
+    int getTier() const { return tier.load(std::memory_order_relaxed); }
+    uint32_t getTierChanges() const { return tierChanges.load(std::memory_order_relaxed); }
+
+    int getCrossfadeSamples() const { return (int)(sampleRate * kCrossfadeMs * 0.001); }
+
+    //---------------------------------------------------------------------------------------------------
+    // Audio thread
+    //---------------------------------------------------------------------------------------------------
+    int64_t beginBlock() const { return enabled ? now() : 0; }
+
+    // Returns the tier for the next block
+    int endBlock(int64_t startNs, int numSamples) {
+        int current = tier.load(std::memory_order_relaxed);
+        if (!enabled) {
+            if (current != kQualityFull) setTier(kQualityFull);
+            return kQualityFull;
+        }
+        if (numSamples <= 0) return current;
+
+        const double blockSeconds = (double)numSamples / sampleRate;
+        const float load = (float)(100.0 * (double)(now() - startNs) * 1.0e-9 / blockSeconds);
+
+        // ~100 ms smoothing independent of the block size
+        const float alpha = (float)(blockSeconds / (blockSeconds + 0.1));
+        smoothedLoad += alpha * (load - smoothedLoad);
+        secondsSinceChange += blockSeconds;
+
+        if ((smoothedLoad > settings.stepDownPercent || load > 100.0f) && current < kNumQualityTiers - 1
+            && secondsSinceChange >= settings.settleSeconds) {
+            setTier(current + 1);
+            secondsRecovered = 0.0;
+        } else if (smoothedLoad < settings.stepUpPercent && current > kQualityFull) {
+            secondsRecovered += blockSeconds;
+            if (secondsRecovered >= settings.recoverSeconds) {
+                setTier(current - 1);
+                secondsRecovered = 0.0;
+            }
+        } else {
+            secondsRecovered = 0.0;
+        }
+        return tier.load(std::memory_order_relaxed);
+    }
+
+private:
+    static int64_t now() {
+        return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void setTier(int newTier) {
+        tier.store(newTier, std::memory_order_relaxed);
+        tierChanges.fetch_add(1, std::memory_order_relaxed);
+        secondsSinceChange = 0.0;
+    }
+
+    void loadFromEnvironment() {
+        const char* value = getenv("ELC4L_ADAPTIVE_QUALITY");
+        if (!value) return;
+        if (strcmp(value, "off") == 0 || strcmp(value, "0") == 0) {
+            enabled = false;
+            return;
+        }
+        float down = 0.0f, up = 0.0f;
+        if (sscanf(value, "%f,%f", &down, &up) == 2 && up > 0.0f && down > up) {
+            settings.stepDownPercent = down;
+            settings.stepUpPercent = up;
+        }
+    }
+
+    Settings settings;
+    bool enabled = true;
+    double sampleRate = 44100.0;
+
+    // Audio thread state
+    float smoothedLoad = 0.0f;
+    double secondsSinceChange = 0.0;
+    double secondsRecovered = 0.0;
+
+    std::atomic<int> tier { kQualityFull };
+    std::atomic<uint32_t> tierChanges { 0 };
+};
+
+// Combines the user's processing quality with the overload tier
+inline QualitySettings getQualitySettings(int quality, int tier) {
+    QualitySettings settings;
+    settings.doublePrecisionCrossover = (quality != kProcessingEco);
+    settings.saturationFactor = (quality == kProcessingEco) ? 1 : (quality == kProcessingHigh) ? 8 : 4;
+    settings.gainComputerInterval = (quality == kProcessingEco) ? QualityGovernor::kControlRateInterval : 1;
+    settings.analyzerHopScale = (quality == kProcessingEco) ? 2 : 1;
+    settings.extendedLookahead = (quality == kProcessingHigh);
+
+    // Overload tiers only ever take quality away; the lookahead stays (it sets the reported latency)
+    if (tier >= kQualityAnalyzerPaused) settings.analyzerHopScale = 0;
+    if (tier >= kQualityNoOversampling) settings.saturationFactor = 1;
+    if (tier >= kQualityControlRate) settings.gainComputerInterval = QualityGovernor::kControlRateInterval;
+    return settings;
+}
+
+} // namespace ELC4L
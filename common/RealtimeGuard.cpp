@@ -0,0 +1,287 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Realtime Safety Guard Implementation
+// Replaces the global operator new/delete of the plugin binary so every allocation made while the
+// audio thread marker is set is reported with the caller's address (resolved to a symbol when the
+// report is printed). Empty unless ELC4L_RT_GUARD=1.
+//-------------------------------------------------------------------------------------------------------
+
+#include "RealtimeGuard.h"
+
+#if ELC4L_RT_GUARD
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace ELC4L {
+namespace rt {
+
+namespace {
+
+thread_local int audioDepth = 0;
+thread_local const char* audioScope = nullptr;
+thread_local bool inReport = false;     // guards against recursion while recording
+thread_local unsigned lastIndex = 0;    // Ring index of this thread's last site-named violation
+thread_local const char* lastSite = nullptr;
+
+constexpr int kMaxViolations = 256;
+
+struct Slot {
+    std::atomic<bool> ready{false};
+    ViolationKind kind;
+    const char* scope;
+    const char* site;
+    void* caller;
+    std::atomic<unsigned> repeats{0};
+};
+
+Slot ring[kMaxViolations];
+std::atomic<unsigned> writeIndex{0};
+std::atomic<unsigned> readIndex{0};
+std::atomic<unsigned> dropped{0};
+
+const char* kindName(ViolationKind kind) {
+    switch (kind) {
+        case kViolationAlloc:   return "heap allocation";
+        case kViolationFree:    return "heap free";
+        case kViolationLock:    return "lock acquisition";
+        case kViolationSyscall: return "system call";
+    }
+    return "violation";
+}
+
+void writeLine(const char* text) {
+#if defined(_WIN32)
+    OutputDebugStringA(text);
+#endif
+    fputs(text, stderr);
+}
+
+// Resolves a code address to "symbol+offset (module)"
+void describeCaller(void* caller, char* where, size_t size) {
+    if (caller) {
+#if defined(_WIN32)
+        HMODULE module = nullptr;
+        char moduleName[MAX_PATH] = "?";
+        if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                               (LPCSTR)caller, &module)) {
+            GetModuleFileNameA(module, moduleName, MAX_PATH);
+        }
+        snprintf(where, size, "%s+0x%llx", moduleName,
+                 (unsigned long long)((const char*)caller - (const char*)module));
+#else
+        Dl_info info;
+        if (dladdr(caller, &info) && info.dli_sname) {
+            snprintf(where, size, "%s+0x%lx (%s)", info.dli_sname,
+                     (unsigned long)((const char*)caller - (const char*)info.dli_saddr),
+                     info.dli_fname ? info.dli_fname : "?");
+        } else {
+            snprintf(where, size, "%p", caller);
+        }
+#endif
+    } else {
+        snprintf(where, size, "unknown site");
+    }
+}
+
+// Formats "<kind> in <scope> at <site> (called from <caller>)[ x<count>]"
+void printViolation(ViolationKind kind, const char* scope, const char* site, void* caller, unsigned repeats) {
+    char from[512];
+    describeCaller(caller, from, sizeof(from));
+
+    char where[640];
+    if (site && caller) snprintf(where, sizeof(where), "%s (called from %s)", site, from);
+    else if (site) snprintf(where, sizeof(where), "%s", site);
+    else snprintf(where, sizeof(where), "%s", from);
+
+    char count[32] = "";
+    if (repeats > 0) snprintf(count, sizeof(count), " x%u", repeats + 1);
+
+    char line[896];
+    snprintf(line, sizeof(line), "ELC4L RT: %s in %s at %s%s\n",
+             kindName(kind), scope ? scope : "audio thread", where, count);
+    writeLine(line);
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------
+void enterAudioThread(const char* scope) {
+    if (audioDepth++ == 0) audioScope = scope;
+}
+
+void leaveAudioThread() {
+    if (--audioDepth == 0) audioScope = nullptr;
+}
+
+bool isAudioThread() {
+    return audioDepth > 0 && !inReport;
+}
+
+//-------------------------------------------------------------------------------------------------------
+void reportViolation(ViolationKind kind, const char* site, void* caller) {
+    inReport = true;
+
+#if ELC4L_RT_GUARD_TRAP
+    printViolation(kind, audioScope, site, caller, 0);
+    std::abort();
+#else
+    // A site hit every block (a lock per process call) takes one slot, not the ring
+    if (site && site == lastSite) {
+        Slot& last = ring[lastIndex % kMaxViolations];
+        if (last.ready.load(std::memory_order_acquire) && last.site == site && last.kind == kind) {
+            last.repeats.fetch_add(1, std::memory_order_relaxed);
+            inReport = false;
+            return;
+        }
+    }
+
+    unsigned index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    if (index - readIndex.load(std::memory_order_acquire) >= (unsigned)kMaxViolations) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        Slot& slot = ring[index % kMaxViolations];
+        slot.kind = kind;
+        slot.scope = audioScope;
+        slot.site = site;
+        slot.caller = caller;
+        slot.repeats.store(0, std::memory_order_relaxed);
+        slot.ready.store(true, std::memory_order_release);
+        lastIndex = index;
+        lastSite = site;
+    }
+#endif
+
+    inReport = false;
+}
+
+//-------------------------------------------------------------------------------------------------------
+void flushReport() {
+    unsigned index = readIndex.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring[index % kMaxViolations];
+        if (!slot.ready.load(std::memory_order_acquire)) break;
+
+        printViolation(slot.kind, slot.scope, slot.site, slot.caller,
+                       slot.repeats.load(std::memory_order_relaxed));
+        slot.ready.store(false, std::memory_order_relaxed);
+        readIndex.store(++index, std::memory_order_release);
+    }
+
+    unsigned lost = dropped.exchange(0, std::memory_order_relaxed);
+    if (lost > 0) {
+        char line[96];
+        snprintf(line, sizeof(line), "ELC4L RT: %u further violations dropped (ring full)\n", lost);
+        writeLine(line);
+    }
+}
+
+} // namespace rt
+} // namespace ELC4L
+
+//-------------------------------------------------------------------------------------------------------
+// Global allocation hooks
+// On ELF platforms the plugin is linked with -Bsymbolic when the guard is enabled so its own calls
+// bind to these definitions instead of the host's operator new.
+//-------------------------------------------------------------------------------------------------------
+namespace {
+
+inline void checkAlloc(void* caller) {
+    if (ELC4L::rt::isAudioThread()) ELC4L::rt::reportViolation(ELC4L::rt::kViolationAlloc, nullptr, caller);
+}
+
+inline void checkFree(void* ptr, void* caller) {
+    if (ptr && ELC4L::rt::isAudioThread()) ELC4L::rt::reportViolation(ELC4L::rt::kViolationFree, nullptr, caller);
+}
+
+inline void* allocAligned(std::size_t size, std::size_t align) {
+    if (size == 0) size = 1;
+#if defined(_WIN32)
+    return _aligned_malloc(size, align);
+#else
+    void* ptr = nullptr;
+    if (align < sizeof(void*)) align = sizeof(void*);
+    return (posix_memalign(&ptr, align, size) == 0) ? ptr : nullptr;
+#endif
+}
+
+inline void freeAligned(void* ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    checkAlloc(ELC4L_RT_CALLER());
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    checkAlloc(ELC4L_RT_CALLER());
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    checkAlloc(ELC4L_RT_CALLER());
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    checkAlloc(ELC4L_RT_CALLER());
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    checkAlloc(ELC4L_RT_CALLER());
+    void* ptr = allocAligned(size, static_cast<std::size_t>(align));
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    checkAlloc(ELC4L_RT_CALLER());
+    void* ptr = allocAligned(size, static_cast<std::size_t>(align));
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    checkAlloc(ELC4L_RT_CALLER());
+    return allocAligned(size, static_cast<std::size_t>(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    checkAlloc(ELC4L_RT_CALLER());
+    return allocAligned(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); std::free(ptr); }
+void operator delete[](void* ptr) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); freeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); freeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); freeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); freeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); freeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkFree(ptr, ELC4L_RT_CALLER()); freeAligned(ptr); }
+
+#endif // ELC4L_RT_GUARD
@@ -0,0 +1,106 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Realtime Safety Guard (debug instrumentation, shared by VST2 / VST3 / JUCE)
+// Marks the audio thread inside processReplacing / process / processBlock and reports any heap
+// allocation, lock acquisition or system call made from it, naming the offending call site.
+// Locks are caught by CheckedMutex (the mutexes of SharedTables.h and LazyEditorState.h); system
+// calls by ELC4L_RT_CHECK_SYSCALL at the OS entry points of Telemetry.cpp and MemoryLock.cpp.
+//
+// Compiled in only when ELC4L_RT_GUARD=1 (CMake option ELC4L_ENABLE_RT_GUARD); otherwise every
+// macro below expands to nothing and RealtimeGuard.cpp is empty.
+//   ELC4L_RT_GUARD_TRAP=1 : print the report and abort at the first violation
+//   (default)             : record into a lock-free ring, printed by ELC4L_RT_REPORT()
+//                           from a non-audio thread (suspend / setActive(false) / releaseResources)
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <mutex>
+
+#ifndef ELC4L_RT_GUARD
+#define ELC4L_RT_GUARD 0
+#endif
+
+#ifndef ELC4L_RT_GUARD_TRAP
+#define ELC4L_RT_GUARD_TRAP 0
+#endif
+
+#if ELC4L_RT_GUARD
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define ELC4L_RT_CALLER() _ReturnAddress()
+#else
+#define ELC4L_RT_CALLER() __builtin_return_address(0)
+#endif
+
+namespace ELC4L {
+namespace rt {
+
+enum ViolationKind {
+    kViolationAlloc = 0,    // operator new on the audio thread
+    kViolationFree,         // operator delete on the audio thread
+    kViolationLock,         // blocking lock on the audio thread
+    kViolationSyscall       // file / console / OS call on the audio thread
+};
+
+// Audio thread marker (nestable, thread_local)
+void enterAudioThread(const char* scope);
+void leaveAudioThread();
+bool isAudioThread();
+
+// 'site' names explicit checks (locks/syscalls); 'caller' is the return address of the function
+// that allocated, locked or made the call. Repeats of one site on a thread are counted, not queued.
+void reportViolation(ViolationKind kind, const char* site, void* caller);
+
+// Print and clear the recorded violations (never call from the audio thread)
+void flushReport();
+
+struct ScopedAudioThread {
+    explicit ScopedAudioThread(const char* scope) { enterAudioThread(scope); }
+    ~ScopedAudioThread() { leaveAudioThread(); }
+
+    ScopedAudioThread(const ScopedAudioThread&) = delete;
+    ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+};
+
+// std::mutex replacement for any state shared with the audio thread: a blocking lock() taken on
+// the audio thread is reported under the mutex's name with the caller, try_lock() is allowed
+class CheckedMutex {
+public:
+    explicit CheckedMutex(const char* name = "CheckedMutex") : name(name) {}
+
+    void lock() {
+        if (isAudioThread()) reportViolation(kViolationLock, name, ELC4L_RT_CALLER());
+        mutex.lock();
+    }
+    bool try_lock() { return mutex.try_lock(); }
+    void unlock() { mutex.unlock(); }
+
+private:
+    const char* name;
+    std::mutex mutex;
+};
+
+} // namespace rt
+} // namespace ELC4L
+
+#define ELC4L_RT_SCOPE(name)        ELC4L::rt::ScopedAudioThread elc4lRtScope_(name)
+#define ELC4L_RT_CHECK_SYSCALL(site) do { if (ELC4L::rt::isAudioThread()) ELC4L::rt::reportViolation(ELC4L::rt::kViolationSyscall, site, ELC4L_RT_CALLER()); } while (0)
+#define ELC4L_RT_REPORT()           ELC4L::rt::flushReport()
+
+#else
+
+namespace ELC4L {
+namespace rt {
+class CheckedMutex : public std::mutex {
+public:
+    explicit CheckedMutex(const char* = nullptr) {}
+};
+} // namespace rt
+} // namespace ELC4L
+
+#define ELC4L_RT_SCOPE(name)        ((void)0)
+#define ELC4L_RT_CHECK_SYSCALL(site) ((void)0)
+#define ELC4L_RT_REPORT()           ((void)0)
+
+#endif // ELC4L_RT_GUARD
@@ -0,0 +1,226 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Process-wide shared read-only tables (shared by VST2 / JUCE and the tools)
+// The spectrum analyzer's window, FFT twiddles and bit-reversal permutation, and its log-frequency bin
+// map per sample rate, are identical for every instance in a host process. SharedTable<T> hands out
+// one immutable copy per key: built by the first acquire, reference-counted by its holders and freed
+// with the last one, so dozens of instances build the tables once and keep a single copy in cache.
+//
+// acquire() takes a mutex and allocates: call it from constructors / prepare / setSampleRate, never
+// from the audio thread (the RT guard reports the registry lock if it is). Reading a table through
+// the returned pointer is lock-free.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "RealtimeGuard.h"
+
+namespace ELC4L {
+
+template <typename Table>
+class SharedTable {
+public:
+    using Key = typename Table::Key;
+
+    static std::shared_ptr<const Table> acquire(const Key& key) {
+        Registry& registry = getRegistry();
+        std::lock_guard<rt::CheckedMutex> lock(registry.mutex);
+        for (auto it = registry.tables.begin(); it != registry.tables.end();) {
+            if (it->second.expired()) it = registry.tables.erase(it);
+            else ++it;
+        }
+        std::weak_ptr<const Table>& slot = registry.tables[key];
+        std::shared_ptr<const Table> table = slot.lock();
+        if (!table) {
+            // Not make_shared: the registry's weak_ptr would keep the table's memory alive with the
+            // control block until the next acquire prunes the entry
+            table = std::shared_ptr<const Table>(new Table(key));
+            slot = table;
+        }
+        return table;
+    }
+
+    // Tables of this type currently alive in the process (diagnostics / tools)
+    static int getNumLive() {
+        Registry& registry = getRegistry();
+        std::lock_guard<rt::CheckedMutex> lock(registry.mutex);
+        int live = 0;
+        for (const auto& entry : registry.tables) live += entry.second.expired() ? 0 : 1;
+        return live;
+    }
+
+private:
+    struct Registry {
+        rt::CheckedMutex mutex { "SharedTable registry mutex" };
+        std::map<Key, std::weak_ptr<const Table>> tables;
+    };
+
+    static Registry& getRegistry() {
+        static Registry registry;
+        return registry;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// Radix-2 FFT tables: Blackman-Harris window, bit-reversal permutation and, per butterfly stage, the
+// twiddle sequence the stage's rotation recurrence produces (so table and recurrence agree bit for bit)
+//-------------------------------------------------------------------------------------------------------
+struct FftTables {
+    using Key = int;                    // FFT size (power of two)
+
+    int size;
+    float windowNormalization;          // size / sum(window): scales the window to unit mean gain
+    std::vector<float> window;
+    std::vector<int> bitReverse;
+    std::vector<float> twiddleRe;       // Stage with half-length h reads [h, 2h)
+    std::vector<float> twiddleIm;
+
+    explicit FftTables(int fftSize)
+        : size(fftSize), window(fftSize), bitReverse(fftSize), twiddleRe(fftSize), twiddleIm(fftSize) {
+        // Blackman-Harris Window (better sidelobe rejection than Hann)
+        const float a0 = 0.35875f;
+        const float a1 = 0.48829f;
+        const float a2 = 0.14128f;
+        const float a3 = 0.01168f;
+        const float pi = 3.14159265359f;
+        double windowSum = 0.0;
+        for (int i = 0; i < size; ++i) {
+            float t = (float)i / (float)(size - 1);
+            window[i] = a0 - a1 * cosf(2.0f * pi * t) + a2 * cosf(4.0f * pi * t) - a3 * cosf(6.0f * pi * t);
+            windowSum += window[i];
+        }
+        windowNormalization = (windowSum > 0.0) ? (float)(size / windowSum) : 1.0f;
+
+        int levels = 0;
+        while ((1 << levels) < size) levels++;
+        for (int i = 0; i < size; ++i) {
+            int rev = 0, val = i;
+            for (int j = 0; j < levels; ++j) {
+                rev = (rev << 1) | (val & 1);
+                val >>= 1;
+            }
+            bitReverse[i] = rev;
+        }
+
+        twiddleRe[0] = 1.0f;
+        twiddleIm[0] = 0.0f;
+        for (int half = 1; half < size; half <<= 1) {
+            float ang = -2.0f * pi / (2 * half);
+            float wlenR = cosf(ang);
+            float wlenI = sinf(ang);
+            float wR = 1.0f, wI = 0.0f;
+            for (int j = 0; j < half; ++j) {
+                twiddleRe[half + j] = wR;
+                twiddleIm[half + j] = wI;
+                float tmpW = wR * wlenR - wI * wlenI;
+                wI = wR * wlenI + wI * wlenR;
+                wR = tmpW;
+            }
+        }
+    }
+};
+
+// In-place Cooley-Tukey FFT of tables.size points
+inline void performFft(const FftTables& tables, float* re, float* im) {
+    const int n = tables.size;
+    const int* bitReverse = tables.bitReverse.data();
+    for (int i = 0; i < n; ++i) {
+        const int j = bitReverse[i];
+        if (i < j) {
+            float tmpR = re[i];
+            float tmpI = im[i];
+            re[i] = re[j];
+            im[i] = im[j];
+            re[j] = tmpR;
+            im[j] = tmpI;
+        }
+    }
+
+    for (int half = 1; half < n; half <<= 1) {
+        const float* wRe = &tables.twiddleRe[half];
+        const float* wIm = &tables.twiddleIm[half];
+        for (int i = 0; i < n; i += 2 * half) {
+            for (int j = 0; j < half; ++j) {
+                const float wR = wRe[j];
+                const float wI = wIm[j];
+                float uR = re[i + j];
+                float uI = im[i + j];
+                float vR = re[i + j + half] * wR - im[i + j + half] * wI;
+                float vI = re[i + j + half] * wI + im[i + j + half] * wR;
+
+                re[i + j] = uR + vR;
+                im[i + j] = uI + vI;
+                re[i + j + half] = uR - vR;
+                im[i + j + half] = uI - vI;
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Log-frequency display bins (20 Hz - 20 kHz) for one sample rate: the FFT bins each display bin
+// averages, the pink-noise tilt (+3 dB/octave around 1 kHz) and the asymmetric smoothing coefficients.
+// Fixed capacity, so an unprepared rate can build one on the stack.
+//-------------------------------------------------------------------------------------------------------
+struct SpectrumBinMap {
+    using Key = std::tuple<float, int, int>;    // Sample rate, FFT size, display bins
+    static constexpr int kMaxBins = 512;
+
+    struct Bin {
+        int first;          // FFT bins [first, first + count) are averaged
+        int count;
+        float tiltDb;
+        float attackCoeff;
+        float releaseCoeff;
+    };
+
+    float sampleRate;
+    int fftSize;
+    int numBins;
+    Bin bins[kMaxBins];
+
+    explicit SpectrumBinMap(const Key& key)
+        : sampleRate(std::get<0>(key)), fftSize(std::get<1>(key)), numBins(std::get<2>(key)) {
+        if (numBins > kMaxBins) numBins = kMaxBins;
+        const float sr = (sampleRate > 0.0f) ? sampleRate : 44100.0f;
+        const float minLogFreq = log10f(20.0f);
+        const float maxLogFreq = log10f(20000.0f);
+        const float logRange = maxLogFreq - minLogFreq;
+
+        for (int bin = 0; bin < numBins; ++bin) {
+            // Map display bin to frequency (logarithmic scale for better low-end resolution)
+            float t = (float)bin / (float)(numBins - 1);
+            float logFreq = minLogFreq + t * logRange;
+            float freq = powf(10.0f, logFreq);
+
+            int fftBin = (int)(freq * fftSize / sr);
+            if (fftBin < 1) fftBin = 1;
+            if (fftBin >= fftSize / 2) fftBin = fftSize / 2 - 1;
+
+            // Spread: narrow at low freq, wider at high freq for noise reduction
+            int spread = (fftBin < 30) ? 1 : (fftBin < 100 ? 2 : (fftBin < 400 ? 3 : 4));
+            int first = fftBin - spread;
+            int last = fftBin + spread;
+            if (first < 1) first = 1;
+            if (last > fftSize / 2 - 1) last = fftSize / 2 - 1;
+
+            Bin& b = bins[bin];
+            b.first = first;
+            b.count = last - first + 1;
+            b.tiltDb = (freq > 20.0f) ? 3.0f * log2f(freq / 1000.0f) : 0.0f;
+            b.attackCoeff = (freq > 4000.0f) ? 0.50f : 0.35f;
+            b.releaseCoeff = (freq > 4000.0f) ? 0.88f : 0.92f;
+        }
+    }
+
+    bool matches(float rate, int size, int bins) const {
+        return sampleRate == rate && fftSize == size && numBins == bins;
+    }
+};
+
+} // namespace ELC4L
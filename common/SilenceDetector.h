@@ -0,0 +1,37 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Silence detection helpers (shared by VST2 / VST3 / JUCE)
+// A wrapper keeps running the DSP after its input goes silent until every module reports isIdle(),
+// then skips processing entirely (zero output + silence flags) until signal returns.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+
+namespace ELC4L {
+
+constexpr float kSilenceInputThreshold = 1.0e-8f;   // ~-160 dBFS: treated as digital zero
+constexpr float kSilenceStateThreshold = 1.0e-6f;   // ~-120 dBFS: residual filter/delay state
+
+// True when every sample of both channels is below 'threshold'
+inline bool isBlockSilent(const float* left, const float* right, int numSamples, float threshold) {
+    float peak = 0.0f;
+    for (int i = 0; i < numSamples; ++i) {
+        float a = std::fabs(left[i]);
+        float b = std::fabs(right[i]);
+        peak = (a > peak) ? a : peak;
+        peak = (b > peak) ? b : peak;
+    }
+    return peak < threshold;
+}
+
+// Peak of a state buffer (limiter delay line, oversampler taps)
+inline float bufferPeak(const float* data, int size) {
+    float peak = 0.0f;
+    for (int i = 0; i < size; ++i) {
+        float a = std::fabs(data[i]);
+        peak = (a > peak) ? a : peak;
+    }
+    return peak;
+}
+
+} // namespace ELC4L
@@ -0,0 +1,302 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Per-stage CPU profiler (shared by VST2 / VST3 / JUCE)
+// Answers "which part of ELC4L is expensive on this machine": the process call is split into
+// crossover, band compressors, saturation, limiter, metering and analyzer, and every block's cost per
+// stage is aggregated into min / avg / max / p99 over a ~0.5 s window that the editor can read.
+//
+// Always compiled in, off by default; setEnabled() switches it at runtime (the editors enable it while
+// their hidden diagnostics overlay is shown). Cost model, with steady_clock as the time base:
+//   - the whole process call is timed exactly (two clock reads per block)
+//   - the wrappers run the chain in short chunks, stage by stage; one chunk in every kSampleInterval
+//     samples is timed and scaled to the block (every other chunk with VST2's 32-sample chunks), so
+//     the overhead is a few predictable branches per chunk plus the laps of a timed chunk: 13 clock
+//     reads in VST2 (beginChunk, crossover, 4 x compressors + saturation, band mix, limiter, metering),
+//     about 0.2 reads per sample. With a ~45 ns steady_clock that is 2-3% of the chain at 48 kHz
+//     (elc4l_module_bench: chain-prof against chain, which runs the same chain with the profiler off)
+//   - rare per-hop work (the analyzer FFT) is timed exactly with beginExact / endExact
+// Disabled, the audio thread pays one relaxed atomic load per block and the untaken branches.
+//
+// Publication is a seqlock over relaxed atomic words: the audio thread never waits, a reader retries
+// if it raced a publication. Audio thread: beginBlock / beginChunk / lap / beginExact / endExact /
+// endBlock. Any thread: setEnabled / read.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace ELC4L {
+
+enum ProfileStage {
+    kStageCrossover = 0,
+    kStageCompressors,      // Detector, envelopes and gain computer of the band compressors (+ band mix)
+    kStageSaturation,       // Oversampled tape saturation inside the band compressors
+    kStageLimiter,
+    kStageMetering,         // LUFS, level and GR meters
+    kStageAnalyzer,         // Spectrum analyzer buffers and FFT
+    kNumProfileStages
+};
+
+inline const char* getProfileStageName(int stage) {
+    static const char* const names[kNumProfileStages] = {
+        "Crossover", "Compressors", "Saturation", "Limiter", "Metering", "Analyzer"
+    };
+    return (stage >= 0 && stage < kNumProfileStages) ? names[stage] : "?";
+}
+
+// Per-block cost of one series over the published window (microseconds)
+struct StageStats {
+    float minUs;
+    float avgUs;
+    float maxUs;
+    float p99Us;
+};
+
+struct StageProfileSnapshot {
+    StageStats stages[kNumProfileStages];
+    StageStats block;           // Whole process call (measured exactly)
+    float blockBudgetUs;        // Mean audio duration of a block in the window
+    float loadPercent;          // Process time / audio time over the window
+    uint32_t numBlocks;         // Blocks in the window
+    uint32_t generation;        // Incremented by every publication (0: nothing published yet)
+};
+
+class StageProfiler {
+public:
+    static constexpr int kSampleInterval = 64;
+
+    StageProfiler() {
+        for (int i = 0; i < kNumWords; ++i) publishedWords[i].store(0, std::memory_order_relaxed);
+        resetWindow();
+    }
+
+    // Any thread
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Call from prepare / setSampleRate (not concurrently with processing)
+    void prepare(double newSampleRate) {
+        sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
+        windowLength = (int64_t)(sampleRate * 0.5);
+        clockOverheadNs = measureClockOverhead();
+        resetWindow();
+    }
+
+    //---------------------------------------------------------------------------------------------------
+    // Audio thread
+    //---------------------------------------------------------------------------------------------------
+    void beginBlock() {
+        const bool nowActive = enabled.load(std::memory_order_relaxed);
+        if (nowActive != active) {
+            active = nowActive;
+            resetWindow();
+        }
+        sampling = false;
+        if (!active) return;
+
+        for (int s = 0; s < kNumProfileStages; ++s) {
+            sampledNs[s] = 0;
+            exactNs[s] = 0;
+        }
+        sampledCount = 0;
+        blockStart = now();
+    }
+
+    // At the top of each chunk: about one chunk per kSampleInterval samples is timed stage by stage
+    void beginChunk(int numSamples) {
+        if (!active) return;
+        countdown -= numSamples;
+        if (countdown > 0) {
+            sampling = false;
+            return;
+        }
+        countdown = kSampleInterval;
+        sampling = true;
+        sampledCount += numSamples;
+        lapStart = now();
+    }
+
+    // Charges the time since the previous lap (or beginChunk) to 'stage' on sampled chunks; the
+    // cost of the clock read itself is taken out, since the scaling would multiply it by kSampleInterval
+    void lap(int stage) {
+        if (!sampling) return;
+        const int64_t t = now();
+        const int64_t elapsed = t - lapStart - clockOverheadNs;
+        if (elapsed > 0) sampledNs[stage] += elapsed;
+        lapStart = t;
+    }
+
+    // Exact timing for rare work inside the sample loop; excluded from the surrounding lap
+    int64_t beginExact() const { return active ? now() : 0; }
+    void endExact(int stage, int64_t startNs) {
+        if (!active) return;
+        const int64_t elapsed = now() - startNs;
+        exactNs[stage] += elapsed;
+        if (sampling) lapStart += elapsed;
+    }
+
+    void endBlock(int numSamples) {
+        if (!active || numSamples <= 0) return;
+        sampling = false;
+        const int64_t totalNs = now() - blockStart;
+
+        const double scale = (sampledCount > 0) ? (double)numSamples / (double)sampledCount : 0.0;
+        for (int s = 0; s < kNumProfileStages; ++s) {
+            window[s].add((double)sampledNs[s] * scale + (double)exactNs[s]);
+        }
+        window[kNumProfileStages].add((double)totalNs);
+
+        windowSamples += numSamples;
+        windowBlocks++;
+        windowProcessNs += (double)totalNs;
+        if (windowSamples >= windowLength) {
+            publish();
+            resetWindow();
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------------
+    // Any thread: latest published window; false if none yet or a publication kept racing the read
+    //---------------------------------------------------------------------------------------------------
+    bool read(StageProfileSnapshot& snapshot) const {
+        uint32_t words[kNumWords];
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            const uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            for (int i = 0; i < kNumWords; ++i) words[i] = publishedWords[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != before) continue;
+
+            memcpy(&snapshot, words, sizeof(snapshot));
+            return snapshot.generation != 0;
+        }
+        return false;
+    }
+
+private:
+    static constexpr int kNumSeries = kNumProfileStages + 1;    // Stages + whole block
+    static constexpr int kNumBuckets = 64;                      // 4 per octave from 250 ns (~16 ms top)
+    static constexpr int kNumWords = (int)(sizeof(StageProfileSnapshot) / sizeof(uint32_t));
+    static_assert(sizeof(StageProfileSnapshot) % sizeof(uint32_t) == 0, "snapshot must be whole words");
+
+    struct Series {
+        double minNs, maxNs, sumNs;
+        uint32_t count;
+        uint32_t histogram[kNumBuckets];
+
+        void reset() {
+            minNs = 1.0e300;
+            maxNs = 0.0;
+            sumNs = 0.0;
+            count = 0;
+            memset(histogram, 0, sizeof(histogram));
+        }
+
+        void add(double ns) {
+            if (ns < minNs) minNs = ns;
+            if (ns > maxNs) maxNs = ns;
+            sumNs += ns;
+            count++;
+            int bucket = 0;
+            if (ns > 250.0) {
+                bucket = 1 + (int)(4.0f * log2f((float)(ns / 250.0)));
+                if (bucket >= kNumBuckets) bucket = kNumBuckets - 1;
+            }
+            histogram[bucket]++;
+        }
+
+        StageStats toStats() const {
+            StageStats stats = { 0.0f, 0.0f, 0.0f, 0.0f };
+            if (count == 0) return stats;
+            stats.minUs = (float)(minNs * 1.0e-3);
+            stats.avgUs = (float)(sumNs / count * 1.0e-3);
+            stats.maxUs = (float)(maxNs * 1.0e-3);
+
+            // Upper edge of the bucket holding the 99th percentile, capped at the observed maximum
+            const uint32_t target = count - count / 100;
+            uint32_t cumulative = 0;
+            int bucket = 0;
+            for (; bucket < kNumBuckets - 1; ++bucket) {
+                cumulative += histogram[bucket];
+                if (cumulative >= target) break;
+            }
+            const double upperNs = 250.0 * exp2((double)bucket / 4.0);
+            stats.p99Us = (float)((upperNs < maxNs ? upperNs : maxNs) * 1.0e-3);
+            return stats;
+        }
+    };
+
+    static int64_t now() {
+        return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Cheapest of a few back-to-back clock reads (tens of ns with a vDSO clock)
+    static int64_t measureClockOverhead() {
+        int64_t best = INT64_MAX;
+        int64_t previous = now();
+        for (int i = 0; i < 64; ++i) {
+            const int64_t t = now();
+            if (t - previous < best) best = t - previous;
+            previous = t;
+        }
+        return best;
+    }
+
+    void resetWindow() {
+        for (int s = 0; s < kNumSeries; ++s) window[s].reset();
+        windowSamples = 0;
+        windowBlocks = 0;
+        windowProcessNs = 0.0;
+    }
+
+    void publish() {
+        StageProfileSnapshot snapshot;
+        for (int s = 0; s < kNumProfileStages; ++s) snapshot.stages[s] = window[s].toStats();
+        snapshot.block = window[kNumProfileStages].toStats();
+        const double audioNs = (double)windowSamples * 1.0e9 / sampleRate;
+        snapshot.blockBudgetUs = (float)(audioNs / windowBlocks * 1.0e-3);
+        snapshot.loadPercent = (float)(100.0 * windowProcessNs / audioNs);
+        snapshot.numBlocks = windowBlocks;
+        snapshot.generation = ++generation;
+
+        uint32_t words[kNumWords];
+        memcpy(words, &snapshot, sizeof(snapshot));
+
+        const uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < kNumWords; ++i) publishedWords[i].store(words[i], std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    std::atomic<bool> enabled { false };
+
+    // Audio thread state
+    double sampleRate = 44100.0;
+    int64_t windowLength = 22050;
+    int64_t clockOverheadNs = 0;
+    bool active = false;
+    bool sampling = false;
+    int countdown = 1;
+    int64_t blockStart = 0;
+    int64_t lapStart = 0;
+    int64_t sampledNs[kNumProfileStages] = {};
+    int64_t exactNs[kNumProfileStages] = {};
+    int sampledCount = 0;           // Samples in the timed chunks of the current block
+
+    Series window[kNumSeries];
+    int64_t windowSamples = 0;
+    uint32_t windowBlocks = 0;
+    double windowProcessNs = 0.0;
+    uint32_t generation = 0;
+
+    // Published window
+    std::atomic<uint32_t> sequence { 0 };
+    std::atomic<uint32_t> publishedWords[kNumWords];
+};
+
+} // namespace ELC4L
@@ -0,0 +1,60 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Cache-line-aligned DSP state arena (shared by VST2 / JUCE and the tools)
+// The per-sample state of a processor (crossover, band compressors, limiter, loudness meter) used to
+// sit between parameter caches, flags and the meters the editor polls, so the audio thread's writes
+// shared cache lines with data another thread reads. StateArena<State> holds the whole State in one
+// allocation aligned to kCacheLineSize; State lists its stages in processing order, each declared
+// alignas(kCacheLineSize) so it starts on a line of its own, and the UI-visible meters come last on
+// their own line(s).
+//
+// The block is aligned by hand instead of with C++17 over-aligned new, which the macOS 10.13
+// deployment target does not provide. The owner allocates it once, in its constructor: parameter
+// setters and editor getters reach the stages before the host prepares the instance.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace ELC4L {
+
+constexpr size_t kCacheLineSize = 64;
+
+template <typename State>
+class StateArena {
+public:
+    static_assert(alignof(State) <= kCacheLineSize, "StateArena aligns to one cache line");
+
+    StateArena() : block(::operator new(sizeof(State) + kCacheLineSize - 1)) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block);
+        void* aligned = reinterpret_cast<void*>((address + kCacheLineSize - 1) & ~(uintptr_t)(kCacheLineSize - 1));
+        try {
+            state = new (aligned) State();
+        } catch (...) {
+            ::operator delete(block);
+            throw;
+        }
+    }
+
+    ~StateArena() {
+        state->~State();
+        ::operator delete(block);
+    }
+
+    StateArena(const StateArena&) = delete;
+    StateArena& operator=(const StateArena&) = delete;
+
+    State& operator*() const { return *state; }
+    State* operator->() const { return state; }
+
+    // The arena's memory: sizeof(State) bytes from a cache-line boundary
+    void* data() const { return state; }
+    static constexpr size_t size() { return sizeof(State); }
+
+private:
+    void* block;                // As allocated
+    State* state = nullptr;     // First cache line boundary in the block
+};
+
+} // namespace ELC4L
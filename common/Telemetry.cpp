@@ -0,0 +1,149 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Shared-memory telemetry: segment mapping and slot claiming (POSIX; closed on Windows)
+//-------------------------------------------------------------------------------------------------------
+#include "Telemetry.h"
+#include "RealtimeGuard.h"
+
+#include <cstdlib>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace ELC4L {
+
+#if !defined(_WIN32)
+
+TelemetrySegment* mapTelemetrySegment(const char* name, bool writable) {
+    ELC4L_RT_CHECK_SYSCALL("mapTelemetrySegment (shm_open/mmap)");
+    if (!name || name[0] != '/') return nullptr;
+
+    const int fd = writable ? shm_open(name, O_RDWR | O_CREAT, 0666) : shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return nullptr;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    if ((size_t)info.st_size < sizeof(TelemetrySegment)) {
+        // A fresh segment is zero-filled by ftruncate; a reader waits for the first publisher
+        if (!writable || ftruncate(fd, (off_t)sizeof(TelemetrySegment)) != 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        fchmod(fd, 0666);   // Readable by the monitoring user regardless of the host's umask
+    }
+
+    void* memory = mmap(nullptr, sizeof(TelemetrySegment), writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                        MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) return nullptr;
+
+    TelemetrySegment* segment = static_cast<TelemetrySegment*>(memory);
+    uint32_t magic = segment->magic.load(std::memory_order_acquire);
+    if (magic == 0 && writable) {
+        // Every opener writes the same constant header; the magic is published last
+        segment->version = kTelemetryVersion;
+        segment->numSlots = kTelemetryNumSlots;
+        segment->slotSize = (uint32_t)sizeof(TelemetrySlot);
+        segment->magic.compare_exchange_strong(magic, kTelemetryMagic, std::memory_order_release,
+                                               std::memory_order_acquire);
+        magic = kTelemetryMagic;
+    }
+    if (magic != kTelemetryMagic || segment->version != kTelemetryVersion
+        || segment->numSlots != kTelemetryNumSlots || segment->slotSize != sizeof(TelemetrySlot)) {
+        munmap(memory, sizeof(TelemetrySegment));
+        return nullptr;
+    }
+    return segment;
+}
+
+void unmapTelemetrySegment(TelemetrySegment* segment) {
+    if (!segment) return;
+    ELC4L_RT_CHECK_SYSCALL("unmapTelemetrySegment (munmap)");
+    munmap(segment, sizeof(TelemetrySegment));
+}
+
+bool isTelemetryOwnerAlive(uint32_t pid) {
+    if (pid == 0) return false;
+    ELC4L_RT_CHECK_SYSCALL("isTelemetryOwnerAlive (kill)");
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+}
+
+// Read twice per published block on the audio thread. Not an RT guard site: like the steady_clock
+// reads of QualityGovernor and StageProfiler it is a vDSO read on Linux and never enters the kernel.
+void getTelemetryClock(uint32_t& sec, uint32_t& nsec) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    sec = (uint32_t)ts.tv_sec;
+    nsec = (uint32_t)ts.tv_nsec;
+}
+
+bool TelemetryPublisher::open(TelemetryWrapper wrapper) {
+    close();
+    const char* name = getTelemetryNameFromEnvironment();
+    if (!name) return false;
+
+    segment = mapTelemetrySegment(name, true);
+    if (!segment) return false;
+
+    // Claim a free slot, or one whose owner process has died
+    const uint32_t pid = (uint32_t)getpid();
+    for (int s = 0; s < kTelemetryNumSlots && !slot; ++s) {
+        TelemetrySlot& candidate = segment->slots[s];
+        uint32_t owner = candidate.ownerPid.load(std::memory_order_relaxed);
+        if (owner != 0 && (owner == pid || isTelemetryOwnerAlive(owner))) continue;
+        if (candidate.ownerPid.compare_exchange_strong(owner, pid, std::memory_order_acq_rel)) {
+            slot = &candidate;
+        }
+    }
+    if (!slot) {
+        unmapTelemetrySegment(segment);
+        segment = nullptr;
+        return false;
+    }
+
+    static std::atomic<uint32_t> nextInstanceId { 1 };
+    record = TelemetryRecord();
+    record.instanceId = nextInstanceId.fetch_add(1, std::memory_order_relaxed);
+    record.wrapper = wrapper;
+    overCount = 0;
+    peakWindowStart = 0;
+    publishRecord();    // Replace whatever a previous owner left in the slot
+    return true;
+}
+
+void TelemetryPublisher::close() {
+    if (slot) {
+        slot->ownerPid.store(0, std::memory_order_release);
+        slot = nullptr;
+    }
+    unmapTelemetrySegment(segment);
+    segment = nullptr;
+}
+
+#else
+
+TelemetrySegment* mapTelemetrySegment(const char*, bool) { return nullptr; }
+void unmapTelemetrySegment(TelemetrySegment*) {}
+bool isTelemetryOwnerAlive(uint32_t) { return false; }
+void getTelemetryClock(uint32_t& sec, uint32_t& nsec) { sec = 0; nsec = 0; }
+bool TelemetryPublisher::open(TelemetryWrapper) { return false; }
+void TelemetryPublisher::close() {}
+
+#endif
+
+const char* getTelemetryNameFromEnvironment() {
+    const char* value = getenv("ELC4L_TELEMETRY");
+    if (!value || value[0] == '\0' || (value[0] == '0' && value[1] == '\0')) return nullptr;
+    return (value[0] == '/') ? value : kTelemetryDefaultName;
+}
+
+} // namespace ELC4L
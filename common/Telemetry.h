@@ -0,0 +1,181 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - Shared-memory telemetry (shared by VST2 / VST3 / JUCE and tools/telemetry_main.cpp)
+// Lets a machine running many ELC4L instances be monitored without opening editors: each instance
+// claims a slot in one POSIX shared-memory segment and publishes a fixed-layout record per block
+// (sample rate, block size, DSP time vs block duration, GR per band, limiter GR, momentary LUFS,
+// overs). elc4l_telemetry tails every slot.
+//
+// Opt-in with the environment variable ELC4L_TELEMETRY: "1" uses the default segment name, a value
+// starting with '/' names the segment. Without it (and on Windows) the publisher stays closed and
+// the audio thread pays one branch per block.
+//
+// Publication is a per-slot seqlock over 32-bit atomic words: the writer bumps the sequence to odd,
+// stores the record words and bumps it back to even, so it is wait-free (a couple of dozen relaxed
+// stores and two clock reads per block). Readers copy the words and retry when the sequence changed.
+// Slots are claimed by CAS on the owner PID; slots of dead processes are reclaimed.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace ELC4L {
+
+constexpr const char* kTelemetryDefaultName = "/elc4l-telemetry";
+constexpr uint32_t kTelemetryMagic = 0x34434C45u;      // "ELC4" in memory order (little-endian)
+constexpr uint32_t kTelemetryVersion = 1;
+constexpr int kTelemetryNumSlots = 256;
+
+enum TelemetryWrapper : uint32_t {
+    kTelemetryWrapperVst2 = 1,
+    kTelemetryWrapperVst3 = 2,
+    kTelemetryWrapperJuce = 3
+};
+
+// One instance's record as published (28 words)
+struct TelemetryRecord {
+    uint32_t instanceId;        // Unique within the process; (ownerPid, instanceId) across the machine
+    uint32_t wrapper;           // TelemetryWrapper
+    float sampleRate;
+    uint32_t blockSize;         // Samples in the last block
+    float dspUs;                // Process time of the last block (microseconds)
+    float blockUs;              // Audio duration of the last block (microseconds)
+    float peakLoadPercent;      // Highest dspUs / blockUs over the current ~1 s window
+    float bandGrDb[4];
+    float limiterGrDb;
+    float lufsMomentary;
+    uint32_t overCount;         // Output samples at or above 0 dBFS since the instance opened
+    uint32_t blockCount;        // Blocks published since the instance opened
+    uint32_t updateSec;         // CLOCK_MONOTONIC of the last publication
+    uint32_t updateNsec;
+    uint32_t qualityTier;       // QualityTier the instance runs at (0: full quality)
+    uint32_t reserved[10];
+};
+
+constexpr int kTelemetryRecordWords = (int)(sizeof(TelemetryRecord) / sizeof(uint32_t));
+static_assert(sizeof(TelemetryRecord) % sizeof(uint32_t) == 0, "record must be whole words");
+
+// 128 bytes per slot: instances in one process never write the same cache line pair
+struct TelemetrySlot {
+    std::atomic<uint32_t> ownerPid;     // 0: free
+    std::atomic<uint32_t> sequence;     // Odd while a publication is in progress
+    std::atomic<uint32_t> words[kTelemetryRecordWords];
+    uint32_t padding[32 - 2 - kTelemetryRecordWords];
+};
+static_assert(sizeof(TelemetrySlot) == 128, "telemetry slot layout changed");
+
+struct TelemetrySegment {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t numSlots;
+    uint32_t slotSize;
+    uint32_t padding[28];
+    TelemetrySlot slots[kTelemetryNumSlots];
+};
+
+// Segment mapping (Telemetry.cpp); nullptr when unavailable. The writable mapping creates the
+// segment if needed. Never call from the audio thread.
+TelemetrySegment* mapTelemetrySegment(const char* name, bool writable);
+void unmapTelemetrySegment(TelemetrySegment* segment);
+const char* getTelemetryNameFromEnvironment();      // nullptr: telemetry not requested
+bool isTelemetryOwnerAlive(uint32_t pid);
+void getTelemetryClock(uint32_t& sec, uint32_t& nsec);
+
+// Seqlock read of one slot; false if the slot is free or a publication kept racing the read
+inline bool readTelemetrySlot(const TelemetrySlot& slot, uint32_t& ownerPid, TelemetryRecord& record) {
+    uint32_t words[kTelemetryRecordWords];
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1u) continue;
+        ownerPid = slot.ownerPid.load(std::memory_order_relaxed);
+        for (int i = 0; i < kTelemetryRecordWords; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) continue;
+
+        memcpy(&record, words, sizeof(record));
+        return ownerPid != 0;
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Per-instance publisher. open / close from the message thread (constructor, initialize, destructor);
+// beginBlock / endBlock from the audio thread.
+//-------------------------------------------------------------------------------------------------------
+class TelemetryPublisher {
+public:
+    TelemetryPublisher() = default;
+    ~TelemetryPublisher() { close(); }
+
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+    // Claims a slot if ELC4L_TELEMETRY is set; false when telemetry is off or unavailable
+    bool open(TelemetryWrapper wrapper);
+    void close();
+    bool isOpen() const { return slot != nullptr; }
+
+    // Audio thread: published with the next record
+    void setQualityTier(int tier) { record.qualityTier = (uint32_t)tier; }
+
+    // Audio thread: returns the block start time (0 when closed)
+    int64_t beginBlock() const { return slot ? now() : 0; }
+
+    // Audio thread: counts overs in the output and publishes the record
+    void endBlock(int64_t startNs, const float* outL, const float* outR, int numSamples, float sampleRate,
+                  const float* bandGrDb, float limiterGrDb, float lufsMomentary) {
+        if (!slot || numSamples <= 0) return;
+
+        for (int i = 0; i < numSamples; ++i) {
+            overCount += (uint32_t)(outL[i] >= 1.0f || outL[i] <= -1.0f);
+            overCount += (uint32_t)(outR[i] >= 1.0f || outR[i] <= -1.0f);
+        }
+
+        const int64_t endNs = now();
+        record.sampleRate = sampleRate;
+        record.blockSize = (uint32_t)numSamples;
+        record.dspUs = (float)((double)(endNs - startNs) * 1.0e-3);
+        record.blockUs = (sampleRate > 0.0f) ? (float)(1.0e6 * numSamples / sampleRate) : 0.0f;
+        const float load = (record.blockUs > 0.0f) ? 100.0f * record.dspUs / record.blockUs : 0.0f;
+        if (endNs - peakWindowStart > 1000000000) {
+            peakWindowStart = endNs;
+            record.peakLoadPercent = load;
+        } else if (load > record.peakLoadPercent) {
+            record.peakLoadPercent = load;
+        }
+        for (int b = 0; b < 4; ++b) record.bandGrDb[b] = bandGrDb[b];
+        record.limiterGrDb = limiterGrDb;
+        record.lufsMomentary = lufsMomentary;
+        record.overCount = overCount;
+        record.blockCount++;
+        record.updateSec = (uint32_t)(endNs / 1000000000);
+        record.updateNsec = (uint32_t)(endNs % 1000000000);
+        publishRecord();
+    }
+
+private:
+    void publishRecord() {
+        uint32_t words[kTelemetryRecordWords];
+        memcpy(words, &record, sizeof(record));
+        const uint32_t seq = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < kTelemetryRecordWords; ++i) slot->words[i].store(words[i], std::memory_order_relaxed);
+        slot->sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    static int64_t now() {
+        uint32_t sec, nsec;
+        getTelemetryClock(sec, nsec);
+        return (int64_t)sec * 1000000000 + nsec;
+    }
+
+    TelemetrySegment* segment = nullptr;
+    TelemetrySlot* slot = nullptr;
+    TelemetryRecord record {};
+    uint32_t overCount = 0;
+    int64_t peakWindowStart = 0;
+};
+
+} // namespace ELC4L
@@ -0,0 +1,1710 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L - DSP Core (VST2 signal chain)
+// SDK-free: included by HyeokStreamMaster and by the offline tools (tools/)
+//-------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "SilenceDetector.h"
+#include "DenormalGuard.h"
+#include "SharedTables.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+// ======================================================================
+// [NEW] HIGH-END DSP MODULES (Pure C++ / Zero Latency)
+// ======================================================================
+
+// 1. Tape Saturator (Algebraic Sigmoid)
+struct TapeSaturator {
+    // x / sqrt(1 + x^2) based soft clipper with bias
+    inline float process(float input, float drive, float bias) {
+        return process(input, drive, bias, biasOffset(bias));
+    }
+
+    // Same curve with the DC term computed once per block (biasOffset of the same bias)
+    inline float process(float input, float drive, float bias, float offset) {
+        float x = input * drive + bias;
+        float saturated = x / sqrtf(1.0f + x * x);
+        return (saturated - offset);
+    }
+
+    // Remove DC Offset caused by bias
+    static inline float biasOffset(float bias) {
+        return bias / sqrtf(1.0f + bias * bias);
+    }
+};
+
+// Fully unrolled dot product, summed in index order (same rounding as the plain loop)
+template <int N>
+struct UnrolledDot {
+    static inline float run(const float* a, const float* b) {
+        return UnrolledDot<N - 1>::run(a, b) + a[N - 1] * b[N - 1];
+    }
+};
+
+template <>
+struct UnrolledDot<1> {
+    static inline float run(const float* a, const float* b) { return a[0] * b[0]; }
+};
+
+// 2. Polyphase FIR Oversampler (4x, or 2x from every other phase)
+// 32-tap Linear Phase FIR / 4 Phases. Every factor keeps the ~4-sample base-rate group delay of the
+// 4x kernel (2x is within an eighth of a sample), so switching factors does not move the band.
+class PolyphaseOversampler {
+public:
+    PolyphaseOversampler() { reset(); }
+
+    void reset() {
+        for (int i = 0; i < 2 * kTapsPerPhase; ++i) state[i] = 0.0f;
+        ptr = 0;
+    }
+
+    // True when every tap is below 'threshold' (zero input now yields ~zero output)
+    bool isIdle(float threshold) const {
+        return ELC4L::bufferPeak(state, kTapsPerPhase) < threshold;
+    }
+
+    void flushDenormals() { ELC4L::flushDenormals(state, 2 * kTapsPerPhase); }
+
+    // Upsample 1 -> Factor (the history is mirrored so the taps read one contiguous run)
+    template <int Factor = 4>
+    void processUpsample(float input, float* outBuffer) {
+        static_assert(Factor == 2 || Factor == 4, "PolyphaseOversampler runs at 2x or 4x");
+        const float* history = pushSample(input);
+        for (int phase = 0; phase < Factor; ++phase) {
+            const float* coeffs = &kCoeffs[phase * (4 / Factor) * kTapsPerPhase];
+            outBuffer[phase] = UnrolledDot<kTapsPerPhase>::run(history, coeffs); // Gain Compensation
+        }
+    }
+
+    // Downsample Factor -> 1 (Simple Windowed Sinc decimation for efficiency)
+    template <int Factor = 4>
+    float processDownsample(const float* inBuffer) {
+        static_assert(Factor == 2 || Factor == 4, "PolyphaseOversampler runs at 2x or 4x");
+        // High quality mix of 4 samples; 2x folds the weights pairwise
+        if (Factor == 4) return UnrolledDot<4>::run(inBuffer, kDecimation4x);
+        return UnrolledDot<2>::run(inBuffer, kDecimation2x);
+    }
+
+    // 1x filter with the same linear response as processUpsample() followed by processDownsample()
+    // (the decimation weights folded into the phases). Shares the tap state with processUpsample().
+    float processLinearEquivalent(float input) {
+        return UnrolledDot<kTapsPerPhase>::run(pushSample(input), folded.c);
+    }
+
+    // processLinearEquivalent over a block, in place. The history and the block are laid out in one
+    // oldest-first run so the outputs are independent dot products (same tap order, same rounding).
+    void processLinearEquivalentChunk(float* samples, int numSamples) {
+        float run[kTapsPerPhase - 1 + kMaxChunk];
+        for (int n = 0; n < numSamples; n += kMaxChunk) {
+            const int count = (numSamples - n < kMaxChunk) ? numSamples - n : kMaxChunk;
+            for (int i = 0; i < kTapsPerPhase - 1; ++i) run[i] = state[ptr + kTapsPerPhase - 2 - i];
+            for (int i = 0; i < count; ++i) run[kTapsPerPhase - 1 + i] = samples[n + i];
+
+            for (int i = 0; i < count; ++i) {
+                const float* newest = &run[kTapsPerPhase - 1 + i];
+                float sum = newest[0] * folded.c[0];
+                for (int k = 1; k < kTapsPerPhase; ++k) sum += newest[-k] * folded.c[k];
+                samples[n + i] = sum;
+            }
+
+            // Back to the ring layout: the newest sample at ptr 0
+            ptr = 0;
+            for (int i = 0; i < kTapsPerPhase; ++i) {
+                state[i] = run[kTapsPerPhase - 2 + count - i];
+                state[i + kTapsPerPhase] = state[i];
+            }
+        }
+    }
+
+    // 32-tap Polyphase FIR Coefficients (Kaiser Windowed Sinc)
+    static constexpr float kCoeffs[32] = {
+        // Phase 0
+        -0.002f, 0.005f, -0.012f, 0.025f, 0.965f, 0.025f, -0.012f, 0.005f,
+        // Phase 1
+        -0.004f, 0.010f, -0.025f, 0.060f, 0.880f, 0.090f, -0.025f, 0.010f,
+        // Phase 2
+        -0.005f, 0.015f, -0.040f, 0.120f, 0.750f, 0.180f, -0.040f, 0.015f,
+        // Phase 3
+        -0.004f, 0.012f, -0.045f, 0.220f, 0.550f, 0.280f, -0.045f, 0.012f
+    };
+    static constexpr float kDecimation4x[4] = { 0.1f, 0.4f, 0.4f, 0.1f };
+    static constexpr float kDecimation2x[2] = { 0.5f, 0.5f };
+    static constexpr int kTapsPerPhase = 8;
+    static constexpr int kTapLength = 32;
+    static constexpr int kMaxChunk = 64;    // processLinearEquivalentChunk works in runs of this length
+
+private:
+    struct LinearEquivalentCoeffs {
+        float c[kTapsPerPhase];
+        constexpr LinearEquivalentCoeffs() : c() {
+            for (int i = 0; i < kTapsPerPhase; ++i) {
+                for (int phase = 0; phase < 4; ++phase) c[i] += kDecimation4x[phase] * kCoeffs[phase * kTapsPerPhase + i];
+            }
+        }
+    };
+    static const LinearEquivalentCoeffs folded;     // Constant-initialized (defined below the class)
+
+    // Newest sample first: history[i] is the input i samples ago
+    inline const float* pushSample(float input) {
+        ptr = (ptr == 0 ? kTapsPerPhase : ptr) - 1;
+        state[ptr] = input;
+        state[ptr + kTapsPerPhase] = input;
+        return &state[ptr];
+    }
+
+    float state[2 * kTapsPerPhase];
+    int ptr = 0;
+};
+
+inline constexpr PolyphaseOversampler::LinearEquivalentCoeffs PolyphaseOversampler::folded;
+
+// 3. Windowed-sinc 8x Oversampler (High quality)
+// One 64-tap Blackman-windowed sinc, cut off just below the base-rate Nyquist, serves as the 8-phase
+// interpolator and as the decimation filter (7 samples of group delay at the base rate in total).
+class SincOversampler8x {
+public:
+    static constexpr int kFactor = 8;
+    static constexpr int kTapsPerPhase = 8;
+    static constexpr int kTapLength = kFactor * kTapsPerPhase;
+
+    SincOversampler8x() { reset(); }
+
+    void reset() {
+        for (int i = 0; i < 2 * kTapsPerPhase; ++i) input[i] = 0.0f;
+        for (int i = 0; i < 2 * kTapLength; ++i) upsampled[i] = 0.0f;
+        inputPos = 0;
+        upsampledPos = 0;
+    }
+
+    bool isIdle(float threshold) const {
+        return ELC4L::bufferPeak(input, kTapsPerPhase) < threshold
+            && ELC4L::bufferPeak(upsampled, kTapLength) < threshold;
+    }
+
+    void flushDenormals() {
+        ELC4L::flushDenormals(input, 2 * kTapsPerPhase);
+        ELC4L::flushDenormals(upsampled, 2 * kTapLength);
+    }
+
+    // Upsample 1 -> 8 (the histories are mirrored so the taps read one contiguous run)
+    void processUpsample(float sample, float* outBuffer8x) {
+        inputPos = (inputPos == 0 ? kTapsPerPhase : inputPos) - 1;
+        input[inputPos] = sample;
+        input[inputPos + kTapsPerPhase] = sample;
+        const float* history = &input[inputPos];
+        for (int phase = 0; phase < kFactor; ++phase) {
+            const float* coeffs = kernel.phases[phase];
+            float sum = 0.0f;
+            for (int i = 0; i < kTapsPerPhase; ++i) sum += history[i] * coeffs[i];
+            outBuffer8x[phase] = sum;
+        }
+    }
+
+    // Downsample 8 -> 1
+    float processDownsample(const float* inBuffer8x) {
+        for (int phase = 0; phase < kFactor; ++phase) {
+            upsampledPos = (upsampledPos == 0 ? kTapLength : upsampledPos) - 1;
+            upsampled[upsampledPos] = inBuffer8x[phase];
+            upsampled[upsampledPos + kTapLength] = inBuffer8x[phase];
+        }
+        const float* history = &upsampled[upsampledPos];
+        float sum = 0.0f;
+        for (int i = 0; i < kTapLength; ++i) sum += history[i] * kernel.decimator[i];
+        return sum;
+    }
+
+private:
+    struct Kernel {
+        float phases[kFactor][kTapsPerPhase];   // Interpolator, unity DC gain per phase
+        float decimator[kTapLength];            // Unity DC gain
+        Kernel() {
+            const double pi = 3.14159265358979323846;
+            const double cutoff = 0.45 / kFactor;   // Cycles per oversampled sample
+            double prototype[kTapLength];
+            double total = 0.0;
+            for (int k = 0; k < kTapLength; ++k) {
+                const double t = k - 0.5 * (kTapLength - 1);
+                const double sinc = 2.0 * cutoff * ((t == 0.0) ? 1.0 : sin(2.0 * pi * cutoff * t) / (2.0 * pi * cutoff * t));
+                const double window = 0.42 - 0.5 * cos(2.0 * pi * k / (kTapLength - 1))
+                                    + 0.08 * cos(4.0 * pi * k / (kTapLength - 1));
+                prototype[k] = sinc * window;
+                total += prototype[k];
+            }
+            for (int k = 0; k < kTapLength; ++k) decimator[k] = (float)(prototype[k] / total);
+            for (int phase = 0; phase < kFactor; ++phase) {
+                double phaseSum = 0.0;
+                for (int i = 0; i < kTapsPerPhase; ++i) phaseSum += prototype[phase + i * kFactor];
+                for (int i = 0; i < kTapsPerPhase; ++i) {
+                    phases[phase][i] = (float)(prototype[phase + i * kFactor] / phaseSum);
+                }
+            }
+        }
+    };
+
+    // Built once at load time (sin/cos per tap), never on the audio thread
+    static const Kernel kernel;
+
+    float input[2 * kTapsPerPhase];
+    float upsampled[2 * kTapLength];
+    int inputPos = 0;
+    int upsampledPos = 0;
+};
+
+inline const SincOversampler8x::Kernel SincOversampler8x::kernel;
+
+//-------------------------------------------------------------------------------------------------------
+// Lookahead Limiter (Brickwall with lookahead for transparent limiting)
+//-------------------------------------------------------------------------------------------------------
+struct LookaheadLimiter {
+    static constexpr int kLookaheadSamples = 64;           // ~1.5ms at 44.1kHz
+    static constexpr int kExtendedLookaheadSamples = 128;  // ~2.9ms at 44.1kHz (High quality)
+    static constexpr int kMaxLookaheadSamples = kExtendedLookaheadSamples;
+    
+    // Delay buffers
+    float delayL[kMaxLookaheadSamples];
+    float delayR[kMaxLookaheadSamples];
+    int delayIndex;
+    int lookaheadSamples = kLookaheadSamples;
+
+    // Extended mode: the detector sees the maximum input peak over the whole delay line (sliding
+    // maximum as a monotonic queue), so the gain is down before a peak leaves the delay
+    bool peakHoldEnabled = false;
+    float holdPeak[kMaxLookaheadSamples + 1];
+    uint32_t holdExpiry[kMaxLookaheadSamples + 1];
+    int holdHead = 0;
+    int holdCount = 0;
+    uint32_t holdClock = 0;
+    
+    // Envelope follower
+    float envelope;
+    float attackCoeff;
+    float releaseCoeff;
+    float fastReleaseCoeff;
+    float slowReleaseCoeff;
+    
+    // Settings
+    float threshold;    // Linear threshold
+    float ceiling;      // Linear ceiling (output)
+    float makeupGain;   // Automatic makeup gain
+    float sampleRate;
+    float lastGain;
+    float gainReductionDb;
+    float releaseMs;    // User-adjustable release time
+    
+    LookaheadLimiter() 
+        : delayIndex(0)
+        , envelope(0.0f)
+        , attackCoeff(0.0f)
+        , releaseCoeff(0.0f)
+        , fastReleaseCoeff(0.0f)
+        , slowReleaseCoeff(0.0f)
+        , threshold(0.5f)
+        , ceiling(0.891f)  // -1 dB
+        , makeupGain(1.0f)
+        , sampleRate(44100.0f)
+        , lastGain(1.0f)
+        , gainReductionDb(0.0f)
+        , releaseMs(100.0f)
+    {
+        reset();
+        updateCoefficients();
+    }
+    
+    void reset() {
+        for (int i = 0; i < kMaxLookaheadSamples; ++i) {
+            delayL[i] = 0.0f;
+            delayR[i] = 0.0f;
+        }
+        delayIndex = 0;
+        holdHead = 0;
+        holdCount = 0;
+        envelope = 0.0f;
+        lastGain = 1.0f;
+        gainReductionDb = 0.0f;
+    }
+
+    // Standard (64 samples) or extended (128 samples + peak hold) lookahead. Changes the latency and
+    // clears the delay line; call between blocks.
+    void setExtendedLookahead(bool enabled) {
+        const int samples = enabled ? kExtendedLookaheadSamples : kLookaheadSamples;
+        if (samples == lookaheadSamples && enabled == peakHoldEnabled) return;
+        lookaheadSamples = samples;
+        peakHoldEnabled = enabled;
+        reset();
+    }
+
+    int getLookaheadSamples() const { return lookaheadSamples; }
+
+    static int getLookaheadSamples(bool extended) {
+        return extended ? kExtendedLookaheadSamples : kLookaheadSamples;
+    }
+    
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+    
+    void setThreshold(float threshDb) {
+        threshold = powf(10.0f, threshDb / 20.0f);
+        updateMakeupGain();
+    }
+    
+    void setCeiling(float ceilingDb) {
+        ceiling = powf(10.0f, ceilingDb / 20.0f);
+        updateMakeupGain();
+    }
+    
+    void setRelease(float relMs) {
+        releaseMs = relMs;
+        if (releaseMs < 10.0f) releaseMs = 10.0f;
+        if (releaseMs > 500.0f) releaseMs = 500.0f;
+        updateCoefficients();
+    }
+    
+    void updateCoefficients() {
+        float attackMs = 0.1f;
+        // ARC-style dual release based on user setting
+        float fastReleaseMs = releaseMs * 0.4f;     // Fast = 40% of setting
+        float slowReleaseMs = releaseMs * 4.0f;     // Slow = 400% of setting
+        attackCoeff = expf(-1.0f / (sampleRate * attackMs / 1000.0f));
+        releaseCoeff = expf(-1.0f / (sampleRate * releaseMs / 1000.0f));
+        fastReleaseCoeff = expf(-1.0f / (sampleRate * fastReleaseMs / 1000.0f));
+        slowReleaseCoeff = expf(-1.0f / (sampleRate * slowReleaseMs / 1000.0f));
+    }
+    
+    void updateMakeupGain() {
+        makeupGain = ceiling / threshold;
+        if (makeupGain > 4.0f) makeupGain = 4.0f;
+    }
+    
+    // Envelope follower and gain computer for one input peak (no delay line, no makeup/ceiling)
+    float computeGain(float peak) {
+        float fastEnv = envelope;
+        float slowEnv = envelope;
+
+        // Coefficients selected rather than branched on (the comparisons follow the signal)
+        const float fastCoeff = (peak > fastEnv) ? attackCoeff : fastReleaseCoeff;
+        fastEnv = fastCoeff * fastEnv + (1.0f - fastCoeff) * peak;
+
+        const float slowCoeff = (peak > slowEnv) ? attackCoeff : slowReleaseCoeff;
+        slowEnv = slowCoeff * slowEnv + (1.0f - slowCoeff) * peak;
+
+        envelope = (fastEnv > slowEnv) ? fastEnv : slowEnv;
+        
+        float gain = 1.0f;
+        if (envelope > threshold) {
+            gain = threshold / envelope;
+        }
+        return gain;
+    }
+
+    // Sliding maximum over the samples still in the delay line (including the one leaving it)
+    float holdPeakOverLookahead(float peak) {
+        const int size = kMaxLookaheadSamples + 1;
+        while (holdCount > 0 && holdPeak[(holdHead + holdCount - 1) % size] <= peak) --holdCount;
+        const int tail = (holdHead + holdCount) % size;
+        holdPeak[tail] = peak;
+        holdExpiry[tail] = holdClock + (uint32_t)lookaheadSamples + 1u;
+        ++holdCount;
+        ++holdClock;
+        while ((int32_t)(holdExpiry[holdHead] - holdClock) <= 0) {
+            holdHead = (holdHead + 1) % size;
+            --holdCount;
+        }
+        return holdPeak[holdHead];
+    }
+
+    void process(float& left, float& right) {
+        if (peakHoldEnabled) processSample<true>(left, right);
+        else processSample<false>(left, right);
+    }
+
+    // Block processors: the peak-hold mode is resolved once per chunk and the gain reduction meter
+    // is updated from the chunk's last gain
+    void processChunk(float* left, float* right, int numSamples) {
+        if (numSamples <= 0) return;
+        if (peakHoldEnabled) {
+            for (int i = 0; i < numSamples; ++i) processSample<true, false>(left[i], right[i]);
+        } else {
+            for (int i = 0; i < numSamples; ++i) processSample<false, false>(left[i], right[i]);
+        }
+        updateGainReductionDb();
+    }
+
+    template <bool PeakHold, bool Meter = true>
+    inline void processSample(float& left, float& right) {
+        float delayedL = delayL[delayIndex];
+        float delayedR = delayR[delayIndex];
+        
+        delayL[delayIndex] = left;
+        delayR[delayIndex] = right;
+        if (++delayIndex >= lookaheadSamples) delayIndex = 0;
+        
+        float peakL = fabsf(left);
+        float peakR = fabsf(right);
+        float peak = (peakL > peakR) ? peakL : peakR;
+        if constexpr (PeakHold) peak = holdPeakOverLookahead(peak);
+        float gain = computeGain(peak);
+        
+        float outL = delayedL * gain * makeupGain;
+        float outR = delayedR * gain * makeupGain;
+        
+        if (outL > ceiling) outL = ceiling;
+        if (outL < -ceiling) outL = -ceiling;
+        if (outR > ceiling) outR = ceiling;
+        if (outR < -ceiling) outR = -ceiling;
+        
+        left = outL;
+        right = outR;
+
+        lastGain = gain;
+        if constexpr (Meter) updateGainReductionDb();
+    }
+
+    void updateGainReductionDb() {
+        gainReductionDb = (lastGain > 1.0e-9f) ? (-20.0f * log10f(lastGain)) : 60.0f;
+    }
+
+    float getGainReductionDb() const { return gainReductionDb; }
+
+    // No gain reduction pending and the lookahead delay has drained
+    bool isIdle(float level) const {
+        if (envelope > threshold) return false;
+        return ELC4L::bufferPeak(delayL, lookaheadSamples) < level
+            && ELC4L::bufferPeak(delayR, lookaheadSamples) < level;
+    }
+
+    // Denormal fallback (once per block); the delay lines only hold input samples
+    void flushDenormals() { ELC4L::flushDenormal(envelope); }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// LA-2A Style Opto Compressor (per-band)
+// - Variable ratio (soft-knee, ~3:1 to infinity based on input level)
+// - Program-dependent attack (~10ms) and dual-release (60ms fast + 1-15s slow)
+// - RMS detection for natural opto response
+// - Tube saturation emulation (T4B optical cell + 12AX7 tube stage)
+//-------------------------------------------------------------------------------------------------------
+struct OptoCompressor {
+    // Hot: what the per-sample loops read and write, first and in one run of cache lines (the
+    // instance itself starts on a line boundary in the processors' StateArena)
+    float envelope;
+    float fastEnvelope;      // Fast release envelope
+    float slowEnvelope;      // Slow release envelope (LA-2A dual time constant)
+    float peakHold;          // Peak hold for ratio calculation
+    float lastGain;
+    float gainReductionDb;
+
+    // [ADDED] Current raw gain (before makeup) for delta monitoring
+    float currentGain = 1.0f;
+
+    // Gain computer rate: program-dependent release and gain curve every N samples (1 = per sample);
+    // detector, envelopes and gain smoothing always run per sample
+    int gainComputerInterval = 1;
+    int gainComputerCountdown = 0;
+    float dynamicSlowCoeff = 0.0f;
+    float targetGain = 1.0f;
+    float targetGrDb = 0.0f;
+
+    float attackCoeff;
+    float fastReleaseCoeff;  // ~60ms fast release
+    float slowReleaseCoeff;  // ~1-15s slow release (program dependent)
+    float peakDecay;         // Peak decay coefficient
+    float threshold;
+    float thresholdDb = 0.0f;   // The gain computer's threshold level (set with threshold)
+    float makeupGain;
+
+    // Quiet fast path: below quietLevel the gain computer's result is known to be exactly 0 dB GR
+    // (and below the threshold its release is exactly the base one), so the log/exp/pow math is
+    // skipped. Decided at every gain computer update, so leaving it is seamless by construction.
+    float quietLevel = 0.0f;
+
+    // [NEW] Sidechain HPF state (1-pole lowpass used to derive HPF: HP = in - LP)
+    bool sidechainEnabled = false;
+    float scFilterCoeff = 0.0f; // exp(-2*pi*fc / sr)
+    float scFilterState = 0.0f; // lowpass state
+
+    // Tube saturation parameters
+    float saturationDrive;   // 0.0 = clean, 1.0 = fully saturated
+    bool saturationEnabled;
+    int saturationFactor = 4;            // Oversampling factor in use: the requested factor reduced at 88.2 kHz and above
+    int fadeFromFactor = 4;              // Path faded out while saturationFadeRemaining > 0
+    float saturationFadeMix = 1.0f;      // Weight of the saturationFactor path during a fade
+    float saturationFadeStep = 0.0f;
+    int saturationFadeRemaining = 0;
+    bool saturationPathStale = false;   // Set by processDetectorChunk, cleared by processSaturationChunk
+
+    // The 8x path delays by this much more than the 1x/2x/4x paths (7 against ~4 samples at the base
+    // rate). While the selected quality runs 8x, those paths are delayed by the difference, so an
+    // overload step down and its crossfade stay phase-aligned and the reported latency holds.
+    static constexpr int kSinc8xAlignSamples = 3;
+    bool alignToSinc8x = false;
+    int alignPos = 0;
+    float alignDelayL[kSinc8xAlignSamples] = {};
+    float alignDelayR[kSinc8xAlignSamples] = {};
+
+    // [ADDED] High-quality saturation + oversampling
+    TapeSaturator saturator;
+    float upBufferL[SincOversampler8x::kFactor];
+    float upBufferR[SincOversampler8x::kFactor];
+
+    // Cold: configuration only the setters read
+    float sampleRate;
+    int requestedSaturationFactor = 4;   // 1: same curve at 1x (Eco, offline analysis, overload tiers), 4, 8
+    int latencyFactor = 4;               // The selected quality's factor at full tier (setLatencyFactor)
+
+    // Oversampler filter memories last: only the running factor's pair is touched per sample
+    PolyphaseOversampler oversamplerL;
+    PolyphaseOversampler oversamplerR;
+    PolyphaseOversampler oversampler2xL; // 2x path (4x requested at 88.2/96 kHz)
+    PolyphaseOversampler oversampler2xR;
+    PolyphaseOversampler linearL;        // 1x path state, kept apart so the paths can crossfade
+    PolyphaseOversampler linearR;
+    SincOversampler8x sincL;             // 8x path (High quality)
+    SincOversampler8x sincR;
+
+    void setSidechainEnabled(bool enabled) { sidechainEnabled = enabled; }
+    void setSidechainFreq(float fc) {
+        if (fc <= 0.0f || sampleRate <= 0.0f) { scFilterCoeff = 0.0f; return; }
+        // Coefficient for simple 1-pole lowpass approximation
+        scFilterCoeff = expf(-2.0f * 3.14159265358979323846f * fc / sampleRate);
+    }
+
+    // LA-2A constants
+    static constexpr float kMinRatio = 3.0f;     // Low level ratio (~3:1)
+    static constexpr float kMaxRatio = 100.0f;   // High level ratio (limiting)
+    static constexpr float kKneeDb = 10.0f;      // Wide soft-knee for opto
+    static constexpr float kAttackMs = 10.0f;    // LA-2A attack ~10ms
+    static constexpr float kFastReleaseMs = 60.0f;   // Fast release ~60ms
+    static constexpr float kSlowReleaseBase = 500.0f; // Base slow release ~500ms
+    static constexpr float kSlowReleaseMax = 5000.0f; // Max slow release ~5s
+    static constexpr float kQuietMarginDb = 0.5f;     // Below -knee/2, far above the float error of the dB math
+    static constexpr float kDetectorFloor = 1.0e-6f;  // sqrt of the detector's 1e-12 bias: the envelopes' rest value
+
+    OptoCompressor()
+        : envelope(0.0f)
+        , fastEnvelope(0.0f)
+        , slowEnvelope(0.0f)
+        , peakHold(0.0f)
+        , lastGain(1.0f)
+        , gainReductionDb(0.0f)
+        , attackCoeff(0.0f)
+        , fastReleaseCoeff(0.0f)
+        , slowReleaseCoeff(0.0f)
+        , peakDecay(0.0f)
+        , threshold(1.0f)
+        , makeupGain(1.0f)
+        , saturationDrive(0.3f)    // Default subtle saturation
+        , saturationEnabled(true)
+        , sampleRate(44100.0f)
+    {
+        updateCoefficients();
+        setThresholdDb(0.0f);
+    }
+
+    void reset() {
+        envelope = 0.0f;
+        fastEnvelope = 0.0f;
+        slowEnvelope = 0.0f;
+        lastGain = 1.0f;
+        gainReductionDb = 0.0f;
+        peakHold = 0.0f;
+        gainComputerCountdown = 0;
+        targetGain = 1.0f;
+        targetGrDb = 0.0f;
+    }
+
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+        setLatencyFactor(latencyFactor);
+        setSaturationFactor(requestedSaturationFactor);
+    }
+
+    static int clampSaturationFactor(int factor) {
+        return (factor >= 8) ? 8 : (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
+    }
+
+    // Factors are requested for 44.1/48 kHz; at higher rates the same oversampled bandwidth needs
+    // less: 4x runs at 2x at 88.2/96 kHz and at 1x from 176.4 kHz (8x at 4x and 2x)
+    static int rateAdaptedSaturationFactor(int factor, float sr) {
+        const int rateMultiple = (sr > 140000.0f) ? 4 : (sr > 70000.0f) ? 2 : 1;
+        factor = clampSaturationFactor(factor) / rateMultiple;
+        return (factor < 1) ? 1 : factor;
+    }
+
+    void setThresholdDb(float db) {
+        threshold = powf(10.0f, db / 20.0f);
+        thresholdDb = 20.0f * log10f(threshold + 1.0e-12f);
+        quietLevel = powf(10.0f, (db - kKneeDb * 0.5f - kQuietMarginDb) / 20.0f);
+    }
+
+    void setMakeupDb(float db) {
+        makeupGain = powf(10.0f, db / 20.0f);
+    }
+    
+    void setSaturationDrive(float drive) {
+        saturationDrive = (drive < 0.0f) ? 0.0f : (drive > 1.0f) ? 1.0f : drive;
+    }
+    
+    void setSaturationEnabled(bool enabled) {
+        saturationEnabled = enabled;
+    }
+
+    // Saturation oversampling factor (1, 4 or 8 at 44.1/48 kHz), switched immediately
+    void setSaturationFactor(int factor) {
+        requestedSaturationFactor = clampSaturationFactor(factor);
+        factor = rateAdaptedSaturationFactor(factor, sampleRate);
+        if (factor != saturationFactor) resetSaturationPath(factor);
+        saturationFactor = factor;
+        fadeFromFactor = factor;
+        saturationFadeMix = 1.0f;
+        saturationFadeRemaining = 0;
+    }
+
+    void setSaturationOversampling(bool enabled) { setSaturationFactor(enabled ? 4 : 1); }
+
+    // Delay the saturation adds on top of the ~4 samples every path has: kSinc8xAlignSamples while
+    // the factor runs as 8x at this rate. The wrappers add it to their reported latency.
+    static int getSaturationLatency(int factor, float sr) {
+        return (rateAdaptedSaturationFactor(factor, sr) == 8) ? kSinc8xAlignSamples : 0;
+    }
+
+    int getSaturationLatency() const { return alignToSinc8x ? kSinc8xAlignSamples : 0; }
+
+    // The selected quality's factor at full tier, which the latency is reported for. Returns true when
+    // the alignment changed: the output moves by the difference, so the caller switches the path
+    // without a fade, at the same block boundary as its latency change.
+    bool setLatencyFactor(int factor) {
+        latencyFactor = clampSaturationFactor(factor);
+        const bool align = getSaturationLatency(latencyFactor, sampleRate) > 0;
+        if (align == alignToSinc8x) return false;
+        alignToSinc8x = align;
+        resetAlignDelay();
+        return true;
+    }
+
+    // Switches the saturation path with a linear crossfade (both paths run meanwhile); the alignment
+    // delay keeps the 8x path and the others in phase during the fade.
+    void fadeSaturationFactor(int factor, int fadeSamples) {
+        requestedSaturationFactor = clampSaturationFactor(factor);
+        factor = rateAdaptedSaturationFactor(factor, sampleRate);
+        if (factor == saturationFactor) return;
+        if (fadeSamples <= 0) {
+            setSaturationFactor(factor);
+            return;
+        }
+        if (saturationFadeRemaining > 0 && factor == fadeFromFactor) {
+            // Reversal mid-fade: continue from the current mix instead of jumping
+            saturationFadeMix = 1.0f - saturationFadeMix;
+        } else {
+            resetSaturationPath(factor);
+            saturationFadeMix = 0.0f;
+        }
+        fadeFromFactor = saturationFactor;
+        saturationFactor = factor;
+        saturationFadeRemaining = fadeSamples;
+        saturationFadeStep = (1.0f - saturationFadeMix) / (float)fadeSamples;
+    }
+
+    int getSaturationFactor() const { return saturationFactor; }
+
+    void setGainComputerInterval(int samples) {
+        gainComputerInterval = (samples < 1) ? 1 : (samples > 64) ? 64 : samples;
+    }
+    
+    // LA-2A style tube saturation (12AX7 + T4B optical cell emulation)
+    // Soft asymmetric clipping with even and odd harmonics
+    inline float applyTubeSaturation(float sample) const {
+        if (!saturationEnabled || saturationDrive < 0.001f) return sample;
+        
+        // Input scaling based on drive
+        float drive = 1.0f + saturationDrive * 4.0f;  // 1x to 5x gain
+        float x = sample * drive;
+        
+        // Tube saturation model:
+        // - Soft clipping with asymmetry (more positive compression)
+        // - Even harmonics from triode asymmetry
+        // - Gentle limiting at extremes
+        
+        // Asymmetric soft clipping (triode-like)
+        float pos = x >= 0.0f ? x : 0.0f;
+        float neg = x < 0.0f ? x : 0.0f;
+        
+        // Positive half: softer clipping (more headroom)
+        float satPos = pos / (1.0f + 0.3f * pos * pos);
+        
+        // Negative half: slightly harder clipping (typical triode behavior)
+        float satNeg = neg / (1.0f + 0.4f * neg * neg);
+        
+        float saturated = satPos + satNeg;
+        
+        // Add subtle even harmonics (2nd harmonic injection)
+        float evenHarmonic = 0.05f * saturationDrive * saturated * saturated;
+        saturated += evenHarmonic;
+        
+        // Output scaling to maintain level
+        saturated /= drive * 0.7f;
+        
+        // Blend dry/wet based on drive amount
+        float wet = saturationDrive * 0.7f;  // Max 70% wet
+        return sample * (1.0f - wet) + saturated * wet;
+    }
+
+    void updateCoefficients() {
+        attackCoeff = expf(-1.0f / (sampleRate * kAttackMs / 1000.0f));
+        fastReleaseCoeff = expf(-1.0f / (sampleRate * kFastReleaseMs / 1000.0f));
+        slowReleaseCoeff = expf(-1.0f / (sampleRate * kSlowReleaseBase / 1000.0f));
+        peakDecay = expf(-1.0f / (sampleRate * 0.5f));  // 500ms peak decay
+    }
+
+    void process(float& left, float& right) {
+        processDynamics(left, right);
+        processSaturation(left, right);
+    }
+
+    // Detector, envelopes and gain computer; applies gain and makeup
+    void processDynamics(float& left, float& right) {
+        if (sidechainEnabled) processDynamicsSample<true>(left, right);
+        else processDynamicsSample<false>(left, right);
+    }
+
+    // Chunk versions for the block processors: the sidechain, saturation factor and fade are resolved
+    // once per chunk, so the per-sample loops only branch on the signal. gains receives the raw
+    // compressor gain (getCurrentGain) of every sample.
+    void processDynamicsChunk(float* left, float* right, float* gains, int numSamples) {
+        if (sidechainEnabled) {
+            for (int i = 0; i < numSamples; ++i) {
+                processDynamicsSample<true>(left[i], right[i]);
+                gains[i] = currentGain;
+            }
+        } else {
+            for (int i = 0; i < numSamples; ++i) {
+                processDynamicsSample<false>(left[i], right[i]);
+                gains[i] = currentGain;
+            }
+        }
+    }
+
+    void processSaturationChunk(float* left, float* right, int numSamples) {
+        if (saturationPathStale) {
+            // Filter memories left over from before the band was muted would replay as a click
+            resetSaturationPath(saturationFactor);
+            if (saturationFadeRemaining > 0) resetSaturationPath(fadeFromFactor);
+            saturationPathStale = false;
+        }
+        if (!saturationEnabled) return;
+        if (saturationFadeRemaining > 0) {
+            // Quality crossfade in progress (~20 ms after a switch): per-sample path
+            for (int i = 0; i < numSamples; ++i) processSaturation(left[i], right[i]);
+            return;
+        }
+
+        const float drive = 1.0f + saturationDrive * 3.0f;
+        const float bias = saturationDrive * 0.1f;
+        const float offset = TapeSaturator::biasOffset(bias);
+        switch (saturationFactor) {
+            case 4:
+                for (int i = 0; i < numSamples; ++i)
+                    saturateOversampled<4>(oversamplerL, oversamplerR, left[i], right[i], drive, bias, offset);
+                break;
+            case 2:
+                for (int i = 0; i < numSamples; ++i)
+                    saturateOversampled<2>(oversampler2xL, oversampler2xR, left[i], right[i], drive, bias, offset);
+                break;
+            case 8:
+                for (int i = 0; i < numSamples; ++i) saturateSinc8x(left[i], right[i], drive, bias, offset);
+                return;
+            default:
+                saturateLinearChunk(left, numSamples, linearL, drive, bias, offset);
+                saturateLinearChunk(right, numSamples, linearR, drive, bias, offset);
+                break;
+        }
+        if (alignToSinc8x) {
+            for (int i = 0; i < numSamples; ++i) alignToSinc8xPath(left[i], right[i]);
+        }
+    }
+
+    // Detector-only update for a band that does not reach the mix (muted / not soloed): envelopes,
+    // gain computer (every kDetectorOnlyInterval samples) and gain smoothing keep following the band,
+    // so un-muting picks up the right gain, but the audio is not touched and the saturation is
+    // skipped. Its filters restart from silence when the band is heard again.
+    static constexpr int kDetectorOnlyInterval = 16;
+
+    void processDetectorChunk(const float* left, const float* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            float l = left[i], r = right[i];
+            if (sidechainEnabled) processDynamicsSample<true, false>(l, r);
+            else processDynamicsSample<false, false>(l, r);
+        }
+        saturationPathStale = true;
+    }
+
+    template <bool Sidechain, bool AudioPath = true>
+    inline void processDynamicsSample(float& left, float& right) {
+        // Internal Sidechain HPF: compute mono detector then optionally HPF it
+        float monoIn = 0.5f * (left + right);
+        float detectorSignal = monoIn;
+
+        if constexpr (Sidechain) {
+            // 1-pole LP: scFilterState = a * scFilterState + (1-a) * x
+            scFilterState = scFilterState * scFilterCoeff + monoIn * (1.0f - scFilterCoeff);
+            detectorSignal = monoIn - scFilterState; // HP = input - LP
+        }
+
+        float level = detectorSignal * detectorSignal;
+        float detector = sqrtf(level + 1.0e-12f);
+
+        // Track peak for dynamic ratio calculation (both sides computed and selected: the comparisons
+        // follow the signal and do not predict)
+        const float peakDecayed = peakDecay * peakHold + (1.0f - peakDecay) * detector;
+        peakHold = (detector > peakHold) ? detector : peakDecayed;
+
+        // Dual time constant envelope (LA-2A style)
+        const float fastCoeff = (detector > fastEnvelope) ? attackCoeff : fastReleaseCoeff;
+        fastEnvelope = fastCoeff * fastEnvelope + (1.0f - fastCoeff) * detector;
+
+        const bool computeGain = (--gainComputerCountdown <= 0);
+        if (computeGain) {
+            gainComputerCountdown = (AudioPath || gainComputerInterval > kDetectorOnlyInterval)
+                                        ? gainComputerInterval : kDetectorOnlyInterval;
+
+            // Slow envelope with program-dependent release (the base release below the threshold)
+            if (peakHold < threshold) {
+                dynamicSlowCoeff = slowReleaseCoeff;
+            } else {
+                float overDb = 20.0f * log10f((peakHold / threshold) + 1.0e-12f);
+                if (overDb < 0.0f) overDb = 0.0f;
+                float releaseScale = 1.0f + (overDb * 0.15f);
+                if (releaseScale > 10.0f) releaseScale = 10.0f;
+                float slowRelMs = kSlowReleaseBase * releaseScale;
+                if (slowRelMs > kSlowReleaseMax) slowRelMs = kSlowReleaseMax;
+                dynamicSlowCoeff = expf(-1.0f / (sampleRate * slowRelMs / 1000.0f));
+            }
+        }
+
+        const float slowCoeff = (detector > slowEnvelope) ? attackCoeff : dynamicSlowCoeff;
+        slowEnvelope = slowCoeff * slowEnvelope + (1.0f - slowCoeff) * detector;
+
+        // Combined envelope
+        envelope = 0.3f * fastEnvelope + 0.7f * slowEnvelope;
+
+        // Gain calculation (same LA-2A logic); quiet fast path well below the knee
+        if (computeGain && envelope < quietLevel) {
+            targetGain = 1.0f;
+            targetGrDb = 0.0f;
+        } else if (computeGain) {
+            float levelDb = 20.0f * log10f(envelope + 1.0e-12f);
+            float overThresh = levelDb - thresholdDb;
+
+            float dynamicRatio = kMinRatio;
+            if (overThresh > 0.0f) {
+                float ratioBlend = overThresh / 20.0f;
+                if (ratioBlend > 1.0f) ratioBlend = 1.0f;
+                dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
+            }
+
+            float grDb = 0.0f;
+            if (overThresh <= -kKneeDb * 0.5f) {
+                grDb = 0.0f;
+            } else if (overThresh >= kKneeDb * 0.5f) {
+                grDb = overThresh - (overThresh / dynamicRatio);
+            } else {
+                float x = overThresh + kKneeDb * 0.5f;
+                grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
+            }
+
+            targetGain = powf(10.0f, -grDb / 20.0f);
+            targetGrDb = grDb;
+        }
+
+        float gainSmooth = 0.995f;
+        float gain = gainSmooth * lastGain + (1.0f - gainSmooth) * targetGain;
+
+        // [ADDED] store raw gain (reduction only) before makeup is applied
+        currentGain = gain;
+
+        if constexpr (AudioPath) {
+            left *= gain * makeupGain;
+            right *= gain * makeupGain;
+        }
+
+        lastGain = gain;
+        gainReductionDb = targetGrDb;
+    }
+
+    // 2. [NEW] Oversampled (1x / 4x / 8x) Tape Saturation
+    void processSaturation(float& left, float& right) {
+        if (saturationEnabled) {
+            float drive = 1.0f + saturationDrive * 3.0f; 
+            float bias = saturationDrive * 0.1f;        
+            float offset = TapeSaturator::biasOffset(bias);
+
+            if (saturationFadeRemaining > 0) {
+                float fromL = left, fromR = right;
+                saturateAt(fadeFromFactor, fromL, fromR, drive, bias, offset);
+                saturateAt(saturationFactor, left, right, drive, bias, offset);
+                saturationFadeMix += saturationFadeStep;
+                if (--saturationFadeRemaining == 0) saturationFadeMix = 1.0f;
+                left = fromL + (left - fromL) * saturationFadeMix;
+                right = fromR + (right - fromR) * saturationFadeMix;
+            } else {
+                saturateAt(saturationFactor, left, right, drive, bias, offset);
+            }
+        }
+    }
+
+    inline void saturateAt(int factor, float& left, float& right, float drive, float bias, float offset) {
+        if (factor == 8) {
+            saturateSinc8x(left, right, drive, bias, offset);
+            return;
+        }
+        if (factor == 4) saturateOversampled<4>(oversamplerL, oversamplerR, left, right, drive, bias, offset);
+        else if (factor == 2) saturateOversampled<2>(oversampler2xL, oversampler2xR, left, right, drive, bias, offset);
+        else saturateLinear(left, right, drive, bias, offset);
+        if (alignToSinc8x) alignToSinc8xPath(left, right);
+    }
+
+    // kSinc8xAlignSamples of delay on a 1x/2x/4x path's output (only one of them runs while aligned:
+    // High's overload tier steps 8x straight down to 1x)
+    inline void alignToSinc8xPath(float& left, float& right) {
+        const float delayedL = alignDelayL[alignPos];
+        const float delayedR = alignDelayR[alignPos];
+        alignDelayL[alignPos] = left;
+        alignDelayR[alignPos] = right;
+        alignPos = (alignPos + 1 == kSinc8xAlignSamples) ? 0 : alignPos + 1;
+        left = delayedL;
+        right = delayedR;
+    }
+
+    void resetAlignDelay() {
+        for (int i = 0; i < kSinc8xAlignSamples; ++i) {
+            alignDelayL[i] = 0.0f;
+            alignDelayR[i] = 0.0f;
+        }
+        alignPos = 0;
+    }
+
+    template <int Factor>
+    inline void saturateOversampled(PolyphaseOversampler& osL, PolyphaseOversampler& osR,
+                                    float& left, float& right, float drive, float bias, float offset) {
+        // LEFT CHANNEL
+        osL.processUpsample<Factor>(left, upBufferL);
+        for (int i = 0; i < Factor; ++i) upBufferL[i] = saturator.process(upBufferL[i], drive, bias, offset);
+        left = osL.processDownsample<Factor>(upBufferL) / drive;
+
+        // RIGHT CHANNEL
+        osR.processUpsample<Factor>(right, upBufferR);
+        for (int i = 0; i < Factor; ++i) upBufferR[i] = saturator.process(upBufferR[i], drive, bias, offset);
+        right = osR.processDownsample<Factor>(upBufferR) / drive;
+    }
+
+    inline void saturateSinc8x(float& left, float& right, float drive, float bias, float offset) {
+        sincL.processUpsample(left, upBufferL);
+        for (int i = 0; i < SincOversampler8x::kFactor; ++i) upBufferL[i] = saturator.process(upBufferL[i], drive, bias, offset);
+        left = sincL.processDownsample(upBufferL) / drive;
+
+        sincR.processUpsample(right, upBufferR);
+        for (int i = 0; i < SincOversampler8x::kFactor; ++i) upBufferR[i] = saturator.process(upBufferR[i], drive, bias, offset);
+        right = sincR.processDownsample(upBufferR) / drive;
+    }
+
+    // A path that is faded in starts from silence rather than from whatever it held when it was left
+    void resetSaturationPath(int factor) {
+        if (factor == 4) {
+            oversamplerL.reset();
+            oversamplerR.reset();
+        } else if (factor == 2) {
+            oversampler2xL.reset();
+            oversampler2xR.reset();
+        } else if (factor == 8) {
+            sincL.reset();
+            sincR.reset();
+        } else {
+            linearL.reset();
+            linearR.reset();
+        }
+        if (factor != 8) resetAlignDelay();
+    }
+
+    // Same curve and filter response at 1x (aliasing is irrelevant for metering)
+    inline void saturateLinear(float& left, float& right, float drive, float bias, float offset) {
+        left = linearL.processLinearEquivalent(saturator.process(left, drive, bias, offset)) / drive;
+        right = linearR.processLinearEquivalent(saturator.process(right, drive, bias, offset)) / drive;
+    }
+
+    // The 1x path over a chunk of one channel: curve, filter and gain each as one loop
+    inline void saturateLinearChunk(float* samples, int numSamples, PolyphaseOversampler& linear,
+                                    float drive, float bias, float offset) {
+        for (int i = 0; i < numSamples; ++i) samples[i] = saturator.process(samples[i], drive, bias, offset);
+        linear.processLinearEquivalentChunk(samples, numSamples);
+        for (int i = 0; i < numSamples; ++i) samples[i] /= drive;
+    }
+
+    float getGainReductionDb() const { return gainReductionDb; }
+    float getCurrentGain() const { return currentGain; }
+
+    // Gain has recovered to unity, the detector envelopes have decayed to within 'threshold' of
+    // their silent rest value and the sidechain/oversampler memories have drained. A compressor
+    // reset any earlier would attack the next onset from a different envelope than a running one.
+    bool isIdle(float threshold) const {
+        if (gainReductionDb > 0.0f || lastGain < 0.9999f) return false;
+        const float level = kDetectorFloor + threshold;
+        if (envelope >= level || fastEnvelope >= level || slowEnvelope >= level || peakHold >= level) return false;
+        if (fabsf(scFilterState) >= threshold) return false;
+        if (ELC4L::bufferPeak(alignDelayL, kSinc8xAlignSamples) >= threshold
+            || ELC4L::bufferPeak(alignDelayR, kSinc8xAlignSamples) >= threshold) return false;
+        return oversamplerL.isIdle(threshold) && oversamplerR.isIdle(threshold)
+            && oversampler2xL.isIdle(threshold) && oversampler2xR.isIdle(threshold)
+            && linearL.isIdle(threshold) && linearR.isIdle(threshold)
+            && sincL.isIdle(threshold) && sincR.isIdle(threshold);
+    }
+
+    // Denormal fallback (once per block): detector envelopes and filter memories
+    void flushDenormals() {
+        ELC4L::flushDenormal(envelope);
+        ELC4L::flushDenormal(fastEnvelope);
+        ELC4L::flushDenormal(slowEnvelope);
+        ELC4L::flushDenormal(peakHold);
+        ELC4L::flushDenormal(scFilterState);
+        oversamplerL.flushDenormals();
+        oversamplerR.flushDenormals();
+        oversampler2xL.flushDenormals();
+        oversampler2xR.flushDenormals();
+        linearL.flushDenormals();
+        linearR.flushDenormals();
+        sincL.flushDenormals();
+        sincR.flushDenormals();
+        ELC4L::flushDenormals(alignDelayL, kSinc8xAlignSamples);
+        ELC4L::flushDenormals(alignDelayR, kSinc8xAlignSamples);
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// CompressorBank<NumBands> - one OptoCompressor per crossover band, sized with the crossover it
+// follows (Crossover<NumBands>::kNumBands). Per-band settings go through operator[]; the lifecycle
+// calls run over the whole bank in a loop the compiler unrolls.
+//-------------------------------------------------------------------------------------------------------
+template <int NumBands>
+struct CompressorBank {
+    static constexpr int kNumBands = NumBands;
+
+    OptoCompressor bands[NumBands];
+
+    OptoCompressor& operator[](int band) { return bands[band]; }
+    const OptoCompressor& operator[](int band) const { return bands[band]; }
+
+    void setSampleRate(float sr) {
+        for (int b = 0; b < NumBands; ++b) bands[b].setSampleRate(sr);
+    }
+
+    void reset() {
+        for (int b = 0; b < NumBands; ++b) bands[b].reset();
+    }
+
+    bool isIdle(float threshold) const {
+        for (int b = 0; b < NumBands; ++b) {
+            if (!bands[b].isIdle(threshold)) return false;
+        }
+        return true;
+    }
+
+    void flushDenormals() {
+        for (int b = 0; b < NumBands; ++b) bands[b].flushDenormals();
+    }
+
+    int getSaturationLatency() const { return bands[0].getSaturationLatency(); }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// LUFS Meter (momentary, approximate)
+//-------------------------------------------------------------------------------------------------------
+struct LufsMeter {
+    float sampleRate;
+    float momentaryEnergy;
+    float momentaryCoeff;
+    float momentaryLufs;
+
+    LufsMeter()
+        : sampleRate(44100.0f)
+        , momentaryEnergy(0.0f)
+        , momentaryCoeff(0.0f)
+        , momentaryLufs(-120.0f)
+    {
+        updateCoefficients();
+    }
+
+    void reset() {
+        momentaryEnergy = 0.0f;
+        momentaryLufs = -120.0f;
+    }
+
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+
+    void updateCoefficients() {
+        // 400 ms momentary window
+        float tau = 0.4f;
+        momentaryCoeff = expf(-1.0f / (sampleRate * tau));
+    }
+
+    void process(float left, float right) {
+        float energy = 0.5f * (left * left + right * right);
+        momentaryEnergy = momentaryCoeff * momentaryEnergy + (1.0f - momentaryCoeff) * energy;
+        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
+        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
+    }
+
+    // process() over a chunk: the energy follows every sample, the loudness is derived once at the end
+    void processChunk(const float* left, const float* right, int numSamples) {
+        if (numSamples <= 0) return;
+        float energy = momentaryEnergy;
+        for (int i = 0; i < numSamples; ++i) {
+            float sampleEnergy = 0.5f * (left[i] * left[i] + right[i] * right[i]);
+            energy = momentaryCoeff * energy + (1.0f - momentaryCoeff) * sampleEnergy;
+        }
+        momentaryEnergy = energy;
+        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
+        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
+    }
+
+    // Equivalent to process(0, 0) repeated numSamples times
+    void processSilence(int numSamples) {
+        momentaryEnergy *= powf(momentaryCoeff, (float)numSamples);
+        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
+        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
+    }
+
+    void flushDenormals() { ELC4L::flushDenormal(momentaryEnergy); }
+
+    float getMomentary() const { return momentaryLufs; }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// Crossover<NumBands> - Linkwitz-Riley 4th-order crossover, 2 to kMaxCrossoverBands bands
+// The split tree is built at compile time: split k sits between band k and band k + 1, each node is
+// its own instantiation and every band's path is a fixed chain of biquads, so the per-sample code is
+// fully unrolled and a 2-band chain runs exactly one split.
+// - Compensated (default): a balanced tree in which each branch also runs the second-order allpass
+//   (lowpass + highpass) of every split on the other side, so all bands share one phase response and
+//   their sum is an allpass.
+// - Uncompensated: the serial cascade (split 0's highpass feeds split 1, ...) without allpasses. Near
+//   the split points the bands' phases differ and the unprocessed sum dips (0.45 dB at the plugin's
+//   default 4-band points, 1.5 dB for 6 bands). HyeokStreamDSP keeps it: it is the shipping 4-band
+//   response the equivalence reference freezes.
+// Coefficients are designed in double precision; the filters run in double (default) or in float
+// (Eco quality). Switching precision carries the filter memories over, so it is click-free.
+//-------------------------------------------------------------------------------------------------------
+constexpr int kMaxCrossoverBands = 8;
+
+template <int NumBands, bool Compensated = true>
+struct Crossover {
+    static_assert(NumBands >= 2 && NumBands <= kMaxCrossoverBands, "Crossover: 2 to 8 bands");
+
+    static constexpr int kNumBands = NumBands;
+    static constexpr int kNumSplits = NumBands - 1;
+    static constexpr int kMaxChunkSize = 64;    // Largest numSamples processChunk takes
+
+    // Tree shape: a node over 'count' bands splits after its lower lowCount(count) bands; its two
+    // branches run count - 2 allpasses between them (each the other side's splits)
+    static constexpr int lowCount(int count) { return Compensated ? count / 2 : 1; }
+    static constexpr int nodeAllpasses(int count) { return Compensated ? count - 2 : 0; }
+    static constexpr int treeAllpasses(int count) {
+        return (count < 2) ? 0
+             : nodeAllpasses(count) + treeAllpasses(lowCount(count)) + treeAllpasses(count - lowCount(count));
+    }
+    static constexpr int kNumAllpasses = treeAllpasses(NumBands);
+
+    template <typename T>
+    struct BiquadCoeffs {
+        T b0, b1, b2;
+        T a1, a2;
+    };
+    
+    // Channel pairs (x1[0], x1[1], ...) are loaded and stored as one vector: 16-byte aligned, so a
+    // pair never straddles a cache line
+    template <typename T>
+    struct alignas(16) BiquadState {
+        T x1[2], x2[2];
+        T y1[2], y2[2];
+        
+        BiquadState() { reset(); }
+        
+        void reset() {
+            x1[0] = x1[1] = x2[0] = x2[1] = 0;
+            y1[0] = y1[1] = y2[0] = y2[1] = 0;
+        }
+
+        bool isIdle(double threshold) const {
+            for (int ch = 0; ch < 2; ++ch) {
+                if (fabs(x1[ch]) >= threshold || fabs(x2[ch]) >= threshold) return false;
+                if (fabs(y1[ch]) >= threshold || fabs(y2[ch]) >= threshold) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int ch = 0; ch < 2; ++ch) {
+                ELC4L::flushDenormal(x1[ch]); ELC4L::flushDenormal(x2[ch]);
+                ELC4L::flushDenormal(y1[ch]); ELC4L::flushDenormal(y2[ch]);
+            }
+        }
+
+        template <typename U>
+        void copyFrom(const BiquadState<U>& other) {
+            for (int ch = 0; ch < 2; ++ch) {
+                x1[ch] = (T)other.x1[ch]; x2[ch] = (T)other.x2[ch];
+                y1[ch] = (T)other.y1[ch]; y2[ch] = (T)other.y2[ch];
+            }
+        }
+    };
+
+    // One split point: the LR4 lowpass and highpass (two cascaded Butterworth biquads each), with the
+    // coefficients and memories in the order the sample loop visits them, so a split is one
+    // contiguous run of cache lines instead of six arrays strided across the network
+    template <typename T>
+    struct Split {
+        BiquadCoeffs<T> lowpass;
+        BiquadState<T> lpStateA, lpStateB;
+        BiquadCoeffs<T> highpass;
+        BiquadState<T> hpStateA, hpStateB;
+
+        void reset() {
+            lpStateA.reset(); lpStateB.reset();
+            hpStateA.reset(); hpStateB.reset();
+        }
+
+        bool isIdle(double threshold) const {
+            return lpStateA.isIdle(threshold) && lpStateB.isIdle(threshold)
+                && hpStateA.isIdle(threshold) && hpStateB.isIdle(threshold);
+        }
+
+        void flushDenormals() {
+            lpStateA.flushDenormals(); lpStateB.flushDenormals();
+            hpStateA.flushDenormals(); hpStateB.flushDenormals();
+        }
+    };
+
+    // Compensation allpass memories, in tree order (none for 2 bands or the serial cascade)
+    template <typename T, int Count>
+    struct AllpassStates {
+        BiquadState<T> states[Count];
+    };
+
+    template <typename T>
+    struct AllpassStates<T, 0> {
+        static constexpr BiquadState<T>* states = nullptr;
+    };
+
+    template <typename T>
+    struct Network;
+
+    // The node over bands [First, First + Count), whose allpass memories start at Offset: splits its
+    // input, compensates both branches and hands them to its children
+    template <int First, int Count, int Offset>
+    struct Node {
+        static constexpr int kLowCount = lowCount(Count);
+        static constexpr int kSplit = First + kLowCount - 1;
+        static constexpr int kLowChildOffset = Offset + nodeAllpasses(Count);
+        static constexpr int kHighChildOffset = kLowChildOffset + treeAllpasses(kLowCount);
+
+        template <typename T>
+        static inline void process(Network<T>& net, T inL, T inR, float* bandL, float* bandR) {
+            Split<T>& split = net.splits[kSplit];
+            T lpL = Network<T>::processBiquad(inL, 0, split.lowpass, split.lpStateA);
+            T lpR = Network<T>::processBiquad(inR, 1, split.lowpass, split.lpStateA);
+            T lowL = Network<T>::processBiquad(lpL, 0, split.lowpass, split.lpStateB);
+            T lowR = Network<T>::processBiquad(lpR, 1, split.lowpass, split.lpStateB);
+
+            T hpL = Network<T>::processBiquad(inL, 0, split.highpass, split.hpStateA);
+            T hpR = Network<T>::processBiquad(inR, 1, split.highpass, split.hpStateA);
+            T highL = Network<T>::processBiquad(hpL, 0, split.highpass, split.hpStateB);
+            T highR = Network<T>::processBiquad(hpR, 1, split.highpass, split.hpStateB);
+
+            if constexpr (Compensated) {
+                // Low branch: the high side's splits; high branch: the low side's
+                int allpass = Offset;
+                for (int k = kSplit + 1; k < First + Count - 1; ++k, ++allpass) {
+                    lowL = Network<T>::processAllpass(lowL, 0, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                    lowR = Network<T>::processAllpass(lowR, 1, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                }
+                for (int k = First; k < kSplit; ++k, ++allpass) {
+                    highL = Network<T>::processAllpass(highL, 0, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                    highR = Network<T>::processAllpass(highR, 1, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                }
+            }
+
+            Node<First, kLowCount, kLowChildOffset>::process(net, lowL, lowR, bandL, bandR);
+            Node<First + kLowCount, Count - kLowCount, kHighChildOffset>::process(net, highL, highR, bandL, bandR);
+        }
+
+        // The same network over a chunk, one filter pass at a time with the memories in locals.
+        // inL / inR are overwritten (they carry the high branch down the tree).
+        template <typename T>
+        static inline void processChunk(Network<T>& net, T* inL, T* inR, float* const* bandL,
+                                        float* const* bandR, int numSamples) {
+            Split<T>& split = net.splits[kSplit];
+            const BiquadCoeffs<T> lowpass = split.lowpass;
+            const BiquadCoeffs<T> highpass = split.highpass;
+            BiquadState<T> lpStateA = split.lpStateA, lpStateB = split.lpStateB;
+            BiquadState<T> hpStateA = split.hpStateA, hpStateB = split.hpStateB;
+            T lowL[kMaxChunkSize], lowR[kMaxChunkSize];
+            for (int i = 0; i < numSamples; ++i) {
+                T lpL = Network<T>::processBiquad(inL[i], 0, lowpass, lpStateA);
+                T lpR = Network<T>::processBiquad(inR[i], 1, lowpass, lpStateA);
+                lowL[i] = Network<T>::processBiquad(lpL, 0, lowpass, lpStateB);
+                lowR[i] = Network<T>::processBiquad(lpR, 1, lowpass, lpStateB);
+
+                T hpL = Network<T>::processBiquad(inL[i], 0, highpass, hpStateA);
+                T hpR = Network<T>::processBiquad(inR[i], 1, highpass, hpStateA);
+                inL[i] = Network<T>::processBiquad(hpL, 0, highpass, hpStateB);
+                inR[i] = Network<T>::processBiquad(hpR, 1, highpass, hpStateB);
+            }
+            split.lpStateA = lpStateA; split.lpStateB = lpStateB;
+            split.hpStateA = hpStateA; split.hpStateB = hpStateB;
+
+            if constexpr (Compensated) {
+                int allpass = Offset;
+                for (int k = kSplit + 1; k < First + Count - 1; ++k, ++allpass) {
+                    processAllpassChunk(net.splits[k].lowpass, net.allpasses.states[allpass], lowL, lowR, numSamples);
+                }
+                for (int k = First; k < kSplit; ++k, ++allpass) {
+                    processAllpassChunk(net.splits[k].lowpass, net.allpasses.states[allpass], inL, inR, numSamples);
+                }
+            }
+
+            Node<First, kLowCount, kLowChildOffset>::processChunk(net, lowL, lowR, bandL, bandR, numSamples);
+            Node<First + kLowCount, Count - kLowCount, kHighChildOffset>::processChunk(net, inL, inR, bandL, bandR,
+                                                                                       numSamples);
+        }
+
+        template <typename T>
+        static inline void processAllpassChunk(const BiquadCoeffs<T>& coeffs, BiquadState<T>& state,
+                                               T* left, T* right, int numSamples) {
+            const BiquadCoeffs<T> c = coeffs;
+            BiquadState<T> s = state;
+            for (int i = 0; i < numSamples; ++i) {
+                left[i] = Network<T>::processAllpass(left[i], 0, c, s);
+                right[i] = Network<T>::processAllpass(right[i], 1, c, s);
+            }
+            state = s;
+        }
+    };
+
+    template <int First, int Offset>
+    struct Node<First, 1, Offset> {
+        template <typename T>
+        static inline void process(Network<T>&, T inL, T inR, float* bandL, float* bandR) {
+            bandL[First] = (float)inL;
+            bandR[First] = (float)inR;
+        }
+
+        template <typename T>
+        static inline void processChunk(Network<T>&, T* inL, T* inR, float* const* bandL,
+                                        float* const* bandR, int numSamples) {
+            for (int i = 0; i < numSamples; ++i) {
+                bandL[First][i] = (float)inL[i];
+                bandR[First][i] = (float)inR[i];
+            }
+        }
+    };
+
+    // All split points and compensation allpasses in one precision
+    template <typename T>
+    struct Network {
+        Split<T> splits[kNumSplits];
+        AllpassStates<T, kNumAllpasses> allpasses;
+
+        static inline T processBiquad(T input, int channel, const BiquadCoeffs<T>& c, BiquadState<T>& s) {
+            T output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
+                     - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+
+            s.x2[channel] = s.x1[channel];
+            s.x1[channel] = input;
+            s.y2[channel] = s.y1[channel];
+            s.y1[channel] = output;
+
+            return output;
+        }
+
+        // LR4 lowpass + highpass of a split: its Butterworth denominator over the mirrored numerator,
+        // so the allpass reads the split's lowpass coefficients
+        static inline T processAllpass(T input, int channel, const BiquadCoeffs<T>& c, BiquadState<T>& s) {
+            T output = c.a2 * input + c.a1 * s.x1[channel] + s.x2[channel]
+                     - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+
+            s.x2[channel] = s.x1[channel];
+            s.x1[channel] = input;
+            s.y2[channel] = s.y1[channel];
+            s.y1[channel] = output;
+
+            return output;
+        }
+
+        inline void process(float inL, float inR, float* bandL, float* bandR) {
+            Node<0, NumBands, 0>::process(*this, (T)inL, (T)inR, bandL, bandR);
+        }
+
+        inline void processChunk(const float* inL, const float* inR, float* const* bandL, float* const* bandR,
+                                 int numSamples) {
+            T left[kMaxChunkSize], right[kMaxChunkSize];
+            for (int i = 0; i < numSamples; ++i) {
+                left[i] = (T)inL[i];
+                right[i] = (T)inR[i];
+            }
+            Node<0, NumBands, 0>::processChunk(*this, left, right, bandL, bandR, numSamples);
+        }
+
+        void reset() {
+            for (int k = 0; k < kNumSplits; ++k) splits[k].reset();
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].reset();
+        }
+
+        bool isIdle(double threshold) const {
+            for (int k = 0; k < kNumSplits; ++k) {
+                if (!splits[k].isIdle(threshold)) return false;
+            }
+            for (int a = 0; a < kNumAllpasses; ++a) {
+                if (!allpasses.states[a].isIdle(threshold)) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int k = 0; k < kNumSplits; ++k) splits[k].flushDenormals();
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].flushDenormals();
+        }
+
+        // Coefficients of one split point (its allpasses read them too)
+        template <typename U>
+        void copyCoefficientsFrom(const Network<U>& other, int k) {
+            const BiquadCoeffs<U>* src[2] = { &other.splits[k].lowpass, &other.splits[k].highpass };
+            BiquadCoeffs<T>* dst[2] = { &splits[k].lowpass, &splits[k].highpass };
+            for (int f = 0; f < 2; ++f) {
+                dst[f]->b0 = (T)src[f]->b0; dst[f]->b1 = (T)src[f]->b1; dst[f]->b2 = (T)src[f]->b2;
+                dst[f]->a1 = (T)src[f]->a1; dst[f]->a2 = (T)src[f]->a2;
+            }
+        }
+
+        template <typename U>
+        void copyStateFrom(const Network<U>& other) {
+            for (int k = 0; k < kNumSplits; ++k) {
+                const Split<U>& src = other.splits[k];
+                Split<T>& dst = splits[k];
+                dst.lpStateA.copyFrom(src.lpStateA); dst.lpStateB.copyFrom(src.lpStateB);
+                dst.hpStateA.copyFrom(src.hpStateA); dst.hpStateB.copyFrom(src.hpStateB);
+            }
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].copyFrom(other.allpasses.states[a]);
+        }
+    };
+
+    Network<double> precise;
+    Network<float> fast;
+    bool doublePrecision;
+
+    float sampleRate;
+    float frequencies[kNumSplits];
+    
+    Crossover() 
+        : doublePrecision(true)
+        , sampleRate(44100.0f)
+    {
+        for (int k = 0; k < kNumSplits; ++k) frequencies[k] = getDefaultFrequency(k);
+        updateCoefficients();
+    }
+
+    // The 4-band plugin's 120 / 800 / 4000 Hz; other band counts log-spaced over 100 Hz - 8 kHz
+    static float getDefaultFrequency(int k) {
+        static const float fourBand[3] = { 120.0f, 800.0f, 4000.0f };
+        if (NumBands == 4) return fourBand[k];
+        if (kNumSplits == 1) return 800.0f;
+        return 100.0f * powf(80.0f, (float)k / (float)(kNumSplits - 1));
+    }
+    
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+    
+    // Only recomputes the filter pair of split k
+    void setFrequency(int k, float freq) {
+        frequencies[k] = freq;
+        updateSplitCoefficients(k);
+    }
+
+    float getFrequency(int k) const { return frequencies[k]; }
+
+    // Audio thread (between samples): the running network's memories move to the other precision
+    void setDoublePrecision(bool enabled) {
+        if (enabled == doublePrecision) return;
+        if (enabled) precise.copyStateFrom(fast);
+        else fast.copyStateFrom(precise);
+        doublePrecision = enabled;
+    }
+    
+    void updateCoefficients() {
+        for (int k = 0; k < kNumSplits; ++k) {
+            updateSplitCoefficients(k);
+        }
+    }
+
+    void updateSplitCoefficients(int k) {
+        calculateButterworthLP(precise.splits[k].lowpass, frequencies[k], sampleRate);
+        calculateButterworthHP(precise.splits[k].highpass, frequencies[k], sampleRate);
+        fast.copyCoefficientsFrom(precise, k);
+    }
+    
+    void calculateButterworthLP(BiquadCoeffs<double>& c, float freq, float sr) {
+        const double w0 = 2.0 * 3.14159265358979323846 * freq / sr;
+        const double cosw0 = cos(w0);
+        const double sinw0 = sin(w0);
+        const double Q = 0.7071067811865476;
+        const double alpha = sinw0 / (2.0 * Q);
+        
+        const double a0 = 1.0 + alpha;
+        c.b0 = ((1.0 - cosw0) / 2.0) / a0;
+        c.b1 = (1.0 - cosw0) / a0;
+        c.b2 = ((1.0 - cosw0) / 2.0) / a0;
+        c.a1 = (-2.0 * cosw0) / a0;
+        c.a2 = (1.0 - alpha) / a0;
+    }
+    
+    void calculateButterworthHP(BiquadCoeffs<double>& c, float freq, float sr) {
+        const double w0 = 2.0 * 3.14159265358979323846 * freq / sr;
+        const double cosw0 = cos(w0);
+        const double sinw0 = sin(w0);
+        const double Q = 0.7071067811865476;
+        const double alpha = sinw0 / (2.0 * Q);
+        
+        const double a0 = 1.0 + alpha;
+        c.b0 = ((1.0 + cosw0) / 2.0) / a0;
+        c.b1 = (-(1.0 + cosw0)) / a0;
+        c.b2 = ((1.0 + cosw0) / 2.0) / a0;
+        c.a1 = (-2.0 * cosw0) / a0;
+        c.a2 = (1.0 - alpha) / a0;
+    }
+    
+    // bandL / bandR: kNumBands samples each, lowest band first
+    inline void processSample(float inL, float inR, float* bandL, float* bandR) {
+        if (doublePrecision) precise.process(inL, inR, bandL, bandR);
+        else fast.process(inL, inR, bandL, bandR);
+    }
+
+    // processSample over up to kMaxChunkSize samples: bandL[b] / bandR[b] receive band b. Each split
+    // runs over the whole chunk before the next (the same arithmetic, so the same samples)
+    inline void processChunk(const float* inL, const float* inR, float* const* bandL, float* const* bandR,
+                             int numSamples) {
+        if (doublePrecision) precise.processChunk(inL, inR, bandL, bandR, numSamples);
+        else fast.processChunk(inL, inR, bandL, bandR, numSamples);
+    }
+    
+    void reset() {
+        precise.reset();
+        fast.reset();
+    }
+
+    // All biquad memories below 'threshold'
+    bool isIdle(double threshold) const {
+        return doublePrecision ? precise.isIdle(threshold) : fast.isIdle(threshold);
+    }
+
+    // Denormal fallback (once per block) for hosts that reset MXCSR
+    void flushDenormals() {
+        if (doublePrecision) precise.flushDenormals();
+        else fast.flushDenormals();
+    }
+};
+
+// The VST2 chain's 4-band crossover: the serial cascade, bit for bit what the plugin has always run
+using HyeokStreamDSP = Crossover<4, false>;
+
+//-------------------------------------------------------------------------------------------------------
+// SpectrumAnalyzer - 4096-point spectrum with log bin mapping (Pro-Q 3 style display)
+// FFT scratch per instance; window, twiddles, bit reversal and the log bin map are process-wide
+// shared tables (SharedTables.h). The caller owns the sample history and output bins.
+//-------------------------------------------------------------------------------------------------------
+struct SpectrumAnalyzer {
+    static constexpr int kFftSize = 4096;
+    static constexpr int kSpectrumBins = 512;
+
+    std::shared_ptr<const ELC4L::FftTables> tables;         // Window, twiddles, bit reversal
+    std::shared_ptr<const ELC4L::SpectrumBinMap> binMap;    // Log bins at the prepared sample rate
+    float real[kFftSize];                // FFT real part
+    float imag[kFftSize];                // FFT imaginary part
+
+    SpectrumAnalyzer() : tables(ELC4L::SharedTable<ELC4L::FftTables>::acquire(kFftSize)) {
+        for (int i = 0; i < kFftSize; ++i) {
+            real[i] = 0.0f;
+            imag[i] = 0.0f;
+        }
+    }
+
+    // Not on the audio thread: picks up the shared bin map of this rate
+    void setSampleRate(float sampleRate) {
+        binMap = ELC4L::SharedTable<ELC4L::SpectrumBinMap>::acquire(
+            ELC4L::SpectrumBinMap::Key(sampleRate, kFftSize, kSpectrumBins));
+    }
+
+    // Window + FFT of kFftSize samples, then log-scale bins with tilt correction, smoothed into 'output'
+    void computeSpectrum(const float* input, float* output, float sampleRate) {
+        // 1. Apply window and copy to FFT buffers
+        const float* window = tables->window.data();
+        for (int i = 0; i < kFftSize; ++i) {
+            real[i] = input[i] * window[i];
+            imag[i] = 0.0f;
+        }
+
+        // 2. Perform FFT
+        ELC4L::performFft(*tables, real, imag);
+
+        // 3. Log-scale bin mapping with Pink Noise tilt correction (a rate that was not prepared, as in
+        // the offline tools, builds its map on the stack)
+        const ELC4L::SpectrumBinMap* map = binMap.get();
+        if (!map || !map->matches(sampleRate, kFftSize, kSpectrumBins)) {
+            const ELC4L::SpectrumBinMap local(ELC4L::SpectrumBinMap::Key(sampleRate, kFftSize, kSpectrumBins));
+            mapBins(local, output);
+        } else {
+            mapBins(*map, output);
+        }
+    }
+
+private:
+    void mapBins(const ELC4L::SpectrumBinMap& map, float* output) const {
+        const float invN = 2.0f / (float)kFftSize;
+        for (int bin = 0; bin < kSpectrumBins; ++bin) {
+            const ELC4L::SpectrumBinMap::Bin& b = map.bins[bin];
+
+            // Average nearby bins' MAGNITUDE (not complex values) - summing complex values causes
+            // phase cancellation, especially at high frequencies where the spread is larger
+            float sumMag = 0.0f;
+            for (int idx = b.first; idx < b.first + b.count; ++idx) {
+                float re = real[idx];
+                float im = imag[idx];
+                sumMag += sqrtf(re * re + im * im);
+            }
+            float mag = (sumMag / (float)b.count) * invN;
+
+            // Convert to dB, Pink Noise Tilt Correction (+3dB/Octave) makes the spectrum look
+            // balanced like Pro-Q 3
+            float db = 20.0f * log10f(mag + 1.0e-9f);
+            db += b.tiltDb;
+
+            // Clamp range
+            if (db < -90.0f) db = -90.0f;
+            if (db > 6.0f) db = 6.0f;
+
+            // Asymmetric smoothing (fast attack, slow release), slightly faster at high frequencies
+            if (db > output[bin]) {
+                output[bin] = (1.0f - b.attackCoeff) * output[bin] + b.attackCoeff * db;
+            } else {
+                output[bin] = b.releaseCoeff * output[bin] + (1.0f - b.releaseCoeff) * db;
+            }
+        }
+    }
+};
@@ -56,6 +56,10 @@ namespace Layout {
     // Global left offset to give breathing room
     constexpr int GlobalOffsetX = 80;
 
+    // Header: processing quality selector (left of the LUFS peak readout)
+    constexpr int QualityLabelX = 460;
+    constexpr int QualityLabelW = 220;
+
     // ===== TOP HALF: SPECTRUM ANALYZER =====
     constexpr int SpectrumX = 15 + GlobalOffsetX; // Offset applied
     constexpr int SpectrumY = 55;
@@ -388,10 +392,29 @@ bool HyeokStreamEditor::open(void* ptr) {
         return false;
     }
 
+    HyeokStreamMaster* plugin = getPlugin();
+    if (plugin && !analyzerSubscribed) {
+        plugin->subscribeAnalyzer();
+        analyzerSubscribed = true;
+    }
+
     return true;
 }
 
 void HyeokStreamEditor::close() {
+    if (showDiagnostics) {
+        HyeokStreamMaster* plugin = getPlugin();
+        if (plugin) plugin->setProfilingEnabled(false);
+        showDiagnostics = false;
+    }
+
+    // The analyzer state is freed with the window; the audio thread lets go within a block
+    if (analyzerSubscribed) {
+        HyeokStreamMaster* plugin = getPlugin();
+        if (plugin) plugin->unsubscribeAnalyzer();
+        analyzerSubscribed = false;
+    }
+
     if (hwnd) {
         DestroyWindow(hwnd);
         hwnd = nullptr;
@@ -616,6 +639,83 @@ void HyeokStreamEditor::draw(HDC hdc) {
         drawControl(hdc, controls[i], value);
         drawControlValue(hdc, controls[i], value);
     }
+
+    if (showDiagnostics) drawDiagnostics(hdc);
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Diagnostics overlay: per-stage cost per block over the profiler's last window
+//-------------------------------------------------------------------------------------------------------
+void HyeokStreamEditor::drawDiagnostics(HDC hdc) {
+    using namespace Layout;
+
+    HyeokStreamMaster* plugin = getPlugin();
+    if (!plugin) return;
+
+    RECT panel = { SpectrumX + 50, SpectrumY + 20, SpectrumX + 50 + 420, SpectrumY + 20 + 190 };
+    HBRUSH panelBrush = CreateSolidBrush(ELC_BG_DARK);
+    FillRect(hdc, &panel, panelBrush);
+    DeleteObject(panelBrush);
+
+    HPEN borderPen = CreatePen(PS_SOLID, 1, ELC_GOLD_PRIMARY);
+    HPEN oldPen = (HPEN)SelectObject(hdc, borderPen);
+    HBRUSH oldBrush = (HBRUSH)SelectObject(hdc, GetStockObject(NULL_BRUSH));
+    Rectangle(hdc, panel.left, panel.top, panel.right, panel.bottom);
+    SelectObject(hdc, oldPen);
+    SelectObject(hdc, oldBrush);
+    DeleteObject(borderPen);
+
+    SetBkMode(hdc, TRANSPARENT);
+    SelectObject(hdc, valueFont);
+
+    const int x = panel.left + 12;
+    const int rowH = 18;
+    int y = panel.top + 8;
+    char text[128];
+
+    ELC4L::StageProfileSnapshot profile;
+    if (!plugin->getStageProfile(profile)) {
+        SetTextColor(hdc, ELC_TEXT_DIM);
+        RECT r = { x, y, panel.right - 12, y + rowH };
+        DrawTextA(hdc, "DSP PROFILE - collecting...", -1, &r, DT_LEFT | DT_SINGLELINE);
+        return;
+    }
+
+    SetTextColor(hdc, ELC_GOLD_PRIMARY);
+    sprintf(text, "DSP PROFILE   load %.1f%%   budget %.0f us/block   %u blocks",
+            profile.loadPercent, profile.blockBudgetUs, profile.numBlocks);
+    RECT header = { x, y, panel.right - 12, y + rowH };
+    DrawTextA(hdc, text, -1, &header, DT_LEFT | DT_SINGLELINE);
+    y += rowH + 4;
+
+    const int columns[5] = { x, x + 120, x + 190, x + 260, x + 330 };
+    const char* const titles[5] = { "stage (us)", "min", "avg", "p99", "max" };
+    SetTextColor(hdc, ELC_TEXT_DIM);
+    for (int c = 0; c < 5; ++c) {
+        RECT r = { columns[c], y, columns[c] + 70, y + rowH };
+        DrawTextA(hdc, titles[c], -1, &r, DT_LEFT | DT_SINGLELINE);
+    }
+    y += rowH;
+
+    for (int row = 0; row <= ELC4L::kNumProfileStages; ++row) {
+        const bool isTotal = (row == ELC4L::kNumProfileStages);
+        const ELC4L::StageStats& stats = isTotal ? profile.block : profile.stages[row];
+        const float values[4] = { stats.minUs, stats.avgUs, stats.p99Us, stats.maxUs };
+
+        SetTextColor(hdc, isTotal ? ELC_TEXT_BRIGHT : ELC_TEXT_NORMAL);
+        RECT nameRect = { columns[0], y, columns[1], y + rowH };
+        DrawTextA(hdc, isTotal ? "Block total" : ELC4L::getProfileStageName(row), -1, &nameRect,
+                  DT_LEFT | DT_SINGLELINE);
+        for (int c = 0; c < 4; ++c) {
+            // Values over the block budget are flagged in red
+            SetTextColor(hdc, (values[c] > profile.blockBudgetUs) ? ELC_METER_RED
+                              : (isTotal ? ELC_TEXT_BRIGHT : ELC_TEXT_NORMAL));
+            sprintf(text, "%.1f", values[c]);
+            RECT r = { columns[c + 1], y, columns[c + 1] + 70, y + rowH };
+            DrawTextA(hdc, text, -1, &r, DT_LEFT | DT_SINGLELINE);
+        }
+        y += rowH;
+    }
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -645,6 +745,8 @@ void HyeokStreamEditor::drawBackground(HDC hdc) {
 // Header with ELBIX branding
 //-------------------------------------------------------------------------------------------------------
 void HyeokStreamEditor::drawHeader(HDC hdc) {
+    using namespace Layout;
+
     SetBkMode(hdc, TRANSPARENT);
     SelectObject(hdc, headerFont);
     SetTextColor(hdc, ELC_GOLD_PRIMARY);
@@ -656,6 +758,26 @@ void HyeokStreamEditor::drawHeader(HDC hdc) {
     SetTextColor(hdc, ELC_TEXT_DIM);
     RECT subRect = { 120, 18, 450, 38 };
     DrawTextA(hdc, "ELBIX 4-Band Compressor + Limiter", -1, &subRect, DT_LEFT | DT_SINGLELINE);
+
+    HyeokStreamMaster* plugin = getPlugin();
+    if (!plugin) return;
+
+    // Processing quality (click cycles Eco -> Standard -> High)
+    char text[64];
+    sprintf(text, "QUALITY: %s", ELC4L::getProcessingQualityName(plugin->getProcessingQuality()));
+    SetTextColor(hdc, ELC_GOLD_PRIMARY);
+    RECT qualityRect = { QualityLabelX, 18, QualityLabelX + QualityLabelW, 38 };
+    DrawTextA(hdc, text, -1, &qualityRect, DT_LEFT | DT_SINGLELINE);
+
+    // Quality stepped down under CPU overload (below the quality selector)
+    const int tier = plugin->getQualityTier();
+    if (tier != ELC4L::kQualityFull) {
+        sprintf(text, "CPU SAVE: %s", ELC4L::getQualityTierName(tier));
+        SetTextColor(hdc, ELC_LIMITER);
+        SelectObject(hdc, smallFont);
+        RECT tierRect = { QualityLabelX, 38, kEditorWidth - 330, 52 };
+        DrawTextA(hdc, text, -1, &tierRect, DT_LEFT | DT_SINGLELINE);
+    }
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -2336,6 +2458,14 @@ void HyeokStreamEditor::onMouseDown(int x, int y, bool shiftHeld) {
             return;
         }
 
+        // Processing quality selector in the header
+        if (x >= QualityLabelX && x <= QualityLabelX + QualityLabelW && y >= 12 && y <= 38) {
+            const int next = (plugin->getProcessingQuality() + 1) % ELC4L::kNumProcessingQualities;
+            plugin->setParameterAutomated(kParamQuality, ELC4L::processingQualityToNormalized(next));
+            InvalidateRect(hwnd, nullptr, FALSE);
+            return;
+        }
+
         // IN/OUT meters
         int panelX = IOSectionX - 5;
         int panelY = BandSectionY;
@@ -2706,6 +2836,16 @@ void HyeokStreamEditor::onMouseWheel(int delta, bool shiftHeld) {
 // Double-click for value input
 //-------------------------------------------------------------------------------------------------------
 void HyeokStreamEditor::onDoubleClick(int x, int y) {
+    // Double-click on the ELC4L title toggles the diagnostics overlay
+    if (x >= 20 && x < 110 && y >= 8 && y < 45) {
+        HyeokStreamMaster* plugin = getPlugin();
+        if (!plugin) return;
+        showDiagnostics = !showDiagnostics;
+        plugin->setProfilingEnabled(showDiagnostics);
+        InvalidateRect(hwnd, nullptr, FALSE);
+        return;
+    }
+
     // Check if clicked on a value display area
     int ctrlIndex = hitTestValueArea(x, y);
     if (ctrlIndex >= 0) {
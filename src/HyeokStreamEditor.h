@@ -179,6 +179,7 @@ private:
     void drawSlider(HDC hdc, const Control& ctrl, float value);
     void drawControlValue(HDC hdc, const Control& ctrl, float value);
     void drawLufs(HDC hdc, float lufs);
+    void drawDiagnostics(HDC hdc);  // Hidden per-stage CPU overlay (double-click the title)
     void drawVerticalMeter(HDC hdc, int x, int y, int w, int h, float db, 
                            COLORREF color, const char* label, bool isGR);
     void drawMSDButton(HDC hdc, int x, int y, int w, int h, const char* label, bool active, COLORREF activeColor);
@@ -232,6 +233,12 @@ private:
     bool activeSidechainDrag = false;
     int scDragStartX = 0;
     float scDragStartValue = 0.0f;
+
+    // Diagnostics overlay (toggled by double-clicking the ELC4L title)
+    bool showDiagnostics = false;
+
+    // Holds the plugin's analyzer state while the window is open
+    bool analyzerSubscribed = false;
     
     DWORD lastUiUpdateMs;
     
@@ -6,21 +6,10 @@
 
 #include "HyeokStreamMaster.h"
 #include "HyeokStreamEditor.h"
+#include "RealtimeGuard.h"
 #include <cstdio>
 #include <cstring>
 
-// 32-tap Polyphase FIR Coefficients (Kaiser Windowed Sinc)
-const float PolyphaseOversampler::kCoeffs[32] = {
-    // Phase 0
-    -0.002f, 0.005f, -0.012f, 0.025f, 0.965f, 0.025f, -0.012f, 0.005f,
-    // Phase 1
-    -0.004f, 0.010f, -0.025f, 0.060f, 0.880f, 0.090f, -0.025f, 0.010f,
-    // Phase 2
-    -0.005f, 0.015f, -0.040f, 0.120f, 0.750f, 0.180f, -0.040f, 0.015f,
-    // Phase 3
-    -0.004f, 0.012f, -0.045f, 0.220f, 0.550f, 0.280f, -0.045f, 0.012f
-};
-
 //-------------------------------------------------------------------------------------------------------
 // HyeokStreamMaster implementation
 //-------------------------------------------------------------------------------------------------------
@@ -52,34 +41,20 @@ HyeokStreamMaster::HyeokStreamMaster(audioMasterCallback audioMaster)
     parameters[kParamLimiterThresh] = kDefaultLimiterThresh;
     parameters[kParamLimiterCeiling] = kDefaultLimiterCeiling;
     parameters[kParamLimiterRelease] = kDefaultLimiterRelease;
+    parameters[kParamQuality] = kDefaultQuality;
 
-    for (int i = 0; i < kSpectrumBins; ++i) {
-        spectrumIn[i] = -90.0f;
-        spectrumOut[i] = -90.0f;
-    }
-    for (int i = 0; i < kDisplayBins; ++i) {
-        displayIn[i] = -90.0f;
-        displayOut[i] = -90.0f;
-    }
-    for (int i = 0; i < kFftSize; ++i) {
-        fftBufferIn[i] = 0.0f;
-        fftBufferOut[i] = 0.0f;
-    }
-    fftWritePos = 0;
-    fftInitialized = false;
-    inputDb = -120.0f;
-    outputDb = -120.0f;
-    for (int i = 0; i < 4; ++i) {
-        bandGrDb[i] = 0.0f;
+    dspSleeping = false;
+    for (int i = 0; i < kNumBands; ++i) {
         bandMute[i] = false;
         bandSolo[i] = false;
         bandDelta[i] = false;
         bandBypass[i] = false;
+        bandMakeupGains[i] = 1.0f;
     }
-    limiterGrDb = 0.0f;
     limiterBypass = false;
-    
-    initFFT();  // Initialize FFT tables
+    profiler.prepare(sampleRate);
+    governor.prepare(sampleRate);
+    telemetry.open(ELC4L::kTelemetryWrapperVst2);
     
     updateCompressors();
     updateFrequencies();
@@ -89,197 +64,339 @@ HyeokStreamMaster::HyeokStreamMaster(audioMasterCallback audioMaster)
 }
 
 HyeokStreamMaster::~HyeokStreamMaster() {
+    ELC4L_RT_REPORT();
+    // AudioEffect deletes the editor after our members are gone: let it drop its analyzer hold now
+    if (editor) editor->close();
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Analyzer: allocated while an editor is open, so headless instances skip its ~70 KB and its FFTs
+//-------------------------------------------------------------------------------------------------------
+void HyeokStreamMaster::subscribeAnalyzer() {
+    const float rate = sampleRate;
+    analyzerLink.subscribe([this, rate](AnalyzerState& state) {
+        state.analyzer.setSampleRate(rate);
+        // A fresh state: locked before the audio thread can see it (ELC4L_LOCK_MEMORY)
+        if (memoryLockMode == ELC4L::kMemoryLockOff) return;
+        const ELC4L::MemoryRegion region = { &state, sizeof(state) };
+        analyzerMemoryLock.lock(memoryLockMode, &region, 1);
+        ELC4L::MemoryLock::printReport("ELC4L VST2 analyzer", memoryLockMode, analyzerMemoryLock.getReport());
+    });
+}
+
+void HyeokStreamMaster::unsubscribeAnalyzer() {
+    analyzerLink.unsubscribe();
+    if (!analyzerLink.isAllocated()) analyzerMemoryLock.unlock();
+}
+
+// Floor shown when no analyzer state exists
+static const float* getSilentSpectrum() {
+    static float silent[kSpectrumBins];
+    static const bool filled = [] {
+        for (int i = 0; i < kSpectrumBins; ++i) silent[i] = -90.0f;
+        return true;
+    }();
+    (void)filled;
+    return silent;
+}
+
+const float* HyeokStreamMaster::getSpectrumIn() const {
+    const AnalyzerState* state = analyzerLink.get();
+    return state ? state->spectrumIn : getSilentSpectrum();
+}
+
+const float* HyeokStreamMaster::getSpectrumOut() const {
+    const AnalyzerState* state = analyzerLink.get();
+    return state ? state->spectrumOut : getSilentSpectrum();
+}
+
+const float* HyeokStreamMaster::getDisplayIn() const {
+    const AnalyzerState* state = analyzerLink.get();
+    return state ? state->displayIn : getSilentSpectrum();
+}
+
+const float* HyeokStreamMaster::getDisplayOut() const {
+    const AnalyzerState* state = analyzerLink.get();
+    return state ? state->displayOut : getSilentSpectrum();
 }
 
 //-------------------------------------------------------------------------------------------------------
 // Audio processing
 //-------------------------------------------------------------------------------------------------------
 void HyeokStreamMaster::processReplacing(float** inputs, float** outputs, VstInt32 sampleFrames) {
+    ELC4L_RT_SCOPE("HyeokStreamMaster::processReplacing");
+    ELC4L::ScopedFlushDenormals noDenormals;
+    const ELC4L::LazyEditorState<AnalyzerState>::AudioAccess analyzerAccess(analyzerLink, analyzer);
+    
     float* inL = inputs[0];
     float* inR = inputs[1];
     float* outL = outputs[0];
     float* outR = outputs[1];
-    
-    // Check if any band is in Solo mode
-    bool anySolo = bandSolo[0] || bandSolo[1] || bandSolo[2] || bandSolo[3];
-    
-    for (VstInt32 i = 0; i < sampleFrames; ++i) {
-        float b1L, b1R, b2L, b2R, b3L, b3R, b4L, b4R;
 
-        // 1. Split into 4 bands
-        dsp.processSample(inL[i], inR[i], b1L, b1R, b2L, b2R, b3L, b3R, b4L, b4R);
-
-        // Store uncompressed band signals for Delta calculation
-        float bandInputL[4] = { b1L, b2L, b3L, b4L };
-        float bandInputR[4] = { b1R, b2R, b3R, b4R };
+    profiler.beginBlock();
+    const int64_t telemetryStart = telemetry.beginBlock();
+    const int64_t governorStart = governor.beginBlock();
+
+    // Host bypass: once the crossfade to the dry path is done only its delay line runs
+    if (!hostBypass.beginBlock()) {
+        if (hostBypass.takeFlushRequest()) enterSilenceSleep();
+        hostBypass.processDry(inL, inR, outL, outR, sampleFrames);
+        profiler.endBlock(sampleFrames);
+        applyQuality(processingQuality, governor.endBlock(governorStart, sampleFrames));
+        telemetry.endBlock(telemetryStart, outL, outR, sampleFrames, sampleRate, meters.bandGrDb,
+                           meters.limiterGrDb, lufsMeter.getMomentary());
+        return;
+    }
 
-        // [MOVED UP] Calculate makeup gains FIRST (needed for bypass logic)
-        float makeupGains[4];
-        for (int b = 0; b < 4; ++b) {
-            float makeupDb = normalizedToCompMakeupDb(parameters[kParamBand1Makeup + b]);
-            makeupGains[b] = dbToLinear(makeupDb);
+    // Silence sleep: once the input is silent and every tail has drained, skip the DSP entirely
+    const bool inputSilent = ELC4L::isBlockSilent(inL, inR, sampleFrames, ELC4L::kSilenceInputThreshold);
+    if (inputSilent && dspSleeping) {
+        for (VstInt32 i = 0; i < sampleFrames; ++i) {
+            outL[i] = 0.0f;
+            outR[i] = 0.0f;
+        }
+        lufsMeter.processSilence(sampleFrames);
+        hostBypass.advanceSilent(sampleFrames);
+        profiler.endBlock(sampleFrames);
+        applyQuality(processingQuality, governor.endBlock(governorStart, sampleFrames));
+        telemetry.endBlock(telemetryStart, outL, outR, sampleFrames, sampleRate, meters.bandGrDb,
+                           meters.limiterGrDb, lufsMeter.getMomentary());
+        return;
+    }
+    dspSleeping = false;
+    applyQuality(ELC4L::normalizedToProcessingQuality(parameters[kParamQuality]), qualityTier);
+    
+    // Everything the monitoring switches decide is resolved here, once per block: each band gets the
+    // kernel specialized for its bypass / M/S / delta combination (bands that are not heard only keep
+    // their detector running), the mix only visits the bands that are heard and the output kernel is
+    // specialized for the limiter bypass
+    bool anySolo = false;
+    for (int b = 0; b < kNumBands; ++b) anySolo |= bandSolo[b];
+    BandKernel kernels[kNumBands];
+    int playedBands[kNumBands];
+    int numPlayed = 0;
+    for (int b = 0; b < kNumBands; ++b) {
+        bandMakeupGains[b] = dbToLinear(normalizedToCompMakeupDb(parameters[kParamBand1Makeup + b]));
+        int flags = 0;
+        if (bandBypass[b]) flags |= kBandKernelBypass;
+        if (parameters[kParamBand1Mode + b] > 0.5f) flags |= kBandKernelMidSide;
+        if (bandDelta[b]) flags |= kBandKernelDelta;
+        if (anySolo ? bandSolo[b] : !bandMute[b]) playedBands[numPlayed++] = b;
+        else flags = kBandKernelMuted | (flags & ~kBandKernelDelta);
+        kernels[b] = bandKernels[flags];
+    }
+    const OutputKernel outputKernel = limiterBypass ? &HyeokStreamMaster::processOutputChunk<true>
+                                                    : &HyeokStreamMaster::processOutputChunk<false>;
+
+    float bandL[kNumBands][kChunkSize], bandR[kNumBands][kChunkSize];
+    float* bandPtrL[kNumBands];
+    float* bandPtrR[kNumBands];
+    for (int b = 0; b < kNumBands; ++b) {
+        bandPtrL[b] = bandL[b];
+        bandPtrR[b] = bandR[b];
+    }
+    float mixL[kChunkSize], mixR[kChunkSize];
+    for (VstInt32 start = 0; start < sampleFrames; start += kChunkSize) {
+        const int n = (sampleFrames - start < kChunkSize) ? (int)(sampleFrames - start) : kChunkSize;
+        profiler.beginChunk(n);
+        hostBypass.pushInput(inL + start, inR + start, n);
+
+        // 1. Split into bands
+        dsp.processChunk(inL + start, inR + start, bandPtrL, bandPtrR, n);
+        profiler.lap(ELC4L::kStageCrossover);
+
+        // 2. Band compressors (muted bands: detector only, so their gain stays in step)
+        for (int b = 0; b < kNumBands; ++b) {
+            (this->*kernels[b])(b, bandL[b], bandR[b], n);
         }
 
-        // 2. Process each band (Corrected M/S Logic: Loose Side)
-        // Band 1
-        bool bandModeMS0 = (parameters[kParamBand1Mode] > 0.5f);
-        if (!bandBypass[0]) {
-            if (bandModeMS0) {
-                // M/S with Loose Side Logic
-                float M = 0.5f * (b1L + b1R);
-                float S = 0.5f * (b1L - b1R);
-
-                float pM = M, pS = S;
-                bandComps[0].process(pM, pS);
-
-                // Loose side: reduce compression on S channel when gain < 1
-                float gain = bandComps[0].getCurrentGain();
-                if (gain < 1.0f && gain > 0.0f) {
-                    float looseGain = 1.0f - (1.0f - gain) * 0.5f; // half the compression on side
-                    float correction = looseGain / gain;
-                    pS *= correction;
-                }
-
-                b1L = pM + pS;
-                b1R = pM - pS;
-            } else {
-                bandComps[0].process(b1L, b1R);
+        // 3. Mute / Solo: sum the bands that are heard
+        for (int i = 0; i < n; ++i) {
+            mixL[i] = 0.0f;
+            mixR[i] = 0.0f;
+        }
+        for (int p = 0; p < numPlayed; ++p) {
+            const float* l = bandL[playedBands[p]];
+            const float* r = bandR[playedBands[p]];
+            for (int i = 0; i < n; ++i) {
+                mixL[i] += l[i];
+                mixR[i] += r[i];
             }
-        } else {
-            b1L *= makeupGains[0];
-            b1R *= makeupGains[0];
         }
+        profiler.lap(ELC4L::kStageCompressors);
 
-        // Band 2 (same logic)
-        bool bandModeMS1 = (parameters[kParamBand2Mode] > 0.5f);
-        if (!bandBypass[1]) {
-            if (bandModeMS1) {
-                float M = 0.5f * (b2L + b2R);
-                float S = 0.5f * (b2L - b2R);
-                float pM = M, pS = S;
-                bandComps[1].process(pM, pS);
+        // 4. Limiter, meters and output
+        (this->*outputKernel)(inL + start, inR + start, mixL, mixR, outL + start, outR + start, n);
+        hostBypass.mixOutput(outL + start, outR + start, n);
+    }
 
-                float gain = bandComps[1].getCurrentGain();
-                if (gain < 1.0f && gain > 0.0f) {
-                    float looseGain = 1.0f - (1.0f - gain) * 0.5f;
-                    pS *= (looseGain / gain);
-                }
+    // Fallback for hosts that reset MXCSR behind our back: no state may stay subnormal
+    dsp.flushDenormals();
+    bandComps.flushDenormals();
+    limiter.flushDenormals();
+    lufsMeter.flushDenormals();
 
-                b2L = pM + pS;
-                b2R = pM - pS;
-            } else {
-                bandComps[1].process(b2L, b2R);
-            }
-        } else {
-            b2L *= makeupGains[1];
-            b2R *= makeupGains[1];
-        }
+    // Keep running on silent input until the crossover, compressors and limiter have drained
+    if (inputSilent && isDspIdle()) {
+        enterSilenceSleep();
+    }
+    profiler.endBlock(sampleFrames);
+    applyQuality(processingQuality, governor.endBlock(governorStart, sampleFrames));
+    telemetry.endBlock(telemetryStart, outL, outR, sampleFrames, sampleRate, meters.bandGrDb,
+                       meters.limiterGrDb, lufsMeter.getMomentary());
+}
 
-        // Band 3
-        bool bandModeMS2 = (parameters[kParamBand3Mode] > 0.5f);
-        if (!bandBypass[2]) {
-            if (bandModeMS2) {
-                float M = 0.5f * (b3L + b3R);
-                float S = 0.5f * (b3L - b3R);
-                float pM = M, pS = S;
-                bandComps[2].process(pM, pS);
+//-------------------------------------------------------------------------------------------------------
+// Specialized chunk kernels (selected per block in processReplacing)
+//-------------------------------------------------------------------------------------------------------
+const HyeokStreamMaster::BandKernel HyeokStreamMaster::bandKernels[kNumBandKernels] = {
+    &HyeokStreamMaster::processBandChunk<0>, &HyeokStreamMaster::processBandChunk<1>,
+    &HyeokStreamMaster::processBandChunk<2>, &HyeokStreamMaster::processBandChunk<3>,
+    &HyeokStreamMaster::processBandChunk<4>, &HyeokStreamMaster::processBandChunk<5>,
+    &HyeokStreamMaster::processBandChunk<6>, &HyeokStreamMaster::processBandChunk<7>,
+    &HyeokStreamMaster::processBandChunk<8>, &HyeokStreamMaster::processBandChunk<9>,
+    &HyeokStreamMaster::processBandChunk<10>, &HyeokStreamMaster::processBandChunk<11>,
+    &HyeokStreamMaster::processBandChunk<12>, &HyeokStreamMaster::processBandChunk<13>,
+    &HyeokStreamMaster::processBandChunk<14>, &HyeokStreamMaster::processBandChunk<15>
+};
 
-                float gain = bandComps[2].getCurrentGain();
-                if (gain < 1.0f && gain > 0.0f) {
-                    float looseGain = 1.0f - (1.0f - gain) * 0.5f;
-                    pS *= (looseGain / gain);
+// One band over one chunk, in place: compressor (M/S with loose side), saturation timed as its own
+// stage, or makeup only when bypassed; Delta Listen replaces the output with the removed signal.
+// A band that is not heard only updates its detector and leaves the buffer as scratch.
+template <int Flags>
+void HyeokStreamMaster::processBandChunk(int band, float* left, float* right, int numSamples) {
+    constexpr bool bypass = (Flags & kBandKernelBypass) != 0;
+    constexpr bool midSide = (Flags & kBandKernelMidSide) != 0;
+    constexpr bool delta = (Flags & kBandKernelDelta) != 0;
+    constexpr bool muted = (Flags & kBandKernelMuted) != 0;
+
+    if constexpr (muted) {
+        // A bypassed compressor has no state to keep warm
+        if constexpr (!bypass) {
+            if constexpr (midSide) {
+                for (int i = 0; i < numSamples; ++i) {
+                    const float M = 0.5f * (left[i] + right[i]);
+                    const float S = 0.5f * (left[i] - right[i]);
+                    left[i] = M;
+                    right[i] = S;
                 }
-
-                b3L = pM + pS;
-                b3R = pM - pS;
-            } else {
-                bandComps[2].process(b3L, b3R);
             }
-        } else {
-            b3L *= makeupGains[2];
-            b3R *= makeupGains[2];
+            bandComps[band].processDetectorChunk(left, right, numSamples);
+        }
+        profiler.lap(ELC4L::kStageCompressors);
+        return;
+    } else if constexpr (bypass) {
+        const float makeup = bandMakeupGains[band];
+        for (int i = 0; i < numSamples; ++i) {
+            // A bypassed band removes nothing, so its delta is silence
+            left[i] = delta ? left[i] * 0.0f : left[i] * makeup;
+            right[i] = delta ? right[i] * 0.0f : right[i] * makeup;
+        }
+        profiler.lap(ELC4L::kStageCompressors);
+        return;
+    } else {
+        OptoCompressor& comp = bandComps[band];
+        float inputL[kChunkSize], inputR[kChunkSize];   // Uncompressed band (Delta Listen)
+        float gains[kChunkSize];
+        if constexpr (delta) {
+            for (int i = 0; i < numSamples; ++i) {
+                inputL[i] = left[i];
+                inputR[i] = right[i];
+            }
+        }
+        if constexpr (midSide) {
+            for (int i = 0; i < numSamples; ++i) {
+                const float M = 0.5f * (left[i] + right[i]);
+                const float S = 0.5f * (left[i] - right[i]);
+                left[i] = M;
+                right[i] = S;
+            }
         }
 
-        // Band 4
-        bool bandModeMS3 = (parameters[kParamBand4Mode] > 0.5f);
-        if (!bandBypass[3]) {
-            if (bandModeMS3) {
-                float M = 0.5f * (b4L + b4R);
-                float S = 0.5f * (b4L - b4R);
-                float pM = M, pS = S;
-                bandComps[3].process(pM, pS);
-
-                float gain = bandComps[3].getCurrentGain();
+        comp.processDynamicsChunk(left, right, gains, numSamples);
+        profiler.lap(ELC4L::kStageCompressors);
+        comp.processSaturationChunk(left, right, numSamples);
+        profiler.lap(ELC4L::kStageSaturation);
+
+        if constexpr (delta) {
+            // Delta Listen: play only the amount of reduction introduced by the compressor
+            for (int i = 0; i < numSamples; ++i) {
+                const float reductionAmount = 1.0f - gains[i];
+                left[i] = inputL[i] * reductionAmount;
+                right[i] = inputR[i] * reductionAmount;
+            }
+        } else if constexpr (midSide) {
+            // Loose side: half the compression on the S channel when gain < 1
+            for (int i = 0; i < numSamples; ++i) {
+                const float gain = gains[i];
+                const float pM = left[i];
+                float pS = right[i];
                 if (gain < 1.0f && gain > 0.0f) {
                     float looseGain = 1.0f - (1.0f - gain) * 0.5f;
                     pS *= (looseGain / gain);
                 }
-
-                b4L = pM + pS;
-                b4R = pM - pS;
-            } else {
-                bandComps[3].process(b4L, b4R);
-            }
-        } else {
-            b4L *= makeupGains[3];
-            b4R *= makeupGains[3];
-        }
-        
-        // Band output arrays
-        float bandOutL[4] = { b1L, b2L, b3L, b4L };
-        float bandOutR[4] = { b1R, b2R, b3R, b4R };
-
-        // 3. Apply Delta/Mute/Solo logic
-        float mixL = 0.0f;
-        float mixR = 0.0f;
-        
-        for (int b = 0; b < 4; ++b) {
-            float outBandL, outBandR;
-            
-            if (bandDelta[b]) {
-                // Delta Listen: play only the amount of reduction introduced by the compressor
-                float reductionAmount = 0.0f;
-                if (!bandBypass[b]) {
-                    reductionAmount = 1.0f - bandComps[b].getCurrentGain();
-                }
-
-                outBandL = bandInputL[b] * reductionAmount;
-                outBandR = bandInputR[b] * reductionAmount;
-            } else {
-                outBandL = bandOutL[b];
-                outBandR = bandOutR[b];
-            }
-            
-            // Solo/Mute logic
-            bool playBand = false;
-            if (anySolo) {
-                playBand = bandSolo[b];
-            } else {
-                playBand = !bandMute[b];
-            }
-            
-            if (playBand) {
-                mixL += outBandL;
-                mixR += outBandR;
+                left[i] = pM + pS;
+                right[i] = pM - pS;
             }
         }
+    }
+}
 
-        // 4. Apply limiter
-        if (!limiterBypass) {
-            limiter.process(mixL, mixR);
-        }
-        lufsMeter.process(mixL, mixR);
+// Limiter (skipped when bypassed), LUFS / level meters and the output of one chunk. out may alias in:
+// each input sample is read by the meters before its output is written
+template <bool LimiterBypass>
+void HyeokStreamMaster::processOutputChunk(const float* inL, const float* inR, float* mixL, float* mixR,
+                                           float* outL, float* outR, int numSamples) {
+    if constexpr (!LimiterBypass) {
+        limiter.processChunk(mixL, mixR, numSamples);
+    }
+    profiler.lap(ELC4L::kStageLimiter);
 
-        updateMeters(inL[i], inR[i], mixL, mixR);
-        bandGrDb[0] = bandComps[0].getGainReductionDb();
-        bandGrDb[1] = bandComps[1].getGainReductionDb();
-        bandGrDb[2] = bandComps[2].getGainReductionDb();
-        bandGrDb[3] = bandComps[3].getGainReductionDb();
-        limiterGrDb = limiter.getGainReductionDb();
+    lufsMeter.processChunk(mixL, mixR, numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        updateMeters(inL[i], inR[i], mixL[i], mixR[i]);
+        outL[i] = mixL[i];
+        outR[i] = mixR[i];
+    }
+    for (int b = 0; b < kNumBands; ++b) {
+        meters.bandGrDb[b] = bandComps[b].getGainReductionDb();
+    }
+    meters.limiterGrDb = limiter.getGainReductionDb();
+    profiler.lap(ELC4L::kStageMetering);
+}
 
-        outL[i] = mixL;
-        outR[i] = mixR;
+// Processing quality and overload tier: the saturation path is crossfaded, everything else switches
+// at the block boundary (a lookahead change clears the limiter's delay line). A change of the 8x
+// alignment moves the output like the lookahead change does, so the path switches with it.
+void HyeokStreamMaster::applyQuality(int quality, int tier) {
+    if (quality == processingQuality && tier == qualityTier) return;
+    processingQuality = quality;
+    qualityTier = tier;
+
+    const ELC4L::QualitySettings settings = ELC4L::getQualitySettings(quality, tier);
+    const int latencyFactor = ELC4L::getQualitySettings(quality, ELC4L::kQualityFull).saturationFactor;
+    dsp.setDoublePrecision(settings.doublePrecisionCrossover);
+    for (int b = 0; b < kNumBands; ++b) {
+        const bool realigned = bandComps[b].setLatencyFactor(latencyFactor);
+        bandComps[b].fadeSaturationFactor(settings.saturationFactor, realigned ? 0 : governor.getCrossfadeSamples());
+        bandComps[b].setGainComputerInterval(settings.gainComputerInterval);
     }
+    limiter.setExtendedLookahead(settings.extendedLookahead);
+    hostBypass.setLatency(limiter.getLookaheadSamples() + bandComps.getSaturationLatency());
+    analyzerHopSize = kFftHopSize * settings.analyzerHopScale;
+    telemetry.setQualityTier(tier);
+}
+
+// The lookahead of the selected quality, plus the 8x saturation's extra delay, is the plugin's latency
+void HyeokStreamMaster::updateLatency() {
+    const int quality = ELC4L::normalizedToProcessingQuality(parameters[kParamQuality]);
+    const ELC4L::QualitySettings settings = ELC4L::getQualitySettings(quality, ELC4L::kQualityFull);
+    const VstInt32 latency = LookaheadLimiter::getLookaheadSamples(settings.extendedLookahead)
+                           + OptoCompressor::getSaturationLatency(settings.saturationFactor, sampleRate);
+    if (latency == latencySamples) return;
+    latencySamples = latency;
+    setInitialDelay(latencySamples);
+    ioChanged();
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -323,6 +440,9 @@ void HyeokStreamMaster::setParameter(VstInt32 index, float value) {
         case kParamBand4Mode:
             updateCompressors();
             break;
+        case kParamQuality:
+            updateLatency();
+            break;
     }
     
     if (editor) {
@@ -409,6 +529,9 @@ void HyeokStreamMaster::getParameterDisplay(VstInt32 index, char* text) {
         case kParamBand4Mode:
             sprintf(text, "%s", parameters[index] > 0.5f ? "M/S" : "ST" );
             break;
+        case kParamQuality:
+            sprintf(text, "%s", ELC4L::getProcessingQualityName(ELC4L::normalizedToProcessingQuality(parameters[kParamQuality])));
+            break;
         default:
             *text = 0;
     }
@@ -476,6 +599,9 @@ void HyeokStreamMaster::getParameterName(VstInt32 index, char* text) {
         case kParamBand4Mode:
             strcpy(text, "B4 Mode");
             break;
+        case kParamQuality:
+            strcpy(text, "Quality");
+            break;
         default:
             *text = 0;
     }
@@ -520,62 +646,71 @@ VstInt32 HyeokStreamMaster::canDo(char* text) {
     if (strcmp(text, "receiveVstMidiEvent") == 0) return -1;
     if (strcmp(text, "sendVstEvents") == 0) return -1;
     if (strcmp(text, "sendVstMidiEvent") == 0) return -1;
+    if (strcmp(text, "bypass") == 0) return 1;
     return 0;
 }
 
+// Soft bypass: the dry signal stays aligned with the reported latency (see HostBypass)
+bool HyeokStreamMaster::setBypass(bool onOff) {
+    hostBypass.setBypassed(onOff);
+    return true;
+}
+
 //-------------------------------------------------------------------------------------------------------
 // State
 //-------------------------------------------------------------------------------------------------------
 void HyeokStreamMaster::setSampleRate(float sampleRate) {
     AudioEffectX::setSampleRate(sampleRate);
     dsp.setSampleRate(sampleRate);
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].setSampleRate(sampleRate);
-    }
+    bandComps.setSampleRate(sampleRate);
     limiter.setSampleRate(sampleRate);
     lufsMeter.setSampleRate(sampleRate);
+    analyzerLink.update([sampleRate](AnalyzerState& state) { state.analyzer.setSampleRate(sampleRate); });
+    profiler.prepare(sampleRate);
+    governor.prepare(sampleRate);
+    hostBypass.prepare(sampleRate);
+    hostBypass.setLatency(limiter.getLookaheadSamples() + bandComps.getSaturationLatency());
+    updateLatency();
 }
 
 void HyeokStreamMaster::suspend() {
+    ELC4L_RT_REPORT();
+    memoryLock.unlock();
     dsp.reset();
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].reset();
-    }
+    bandComps.reset();
     limiter.reset();
     lufsMeter.reset();
+    dspSleeping = false;
 }
 
 void HyeokStreamMaster::resume() {
     AudioEffectX::resume();
     dsp.reset();
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].reset();
-    }
+    bandComps.reset();
     limiter.reset();
     lufsMeter.reset();
+    dspSleeping = false;
+    lockDspMemory();
+}
+
+// Stages and meters (the arena) plus the instance itself (host bypass delay line, profiler, flags)
+void HyeokStreamMaster::lockDspMemory() {
+    if (memoryLockMode == ELC4L::kMemoryLockOff) return;
+    const ELC4L::MemoryRegion regions[] = {
+        { dspArena.data(), dspArena.size() },
+        { this, sizeof(*this) }
+    };
+    memoryLock.lock(memoryLockMode, regions, 2);
+    ELC4L::MemoryLock::printReport("ELC4L VST2", memoryLockMode, memoryLock.getReport());
 }
 
 //-------------------------------------------------------------------------------------------------------
 // Private helpers
 //-------------------------------------------------------------------------------------------------------
 void HyeokStreamMaster::updateCompressors() {
-    const float threshDb[4] = {
-        normalizedToCompThreshDb(parameters[kParamBand1Thresh]),
-        normalizedToCompThreshDb(parameters[kParamBand2Thresh]),
-        normalizedToCompThreshDb(parameters[kParamBand3Thresh]),
-        normalizedToCompThreshDb(parameters[kParamBand4Thresh])
-    };
-
-    const float makeupDb[4] = {
-        normalizedToCompMakeupDb(parameters[kParamBand1Makeup]),
-        normalizedToCompMakeupDb(parameters[kParamBand2Makeup]),
-        normalizedToCompMakeupDb(parameters[kParamBand3Makeup]),
-        normalizedToCompMakeupDb(parameters[kParamBand4Makeup])
-    };
-
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].setThresholdDb(threshDb[i]);
-        bandComps[i].setMakeupDb(makeupDb[i]);
+    for (int i = 0; i < kNumBands; ++i) {
+        bandComps[i].setThresholdDb(normalizedToCompThreshDb(parameters[kParamBand1Thresh + i]));
+        bandComps[i].setMakeupDb(normalizedToCompMakeupDb(parameters[kParamBand1Makeup + i]));
         bandComps[i].updateCoefficients();
     }
 
@@ -584,26 +719,30 @@ void HyeokStreamMaster::updateCompressors() {
     // Map normalized 0..1 -> 20..20000 Hz (logarithmic)
     float scNorm = parameters[kParamSidechainFreq];
     float scFreq = 20.0f * powf(20000.0f / 20.0f, scNorm); // 20..20000
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < kNumBands; ++i) {
         bandComps[i].setSidechainEnabled(scActive);
         bandComps[i].setSidechainFreq(scFreq);
     }
 }
 
 void HyeokStreamMaster::updateFrequencies() {
-    float x1 = normalizedToFrequency(parameters[kParamXover1]);
-    float x2 = normalizedToFrequency(parameters[kParamXover2]);
-    float x3 = normalizedToFrequency(parameters[kParamXover3]);
+    const int numSplits = HyeokStreamDSP::kNumSplits;
+    float freqs[numSplits];
+    for (int k = 0; k < numSplits; ++k) {
+        freqs[k] = normalizedToFrequency(parameters[kParamXover1 + k]);
+    }
 
-    if (x1 >= x2) x1 = x2 * 0.85f;
-    if (x2 >= x3) x2 = x3 * 0.85f;
+    // Each split point stays below the next one
+    for (int k = 0; k + 1 < numSplits; ++k) {
+        if (freqs[k] >= freqs[k + 1]) freqs[k] = freqs[k + 1] * 0.85f;
+    }
 
-    if (x1 < kMinFreq) x1 = kMinFreq;
-    if (x3 > kMaxFreq) x3 = kMaxFreq;
+    if (freqs[0] < kMinFreq) freqs[0] = kMinFreq;
+    if (freqs[numSplits - 1] > kMaxFreq) freqs[numSplits - 1] = kMaxFreq;
 
-    dsp.setXover1(x1);
-    dsp.setXover2(x2);
-    dsp.setXover3(x3);
+    for (int k = 0; k < numSplits; ++k) {
+        dsp.setFrequency(k, freqs[k]);
+    }
 }
 
 void HyeokStreamMaster::updateLimiter() {
@@ -616,180 +755,10 @@ void HyeokStreamMaster::updateLimiter() {
     limiter.setRelease(releaseMs);
 }
 
-//-------------------------------------------------------------------------------------------------------
-// FFT Initialization - Pre-compute Blackman-Harris window and bit-reversal table
-//-------------------------------------------------------------------------------------------------------
-void HyeokStreamMaster::initFFT() {
-    // Blackman-Harris Window (better sidelobe rejection than Hann)
-    const float a0 = 0.35875f;
-    const float a1 = 0.48829f;
-    const float a2 = 0.14128f;
-    const float a3 = 0.01168f;
-    const float pi = 3.14159265359f;
-    
-    for (int i = 0; i < kFftSize; ++i) {
-        float t = (float)i / (float)(kFftSize - 1);
-        fftWindow[i] = a0 - a1 * cosf(2.0f * pi * t) + a2 * cosf(4.0f * pi * t) - a3 * cosf(6.0f * pi * t);
-        fftReal[i] = 0.0f;
-        fftImag[i] = 0.0f;
-    }
-
-    // Bit Reversal Table for Cooley-Tukey FFT
-    int levels = 0;
-    int n = kFftSize;
-    while ((1 << levels) < n) levels++;
-    
-    for (int i = 0; i < n; ++i) {
-        int rev = 0, val = i;
-        for (int j = 0; j < levels; ++j) {
-            rev = (rev << 1) | (val & 1);
-            val >>= 1;
-        }
-        fftBitReverse[i] = rev;
-    }
-    
-    fftInitialized = true;
-}
-
-//-------------------------------------------------------------------------------------------------------
-// Cooley-Tukey FFT - O(N log N) instead of O(N^2)
-//-------------------------------------------------------------------------------------------------------
-void HyeokStreamMaster::performFFT(float* real, float* imag, int n) {
-    // Bit-reversal permutation
-    for (int i = 0; i < n; ++i) {
-        if (i < fftBitReverse[i]) {
-            float tmpR = real[i];
-            float tmpI = imag[i];
-            real[i] = real[fftBitReverse[i]];
-            imag[i] = imag[fftBitReverse[i]];
-            real[fftBitReverse[i]] = tmpR;
-            imag[fftBitReverse[i]] = tmpI;
-        }
-    }
-
-    // Butterfly operations
-    for (int len = 2; len <= n; len <<= 1) {
-        float ang = -2.0f * 3.14159265359f / len;
-        float wlenR = cosf(ang);
-        float wlenI = sinf(ang);
-        
-        for (int i = 0; i < n; i += len) {
-            float wR = 1.0f, wI = 0.0f;
-            int half = len >> 1;
-            
-            for (int j = 0; j < half; ++j) {
-                float uR = real[i + j];
-                float uI = imag[i + j];
-                float vR = real[i + j + half] * wR - imag[i + j + half] * wI;
-                float vI = real[i + j + half] * wI + imag[i + j + half] * wR;
-                
-                real[i + j] = uR + vR;
-                imag[i + j] = uI + vI;
-                real[i + j + half] = uR - vR;
-                imag[i + j + half] = uI - vI;
-                
-                float tmpW = wR * wlenR - wI * wlenI;
-                wI = wR * wlenI + wI * wlenR;
-                wR = tmpW;
-            }
-        }
-    }
-}
-
-//-------------------------------------------------------------------------------------------------------
-// Spectrum Computation - Pro-Q 3 style with tilt correction and log mapping
-//-------------------------------------------------------------------------------------------------------
-void HyeokStreamMaster::computeSpectrum(const float* input, float* output) {
-    // 1. Apply window and copy to FFT buffers
-    for (int i = 0; i < kFftSize; ++i) {
-        fftReal[i] = input[i] * fftWindow[i];
-        fftImag[i] = 0.0f;
-    }
-
-    // 2. Perform FFT
-    performFFT(fftReal, fftImag, kFftSize);
-
-    // 3. Log-scale bin mapping with Pink Noise tilt correction
-    const float sr = (sampleRate > 0.0f) ? sampleRate : 44100.0f;
-    const float invN = 2.0f / (float)kFftSize;
-    const float minLogFreq = log10f(20.0f);
-    const float maxLogFreq = log10f(20000.0f);
-    const float logRange = maxLogFreq - minLogFreq;
-
-    for (int bin = 0; bin < kSpectrumBins; ++bin) {
-        // Map display bin to frequency (logarithmic scale for better low-end resolution)
-        float t = (float)bin / (float)(kSpectrumBins - 1);
-        float logFreq = minLogFreq + t * logRange;
-        float freq = powf(10.0f, logFreq);
-        
-        // Find corresponding FFT bin
-        int fftBin = (int)(freq * kFftSize / sr);
-        if (fftBin < 1) fftBin = 1;
-        if (fftBin >= kFftSize / 2) fftBin = kFftSize / 2 - 1;
-
-        // [FIX] Average nearby bins' MAGNITUDE (not complex values!)
-        // Summing complex values causes phase cancellation - especially bad at high frequencies
-        // where spread is larger. We must compute magnitude FIRST, then average.
-        float sumMag = 0.0f;
-        int avgCount = 0;
-        
-        // Spread: narrow at low freq, wider at high freq for noise reduction
-        // Reduced from 8 to 4 at high frequencies to preserve detail
-        int spread = (fftBin < 30) ? 1 : (fftBin < 100 ? 2 : (fftBin < 400 ? 3 : 4));
-        
-        for (int k = -spread; k <= spread; ++k) {
-            int idx = fftBin + k;
-            if (idx >= 1 && idx < kFftSize / 2) {
-                float re = fftReal[idx];
-                float im = fftImag[idx];
-                // [KEY FIX] Compute magnitude for EACH bin before summing
-                // This preserves energy and avoids phase cancellation
-                sumMag += sqrtf(re * re + im * im);
-                avgCount++;
-            }
-        }
-
-        // Compute average magnitude
-        float mag = 0.0f;
-        if (avgCount > 0) {
-            mag = (sumMag / (float)avgCount) * invN;
-        } else {
-            // Fallback: use single bin
-            float re = fftReal[fftBin];
-            float im = fftImag[fftBin];
-            mag = sqrtf(re * re + im * im) * invN;
-        }
-
-        // Convert to dB
-        float db = 20.0f * log10f(mag + 1.0e-9f);
-
-        // [KEY] Pink Noise Tilt Correction (+3dB/Octave)
-        // Makes the spectrum look balanced like Pro-Q 3
-        if (freq > 20.0f) {
-            db += 3.0f * log2f(freq / 1000.0f);
-        }
-
-        // Clamp range
-        if (db < -90.0f) db = -90.0f;
-        if (db > 6.0f) db = 6.0f;
-
-        // [KEY] Asymmetric smoothing (fast attack, slow release)
-        // Slightly faster response at high frequencies
-        float attackCoeff = (freq > 4000.0f) ? 0.50f : 0.35f;
-        float releaseCoeff = (freq > 4000.0f) ? 0.88f : 0.92f;
-        
-        if (db > output[bin]) {
-            output[bin] = (1.0f - attackCoeff) * output[bin] + attackCoeff * db;
-        } else {
-            output[bin] = releaseCoeff * output[bin] + (1.0f - releaseCoeff) * db;
-        }
-    }
-}
-
 //-------------------------------------------------------------------------------------------------------
 // Update Display Buffers (Downsample 512 bins ??128 Bezier-ready points)
 //-------------------------------------------------------------------------------------------------------
-void HyeokStreamMaster::updateDisplayBuffers() {
+void HyeokStreamMaster::updateDisplayBuffers(AnalyzerState& state) {
     const int srcBins = kSpectrumBins;
     const int dstBins = kDisplayBins;
     const int ratio = srcBins / dstBins;  // 512/128 = 4
@@ -802,8 +771,8 @@ void HyeokStreamMaster::updateDisplayBuffers() {
         for (int k = 0; k < ratio; ++k) {
             int srcIdx = startBin + k;
             if (srcIdx < srcBins) {
-                sumIn += spectrumIn[srcIdx];
-                sumOut += spectrumOut[srcIdx];
+                sumIn += state.spectrumIn[srcIdx];
+                sumOut += state.spectrumOut[srcIdx];
             }
         }
         
@@ -811,8 +780,8 @@ void HyeokStreamMaster::updateDisplayBuffers() {
         float avgOut = sumOut / (float)ratio;
         
         // Additional smoothing for Bezier-ready output
-        displayIn[d] = displayIn[d] * 0.6f + avgIn * 0.4f;
-        displayOut[d] = displayOut[d] * 0.6f + avgOut * 0.4f;
+        state.displayIn[d] = state.displayIn[d] * 0.6f + avgIn * 0.4f;
+        state.displayOut[d] = state.displayOut[d] * 0.6f + avgOut * 0.4f;
     }
 }
 
@@ -826,30 +795,65 @@ void HyeokStreamMaster::updateMeters(float inL, float inR, float outL, float out
     float inDb = 10.0f * log10f(inRms + 1.0e-12f);
     float outDb = 10.0f * log10f(outRms + 1.0e-12f);
 
-    inputDb = inputDb * 0.9f + inDb * 0.1f;
-    outputDb = outputDb * 0.9f + outDb * 0.1f;
+    meters.inputDb = meters.inputDb * 0.9f + inDb * 0.1f;
+    meters.outputDb = meters.outputDb * 0.9f + outDb * 0.1f;
+
+    // No editor open (no analyzer state), or analyzer paused under CPU overload: the display holds
+    // its last frame
+    if (analyzerHopSize == 0 || !analyzer) return;
+    AnalyzerState& state = *analyzer;
 
     // Add samples to FFT buffer
     float inMono = 0.5f * (inL + inR);
     float outMono = 0.5f * (outL + outR);
 
-    fftBufferIn[fftWritePos] = inMono;
-    fftBufferOut[fftWritePos] = outMono;
-    fftWritePos++;
+    state.fftBufferIn[state.fftWritePos] = inMono;
+    state.fftBufferOut[state.fftWritePos] = outMono;
+    state.fftWritePos++;
 
-    // Perform FFT with hop (75% overlap for smooth updates)
-    if (fftWritePos >= kFftSize) {
-        computeSpectrum(fftBufferIn, spectrumIn);
-        computeSpectrum(fftBufferOut, spectrumOut);
+    // Perform FFT with hop (75% overlap for smooth updates, 50% in Eco)
+    if (state.fftWritePos >= kFftSize) {
+        const int64_t analyzerStart = profiler.beginExact();
+        state.analyzer.computeSpectrum(state.fftBufferIn, state.spectrumIn, sampleRate);
+        state.analyzer.computeSpectrum(state.fftBufferOut, state.spectrumOut, sampleRate);
         
         // Update Bezier-ready display buffers
-        updateDisplayBuffers();
+        updateDisplayBuffers(state);
         
         // Shift buffer by hop size (keep 75% of data)
-        for (int i = 0; i < kFftSize - kFftHopSize; ++i) {
-            fftBufferIn[i] = fftBufferIn[i + kFftHopSize];
-            fftBufferOut[i] = fftBufferOut[i + kFftHopSize];
+        for (int i = 0; i < kFftSize - analyzerHopSize; ++i) {
+            state.fftBufferIn[i] = state.fftBufferIn[i + analyzerHopSize];
+            state.fftBufferOut[i] = state.fftBufferOut[i + analyzerHopSize];
         }
-        fftWritePos = kFftSize - kFftHopSize;
+        state.fftWritePos = kFftSize - analyzerHopSize;
+        profiler.endExact(ELC4L::kStageAnalyzer, analyzerStart);
     }
 }
+
+//-------------------------------------------------------------------------------------------------------
+// Silence sleep
+//-------------------------------------------------------------------------------------------------------
+bool HyeokStreamMaster::isDspIdle() const {
+    if (!dsp.isIdle(ELC4L::kSilenceStateThreshold)) return false;
+    if (!bandComps.isIdle(ELC4L::kSilenceStateThreshold)) return false;
+    return limiterBypass || limiter.isIdle(ELC4L::kSilenceStateThreshold);
+}
+
+void HyeokStreamMaster::enterSilenceSleep() {
+    // Residual state is below -120 dB: clear it so the next signal starts from a clean state
+    dsp.reset();
+    bandComps.reset();
+    for (int b = 0; b < kNumBands; ++b) {
+        meters.bandGrDb[b] = 0.0f;
+    }
+    limiter.reset();
+    meters.limiterGrDb = 0.0f;
+
+    meters.inputDb = -120.0f;
+    meters.outputDb = -120.0f;
+
+    // Analyzer falls to the floor instead of freezing on the last frame
+    if (analyzer) analyzer->reset();
+
+    dspSleeping = true;
+}
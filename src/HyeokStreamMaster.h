@@ -9,69 +9,17 @@
 #define __HyeokStreamMaster__
 
 #include "audioeffectx.h"
+#include "HyeokStreamDSP.h"
+#include "StageProfiler.h"
+#include "Telemetry.h"
+#include "QualityGovernor.h"
+#include "HostBypass.h"
+#include "LazyEditorState.h"
+#include "StateArena.h"
+#include "MemoryLock.h"
 #include <cmath>
 #include <algorithm>
 
-// ======================================================================
-// [NEW] HIGH-END DSP MODULES (Pure C++ / Zero Latency)
-// ======================================================================
-
-// 1. Tape Saturator (Algebraic Sigmoid)
-struct TapeSaturator {
-    // x / sqrt(1 + x^2) based soft clipper with bias
-    inline float process(float input, float drive, float bias) {
-        float x = input * drive + bias;
-        float saturated = x / sqrtf(1.0f + x * x);
-        
-        // Remove DC Offset caused by bias
-        float biasCurve = bias / sqrtf(1.0f + bias * bias);
-        return (saturated - biasCurve);
-    }
-};
-
-// 2. Polyphase FIR Oversampler (4x)
-// 32-tap Linear Phase FIR / 4 Phases
-class PolyphaseOversampler {
-public:
-    PolyphaseOversampler() { reset(); }
-
-    void reset() {
-        for (int i = 0; i < kTapLength; ++i) state[i] = 0.0f;
-        ptr = 0;
-    }
-
-    // Upsample 1 -> 4
-    void processUpsample(float input, float* outBuffer4x) {
-        state[ptr] = input;
-        for (int phase = 0; phase < 4; ++phase) {
-            float sum = 0.0f;
-            const float* coeffs = &kCoeffs[phase * kTapsPerPhase];
-            for (int i = 0; i < kTapsPerPhase; ++i) {
-                int idx = (ptr - i + kTapLength) % kTapLength;
-                sum += state[idx] * coeffs[i];
-            }
-            outBuffer4x[phase] = sum; // Gain Compensation
-        }
-        ptr = (ptr + 1) % kTapLength;
-    }
-
-    // Downsample 4 -> 1 (Simple Windowed Sinc decimation for efficiency)
-    float processDownsample(const float* inBuffer4x) {
-        // High quality mix of 4 samples
-        return inBuffer4x[0] * 0.1f + inBuffer4x[1] * 0.4f + inBuffer4x[2] * 0.4f + inBuffer4x[3] * 0.1f;
-    }
-
-    // Static Coefficients (Defined in .cpp)
-    static const float kCoeffs[32]; 
-    static constexpr int kTapsPerPhase = 8;
-    static constexpr int kTapLength = 32;
-
-private:
-    float state[kTapLength];
-    int ptr = 0;
-};
-
-
 //-------------------------------------------------------------------------------------------------------
 // Parameter indices
 //-------------------------------------------------------------------------------------------------------
@@ -97,6 +45,7 @@ enum HyeokParameters {
     kParamBand2Mode,
     kParamBand3Mode,
     kParamBand4Mode,
+    kParamQuality,         // Processing quality: 0=Eco, 0.5=Standard, 1=High (ELC4L::ProcessingQuality)
     kNumParams
 };
 
@@ -107,6 +56,10 @@ constexpr VstInt32 kUniqueID = CCONST('E', 'L', 'C', '4');  // 'ELC4'
 constexpr VstInt32 kVersion = 2000;  // 2.0.0.0
 constexpr VstInt32 kNumPrograms = 1;
 
+// Band count: set by the crossover type; the parameter layout above (and the editor) has four bands
+constexpr int kNumBands = HyeokStreamDSP::kNumBands;
+static_assert(kNumBands == kParamBand1Makeup - kParamBand1Thresh, "one threshold parameter per band");
+
 // Default parameter values (normalized 0-1)
 constexpr float kDefaultBandThresh = 0.75f;   // ~-9 dB
 constexpr float kDefaultBandMakeup = 0.5f;    // 0 dB
@@ -116,650 +69,64 @@ constexpr float kDefaultXover3 = 0.80f;       // ~5 kHz
 constexpr float kDefaultLimiterThresh = 0.75f;   // -6 dB threshold
 constexpr float kDefaultLimiterCeiling = 0.9583f; // -1 dB ceiling
 constexpr float kDefaultLimiterRelease = 0.3f;    // ~120ms release
+constexpr float kDefaultQuality = 0.5f;           // Standard
 
 // Frequency range (Hz)
 constexpr float kMinFreq = 20.0f;
 constexpr float kMaxFreq = 20000.0f;
 
 // High-Resolution Spectrum Analyzer (Pro-Q style)
-constexpr int kFftSize = 4096;         // 4096-point FFT (~10Hz resolution at 44.1kHz)
-constexpr int kSpectrumBins = 512;     // Internal processing bins
+constexpr int kFftSize = SpectrumAnalyzer::kFftSize;            // 4096-point FFT (~10Hz resolution at 44.1kHz)
+constexpr int kSpectrumBins = SpectrumAnalyzer::kSpectrumBins;  // Internal processing bins
 constexpr int kDisplayBins = 128;      // Smooth display points for Bezier curves
 constexpr int kFftHopSize = 1024;      // Hop size for 75% overlap
 
-//-------------------------------------------------------------------------------------------------------
-// Lookahead Limiter (Brickwall with lookahead for transparent limiting)
-//-------------------------------------------------------------------------------------------------------
-struct LookaheadLimiter {
-    static constexpr int kLookaheadSamples = 64;  // ~1.5ms at 44.1kHz
-    
-    // Delay buffers
-    float delayL[kLookaheadSamples];
-    float delayR[kLookaheadSamples];
-    int delayIndex;
-    
-    // Envelope follower
-    float envelope;
-    float attackCoeff;
-    float releaseCoeff;
-    float fastReleaseCoeff;
-    float slowReleaseCoeff;
-    
-    // Settings
-    float threshold;    // Linear threshold
-    float ceiling;      // Linear ceiling (output)
-    float makeupGain;   // Automatic makeup gain
-    float sampleRate;
-    float lastGain;
-    float gainReductionDb;
-    float releaseMs;    // User-adjustable release time
-    
-    LookaheadLimiter() 
-        : delayIndex(0)
-        , envelope(0.0f)
-        , attackCoeff(0.0f)
-        , releaseCoeff(0.0f)
-        , fastReleaseCoeff(0.0f)
-        , slowReleaseCoeff(0.0f)
-        , threshold(0.5f)
-        , ceiling(0.891f)  // -1 dB
-        , makeupGain(1.0f)
-        , sampleRate(44100.0f)
-        , lastGain(1.0f)
-        , gainReductionDb(0.0f)
-        , releaseMs(100.0f)
-    {
-        reset();
-        updateCoefficients();
-    }
-    
-    void reset() {
-        for (int i = 0; i < kLookaheadSamples; ++i) {
-            delayL[i] = 0.0f;
-            delayR[i] = 0.0f;
-        }
-        delayIndex = 0;
-        envelope = 0.0f;
-        lastGain = 1.0f;
-        gainReductionDb = 0.0f;
-    }
-    
-    void setSampleRate(float sr) {
-        sampleRate = sr;
-        updateCoefficients();
-    }
-    
-    void setThreshold(float threshDb) {
-        threshold = powf(10.0f, threshDb / 20.0f);
-        updateMakeupGain();
-    }
-    
-    void setCeiling(float ceilingDb) {
-        ceiling = powf(10.0f, ceilingDb / 20.0f);
-        updateMakeupGain();
-    }
-    
-    void setRelease(float relMs) {
-        releaseMs = relMs;
-        if (releaseMs < 10.0f) releaseMs = 10.0f;
-        if (releaseMs > 500.0f) releaseMs = 500.0f;
-        updateCoefficients();
-    }
-    
-    void updateCoefficients() {
-        float attackMs = 0.1f;
-        // ARC-style dual release based on user setting
-        float fastReleaseMs = releaseMs * 0.4f;     // Fast = 40% of setting
-        float slowReleaseMs = releaseMs * 4.0f;     // Slow = 400% of setting
-        attackCoeff = expf(-1.0f / (sampleRate * attackMs / 1000.0f));
-        releaseCoeff = expf(-1.0f / (sampleRate * releaseMs / 1000.0f));
-        fastReleaseCoeff = expf(-1.0f / (sampleRate * fastReleaseMs / 1000.0f));
-        slowReleaseCoeff = expf(-1.0f / (sampleRate * slowReleaseMs / 1000.0f));
-    }
-    
-    void updateMakeupGain() {
-        makeupGain = ceiling / threshold;
-        if (makeupGain > 4.0f) makeupGain = 4.0f;
-    }
-    
-    void process(float& left, float& right) {
-        float delayedL = delayL[delayIndex];
-        float delayedR = delayR[delayIndex];
-        
-        delayL[delayIndex] = left;
-        delayR[delayIndex] = right;
-        delayIndex = (delayIndex + 1) % kLookaheadSamples;
-        
-        float peakL = fabsf(left);
-        float peakR = fabsf(right);
-        float peak = (peakL > peakR) ? peakL : peakR;
-        
-        float fastEnv = envelope;
-        float slowEnv = envelope;
-
-        if (peak > fastEnv) {
-            fastEnv = attackCoeff * fastEnv + (1.0f - attackCoeff) * peak;
-        } else {
-            fastEnv = fastReleaseCoeff * fastEnv + (1.0f - fastReleaseCoeff) * peak;
-        }
-
-        if (peak > slowEnv) {
-            slowEnv = attackCoeff * slowEnv + (1.0f - attackCoeff) * peak;
-        } else {
-            slowEnv = slowReleaseCoeff * slowEnv + (1.0f - slowReleaseCoeff) * peak;
-        }
-
-        envelope = (fastEnv > slowEnv) ? fastEnv : slowEnv;
-        
-        float gain = 1.0f;
-        if (envelope > threshold) {
-            gain = threshold / envelope;
-        }
-        
-        float outL = delayedL * gain * makeupGain;
-        float outR = delayedR * gain * makeupGain;
-        
-        if (outL > ceiling) outL = ceiling;
-        if (outL < -ceiling) outL = -ceiling;
-        if (outR > ceiling) outR = ceiling;
-        if (outR < -ceiling) outR = -ceiling;
-        
-        left = outL;
-        right = outR;
-
-        lastGain = gain;
-        gainReductionDb = (gain > 1.0e-9f) ? (-20.0f * log10f(gain)) : 60.0f;
-    }
-
-    float getGainReductionDb() const { return gainReductionDb; }
-};
-
-//-------------------------------------------------------------------------------------------------------
-// LA-2A Style Opto Compressor (per-band)
-// - Variable ratio (soft-knee, ~3:1 to infinity based on input level)
-// - Program-dependent attack (~10ms) and dual-release (60ms fast + 1-15s slow)
-// - RMS detection for natural opto response
-// - Tube saturation emulation (T4B optical cell + 12AX7 tube stage)
-//-------------------------------------------------------------------------------------------------------
-struct OptoCompressor {
-    float sampleRate;
-    float envelope;
-    float fastEnvelope;      // Fast release envelope
-    float slowEnvelope;      // Slow release envelope (LA-2A dual time constant)
-    float attackCoeff;
-    float fastReleaseCoeff;  // ~60ms fast release
-    float slowReleaseCoeff;  // ~1-15s slow release (program dependent)
-    float threshold;
-    float makeupGain;
-    float lastGain;
-    float gainReductionDb;
-    float peakHold;          // Peak hold for ratio calculation
-    float peakDecay;         // Peak decay coefficient
-    
-    // Tube saturation parameters
-    float saturationDrive;   // 0.0 = clean, 1.0 = fully saturated
-    bool saturationEnabled;
-
-    // [ADDED] Current raw gain (before makeup) for delta monitoring
-    float currentGain = 1.0f;
-
-    // [ADDED] High-quality saturation + oversampling
-    TapeSaturator saturator;
-    PolyphaseOversampler oversamplerL;
-    PolyphaseOversampler oversamplerR;
-    float upBufferL[4];
-    float upBufferR[4];
-
-    // [NEW] Sidechain HPF state (1-pole lowpass used to derive HPF: HP = in - LP)
-    bool sidechainEnabled = false;
-    float scFilterCoeff = 0.0f; // exp(-2*pi*fc / sr)
-    float scFilterState = 0.0f; // lowpass state
-
-    void setSidechainEnabled(bool enabled) { sidechainEnabled = enabled; }
-    void setSidechainFreq(float fc) {
-        if (fc <= 0.0f || sampleRate <= 0.0f) { scFilterCoeff = 0.0f; return; }
-        // Coefficient for simple 1-pole lowpass approximation
-        scFilterCoeff = expf(-2.0f * 3.14159265358979323846f * fc / sampleRate);
-    }
-
-    // LA-2A constants
-    static constexpr float kMinRatio = 3.0f;     // Low level ratio (~3:1)
-    static constexpr float kMaxRatio = 100.0f;   // High level ratio (limiting)
-    static constexpr float kKneeDb = 10.0f;      // Wide soft-knee for opto
-    static constexpr float kAttackMs = 10.0f;    // LA-2A attack ~10ms
-    static constexpr float kFastReleaseMs = 60.0f;   // Fast release ~60ms
-    static constexpr float kSlowReleaseBase = 500.0f; // Base slow release ~500ms
-    static constexpr float kSlowReleaseMax = 5000.0f; // Max slow release ~5s
+// Analyzer history, FFT scratch, spectrum and display bins: only allocated while an editor is open
+struct AnalyzerState {
+    float fftBufferIn[kFftSize];
+    float fftBufferOut[kFftSize];
+    int fftWritePos;
+    float spectrumIn[kSpectrumBins];
+    float spectrumOut[kSpectrumBins];
+    float displayIn[kDisplayBins];       // Smoothed display buffer for Bezier
+    float displayOut[kDisplayBins];      // Smoothed display buffer for Bezier
+    SpectrumAnalyzer analyzer;           // FFT scratch; window, FFT and bin tables are shared
 
-    OptoCompressor()
-        : sampleRate(44100.0f)
-        , envelope(0.0f)
-        , fastEnvelope(0.0f)
-        , slowEnvelope(0.0f)
-        , attackCoeff(0.0f)
-        , fastReleaseCoeff(0.0f)
-        , slowReleaseCoeff(0.0f)
-        , threshold(1.0f)
-        , makeupGain(1.0f)
-        , lastGain(1.0f)
-        , gainReductionDb(0.0f)
-        , peakHold(0.0f)
-        , peakDecay(0.0f)
-        , saturationDrive(0.3f)    // Default subtle saturation
-        , saturationEnabled(true)
-    {
-        updateCoefficients();
-    }
+    AnalyzerState() { reset(); }
 
+    // Empty history, spectrum at the floor
     void reset() {
-        envelope = 0.0f;
-        fastEnvelope = 0.0f;
-        slowEnvelope = 0.0f;
-        lastGain = 1.0f;
-        gainReductionDb = 0.0f;
-        peakHold = 0.0f;
-    }
-
-    void setSampleRate(float sr) {
-        sampleRate = sr;
-        updateCoefficients();
-    }
-
-    void setThresholdDb(float db) {
-        threshold = powf(10.0f, db / 20.0f);
-    }
-
-    void setMakeupDb(float db) {
-        makeupGain = powf(10.0f, db / 20.0f);
-    }
-    
-    void setSaturationDrive(float drive) {
-        saturationDrive = (drive < 0.0f) ? 0.0f : (drive > 1.0f) ? 1.0f : drive;
-    }
-    
-    void setSaturationEnabled(bool enabled) {
-        saturationEnabled = enabled;
-    }
-    
-    // LA-2A style tube saturation (12AX7 + T4B optical cell emulation)
-    // Soft asymmetric clipping with even and odd harmonics
-    inline float applyTubeSaturation(float sample) const {
-        if (!saturationEnabled || saturationDrive < 0.001f) return sample;
-        
-        // Input scaling based on drive
-        float drive = 1.0f + saturationDrive * 4.0f;  // 1x to 5x gain
-        float x = sample * drive;
-        
-        // Tube saturation model:
-        // - Soft clipping with asymmetry (more positive compression)
-        // - Even harmonics from triode asymmetry
-        // - Gentle limiting at extremes
-        
-        // Asymmetric soft clipping (triode-like)
-        float pos = x >= 0.0f ? x : 0.0f;
-        float neg = x < 0.0f ? x : 0.0f;
-        
-        // Positive half: softer clipping (more headroom)
-        float satPos = pos / (1.0f + 0.3f * pos * pos);
-        
-        // Negative half: slightly harder clipping (typical triode behavior)
-        float satNeg = neg / (1.0f + 0.4f * neg * neg);
-        
-        float saturated = satPos + satNeg;
-        
-        // Add subtle even harmonics (2nd harmonic injection)
-        float evenHarmonic = 0.05f * saturationDrive * saturated * saturated;
-        saturated += evenHarmonic;
-        
-        // Output scaling to maintain level
-        saturated /= drive * 0.7f;
-        
-        // Blend dry/wet based on drive amount
-        float wet = saturationDrive * 0.7f;  // Max 70% wet
-        return sample * (1.0f - wet) + saturated * wet;
-    }
-
-    void updateCoefficients() {
-        attackCoeff = expf(-1.0f / (sampleRate * kAttackMs / 1000.0f));
-        fastReleaseCoeff = expf(-1.0f / (sampleRate * kFastReleaseMs / 1000.0f));
-        slowReleaseCoeff = expf(-1.0f / (sampleRate * kSlowReleaseBase / 1000.0f));
-        peakDecay = expf(-1.0f / (sampleRate * 0.5f));  // 500ms peak decay
-    }
-
-    void process(float& left, float& right) {
-        // Internal Sidechain HPF: compute mono detector then optionally HPF it
-        float monoIn = 0.5f * (left + right);
-        float detectorSignal = monoIn;
-
-        if (sidechainEnabled) {
-            // 1-pole LP: scFilterState = a * scFilterState + (1-a) * x
-            scFilterState = scFilterState * scFilterCoeff + monoIn * (1.0f - scFilterCoeff);
-            detectorSignal = monoIn - scFilterState; // HP = input - LP
+        for (int i = 0; i < kFftSize; ++i) {
+            fftBufferIn[i] = 0.0f;
+            fftBufferOut[i] = 0.0f;
         }
-
-        float level = detectorSignal * detectorSignal;
-        float detector = sqrtf(level + 1.0e-12f);
-
-        // Track peak for dynamic ratio calculation
-        if (detector > peakHold) {
-            peakHold = detector;
-        } else {
-            peakHold = peakDecay * peakHold + (1.0f - peakDecay) * detector;
-        }
-
-        // Dual time constant envelope (LA-2A style)
-        if (detector > fastEnvelope) {
-            fastEnvelope = attackCoeff * fastEnvelope + (1.0f - attackCoeff) * detector;
-        } else {
-            fastEnvelope = fastReleaseCoeff * fastEnvelope + (1.0f - fastReleaseCoeff) * detector;
-        }
-
-        // Slow envelope with program-dependent release
-        float overDb = 20.0f * log10f((peakHold / threshold) + 1.0e-12f);
-        if (overDb < 0.0f) overDb = 0.0f;
-        float releaseScale = 1.0f + (overDb * 0.15f);
-        if (releaseScale > 10.0f) releaseScale = 10.0f;
-        float slowRelMs = kSlowReleaseBase * releaseScale;
-        if (slowRelMs > kSlowReleaseMax) slowRelMs = kSlowReleaseMax;
-        float dynamicSlowCoeff = expf(-1.0f / (sampleRate * slowRelMs / 1000.0f));
-
-        if (detector > slowEnvelope) {
-            slowEnvelope = attackCoeff * slowEnvelope + (1.0f - attackCoeff) * detector;
-        } else {
-            slowEnvelope = dynamicSlowCoeff * slowEnvelope + (1.0f - dynamicSlowCoeff) * detector;
+        fftWritePos = 0;
+        for (int i = 0; i < kSpectrumBins; ++i) {
+            spectrumIn[i] = -90.0f;
+            spectrumOut[i] = -90.0f;
         }
-
-        // Combined envelope
-        envelope = 0.3f * fastEnvelope + 0.7f * slowEnvelope;
-
-        // Gain calculation (same LA-2A logic)
-        float levelDb = 20.0f * log10f(envelope + 1.0e-12f);
-        float threshDb = 20.0f * log10f(threshold + 1.0e-12f);
-        float overThresh = levelDb - threshDb;
-
-        float dynamicRatio = kMinRatio;
-        if (overThresh > 0.0f) {
-            float ratioBlend = overThresh / 20.0f;
-            if (ratioBlend > 1.0f) ratioBlend = 1.0f;
-            dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
+        for (int i = 0; i < kDisplayBins; ++i) {
+            displayIn[i] = -90.0f;
+            displayOut[i] = -90.0f;
         }
-
-        float grDb = 0.0f;
-        if (overThresh <= -kKneeDb * 0.5f) {
-            grDb = 0.0f;
-        } else if (overThresh >= kKneeDb * 0.5f) {
-            grDb = overThresh - (overThresh / dynamicRatio);
-        } else {
-            float x = overThresh + kKneeDb * 0.5f;
-            grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
-        }
-
-        float gain = powf(10.0f, -grDb / 20.0f);
-        float gainSmooth = 0.995f;
-        gain = gainSmooth * lastGain + (1.0f - gainSmooth) * gain;
-
-        // [ADDED] store raw gain (reduction only) before makeup is applied
-        currentGain = gain;
-
-        left *= gain * makeupGain;
-        right *= gain * makeupGain;
-
-        // 2. [NEW] 4x Oversampling + Tape Saturation
-        if (saturationEnabled) {
-            float drive = 1.0f + saturationDrive * 3.0f; 
-            float bias = saturationDrive * 0.1f;        
-
-            // LEFT CHANNEL
-            oversamplerL.processUpsample(left, upBufferL);
-            for (int i = 0; i < 4; ++i) upBufferL[i] = saturator.process(upBufferL[i], drive, bias);
-            left = oversamplerL.processDownsample(upBufferL) / drive;
-
-            // RIGHT CHANNEL
-            oversamplerR.processUpsample(right, upBufferR);
-            for (int i = 0; i < 4; ++i) upBufferR[i] = saturator.process(upBufferR[i], drive, bias);
-            right = oversamplerR.processDownsample(upBufferR) / drive;
-        }
-
-        lastGain = gain;
-        gainReductionDb = grDb;
     }
-
-    float getGainReductionDb() const { return gainReductionDb; }
-    float getCurrentGain() const { return currentGain; }
 };
 
-//-------------------------------------------------------------------------------------------------------
-// LUFS Meter (momentary, approximate)
-//-------------------------------------------------------------------------------------------------------
-struct LufsMeter {
-    float sampleRate;
-    float momentaryEnergy;
-    float momentaryCoeff;
-    float momentaryLufs;
-
-    LufsMeter()
-        : sampleRate(44100.0f)
-        , momentaryEnergy(0.0f)
-        , momentaryCoeff(0.0f)
-        , momentaryLufs(-120.0f)
-    {
-        updateCoefficients();
-    }
-
-    void reset() {
-        momentaryEnergy = 0.0f;
-        momentaryLufs = -120.0f;
-    }
-
-    void setSampleRate(float sr) {
-        sampleRate = sr;
-        updateCoefficients();
-    }
-
-    void updateCoefficients() {
-        // 400 ms momentary window
-        float tau = 0.4f;
-        momentaryCoeff = expf(-1.0f / (sampleRate * tau));
-    }
-
-    void process(float left, float right) {
-        float energy = 0.5f * (left * left + right * right);
-        momentaryEnergy = momentaryCoeff * momentaryEnergy + (1.0f - momentaryCoeff) * energy;
-        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
-        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
-    }
-
-    float getMomentary() const { return momentaryLufs; }
-};
-
-//-------------------------------------------------------------------------------------------------------
-// HyeokStreamDSP - Linkwitz-Riley 4th-order Crossover (4-band)
-//-------------------------------------------------------------------------------------------------------
-struct HyeokStreamDSP {
-    struct BiquadCoeffs {
-        double b0, b1, b2;
-        double a1, a2;
+// Everything processReplacing writes per sample, in one cache-line-aligned arena (StateArena.h): the
+// stages in processing order, each from a line boundary, then the meters the editor polls
+struct ProcessingState {
+    alignas(ELC4L::kCacheLineSize) HyeokStreamDSP dsp;
+    alignas(ELC4L::kCacheLineSize) CompressorBank<kNumBands> bandComps;
+    alignas(ELC4L::kCacheLineSize) LookaheadLimiter limiter;
+    alignas(ELC4L::kCacheLineSize) LufsMeter lufsMeter;
+
+    struct Meters {
+        float inputDb = -120.0f;
+        float outputDb = -120.0f;
+        float bandGrDb[kNumBands] = {};
+        float limiterGrDb = 0.0f;
     };
-    
-    struct BiquadState {
-        double x1[2], x2[2];
-        double y1[2], y2[2];
-        
-        BiquadState() { reset(); }
-        
-        void reset() {
-            x1[0] = x1[1] = x2[0] = x2[1] = 0.0;
-            y1[0] = y1[1] = y2[0] = y2[1] = 0.0;
-        }
-    };
-    
-    BiquadCoeffs lowpass1a, lowpass1b;
-    BiquadCoeffs highpass1a, highpass1b;
-    BiquadState lp1StateA, lp1StateB;
-    BiquadState hp1StateA, hp1StateB;
-
-    BiquadCoeffs lowpass2a, lowpass2b;
-    BiquadCoeffs highpass2a, highpass2b;
-    BiquadState lp2StateA, lp2StateB;
-    BiquadState hp2StateA, hp2StateB;
-
-    BiquadCoeffs lowpass3a, lowpass3b;
-    BiquadCoeffs highpass3a, highpass3b;
-    BiquadState lp3StateA, lp3StateB;
-    BiquadState hp3StateA, hp3StateB;
-
-    float sampleRate;
-    float xover1;
-    float xover2;
-    float xover3;
-    
-    HyeokStreamDSP() 
-        : sampleRate(44100.0f)
-        , xover1(120.0f)
-        , xover2(800.0f)
-        , xover3(4000.0f)
-    {
-        updateCoefficients();
-    }
-    
-    void setSampleRate(float sr) {
-        sampleRate = sr;
-        updateCoefficients();
-    }
-    
-    void setXover1(float freq) {
-        xover1 = freq;
-        updateCoefficients();
-    }
-    
-    void setXover2(float freq) {
-        xover2 = freq;
-        updateCoefficients();
-    }
-
-    void setXover3(float freq) {
-        xover3 = freq;
-        updateCoefficients();
-    }
-    
-    void updateCoefficients() {
-        calculateButterworthLP(lowpass1a, xover1, sampleRate);
-        lowpass1b = lowpass1a;
-        calculateButterworthHP(highpass1a, xover1, sampleRate);
-        highpass1b = highpass1a;
-
-        calculateButterworthLP(lowpass2a, xover2, sampleRate);
-        lowpass2b = lowpass2a;
-        calculateButterworthHP(highpass2a, xover2, sampleRate);
-        highpass2b = highpass2a;
-
-        calculateButterworthLP(lowpass3a, xover3, sampleRate);
-        lowpass3b = lowpass3a;
-        calculateButterworthHP(highpass3a, xover3, sampleRate);
-        highpass3b = highpass3a;
-    }
-    
-    void calculateButterworthLP(BiquadCoeffs& c, float freq, float sr) {
-        const double w0 = 2.0 * 3.14159265358979323846 * freq / sr;
-        const double cosw0 = cos(w0);
-        const double sinw0 = sin(w0);
-        const double Q = 0.7071067811865476;
-        const double alpha = sinw0 / (2.0 * Q);
-        
-        const double a0 = 1.0 + alpha;
-        c.b0 = ((1.0 - cosw0) / 2.0) / a0;
-        c.b1 = (1.0 - cosw0) / a0;
-        c.b2 = ((1.0 - cosw0) / 2.0) / a0;
-        c.a1 = (-2.0 * cosw0) / a0;
-        c.a2 = (1.0 - alpha) / a0;
-    }
-    
-    void calculateButterworthHP(BiquadCoeffs& c, float freq, float sr) {
-        const double w0 = 2.0 * 3.14159265358979323846 * freq / sr;
-        const double cosw0 = cos(w0);
-        const double sinw0 = sin(w0);
-        const double Q = 0.7071067811865476;
-        const double alpha = sinw0 / (2.0 * Q);
-        
-        const double a0 = 1.0 + alpha;
-        c.b0 = ((1.0 + cosw0) / 2.0) / a0;
-        c.b1 = (-(1.0 + cosw0)) / a0;
-        c.b2 = ((1.0 + cosw0) / 2.0) / a0;
-        c.a1 = (-2.0 * cosw0) / a0;
-        c.a2 = (1.0 - alpha) / a0;
-    }
-    
-    inline double processBiquad(double input, int channel, const BiquadCoeffs& c, BiquadState& s) {
-        double output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
-                       - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
-        
-        s.x2[channel] = s.x1[channel];
-        s.x1[channel] = input;
-        s.y2[channel] = s.y1[channel];
-        s.y1[channel] = output;
-        
-        return output;
-    }
-    
-    void processSample(float inL, float inR,
-                       float& band1L, float& band1R,
-                       float& band2L, float& band2R,
-                       float& band3L, float& band3R,
-                       float& band4L, float& band4R) {
-        double lp1L = processBiquad(inL, 0, lowpass1a, lp1StateA);
-        double lp1R = processBiquad(inR, 1, lowpass1a, lp1StateA);
-        double band1OutL = processBiquad(lp1L, 0, lowpass1b, lp1StateB);
-        double band1OutR = processBiquad(lp1R, 1, lowpass1b, lp1StateB);
-
-        double hp1L = processBiquad(inL, 0, highpass1a, hp1StateA);
-        double hp1R = processBiquad(inR, 1, highpass1a, hp1StateA);
-        double highFrom1L = processBiquad(hp1L, 0, highpass1b, hp1StateB);
-        double highFrom1R = processBiquad(hp1R, 1, highpass1b, hp1StateB);
-
-        double lp2L = processBiquad(highFrom1L, 0, lowpass2a, lp2StateA);
-        double lp2R = processBiquad(highFrom1R, 1, lowpass2a, lp2StateA);
-        double band2OutL = processBiquad(lp2L, 0, lowpass2b, lp2StateB);
-        double band2OutR = processBiquad(lp2R, 1, lowpass2b, lp2StateB);
-
-        double hp2L = processBiquad(highFrom1L, 0, highpass2a, hp2StateA);
-        double hp2R = processBiquad(highFrom1R, 1, highpass2a, hp2StateA);
-        double highFrom2L = processBiquad(hp2L, 0, highpass2b, hp2StateB);
-        double highFrom2R = processBiquad(hp2R, 1, highpass2b, hp2StateB);
-
-        double lp3L = processBiquad(highFrom2L, 0, lowpass3a, lp3StateA);
-        double lp3R = processBiquad(highFrom2R, 1, lowpass3a, lp3StateA);
-        double band3OutL = processBiquad(lp3L, 0, lowpass3b, lp3StateB);
-        double band3OutR = processBiquad(lp3R, 1, lowpass3b, lp3StateB);
-
-        double hp3L = processBiquad(highFrom2L, 0, highpass3a, hp3StateA);
-        double hp3R = processBiquad(highFrom2R, 1, highpass3a, hp3StateA);
-        double band4OutL = processBiquad(hp3L, 0, highpass3b, hp3StateB);
-        double band4OutR = processBiquad(hp3R, 1, highpass3b, hp3StateB);
-
-        band1L = (float)band1OutL;
-        band1R = (float)band1OutR;
-        band2L = (float)band2OutL;
-        band2R = (float)band2OutR;
-        band3L = (float)band3OutL;
-        band3R = (float)band3OutR;
-        band4L = (float)band4OutL;
-        band4R = (float)band4OutR;
-    }
-    
-    void reset() {
-        lp1StateA.reset();
-        lp1StateB.reset();
-        hp1StateA.reset();
-        hp1StateB.reset();
-        lp2StateA.reset();
-        lp2StateB.reset();
-        hp2StateA.reset();
-        hp2StateB.reset();
-        lp3StateA.reset();
-        lp3StateB.reset();
-        hp3StateA.reset();
-        hp3StateB.reset();
-    }
+    alignas(ELC4L::kCacheLineSize) Meters meters;
 };
 
 //-------------------------------------------------------------------------------------------------------
@@ -791,58 +158,70 @@ public:
     virtual bool getProductString(char* text) override;
     virtual VstInt32 getVendorVersion() override;
     virtual VstInt32 canDo(char* text) override;
+    virtual bool setBypass(bool onOff) override;
     
     virtual void setSampleRate(float sampleRate) override;
     virtual void suspend() override;
     virtual void resume() override;
     
-    virtual VstInt32 getGetTailSize() override { return LookaheadLimiter::kLookaheadSamples; }
+    virtual VstInt32 getGetTailSize() override { return latencySamples; }
 
     float getParameterValue(VstInt32 index) const { return parameters[index]; }
     float getLufsMomentary() const { return lufsMeter.getMomentary(); }
-    const float* getSpectrumIn() const { return spectrumIn; }
-    const float* getSpectrumOut() const { return spectrumOut; }
-    const float* getDisplayIn() const { return displayIn; }    // Bezier-ready display buffer
-    const float* getDisplayOut() const { return displayOut; }  // Bezier-ready display buffer
-    float getInputDb() const { return inputDb; }
-    float getOutputDb() const { return outputDb; }
-    float getBandGrDb(int band) const { return bandGrDb[band]; }
-    float getLimiterGrDb() const { return limiterGrDb; }
+    // Analyzer buffers: live while the caller holds an analyzer subscription, -90 dB otherwise
+    const float* getSpectrumIn() const;
+    const float* getSpectrumOut() const;
+    const float* getDisplayIn() const;     // Bezier-ready display buffer
+    const float* getDisplayOut() const;    // Bezier-ready display buffer
+
+    // Editor open / close (not the audio thread): the analyzer only exists while subscribed
+    void subscribeAnalyzer();
+    void unsubscribeAnalyzer();
+    float getInputDb() const { return meters.inputDb; }
+    float getOutputDb() const { return meters.outputDb; }
+    float getBandGrDb(int band) const { return meters.bandGrDb[band]; }
+    float getLimiterGrDb() const { return meters.limiterGrDb; }
     
     // Get crossover frequencies for UI display
-    float getXover1Hz() const { return dsp.xover1; }
-    float getXover2Hz() const { return dsp.xover2; }
-    float getXover3Hz() const { return dsp.xover3; }
+    float getXover1Hz() const { return dsp.getFrequency(0); }
+    float getXover2Hz() const { return dsp.getFrequency(1); }
+    float getXover3Hz() const { return dsp.getFrequency(2); }
     
-    // Get crossover frequency by index (0, 1, 2)
+    // Get crossover frequency by index (0 .. kNumBands - 2)
     float getCrossoverFreq(int index) const {
-        switch (index) {
-            case 0: return dsp.xover1;
-            case 1: return dsp.xover2;
-            case 2: return dsp.xover3;
-            default: return 1000.0f;
-        }
+        return (index >= 0 && index < HyeokStreamDSP::kNumSplits) ? dsp.getFrequency(index) : 1000.0f;
     }
     
     // Band monitoring controls (Mute/Solo/Delta)
-    bool getBandMute(int band) const { return (band >= 0 && band < 4) ? bandMute[band] : false; }
-    bool getBandSolo(int band) const { return (band >= 0 && band < 4) ? bandSolo[band] : false; }
-    bool getBandDelta(int band) const { return (band >= 0 && band < 4) ? bandDelta[band] : false; }
-    void setBandMute(int band, bool state) { if (band >= 0 && band < 4) bandMute[band] = state; }
-    void setBandSolo(int band, bool state) { if (band >= 0 && band < 4) bandSolo[band] = state; }
-    void setBandDelta(int band, bool state) { if (band >= 0 && band < 4) bandDelta[band] = state; }
-    void toggleBandMute(int band) { if (band >= 0 && band < 4) bandMute[band] = !bandMute[band]; }
-    void toggleBandSolo(int band) { if (band >= 0 && band < 4) bandSolo[band] = !bandSolo[band]; }
-    void toggleBandDelta(int band) { if (band >= 0 && band < 4) bandDelta[band] = !bandDelta[band]; }
+    bool getBandMute(int band) const { return (band >= 0 && band < kNumBands) ? bandMute[band] : false; }
+    bool getBandSolo(int band) const { return (band >= 0 && band < kNumBands) ? bandSolo[band] : false; }
+    bool getBandDelta(int band) const { return (band >= 0 && band < kNumBands) ? bandDelta[band] : false; }
+    void setBandMute(int band, bool state) { if (band >= 0 && band < kNumBands) bandMute[band] = state; }
+    void setBandSolo(int band, bool state) { if (band >= 0 && band < kNumBands) bandSolo[band] = state; }
+    void setBandDelta(int band, bool state) { if (band >= 0 && band < kNumBands) bandDelta[band] = state; }
+    void toggleBandMute(int band) { if (band >= 0 && band < kNumBands) bandMute[band] = !bandMute[band]; }
+    void toggleBandSolo(int band) { if (band >= 0 && band < kNumBands) bandSolo[band] = !bandSolo[band]; }
+    void toggleBandDelta(int band) { if (band >= 0 && band < kNumBands) bandDelta[band] = !bandDelta[band]; }
     
     // Bypass controls
-    bool getBandBypass(int band) const { return (band >= 0 && band < 4) ? bandBypass[band] : false; }
+    bool getBandBypass(int band) const { return (band >= 0 && band < kNumBands) ? bandBypass[band] : false; }
     bool getLimiterBypass() const { return limiterBypass; }
-    void setBandBypass(int band, bool state) { if (band >= 0 && band < 4) bandBypass[band] = state; }
+    void setBandBypass(int band, bool state) { if (band >= 0 && band < kNumBands) bandBypass[band] = state; }
     void setLimiterBypass(bool state) { limiterBypass = state; }
-    void toggleBandBypass(int band) { if (band >= 0 && band < 4) bandBypass[band] = !bandBypass[band]; }
+    void toggleBandBypass(int band) { if (band >= 0 && band < kNumBands) bandBypass[band] = !bandBypass[band]; }
     void toggleLimiterBypass() { limiterBypass = !limiterBypass; }
 
+    // Per-stage CPU profile (enabled by the editor's diagnostics overlay)
+    void setProfilingEnabled(bool state) { profiler.setEnabled(state); }
+    bool isProfilingEnabled() const { return profiler.isEnabled(); }
+    bool getStageProfile(ELC4L::StageProfileSnapshot& snapshot) const { return profiler.read(snapshot); }
+
+    // Adaptive quality tier under CPU overload (ELC4L::QualityTier, 0 = full quality)
+    int getQualityTier() const { return governor.getTier(); }
+
+    // Selected processing quality (ELC4L::ProcessingQuality)
+    int getProcessingQuality() const { return ELC4L::normalizedToProcessingQuality(parameters[kParamQuality]); }
+
 private:
     float normalizedToFrequency(float normalized) const {
         return kMinFreq * powf(kMaxFreq / kMinFreq, normalized);
@@ -871,48 +250,78 @@ private:
     float parameters[kNumParams];
     char programName[kVstMaxProgNameLen + 1];
     
-    HyeokStreamDSP dsp;
-    OptoCompressor bandComps[4];
-    LookaheadLimiter limiter;
-    LufsMeter lufsMeter;
-
-    // Meters
-    float spectrumIn[kSpectrumBins];
-    float spectrumOut[kSpectrumBins];
-    float displayIn[kDisplayBins];       // Smoothed display buffer for Bezier
-    float displayOut[kDisplayBins];      // Smoothed display buffer for Bezier
-    float inputDb;
-    float outputDb;
-    float bandGrDb[4];
-    float limiterGrDb;
+    // DSP stages and meters, allocated once with the instance; the names below are views into it
+    ELC4L::StateArena<ProcessingState> dspArena;
+    HyeokStreamDSP& dsp = dspArena->dsp;
+    CompressorBank<kNumBands>& bandComps = dspArena->bandComps;
+    LookaheadLimiter& limiter = dspArena->limiter;
+    LufsMeter& lufsMeter = dspArena->lufsMeter;
+    ProcessingState::Meters& meters = dspArena->meters;
     
     // Band monitoring state (Mute/Solo/Delta Listen)
-    bool bandMute[4];
-    bool bandSolo[4];
-    bool bandDelta[4];
+    bool bandMute[kNumBands];
+    bool bandSolo[kNumBands];
+    bool bandDelta[kNumBands];
     
     // Bypass state (per-band + limiter)
-    bool bandBypass[4];
+    bool bandBypass[kNumBands];
     bool limiterBypass;
 
-    // FFT buffers (4096-point high-resolution analyzer)
-    float fftBufferIn[kFftSize];
-    float fftBufferOut[kFftSize];
-    float fftWindow[kFftSize];           // Pre-computed Blackman-Harris window
-    float fftReal[kFftSize];             // FFT real part
-    float fftImag[kFftSize];             // FFT imaginary part
-    int fftBitReverse[kFftSize];         // Bit-reversal table for FFT
-    int fftWritePos;
-    bool fftInitialized;
+    // 4096-point high-resolution analyzer, allocated on demand for the editor
+    ELC4L::LazyEditorState<AnalyzerState> analyzerLink;
+    AnalyzerState* analyzer = nullptr;   // Held for the current block (audio thread), else nullptr
+
+    // Silence sleep: DSP is skipped while the input stays silent and all tails have drained
+    bool dspSleeping;
+
+    ELC4L::StageProfiler profiler;
+    ELC4L::TelemetryPublisher telemetry;     // Shared-memory telemetry (ELC4L_TELEMETRY=1)
+    ELC4L::QualityGovernor governor;         // Steps quality down when the block budget runs short
+    ELC4L::HostBypass hostBypass;            // Host bypass: latency-matched dry path, DSP skipped
+    int qualityTier = ELC4L::kQualityFull;   // Tier applied to the DSP (audio thread)
+    int processingQuality = ELC4L::kProcessingStandard;  // Quality applied to the DSP (audio thread)
+    int analyzerHopSize = kFftHopSize;       // 0: analyzer paused
+    VstInt32 latencySamples = LookaheadLimiter::kLookaheadSamples;  // Reported to the host
+
+    // Opt-in (ELC4L_LOCK_MEMORY): the arena and the instance are prefaulted and locked on resume,
+    // unlocked on suspend; the analyzer state is locked while subscribed. Declared after dspArena and
+    // analyzerLink, so the locks let go before that memory is freed.
+    ELC4L::MemoryLockMode memoryLockMode = ELC4L::getMemoryLockModeFromEnvironment();
+    ELC4L::MemoryLock memoryLock;
+    ELC4L::MemoryLock analyzerMemoryLock;
+    void lockDspMemory();
 
     void updateCompressors();
     void updateFrequencies();
     void updateLimiter();
-    void initFFT();                                           // Initialize FFT tables
-    void performFFT(float* real, float* imag, int n);         // Cooley-Tukey FFT
-    void computeSpectrum(const float* input, float* output);  // Compute spectrum with tilt
-    void updateDisplayBuffers();                              // Downsample to Bezier-ready format
+    static void updateDisplayBuffers(AnalyzerState& state);   // Downsample to Bezier-ready format
     void updateMeters(float inL, float inR, float outL, float outR);
+    // Block processing runs in chunks through kernels specialized for the monitoring switches, picked
+    // once per block (bitmask -> table), so the per-sample loops carry no flag branches
+    static constexpr int kChunkSize = 32;
+    static_assert(kChunkSize <= HyeokStreamDSP::kMaxChunkSize, "crossover chunk");
+    enum BandKernelFlags {
+        kBandKernelBypass = 1 << 0,
+        kBandKernelMidSide = 1 << 1,
+        kBandKernelDelta = 1 << 2,
+        kBandKernelMuted = 1 << 3,      // Not in the mix (mute / solo elsewhere): detector only
+        kNumBandKernels = 1 << 4
+    };
+    typedef void (HyeokStreamMaster::*BandKernel)(int band, float* left, float* right, int numSamples);
+    typedef void (HyeokStreamMaster::*OutputKernel)(const float* inL, const float* inR, float* mixL, float* mixR,
+                                                    float* outL, float* outR, int numSamples);
+    static const BandKernel bandKernels[kNumBandKernels];
+    float bandMakeupGains[kNumBands];       // Bypassed bands (per block)
+
+    template <int Flags>
+    void processBandChunk(int band, float* left, float* right, int numSamples);
+    template <bool LimiterBypass>
+    void processOutputChunk(const float* inL, const float* inR, float* mixL, float* mixR,
+                            float* outL, float* outR, int numSamples);
+    void applyQuality(int quality, int tier);                 // Quality / tier switch (audio thread)
+    void updateLatency();                                     // Limiter lookahead of the selected quality
+    bool isDspIdle() const;                                   // All filter/envelope/delay state drained
+    void enterSilenceSleep();                                 // Flush residual state, settle meters
 };
 
 #endif // __HyeokStreamMaster__
@@ -0,0 +1,581 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Memory-mapped WAV / AIFF reader and writer
+//-------------------------------------------------------------------------------------------------------
+
+#include "AudioFile.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ELC4L {
+
+//-------------------------------------------------------------------------------------------------------
+// Helpers
+//-------------------------------------------------------------------------------------------------------
+namespace {
+
+inline uint16_t readLE16(const unsigned char* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t readLE32(const unsigned char* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+inline uint16_t readBE16(const unsigned char* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+inline uint32_t readBE32(const unsigned char* p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3]; }
+
+inline void writeLE16(unsigned char* p, uint16_t v) { p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); }
+inline void writeLE32(unsigned char* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i)); }
+inline void writeBE16(unsigned char* p, uint16_t v) { p[0] = (unsigned char)(v >> 8); p[1] = (unsigned char)v; }
+inline void writeBE32(unsigned char* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (24 - 8 * i)); }
+
+inline bool tagIs(const unsigned char* p, const char* tag) { return memcmp(p, tag, 4) == 0; }
+
+// 80-bit IEEE extended (AIFF sample rate)
+double readExtended(const unsigned char* p) {
+    int exponent = ((p[0] & 0x7F) << 8) | p[1];
+    uint64_t mantissa = 0;
+    for (int i = 0; i < 8; ++i) mantissa = (mantissa << 8) | p[2 + i];
+    if (exponent == 0 && mantissa == 0) return 0.0;
+    double value = ldexp((double)mantissa, exponent - 16383 - 63);
+    return (p[0] & 0x80) ? -value : value;
+}
+
+void writeExtended(unsigned char* p, double value) {
+    memset(p, 0, 10);
+    if (value <= 0.0) return;
+    int exponent = 0;
+    double fraction = frexp(value, &exponent);      // value = fraction * 2^exponent, fraction in [0.5, 1)
+    uint64_t mantissa = (uint64_t)ldexp(fraction, 64);
+    int biased = exponent - 1 + 16383;
+    p[0] = (unsigned char)((biased >> 8) & 0x7F);
+    p[1] = (unsigned char)biased;
+    for (int i = 0; i < 8; ++i) p[2 + i] = (unsigned char)(mantissa >> (56 - 8 * i));
+}
+
+inline float clampSample(float x) { return (x > 1.0f) ? 1.0f : ((x < -1.0f) ? -1.0f : x); }
+
+// Decode 'frames' interleaved frames; channel 1 falls back to channel 0 for mono sources
+void decodeFrames(const unsigned char* src, SampleEncoding encoding, bool bigEndian, int numChannels,
+                  int frameBytes, float* left, float* right, int frames) {
+    const int sampleBytes = bytesPerSample(encoding);
+    const int rightOffset = (numChannels > 1) ? sampleBytes : 0;
+
+    switch (encoding) {
+        case SampleEncoding::Int16:
+            for (int i = 0; i < frames; ++i, src += frameBytes) {
+                const unsigned char* l = src;
+                const unsigned char* r = src + rightOffset;
+                left[i]  = (float)(int16_t)(bigEndian ? readBE16(l) : readLE16(l)) * (1.0f / 32768.0f);
+                right[i] = (float)(int16_t)(bigEndian ? readBE16(r) : readLE16(r)) * (1.0f / 32768.0f);
+            }
+            break;
+        case SampleEncoding::Int24:
+            for (int i = 0; i < frames; ++i, src += frameBytes) {
+                const unsigned char* s[2] = { src, src + rightOffset };
+                float* dst[2] = { &left[i], &right[i] };
+                for (int ch = 0; ch < 2; ++ch) {
+                    const unsigned char* p = s[ch];
+                    uint32_t u = bigEndian ? (((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8))
+                                           : (((uint32_t)p[2] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[0] << 8));
+                    *dst[ch] = (float)((int32_t)u >> 8) * (1.0f / 8388608.0f);
+                }
+            }
+            break;
+        case SampleEncoding::Int32:
+            for (int i = 0; i < frames; ++i, src += frameBytes) {
+                const unsigned char* l = src;
+                const unsigned char* r = src + rightOffset;
+                left[i]  = (float)((double)(int32_t)(bigEndian ? readBE32(l) : readLE32(l)) * (1.0 / 2147483648.0));
+                right[i] = (float)((double)(int32_t)(bigEndian ? readBE32(r) : readLE32(r)) * (1.0 / 2147483648.0));
+            }
+            break;
+        case SampleEncoding::Float32:
+            for (int i = 0; i < frames; ++i, src += frameBytes) {
+                uint32_t l = bigEndian ? readBE32(src) : readLE32(src);
+                uint32_t r = bigEndian ? readBE32(src + rightOffset) : readLE32(src + rightOffset);
+                memcpy(&left[i], &l, 4);
+                memcpy(&right[i], &r, 4);
+            }
+            break;
+        case SampleEncoding::Float64:
+            for (int i = 0; i < frames; ++i, src += frameBytes) {
+                const unsigned char* s[2] = { src, src + rightOffset };
+                float* dst[2] = { &left[i], &right[i] };
+                for (int ch = 0; ch < 2; ++ch) {
+                    uint64_t bits = 0;
+                    for (int b = 0; b < 8; ++b) {
+                        bits |= (uint64_t)s[ch][bigEndian ? (7 - b) : b] << (8 * b);
+                    }
+                    double v;
+                    memcpy(&v, &bits, 8);
+                    *dst[ch] = (float)v;
+                }
+            }
+            break;
+    }
+}
+
+// Encode 'frames' stereo frames (PCM is rounded and clipped, no dither: output stays deterministic)
+void encodeFrames(unsigned char* dst, SampleEncoding encoding, bool bigEndian,
+                  const float* left, const float* right, int frames) {
+    switch (encoding) {
+        case SampleEncoding::Int16:
+            for (int i = 0; i < frames; ++i, dst += 4) {
+                int16_t l = (int16_t)lrintf(clampSample(left[i]) * 32767.0f);
+                int16_t r = (int16_t)lrintf(clampSample(right[i]) * 32767.0f);
+                if (bigEndian) { writeBE16(dst, (uint16_t)l); writeBE16(dst + 2, (uint16_t)r); }
+                else           { writeLE16(dst, (uint16_t)l); writeLE16(dst + 2, (uint16_t)r); }
+            }
+            break;
+        case SampleEncoding::Int24:
+            for (int i = 0; i < frames; ++i, dst += 6) {
+                int32_t v[2] = { (int32_t)lrintf(clampSample(left[i]) * 8388607.0f),
+                                 (int32_t)lrintf(clampSample(right[i]) * 8388607.0f) };
+                for (int ch = 0; ch < 2; ++ch) {
+                    unsigned char* p = dst + 3 * ch;
+                    if (bigEndian) { p[0] = (unsigned char)(v[ch] >> 16); p[1] = (unsigned char)(v[ch] >> 8); p[2] = (unsigned char)v[ch]; }
+                    else           { p[0] = (unsigned char)v[ch]; p[1] = (unsigned char)(v[ch] >> 8); p[2] = (unsigned char)(v[ch] >> 16); }
+                }
+            }
+            break;
+        case SampleEncoding::Float32:
+            for (int i = 0; i < frames; ++i, dst += 8) {
+                uint32_t l, r;
+                memcpy(&l, &left[i], 4);
+                memcpy(&r, &right[i], 4);
+                if (bigEndian) { writeBE32(dst, l); writeBE32(dst + 4, r); }
+                else           { writeLE32(dst, l); writeLE32(dst + 4, r); }
+            }
+            break;
+        default:
+            break;  // Not offered by the writer
+    }
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------------
+bool containerForPath(const char* path, AudioContainer& container) {
+    const char* dot = strrchr(path, '.');
+    if (!dot) return false;
+
+    char ext[8] = {};
+    for (int i = 0; i < 7 && dot[i + 1]; ++i) {
+        char c = dot[i + 1];
+        ext[i] = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+
+    if (strcmp(ext, "wav") == 0) { container = AudioContainer::Wav; return true; }
+    if (strcmp(ext, "aif") == 0 || strcmp(ext, "aiff") == 0 || strcmp(ext, "aifc") == 0) {
+        container = AudioContainer::Aiff;
+        return true;
+    }
+    return false;
+}
+
+int bytesPerSample(SampleEncoding encoding) {
+    switch (encoding) {
+        case SampleEncoding::Int16:   return 2;
+        case SampleEncoding::Int24:   return 3;
+        case SampleEncoding::Int32:   return 4;
+        case SampleEncoding::Float32: return 4;
+        case SampleEncoding::Float64: return 8;
+    }
+    return 0;
+}
+
+void quantizeToEncoding(SampleEncoding encoding, float* samples, int numSamples) {
+    float scale;
+    switch (encoding) {
+        case SampleEncoding::Int16: scale = 32767.0f; break;
+        case SampleEncoding::Int24: scale = 8388607.0f; break;
+        default: return;    // Float output is stored as is
+    }
+    // Same conversion as encodeFrames() followed by decodeFrames()
+    const float inverse = (encoding == SampleEncoding::Int16) ? (1.0f / 32768.0f) : (1.0f / 8388608.0f);
+    for (int i = 0; i < numSamples; ++i) {
+        samples[i] = (float)lrintf(clampSample(samples[i]) * scale) * inverse;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------
+// MappedFile
+//-------------------------------------------------------------------------------------------------------
+#if defined(_WIN32)
+
+bool MappedFile::openRead(const char* path) {
+    close();
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) { CloseHandle(handle); return false; }
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(handle); return false; }
+
+    base = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) { CloseHandle(mapping); CloseHandle(handle); return false; }
+
+    fileHandle = handle;
+    mappingHandle = mapping;
+    length = (uint64_t)fileSize.QuadPart;
+    return true;
+}
+
+bool MappedFile::createWrite(const char* path, uint64_t size) {
+    close();
+    HANDLE handle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READWRITE,
+                                       (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFFu), nullptr);
+    if (!mapping) { CloseHandle(handle); return false; }
+
+    base = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    if (!base) { CloseHandle(mapping); CloseHandle(handle); return false; }
+
+    fileHandle = handle;
+    mappingHandle = mapping;
+    length = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (base) UnmapViewOfFile(base);
+    if (mappingHandle) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle) CloseHandle((HANDLE)fileHandle);
+    base = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+}
+
+#else
+
+bool MappedFile::openRead(const char* path) {
+    close();
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) { close(); return false; }
+
+    void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) { close(); return false; }
+
+    base = (unsigned char*)mapped;
+    length = (uint64_t)info.st_size;
+    madvise(base, (size_t)length, MADV_SEQUENTIAL);
+    return true;
+}
+
+bool MappedFile::createWrite(const char* path, uint64_t size) {
+    close();
+    fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)size) != 0) { close(); return false; }
+
+    void* mapped = mmap(nullptr, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) { close(); return false; }
+
+    base = (unsigned char*)mapped;
+    length = size;
+    madvise(base, (size_t)length, MADV_SEQUENTIAL);
+    return true;
+}
+
+void MappedFile::close() {
+    if (base) munmap(base, (size_t)length);
+    if (fd >= 0) ::close(fd);
+    base = nullptr;
+    fd = -1;
+    length = 0;
+}
+
+#endif
+
+//-------------------------------------------------------------------------------------------------------
+// AudioFileReader
+//-------------------------------------------------------------------------------------------------------
+bool AudioFileReader::open(const char* path) {
+    close();
+    error.clear();
+
+    if (!file.openRead(path)) return fail(std::string("cannot open ") + path);
+    if (file.size() < 12) return fail("file too small");
+
+    const unsigned char* p = file.data();
+    if (tagIs(p, "RIFF") && tagIs(p + 8, "WAVE")) return parseWav();
+    if (tagIs(p, "FORM") && (tagIs(p + 8, "AIFF") || tagIs(p + 8, "AIFC"))) return parseAiff();
+    return fail("not a WAV or AIFF file");
+}
+
+void AudioFileReader::close() {
+    file.close();
+    sampleData = nullptr;
+    numFrames = 0;
+    position = 0;
+}
+
+bool AudioFileReader::parseWav() {
+    const unsigned char* base = file.data();
+    const uint64_t size = file.size();
+    container = AudioContainer::Wav;
+    bigEndian = false;
+
+    bool haveFormat = false;
+    int bits = 0;
+    uint64_t offset = 12;
+
+    while (offset + 8 <= size) {
+        const unsigned char* chunk = base + offset;
+        uint64_t chunkSize = readLE32(chunk + 4);
+
+        if (tagIs(chunk, "fmt ")) {
+            if (chunkSize < 16 || offset + 8 + chunkSize > size) return fail("bad fmt chunk");
+            uint16_t formatTag = readLE16(chunk + 8);
+            numChannels = readLE16(chunk + 10);
+            sampleRate = (double)readLE32(chunk + 12);
+            frameBytes = readLE16(chunk + 20);
+            bits = readLE16(chunk + 22);
+            if (formatTag == 0xFFFE && chunkSize >= 40) {
+                formatTag = readLE16(chunk + 8 + 24);   // SubFormat GUID starts with the format code
+            }
+
+            if (formatTag == 1) {
+                if (bits == 16) encoding = SampleEncoding::Int16;
+                else if (bits == 24) encoding = SampleEncoding::Int24;
+                else if (bits == 32) encoding = SampleEncoding::Int32;
+                else return fail("unsupported PCM bit depth");
+            } else if (formatTag == 3) {
+                if (bits == 32) encoding = SampleEncoding::Float32;
+                else if (bits == 64) encoding = SampleEncoding::Float64;
+                else return fail("unsupported float bit depth");
+            } else {
+                return fail("unsupported WAV format tag");
+            }
+            haveFormat = true;
+        } else if (tagIs(chunk, "data")) {
+            if (!haveFormat) return fail("data chunk before fmt chunk");
+            uint64_t available = size - (offset + 8);
+            // Streamed WAVs (e.g. written to a pipe) may carry a placeholder size
+            if (chunkSize == 0 || chunkSize > available) chunkSize = available;
+            sampleData = chunk + 8;
+            break;
+        }
+
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (!haveFormat || !sampleData) return fail("missing fmt or data chunk");
+    if (numChannels < 1 || numChannels > 2) return fail("only mono and stereo files are supported");
+    if (frameBytes != numChannels * bytesPerSample(encoding)) return fail("unexpected block alignment");
+
+    uint64_t dataBytes = size - (uint64_t)(sampleData - base);
+    numFrames = (int64_t)(dataBytes / (uint64_t)frameBytes);
+    // Clamp to the declared data size when it is valid
+    uint32_t declared = readLE32(sampleData - 4);
+    if (declared > 0 && declared <= dataBytes) numFrames = (int64_t)(declared / (uint32_t)frameBytes);
+    position = 0;
+    return true;
+}
+
+bool AudioFileReader::parseAiff() {
+    const unsigned char* base = file.data();
+    const uint64_t size = file.size();
+    const bool isAifc = tagIs(base + 8, "AIFC");
+    container = AudioContainer::Aiff;
+    bigEndian = true;
+
+    bool haveFormat = false;
+    int bits = 0;
+    uint32_t declaredFrames = 0;
+    uint64_t dataBytes = 0;
+    uint64_t offset = 12;
+
+    while (offset + 8 <= size) {
+        const unsigned char* chunk = base + offset;
+        uint64_t chunkSize = readBE32(chunk + 4);
+
+        if (tagIs(chunk, "COMM")) {
+            if (chunkSize < 18 || offset + 8 + chunkSize > size) return fail("bad COMM chunk");
+            numChannels = readBE16(chunk + 8);
+            declaredFrames = readBE32(chunk + 10);
+            bits = readBE16(chunk + 14);
+            sampleRate = readExtended(chunk + 16);
+
+            encoding = (bits <= 16) ? SampleEncoding::Int16 : (bits <= 24) ? SampleEncoding::Int24 : SampleEncoding::Int32;
+            if (isAifc && chunkSize >= 22) {
+                const unsigned char* type = chunk + 26;
+                if (tagIs(type, "sowt")) bigEndian = false;
+                else if (tagIs(type, "fl32") || tagIs(type, "FL32")) encoding = SampleEncoding::Float32;
+                else if (tagIs(type, "fl64") || tagIs(type, "FL64")) encoding = SampleEncoding::Float64;
+                else if (!tagIs(type, "NONE")) return fail("unsupported AIFC compression");
+            }
+            haveFormat = true;
+        } else if (tagIs(chunk, "SSND")) {
+            if (offset + 16 > size) return fail("bad SSND chunk");
+            uint32_t dataOffset = readBE32(chunk + 8);
+            sampleData = chunk + 16 + dataOffset;
+            uint64_t available = size - (uint64_t)(sampleData - base);
+            dataBytes = (chunkSize >= 8 + dataOffset) ? chunkSize - 8 - dataOffset : 0;
+            if (dataBytes == 0 || dataBytes > available) dataBytes = available;
+        }
+
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (!haveFormat || !sampleData) return fail("missing COMM or SSND chunk");
+    if (numChannels < 1 || numChannels > 2) return fail("only mono and stereo files are supported");
+
+    frameBytes = numChannels * bytesPerSample(encoding);
+    numFrames = (int64_t)(dataBytes / (uint64_t)frameBytes);
+    if (declaredFrames > 0 && (int64_t)declaredFrames < numFrames) numFrames = declaredFrames;
+    position = 0;
+    return true;
+}
+
+int AudioFileReader::read(float* left, float* right, int maxFrames) {
+    int frames = readFrames(position, left, right, maxFrames);
+    position += frames;
+    return frames;
+}
+
+int AudioFileReader::readFrames(int64_t start, float* left, float* right, int maxFrames) const {
+    if (!sampleData || start < 0 || start >= numFrames || maxFrames <= 0) return 0;
+    int64_t remaining = numFrames - start;
+    int frames = (remaining < maxFrames) ? (int)remaining : maxFrames;
+
+    decodeFrames(sampleData + start * frameBytes, encoding, bigEndian, numChannels, frameBytes,
+                 left, right, frames);
+    return frames;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// AudioFileWriter
+//-------------------------------------------------------------------------------------------------------
+bool AudioFileWriter::create(const char* path, AudioContainer container, SampleEncoding newEncoding,
+                             double sampleRate, int64_t frames) {
+    close();
+    error.clear();
+
+    if (newEncoding != SampleEncoding::Int16 && newEncoding != SampleEncoding::Int24 &&
+        newEncoding != SampleEncoding::Float32) {
+        error = "output encoding must be 16-bit, 24-bit or 32-bit float";
+        return false;
+    }
+
+    encoding = newEncoding;
+    numFrames = frames;
+    position = 0;
+    frameBytes = 2 * bytesPerSample(encoding);
+
+    const uint64_t dataBytes = (uint64_t)frames * (uint64_t)frameBytes;
+    const bool isFloat = (encoding == SampleEncoding::Float32);
+    uint64_t headerBytes = 0;
+
+    if (container == AudioContainer::Wav) {
+        bigEndian = false;
+        headerBytes = isFloat ? (12 + 8 + 18 + 8 + 4 + 8) : (12 + 8 + 16 + 8);   // RIFF + fmt (+ fact) + data
+    } else {
+        bigEndian = true;
+        headerBytes = isFloat ? (12 + 8 + 4 + 8 + 34 + 16) : (12 + 8 + 18 + 16);  // FORM (+ FVER) + COMM + SSND
+    }
+
+    const uint64_t totalBytes = headerBytes + dataBytes + (dataBytes & 1);
+    if (totalBytes > 0xFFFFFFFFull) {
+        error = "output exceeds the 4 GB limit of WAV/AIFF";
+        return false;
+    }
+    if (!file.createWrite(path, totalBytes)) {
+        error = std::string("cannot create ") + path;
+        return false;
+    }
+
+    unsigned char* p = file.data();
+    const uint16_t bits = (uint16_t)(8 * bytesPerSample(encoding));
+
+    if (container == AudioContainer::Wav) {
+        memcpy(p, "RIFF", 4); writeLE32(p + 4, (uint32_t)(totalBytes - 8)); memcpy(p + 8, "WAVE", 4);
+        p += 12;
+        memcpy(p, "fmt ", 4); writeLE32(p + 4, isFloat ? 18 : 16);
+        writeLE16(p + 8, isFloat ? 3 : 1);                      // IEEE float / PCM
+        writeLE16(p + 10, 2);
+        writeLE32(p + 12, (uint32_t)sampleRate);
+        writeLE32(p + 16, (uint32_t)sampleRate * (uint32_t)frameBytes);
+        writeLE16(p + 20, (uint16_t)frameBytes);
+        writeLE16(p + 22, bits);
+        p += isFloat ? 26 : 24;
+        if (isFloat) {
+            writeLE16(p - 2, 0);                                // cbSize
+            memcpy(p, "fact", 4); writeLE32(p + 4, 4); writeLE32(p + 8, (uint32_t)frames);
+            p += 12;
+        }
+        memcpy(p, "data", 4); writeLE32(p + 4, (uint32_t)dataBytes);
+        p += 8;
+    } else {
+        memcpy(p, "FORM", 4); writeBE32(p + 4, (uint32_t)(totalBytes - 8)); memcpy(p + 8, isFloat ? "AIFC" : "AIFF", 4);
+        p += 12;
+        if (isFloat) {
+            memcpy(p, "FVER", 4); writeBE32(p + 4, 4); writeBE32(p + 8, 0xA2805140u);
+            p += 12;
+        }
+        memcpy(p, "COMM", 4); writeBE32(p + 4, isFloat ? 34 : 18);
+        writeBE16(p + 8, 2);
+        writeBE32(p + 10, (uint32_t)frames);
+        writeBE16(p + 14, bits);
+        writeExtended(p + 16, sampleRate);
+        p += 26;
+        if (isFloat) {
+            memcpy(p, "fl32", 4);
+            p[4] = 11;                                          // Pascal string, padded to even length
+            memcpy(p + 5, "IEEE 32-bit", 11);
+            p += 16;
+        }
+        memcpy(p, "SSND", 4); writeBE32(p + 4, (uint32_t)(dataBytes + 8));
+        writeBE32(p + 8, 0);                                    // offset
+        writeBE32(p + 12, 0);                                   // block size
+        p += 16;
+    }
+
+    sampleData = p;
+    return true;
+}
+
+bool AudioFileWriter::close() {
+    bool ok = true;
+    if (file.isOpen() && position < numFrames && position > 0) {
+        // Streaming writer closed early: remaining frames stay silent (the mapping is zero-filled)
+        ok = false;
+        error = "output closed before all frames were written";
+    }
+    file.close();
+    sampleData = nullptr;
+    return ok;
+}
+
+int AudioFileWriter::write(const float* left, const float* right, int frames) {
+    int written = writeFrames(position, left, right, frames);
+    position += written;
+    return written;
+}
+
+int AudioFileWriter::writeFrames(int64_t start, const float* left, const float* right, int frames) {
+    if (!sampleData || start < 0 || start >= numFrames || frames <= 0) return 0;
+    int64_t remaining = numFrames - start;
+    int count = (remaining < frames) ? (int)remaining : frames;
+
+    encodeFrames(sampleData + start * frameBytes, encoding, bigEndian, left, right, count);
+    return count;
+}
+
+} // namespace ELC4L
@@ -0,0 +1,138 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Memory-mapped WAV / AIFF reader and writer
+// Files are mapped once and streamed block by block, converting to/from deinterleaved float stereo.
+// Reads: WAV (PCM 16/24/32, IEEE float 32/64, WAVE_FORMAT_EXTENSIBLE), AIFF (PCM 16/24/32),
+//        AIFC (NONE / sowt / fl32 / fl64). Mono sources are duplicated to both channels.
+// Writes: WAV (PCM 16/24, float 32), AIFF (PCM 16/24), AIFC fl32. Always stereo.
+// The positional readFrames()/writeFrames() calls touch disjoint regions of the mapping and may be
+// used from several threads at once.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ELC4L {
+
+enum class AudioContainer {
+    Wav,
+    Aiff
+};
+
+enum class SampleEncoding {
+    Int16,
+    Int24,
+    Int32,
+    Float32,
+    Float64
+};
+
+// Container from the file extension (.wav / .aif / .aiff / .aifc); false if unknown
+bool containerForPath(const char* path, AudioContainer& container);
+int bytesPerSample(SampleEncoding encoding);
+
+// Applies the writer's rounding and clipping in place, so in-memory audio compares bit-exactly
+// with what AudioFileWriter stores for 'encoding'
+void quantizeToEncoding(SampleEncoding encoding, float* samples, int numSamples);
+
+//-------------------------------------------------------------------------------------------------------
+// Read-only or read-write mapping of a whole file
+//-------------------------------------------------------------------------------------------------------
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool openRead(const char* path);
+    bool createWrite(const char* path, uint64_t size);   // Creates/truncates to 'size' bytes
+    void close();
+
+    unsigned char* data() const { return base; }
+    uint64_t size() const { return length; }
+    bool isOpen() const { return base != nullptr; }
+
+private:
+    unsigned char* base = nullptr;
+    uint64_t length = 0;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+//-------------------------------------------------------------------------------------------------------
+class AudioFileReader {
+public:
+    bool open(const char* path);
+    void close();
+
+    // Streaming read from the current position; returns frames read (0 at end of file)
+    int read(float* left, float* right, int maxFrames);
+    void seek(int64_t frame) { position = (frame < 0) ? 0 : (frame > numFrames ? numFrames : frame); }
+    int64_t getPosition() const { return position; }
+
+    // Positional read (thread-safe); returns frames read
+    int readFrames(int64_t start, float* left, float* right, int maxFrames) const;
+
+    int64_t getNumFrames() const { return numFrames; }
+    double getSampleRate() const { return sampleRate; }
+    int getNumChannels() const { return numChannels; }
+    AudioContainer getContainer() const { return container; }
+    SampleEncoding getEncoding() const { return encoding; }
+    const std::string& getError() const { return error; }
+
+private:
+    bool parseWav();
+    bool parseAiff();
+    bool fail(const std::string& message) { error = message; close(); return false; }
+
+    MappedFile file;
+    const unsigned char* sampleData = nullptr;
+    int64_t numFrames = 0;
+    int64_t position = 0;
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    int frameBytes = 0;
+    AudioContainer container = AudioContainer::Wav;
+    SampleEncoding encoding = SampleEncoding::Int16;
+    bool bigEndian = false;
+    std::string error;
+};
+
+//-------------------------------------------------------------------------------------------------------
+class AudioFileWriter {
+public:
+    ~AudioFileWriter() { close(); }
+
+    // Stereo output of exactly 'numFrames' frames (the file is sized and mapped up front)
+    bool create(const char* path, AudioContainer container, SampleEncoding encoding,
+                double sampleRate, int64_t numFrames);
+    bool close();
+
+    // Streaming write at the current position; returns frames written
+    int write(const float* left, const float* right, int frames);
+    int64_t getPosition() const { return position; }
+
+    // Positional write (thread-safe for disjoint ranges); returns frames written
+    int writeFrames(int64_t start, const float* left, const float* right, int frames);
+
+    int64_t getNumFrames() const { return numFrames; }
+    const std::string& getError() const { return error; }
+
+private:
+    MappedFile file;
+    unsigned char* sampleData = nullptr;
+    int64_t numFrames = 0;
+    int64_t position = 0;
+    int frameBytes = 0;
+    SampleEncoding encoding = SampleEncoding::Float32;
+    bool bigEndian = false;
+    std::string error;
+};
+
+} // namespace ELC4L
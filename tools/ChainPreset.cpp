@@ -0,0 +1,197 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Chain presets
+//-------------------------------------------------------------------------------------------------------
+
+#include "ChainPreset.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace ELC4L {
+
+namespace {
+
+enum class ValueKind { Float, Switch, Quality };
+
+struct SettingKey {
+    const char* name;
+    const char* unit;
+    ValueKind kind;
+    float minValue;
+    float maxValue;
+    float* (*floatField)(ChainSettings&);
+    bool* (*switchField)(ChainSettings&);
+    int* (*qualityField)(ChainSettings&);
+};
+
+// Ranges follow the plugin parameter mappings (normalizedTo*() in HyeokStreamMaster.h)
+const SettingKey kKeys[] = {
+    { "band1-thresh",    "dB", ValueKind::Float,  -36.0f, 0.0f,     [](ChainSettings& s) { return &s.bandThreshDb[0]; }, nullptr },
+    { "band2-thresh",    "dB", ValueKind::Float,  -36.0f, 0.0f,     [](ChainSettings& s) { return &s.bandThreshDb[1]; }, nullptr },
+    { "band3-thresh",    "dB", ValueKind::Float,  -36.0f, 0.0f,     [](ChainSettings& s) { return &s.bandThreshDb[2]; }, nullptr },
+    { "band4-thresh",    "dB", ValueKind::Float,  -36.0f, 0.0f,     [](ChainSettings& s) { return &s.bandThreshDb[3]; }, nullptr },
+    { "band1-makeup",    "dB", ValueKind::Float,  -12.0f, 12.0f,    [](ChainSettings& s) { return &s.bandMakeupDb[0]; }, nullptr },
+    { "band2-makeup",    "dB", ValueKind::Float,  -12.0f, 12.0f,    [](ChainSettings& s) { return &s.bandMakeupDb[1]; }, nullptr },
+    { "band3-makeup",    "dB", ValueKind::Float,  -12.0f, 12.0f,    [](ChainSettings& s) { return &s.bandMakeupDb[2]; }, nullptr },
+    { "band4-makeup",    "dB", ValueKind::Float,  -12.0f, 12.0f,    [](ChainSettings& s) { return &s.bandMakeupDb[3]; }, nullptr },
+    { "band1-ms",        "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandMidSide[0]; } },
+    { "band2-ms",        "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandMidSide[1]; } },
+    { "band3-ms",        "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandMidSide[2]; } },
+    { "band4-ms",        "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandMidSide[3]; } },
+    { "band1-bypass",    "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandBypass[0]; } },
+    { "band2-bypass",    "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandBypass[1]; } },
+    { "band3-bypass",    "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandBypass[2]; } },
+    { "band4-bypass",    "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.bandBypass[3]; } },
+    { "xover1",          "Hz", ValueKind::Float,  20.0f, 20000.0f,  [](ChainSettings& s) { return &s.xoverHz[0]; }, nullptr },
+    { "xover2",          "Hz", ValueKind::Float,  20.0f, 20000.0f,  [](ChainSettings& s) { return &s.xoverHz[1]; }, nullptr },
+    { "xover3",          "Hz", ValueKind::Float,  20.0f, 20000.0f,  [](ChainSettings& s) { return &s.xoverHz[2]; }, nullptr },
+    { "limiter-thresh",  "dB", ValueKind::Float,  -24.0f, 0.0f,     [](ChainSettings& s) { return &s.limiterThreshDb; }, nullptr },
+    { "limiter-ceiling", "dB", ValueKind::Float,  -12.0f, 0.0f,     [](ChainSettings& s) { return &s.limiterCeilingDb; }, nullptr },
+    { "limiter-release", "ms", ValueKind::Float,  10.0f, 500.0f,    [](ChainSettings& s) { return &s.limiterReleaseMs; }, nullptr },
+    { "limiter-bypass",  "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.limiterBypass; } },
+    { "sidechain",       "",   ValueKind::Switch, 0.0f, 1.0f,       nullptr, [](ChainSettings& s) { return &s.sidechainActive; } },
+    { "sidechain-freq",  "Hz", ValueKind::Float,  20.0f, 20000.0f,  [](ChainSettings& s) { return &s.sidechainHz; }, nullptr },
+    { "quality",         "",   ValueKind::Quality, 0.0f, 1.0f,      nullptr, nullptr, [](ChainSettings& s) { return &s.processingQuality; } },
+};
+
+const SettingKey* findKey(const std::string& key) {
+    for (const SettingKey& entry : kKeys) {
+        if (key == entry.name) return &entry;
+    }
+    return nullptr;
+}
+
+bool parseSwitch(std::string value, bool& result) {
+    for (char& c : value) c = (char)tolower((unsigned char)c);
+    if (value == "on" || value == "true" || value == "yes" || value == "1") { result = true; return true; }
+    if (value == "off" || value == "false" || value == "no" || value == "0") { result = false; return true; }
+    return false;
+}
+
+// eco / standard / high, or the plugin's normalized parameter value (0, 0.5, 1), through the same
+// mapping as the Quality parameter
+bool parseQuality(std::string value, int& result) {
+    for (char& c : value) c = (char)tolower((unsigned char)c);
+    float normalized = -1.0f;
+    for (int q = 0; q < kNumProcessingQualities; ++q) {
+        std::string name = getProcessingQualityName(q);
+        for (char& c : name) c = (char)tolower((unsigned char)c);
+        if (value == name) normalized = processingQualityToNormalized(q);
+    }
+    if (normalized < 0.0f) {
+        char* end = nullptr;
+        normalized = strtof(value.c_str(), &end);
+        if (value.empty() || *end != '\0' || normalized < 0.0f || normalized > 1.0f) return false;
+    }
+    result = normalizedToProcessingQuality(normalized);
+    return true;
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && isspace((unsigned char)text[begin])) ++begin;
+    while (end > begin && isspace((unsigned char)text[end - 1])) --end;
+    return text.substr(begin, end - begin);
+}
+
+} // namespace
+
+bool applyChainSetting(ChainSettings& settings, const std::string& key, const std::string& value,
+                       std::string& error) {
+    const SettingKey* entry = findKey(key);
+    if (!entry) {
+        error = "unknown setting '" + key + "'";
+        return false;
+    }
+
+    if (entry->kind == ValueKind::Switch) {
+        if (!parseSwitch(value, *entry->switchField(settings))) {
+            error = "'" + key + "' expects on/off, got '" + value + "'";
+            return false;
+        }
+        return true;
+    }
+
+    if (entry->kind == ValueKind::Quality) {
+        if (!parseQuality(value, *entry->qualityField(settings))) {
+            error = "'" + key + "' expects eco/standard/high or 0..1, got '" + value + "'";
+            return false;
+        }
+        return true;
+    }
+
+    char* end = nullptr;
+    float parsed = strtof(value.c_str(), &end);
+    if (value.empty() || *end != '\0') {
+        error = "'" + key + "' expects a number, got '" + value + "'";
+        return false;
+    }
+    if (parsed < entry->minValue || parsed > entry->maxValue) {
+        char range[96];
+        snprintf(range, sizeof(range), " is out of range [%g, %g]", entry->minValue, entry->maxValue);
+        error = "'" + key + "' = " + value + range;
+        return false;
+    }
+    *entry->floatField(settings) = parsed;
+    return true;
+}
+
+bool isChainSettingKey(const std::string& key) {
+    return findKey(key) != nullptr;
+}
+
+bool loadChainPreset(const char* path, ChainSettings& settings, std::string& error) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        error = std::string("cannot open preset ") + path;
+        return false;
+    }
+
+    char buffer[512];
+    int lineNumber = 0;
+    bool ok = true;
+    while (ok && fgets(buffer, sizeof(buffer), file)) {
+        ++lineNumber;
+        std::string line(buffer);
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        std::string lineError;
+        if (equals == std::string::npos) {
+            lineError = "expected 'key = value'";
+            ok = false;
+        } else {
+            ok = applyChainSetting(settings, trim(line.substr(0, equals)), trim(line.substr(equals + 1)), lineError);
+        }
+        if (!ok) {
+            error = std::string(path) + ":" + std::to_string(lineNumber) + ": " + lineError;
+        }
+    }
+
+    fclose(file);
+    return ok;
+}
+
+void printChainSettingKeys(FILE* stream) {
+    ChainSettings defaults;
+    for (const SettingKey& entry : kKeys) {
+        if (entry.kind == ValueKind::Switch) {
+            fprintf(stream, "  %-16s on/off           (default %s)\n", entry.name,
+                    *entry.switchField(defaults) ? "on" : "off");
+        } else if (entry.kind == ValueKind::Quality) {
+            std::string name = getProcessingQualityName(*entry.qualityField(defaults));
+            for (char& c : name) c = (char)tolower((unsigned char)c);
+            fprintf(stream, "  %-16s eco/standard/high (default %s)\n", entry.name, name.c_str());
+        } else {
+            fprintf(stream, "  %-16s %-2s %6g .. %-6g (default %g)\n", entry.name, entry.unit,
+                    entry.minValue, entry.maxValue, *entry.floatField(defaults));
+        }
+    }
+}
+
+} // namespace ELC4L
@@ -0,0 +1,37 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Chain presets
+// Text presets for the offline tools, one "key = value" per line ('#' starts a comment):
+//
+//   band1-thresh = -12      # dB, bands 1..4
+//   band3-ms = on           # M/S loose-side mode
+//   xover2 = 700            # Hz
+//   limiter-ceiling = -1
+//   quality = high          # eco / standard / high (the plugins' Quality parameter)
+//
+// The same keys are accepted on the command line as "--key value". Values are in engineering units
+// (dB, Hz, ms); switches accept on/off, true/false, yes/no, 1/0; quality also accepts the
+// parameter's normalized value (0, 0.5, 1).
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "OfflineChain.h"
+
+#include <cstdio>
+#include <string>
+
+namespace ELC4L {
+
+// Applies one key/value pair; false (with 'error' set) for an unknown key or a malformed value
+bool applyChainSetting(ChainSettings& settings, const std::string& key, const std::string& value,
+                       std::string& error);
+
+// True if 'key' names a chain setting (used to tell settings apart from tool options)
+bool isChainSettingKey(const std::string& key);
+
+// Loads a preset file on top of 'settings'; errors carry the line number
+bool loadChainPreset(const char* path, ChainSettings& settings, std::string& error);
+
+// Prints every key with its unit and default value
+void printChainSettingKeys(FILE* stream);
+
+} // namespace ELC4L
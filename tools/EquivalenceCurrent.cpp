@@ -0,0 +1,25 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Equivalence kernels: current VST2 DSP core (src/HyeokStreamDSP.h)
+//-------------------------------------------------------------------------------------------------------
+
+#include "EquivalenceKernels.h"
+#include "HyeokStreamDSP.h"
+
+#include <cstring>
+
+namespace ELC4L {
+
+std::unique_ptr<ModuleKernel> createCurrentKernel(const char* module) {
+    using namespace EquivalenceAdapters;
+    ModuleKernel* kernel = nullptr;
+    if (strcmp(module, "crossover") == 0)     kernel = new CrossoverKernel<::HyeokStreamDSP>();
+    else if (strcmp(module, "comp") == 0)     kernel = new CompressorKernel<::OptoCompressor>();
+    else if (strcmp(module, "os-sat") == 0)   kernel = new OversampledSaturatorKernel<::PolyphaseOversampler, ::TapeSaturator>();
+    else if (strcmp(module, "limiter") == 0)  kernel = new LimiterKernel<::LookaheadLimiter>();
+    else if (strcmp(module, "lufs") == 0)     kernel = new LufsKernel<::LufsMeter>();
+    else if (strcmp(module, "spectrum") == 0) kernel = new SpectrumKernel<::SpectrumAnalyzer>();
+    else if (strcmp(module, "chain") == 0)    kernel = new ChainKernel<::HyeokStreamDSP, ::OptoCompressor, ::LookaheadLimiter>();
+    return std::unique_ptr<ModuleKernel>(kernel);
+}
+
+} // namespace ELC4L
@@ -0,0 +1,224 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Module kernels for the numerical equivalence harness
+// One adapter per module, templated on the module types so the same driving code runs against each
+// implementation: the frozen reference (reference/ReferenceDSP.h), the current VST2 DSP core
+// (src/HyeokStreamDSP.h) and the VST3 copy (vst3/src/ELC4Ldsp.h). Each implementation lives in its
+// own translation unit because the VST2 core and the VST3 copy declare the same names.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace ELC4L {
+
+// Module settings used for every implementation (plugin defaults unless noted)
+struct EquivalenceSettings {
+    float xoverHz[3] = { 79.6f, 632.5f, 5024.0f };
+    float compThreshDb = -18.0f;        // Lower than the default so the corpus drives real reduction
+    float compMakeupDb = 3.0f;
+    float limiterThreshDb = -6.0f;
+    float limiterCeilingDb = -1.0f;
+    float limiterReleaseMs = 157.0f;
+};
+
+class ModuleKernel {
+public:
+    virtual ~ModuleKernel() = default;
+
+    // Runs a whole stereo signal in host-sized blocks from a freshly prepared state. 'output'
+    // receives the module's observable result (interleaved audio, meter values or spectrum frames).
+    virtual void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+                     int blockSize, const EquivalenceSettings& settings, std::vector<float>& output) = 0;
+};
+
+// Factories per implementation; nullptr if the implementation has no such module
+std::unique_ptr<ModuleKernel> createReferenceKernel(const char* module);
+std::unique_ptr<ModuleKernel> createCurrentKernel(const char* module);
+std::unique_ptr<ModuleKernel> createVst3Kernel(const char* module);
+
+namespace EquivalenceAdapters {
+
+// Calls process(l, r) on a module for every sample, block by block, and appends interleaved output
+template <typename Body>
+void runBlocks(const std::vector<float>& left, const std::vector<float>& right, int blockSize,
+               std::vector<float>& output, Body&& body) {
+    const int total = (int)left.size();
+    output.clear();
+    output.reserve(2 * (size_t)total);
+    for (int start = 0; start < total; start += blockSize) {
+        const int end = std::min(total, start + blockSize);
+        for (int i = start; i < end; ++i) {
+            float l = left[i], r = right[i];
+            body(l, r);
+            output.push_back(l);
+            output.push_back(r);
+        }
+    }
+}
+
+template <typename Crossover>
+void prepareCrossover(Crossover& crossover, float sampleRate, const EquivalenceSettings& settings) {
+    crossover.setSampleRate(sampleRate);
+    static_assert(Crossover::kNumSplits == 3, "equivalence settings describe a 4-band split");
+    for (int k = 0; k < Crossover::kNumSplits; ++k) crossover.setFrequency(k, settings.xoverHz[k]);
+    crossover.reset();
+}
+
+template <typename Compressor>
+void prepareCompressor(Compressor& comp, float sampleRate, const EquivalenceSettings& settings) {
+    comp.setSampleRate(sampleRate);
+    comp.setThresholdDb(settings.compThreshDb);
+    comp.setMakeupDb(settings.compMakeupDb);
+    comp.reset();
+}
+
+template <typename Limiter>
+void prepareLimiter(Limiter& limiter, float sampleRate, const EquivalenceSettings& settings) {
+    limiter.setSampleRate(sampleRate);
+    limiter.setThreshold(settings.limiterThreshDb);
+    limiter.setCeiling(settings.limiterCeilingDb);
+    limiter.setRelease(settings.limiterReleaseMs);
+    limiter.reset();
+}
+
+// Four bands summed; a transparent crossover nulls against its own input up to the allpass phase
+template <typename Crossover>
+class CrossoverKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+             int blockSize, const EquivalenceSettings& settings, std::vector<float>& output) override {
+        std::unique_ptr<Crossover> crossover(new Crossover());
+        prepareCrossover(*crossover, sampleRate, settings);
+        runBlocks(left, right, blockSize, output, [&](float& l, float& r) {
+            float bl[Crossover::kNumBands], br[Crossover::kNumBands];
+            crossover->processSample(l, r, bl, br);
+            l = 0.0f;
+            r = 0.0f;
+            for (int b = 0; b < Crossover::kNumBands; ++b) {
+                l += bl[b];
+                r += br[b];
+            }
+        });
+    }
+};
+
+template <typename Compressor>
+class CompressorKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+             int blockSize, const EquivalenceSettings& settings, std::vector<float>& output) override {
+        std::unique_ptr<Compressor> comp(new Compressor());
+        prepareCompressor(*comp, sampleRate, settings);
+        runBlocks(left, right, blockSize, output, [&](float& l, float& r) { comp->process(l, r); });
+    }
+};
+
+// 4x polyphase upsample -> tape saturation -> decimate, at the compressor's default drive
+template <typename Oversampler, typename Saturator>
+class OversampledSaturatorKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float,
+             int blockSize, const EquivalenceSettings&, std::vector<float>& output) override {
+        std::unique_ptr<Oversampler> oversamplerL(new Oversampler()), oversamplerR(new Oversampler());
+        Saturator saturator;
+        const float drive = 1.0f + 0.3f * 3.0f;
+        const float bias = 0.3f * 0.1f;
+        runBlocks(left, right, blockSize, output, [&](float& l, float& r) {
+            float up[4];
+            oversamplerL->processUpsample(l, up);
+            for (int k = 0; k < 4; ++k) up[k] = saturator.process(up[k], drive, bias);
+            l = oversamplerL->processDownsample(up) / drive;
+            oversamplerR->processUpsample(r, up);
+            for (int k = 0; k < 4; ++k) up[k] = saturator.process(up[k], drive, bias);
+            r = oversamplerR->processDownsample(up) / drive;
+        });
+    }
+};
+
+template <typename Limiter>
+class LimiterKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+             int blockSize, const EquivalenceSettings& settings, std::vector<float>& output) override {
+        std::unique_ptr<Limiter> limiter(new Limiter());
+        prepareLimiter(*limiter, sampleRate, settings);
+        runBlocks(left, right, blockSize, output, [&](float& l, float& r) { limiter->process(l, r); });
+    }
+};
+
+// Momentary loudness (LUFS) after every sample, written to both output channels
+template <typename Meter>
+class LufsKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+             int blockSize, const EquivalenceSettings&, std::vector<float>& output) override {
+        std::unique_ptr<Meter> meter(new Meter());
+        meter->setSampleRate(sampleRate);
+        meter->reset();
+        runBlocks(left, right, blockSize, output, [&](float& l, float& r) {
+            meter->process(l, r);
+            l = r = meter->getMomentary();
+        });
+    }
+};
+
+// Spectrum frames (dB bins) of the mono sum with the plugin's 4096 / 1024 hop, concatenated
+template <typename Analyzer>
+class SpectrumKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+             int, const EquivalenceSettings&, std::vector<float>& output) override {
+        const int fftSize = Analyzer::kFftSize;
+        const int bins = Analyzer::kSpectrumBins;
+        const int hop = 1024;
+        std::unique_ptr<Analyzer> analyzer(new Analyzer());
+        std::vector<float> history(fftSize, 0.0f);
+        std::vector<float> spectrum(bins, -90.0f);
+        int writePos = 0;
+
+        output.clear();
+        for (size_t i = 0; i < left.size(); ++i) {
+            history[writePos] = 0.5f * (left[i] + right[i]);
+            if (++writePos >= fftSize) {
+                analyzer->computeSpectrum(history.data(), spectrum.data(), sampleRate);
+                output.insert(output.end(), spectrum.begin(), spectrum.end());
+                std::copy(history.begin() + hop, history.end(), history.begin());
+                writePos = fftSize - hop;
+            }
+        }
+    }
+};
+
+// Crossover -> 4 compressors -> limiter, no monitoring or bypass logic
+template <typename Crossover, typename Compressor, typename Limiter>
+class ChainKernel : public ModuleKernel {
+public:
+    void run(const std::vector<float>& left, const std::vector<float>& right, float sampleRate,
+             int blockSize, const EquivalenceSettings& settings, std::vector<float>& output) override {
+        std::unique_ptr<Crossover> crossover(new Crossover());
+        std::unique_ptr<Compressor[]> comps(new Compressor[4]);
+        std::unique_ptr<Limiter> limiter(new Limiter());
+        prepareCrossover(*crossover, sampleRate, settings);
+        for (int b = 0; b < 4; ++b) prepareCompressor(comps[b], sampleRate, settings);
+        prepareLimiter(*limiter, sampleRate, settings);
+
+        runBlocks(left, right, blockSize, output, [&](float& l, float& r) {
+            float bl[Crossover::kNumBands], br[Crossover::kNumBands];
+            crossover->processSample(l, r, bl, br);
+            l = 0.0f;
+            r = 0.0f;
+            for (int b = 0; b < 4; ++b) {
+                comps[b].process(bl[b], br[b]);
+                l += bl[b];
+                r += br[b];
+            }
+            limiter->process(l, r);
+        });
+    }
+};
+
+} // namespace EquivalenceAdapters
+
+} // namespace ELC4L
@@ -0,0 +1,48 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Equivalence kernels: frozen reference (reference/ReferenceDSP.h)
+//-------------------------------------------------------------------------------------------------------
+
+#include "EquivalenceKernels.h"
+#include "reference/ReferenceDSP.h"
+
+#include <cstring>
+
+namespace ELC4L {
+
+namespace {
+
+// The frozen crossover keeps its fixed three-split API; present it the way the kernels drive
+// Crossover<N> (numbered split frequencies, bands written to arrays)
+struct ReferenceCrossover : Reference::HyeokStreamDSP {
+    static constexpr int kNumBands = 4;
+    static constexpr int kNumSplits = 3;
+
+    void setFrequency(int k, float f) {
+        if (k == 0) setXover1(f);
+        else if (k == 1) setXover2(f);
+        else setXover3(f);
+    }
+
+    void processSample(float inL, float inR, float* bandL, float* bandR) {
+        Reference::HyeokStreamDSP::processSample(inL, inR, bandL[0], bandR[0], bandL[1], bandR[1],
+                                                 bandL[2], bandR[2], bandL[3], bandR[3]);
+    }
+};
+
+} // namespace
+
+std::unique_ptr<ModuleKernel> createReferenceKernel(const char* module) {
+    using namespace EquivalenceAdapters;
+    namespace R = Reference;
+    ModuleKernel* kernel = nullptr;
+    if (strcmp(module, "crossover") == 0)     kernel = new CrossoverKernel<ReferenceCrossover>();
+    else if (strcmp(module, "comp") == 0)     kernel = new CompressorKernel<R::OptoCompressor>();
+    else if (strcmp(module, "os-sat") == 0)   kernel = new OversampledSaturatorKernel<R::PolyphaseOversampler, R::TapeSaturator>();
+    else if (strcmp(module, "limiter") == 0)  kernel = new LimiterKernel<R::LookaheadLimiter>();
+    else if (strcmp(module, "lufs") == 0)     kernel = new LufsKernel<R::LufsMeter>();
+    else if (strcmp(module, "spectrum") == 0) kernel = new SpectrumKernel<R::SpectrumAnalyzer>();
+    else if (strcmp(module, "chain") == 0)    kernel = new ChainKernel<ReferenceCrossover, R::OptoCompressor, R::LookaheadLimiter>();
+    return std::unique_ptr<ModuleKernel>(kernel);
+}
+
+} // namespace ELC4L
@@ -0,0 +1,25 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Equivalence kernels: VST3 DSP copy (vst3/src/ELC4Ldsp.h)
+// The VST3 copy has no separate oversampler or spectrum analyzer module (its saturation is inline in
+// OptoCompressor and its analyzer lives in the SDK-bound processor), so those return nullptr.
+//-------------------------------------------------------------------------------------------------------
+
+#include "EquivalenceKernels.h"
+#include "ELC4Ldsp.h"
+
+#include <cstring>
+
+namespace ELC4L {
+
+std::unique_ptr<ModuleKernel> createVst3Kernel(const char* module) {
+    using namespace EquivalenceAdapters;
+    ModuleKernel* kernel = nullptr;
+    if (strcmp(module, "crossover") == 0)     kernel = new CrossoverKernel<FourBandCrossover>();
+    else if (strcmp(module, "comp") == 0)     kernel = new CompressorKernel<OptoCompressor>();
+    else if (strcmp(module, "limiter") == 0)  kernel = new LimiterKernel<LookaheadLimiter>();
+    else if (strcmp(module, "lufs") == 0)     kernel = new LufsKernel<LufsMeter>();
+    else if (strcmp(module, "chain") == 0)    kernel = new ChainKernel<FourBandCrossover, OptoCompressor, LookaheadLimiter>();
+    return std::unique_ptr<ModuleKernel>(kernel);
+}
+
+} // namespace ELC4L
@@ -0,0 +1,239 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Program loudness analysis (ITU-R BS.1770-4 / EBU R128)
+//-------------------------------------------------------------------------------------------------------
+
+#include "LoudnessAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ELC4L {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kAbsoluteGateLufs = -70.0;
+constexpr double kIntegratedRelativeGateLu = -10.0;
+constexpr double kRangeRelativeGateLu = -20.0;
+constexpr int kMomentarySteps = 4;      // 400 ms gating block
+constexpr int kShortTermSteps = 30;     // 3 s short-term window
+
+inline double energyToLufs(double energy) {
+    return (energy > 0.0) ? -0.691 + 10.0 * log10(energy) : -INFINITY;
+}
+
+inline double lufsToEnergy(double lufs) {
+    return pow(10.0, (lufs + 0.691) / 10.0);
+}
+
+inline double linearToDb(double linear) {
+    return (linear > 0.0) ? 20.0 * log10(linear) : -INFINITY;
+}
+
+// Mean energy of sliding windows of 'steps' 100 ms steps (75 % overlap for 400 ms, per BS.1770)
+std::vector<double> windowEnergies(const std::vector<double>& stepEnergies, int steps) {
+    std::vector<double> windows;
+    if ((int)stepEnergies.size() < steps) return windows;
+
+    double sum = 0.0;
+    for (int i = 0; i < steps; ++i) sum += stepEnergies[i];
+    windows.push_back(sum / steps);
+    for (size_t i = steps; i < stepEnergies.size(); ++i) {
+        sum += stepEnergies[i] - stepEnergies[i - steps];
+        windows.push_back(std::max(0.0, sum) / steps);
+    }
+    return windows;
+}
+
+} // namespace
+
+void KWeightingFilter::prepare(double sampleRate) {
+    // K-weighting for any sample rate (bilinear designs matching the BS.1770 48 kHz coefficients)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = tan(kPi * f0 / sampleRate);
+        const double vh = pow(10.0, gainDb / 20.0);
+        const double vb = pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = tan(kPi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+        highpass.b0 = 1.0;
+        highpass.b1 = -2.0;
+        highpass.b2 = 1.0;
+        highpass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highpass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    reset();
+}
+
+void KWeightingFilter::reset() {
+    for (int ch = 0; ch < 2; ++ch) {
+        shelf.z1[ch] = shelf.z2[ch] = 0.0;
+        highpass.z1[ch] = highpass.z2[ch] = 0.0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------
+void LoudnessAnalyzer::prepare(double newSampleRate, bool measureTruePeak) {
+    sampleRate = newSampleRate;
+    truePeakEnabled = measureTruePeak;
+    weighting.prepare(sampleRate);
+
+    // True peak: Hann-windowed sinc interpolator, one 12-tap fractional-delay filter per phase
+    for (int phase = 0; phase < kTruePeakPhases; ++phase) {
+        const double fraction = (double)phase / kTruePeakPhases;
+        double sum = 0.0;
+        for (int j = 0; j < kTruePeakTaps; ++j) {
+            double t = (double)j - (kTruePeakTaps / 2) + fraction;     // distance to the output instant
+            double sinc = (fabs(t) < 1.0e-9) ? 1.0 : sin(kPi * t) / (kPi * t);
+            double window = 0.5 + 0.5 * cos(kPi * t / (kTruePeakTaps / 2 + 0.5));
+            truePeakCoeffs[phase][j] = (float)(sinc * window);
+            sum += sinc * window;
+        }
+        for (int j = 0; j < kTruePeakTaps; ++j) {
+            truePeakCoeffs[phase][j] = (float)(truePeakCoeffs[phase][j] / sum);
+        }
+    }
+
+    stepLength = std::max(1, (int)lround(sampleRate * 0.1));
+    reset();
+}
+
+void LoudnessAnalyzer::reset() {
+    weighting.reset();
+    stepPosition = 0;
+    stepEnergy = 0.0;
+    stepEnergies.clear();
+    samplePeak = 0.0;
+    truePeak = 0.0;
+    for (int ch = 0; ch < 2; ++ch) {
+        std::fill(truePeakHistory[ch], truePeakHistory[ch] + 2 * kTruePeakTaps, 0.0f);
+    }
+    truePeakIndex = 0;
+    totalSamples = 0;
+}
+
+void LoudnessAnalyzer::process(const float* left, const float* right, int numSamples) {
+    const float* channels[2] = { left, right };
+    float blockPeak = 0.0f;
+    float blockTruePeak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i) {
+        addEnergy(weighting.processEnergy(left[i], right[i]));
+
+        for (int ch = 0; ch < 2; ++ch) {
+            const float x = channels[ch][i];
+            blockPeak = std::max(blockPeak, fabsf(x));
+
+            if (truePeakEnabled) {
+                float* history = truePeakHistory[ch];
+                history[truePeakIndex] = x;
+                history[truePeakIndex + kTruePeakTaps] = x;
+                // history[truePeakIndex + kTruePeakTaps - j] is the input j samples ago
+                const float* newest = history + truePeakIndex + kTruePeakTaps;
+                for (int phase = 0; phase < kTruePeakPhases; ++phase) {
+                    float y = 0.0f;
+                    for (int j = 0; j < kTruePeakTaps; ++j) {
+                        y += truePeakCoeffs[phase][j] * newest[-j];
+                    }
+                    blockTruePeak = std::max(blockTruePeak, fabsf(y));
+                }
+            }
+        }
+        truePeakIndex = (truePeakIndex + 1) % kTruePeakTaps;
+    }
+
+    samplePeak = std::max(samplePeak, (double)blockPeak);
+    truePeak = std::max(truePeak, (double)blockTruePeak);
+    totalSamples += numSamples;
+}
+
+void LoudnessAnalyzer::accumulateEnergy(const float* energies, int numSamples) {
+    for (int i = 0; i < numSamples; ++i) {
+        addEnergy(energies[i]);
+    }
+    totalSamples += numSamples;
+}
+
+double LoudnessAnalyzer::getIntegratedLufs() const {
+    const std::vector<double> blocks = windowEnergies(stepEnergies, kMomentarySteps);
+    const double absoluteGate = lufsToEnergy(kAbsoluteGateLufs);
+
+    double sum = 0.0;
+    int count = 0;
+    for (double energy : blocks) {
+        if (energy > absoluteGate) { sum += energy; ++count; }
+    }
+    if (count == 0) return -INFINITY;
+
+    const double relativeGate = lufsToEnergy(energyToLufs(sum / count) + kIntegratedRelativeGateLu);
+    sum = 0.0;
+    count = 0;
+    for (double energy : blocks) {
+        if (energy > absoluteGate && energy > relativeGate) { sum += energy; ++count; }
+    }
+    return (count > 0) ? energyToLufs(sum / count) : -INFINITY;
+}
+
+// Short-term loudness values passing the absolute and the -20 LU relative gate, sorted
+std::vector<double> LoudnessAnalyzer::gatedShortTermLoudness() const {
+    const std::vector<double> windows = windowEnergies(stepEnergies, kShortTermSteps);
+    const double absoluteGate = lufsToEnergy(kAbsoluteGateLufs);
+
+    double sum = 0.0;
+    int count = 0;
+    for (double energy : windows) {
+        if (energy > absoluteGate) { sum += energy; ++count; }
+    }
+
+    std::vector<double> loudness;
+    if (count == 0) return loudness;
+    const double relativeGate = lufsToEnergy(energyToLufs(sum / count) + kRangeRelativeGateLu);
+    for (double energy : windows) {
+        if (energy > absoluteGate && energy > relativeGate) loudness.push_back(energyToLufs(energy));
+    }
+    std::sort(loudness.begin(), loudness.end());
+    return loudness;
+}
+
+double LoudnessAnalyzer::getShortTermMaxLufs() const {
+    double maxEnergy = 0.0;
+    for (double energy : windowEnergies(stepEnergies, kShortTermSteps)) maxEnergy = std::max(maxEnergy, energy);
+    return energyToLufs(maxEnergy);
+}
+
+double LoudnessAnalyzer::getShortTermPercentileLufs(double percentile) const {
+    const std::vector<double> loudness = gatedShortTermLoudness();
+    if (loudness.empty()) return -INFINITY;
+    size_t index = (size_t)lround(percentile / 100.0 * (double)(loudness.size() - 1));
+    return loudness[std::min(index, loudness.size() - 1)];
+}
+
+double LoudnessAnalyzer::getLoudnessRangeLu() const {
+    const std::vector<double> loudness = gatedShortTermLoudness();
+    if (loudness.size() < 2) return 0.0;
+    const size_t low = (size_t)lround(0.10 * (double)(loudness.size() - 1));
+    const size_t high = (size_t)lround(0.95 * (double)(loudness.size() - 1));
+    return loudness[high] - loudness[low];
+}
+
+double LoudnessAnalyzer::getSamplePeakDb() const {
+    return linearToDb(samplePeak);
+}
+
+double LoudnessAnalyzer::getTruePeakDb() const {
+    return linearToDb(truePeakEnabled ? std::max(truePeak, samplePeak) : samplePeak);
+}
+
+} // namespace ELC4L
@@ -0,0 +1,101 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Program loudness analysis (ITU-R BS.1770-4 / EBU R128)
+// Whole-file measurement for the offline tools, unlike the plugin's momentary LufsMeter:
+//   - integrated loudness with the absolute (-70 LUFS) and relative (-10 LU) gates
+//   - short-term (3 s) loudness distribution: maximum, percentiles and loudness range (EBU Tech 3342)
+//   - sample peak and, optionally, 4x oversampled true peak
+// K-weighted energy is accumulated in 100 ms steps; the gating blocks are derived from those at the end,
+// so memory grows by one double per 100 ms of audio.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ELC4L {
+
+// BS.1770 K-weighting (head shelf + RLB high-pass) for two channels at any sample rate
+class KWeightingFilter {
+    struct Biquad {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1[2] = { 0.0, 0.0 };
+        double z2[2] = { 0.0, 0.0 };
+
+        double process(double x, int ch) {
+            double y = b0 * x + z1[ch];
+            z1[ch] = b1 * x - a1 * y + z2[ch];
+            z2[ch] = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+public:
+    void prepare(double sampleRate);
+    void reset();
+
+    // Channel-summed K-weighted energy of one stereo sample
+    double processEnergy(float left, float right) {
+        double l = highpass.process(shelf.process(left, 0), 0);
+        double r = highpass.process(shelf.process(right, 1), 1);
+        return l * l + r * r;
+    }
+
+private:
+    Biquad shelf;
+    Biquad highpass;
+};
+
+class LoudnessAnalyzer {
+public:
+    void prepare(double sampleRate, bool measureTruePeak);
+    void reset();
+
+    void process(const float* left, const float* right, int numSamples);
+
+    // Adds precomputed per-sample K-weighted energies (KWeightingFilter::processEnergy) of a signal
+    // that is not available as audio; peaks are not tracked
+    void accumulateEnergy(const float* energies, int numSamples);
+
+    // Results (valid at any time; -INFINITY / very low values when nothing passed the gates)
+    double getIntegratedLufs() const;
+    double getShortTermMaxLufs() const;
+    double getShortTermPercentileLufs(double percentile) const;   // gated short-term distribution
+    double getLoudnessRangeLu() const;
+    double getSamplePeakDb() const;
+    double getTruePeakDb() const;       // Sample peak if true peak measurement is disabled
+    int64_t getNumSamples() const { return totalSamples; }
+
+private:
+    static constexpr int kTruePeakPhases = 4;
+    static constexpr int kTruePeakTaps = 12;
+
+    std::vector<double> gatedShortTermLoudness() const;
+    void addEnergy(double energy) {
+        stepEnergy += energy;
+        if (++stepPosition == stepLength) {
+            stepEnergies.push_back(stepEnergy / stepLength);
+            stepEnergy = 0.0;
+            stepPosition = 0;
+        }
+    }
+
+    double sampleRate = 48000.0;
+    bool truePeakEnabled = false;
+
+    KWeightingFilter weighting;
+
+    int stepLength = 4800;              // 100 ms
+    int stepPosition = 0;
+    double stepEnergy = 0.0;
+    std::vector<double> stepEnergies;   // Mean-square K-weighted energy (channel sum) per 100 ms
+
+    double samplePeak = 0.0;
+    double truePeak = 0.0;
+    float truePeakCoeffs[kTruePeakPhases][kTruePeakTaps] = {};
+    float truePeakHistory[2][2 * kTruePeakTaps] = {};     // Mirrored ring buffer (contiguous reads)
+    int truePeakIndex = 0;
+
+    int64_t totalSamples = 0;
+};
+
+} // namespace ELC4L
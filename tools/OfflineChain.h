@@ -0,0 +1,248 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Offline signal chain
+// The VST2 (OBS) processing chain of HyeokStreamMaster::processReplacing without the host wrapper,
+// editor or metering: crossover -> 4x opto compressor (stereo or M/S loose side) -> limiter.
+// Settings are in engineering units; defaults match the plugin's default parameters. The stage
+// profiler sits at the same points as in processReplacing and is off unless getProfiler() enables it.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "HyeokStreamDSP.h"
+#include "DenormalGuard.h"
+#include "QualityGovernor.h"
+#include "StateArena.h"
+#include "MemoryLock.h"
+#include "StageProfiler.h"
+
+namespace ELC4L {
+
+constexpr int kChainBands = HyeokStreamDSP::kNumBands;
+
+struct ChainSettings {
+    float bandThreshDb[4] = { -9.0f, -9.0f, -9.0f, -9.0f };
+    float bandMakeupDb[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    bool bandMidSide[4] = { false, false, false, false };
+    bool bandBypass[4] = { false, false, false, false };
+    float xoverHz[3] = { 79.6f, 632.5f, 5024.0f };
+    static_assert(kChainBands == 4, "defaults describe the plugin's 4-band layout");
+    float limiterThreshDb = -6.0f;
+    float limiterCeilingDb = -1.0f;
+    float limiterReleaseMs = 157.0f;
+    bool limiterBypass = false;
+    bool sidechainActive = false;
+    float sidechainHz = 100.0f;
+    int processingQuality = kProcessingStandard;    // ProcessingQuality (High adds lookahead latency)
+};
+
+class OfflineChain {
+public:
+    void prepare(float sampleRate, const ChainSettings& newSettings) {
+        settings = newSettings;
+
+        // Same ordering rules as HyeokStreamMaster::updateFrequencies
+        float freqs[HyeokStreamDSP::kNumSplits];
+        for (int k = 0; k < HyeokStreamDSP::kNumSplits; ++k) freqs[k] = settings.xoverHz[k];
+        for (int k = 0; k + 1 < HyeokStreamDSP::kNumSplits; ++k) {
+            if (freqs[k] >= freqs[k + 1]) freqs[k] = freqs[k + 1] * 0.85f;
+        }
+
+        crossover.setSampleRate(sampleRate);
+        for (int k = 0; k < HyeokStreamDSP::kNumSplits; ++k) crossover.setFrequency(k, freqs[k]);
+
+        for (int b = 0; b < kChainBands; ++b) {
+            bandComps[b].setSampleRate(sampleRate);
+            bandComps[b].setThresholdDb(settings.bandThreshDb[b]);
+            bandComps[b].setMakeupDb(settings.bandMakeupDb[b]);
+            bandComps[b].setSidechainEnabled(settings.sidechainActive);
+            bandComps[b].setSidechainFreq(settings.sidechainHz);
+            makeupGains[b] = powf(10.0f, settings.bandMakeupDb[b] / 20.0f);
+        }
+
+        limiter.setSampleRate(sampleRate);
+        limiter.setThreshold(settings.limiterThreshDb);
+        limiter.setCeiling(settings.limiterCeilingDb);
+        limiter.setRelease(settings.limiterReleaseMs);
+
+        lufsMeter.setSampleRate(sampleRate);
+        profiler.prepare(sampleRate);
+        setProcessingQuality(settings.processingQuality);
+        reset();
+    }
+
+    void reset() {
+        crossover.reset();
+        bandComps.reset();
+        limiter.reset();
+        lufsMeter.reset();
+    }
+
+    // In-place safe (outL may alias inL). preLimiterGain, if given, scales the band mix per sample
+    // before the limiter (the loudness render's whole-file gain envelope).
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples,
+                 const float* preLimiterGain = nullptr) {
+        profiler.beginBlock();
+        float mixL[kChunkSize], mixR[kChunkSize];
+        for (int start = 0; start < numSamples; start += kChunkSize) {
+            const int n = (numSamples - start < kChunkSize) ? numSamples - start : kChunkSize;
+            profiler.beginChunk(n);
+            processBandsChunk(inL + start, inR + start, mixL, mixR, n);
+
+            if (preLimiterGain) {
+                for (int i = 0; i < n; ++i) {
+                    mixL[i] *= preLimiterGain[start + i];
+                    mixR[i] *= preLimiterGain[start + i];
+                }
+            }
+            if (!settings.limiterBypass) {
+                limiter.processChunk(mixL, mixR, n);
+            }
+            profiler.lap(kStageLimiter);
+            lufsMeter.processChunk(mixL, mixR, n);
+            for (int i = 0; i < n; ++i) {
+                outL[start + i] = mixL[i];
+                outR[start + i] = mixR[i];
+            }
+            profiler.lap(kStageMetering);
+        }
+        profiler.endBlock(numSamples);
+    }
+
+    // Analysis-only path: crossover and band compressors, no limiter or meter. The caller may also
+    // run the saturation at 1x (setSaturationOversampling) for a cheaper, level-equivalent estimate.
+    void processCompressors(const float* inL, const float* inR, float* outL, float* outR, int numSamples) {
+        for (int start = 0; start < numSamples; start += kChunkSize) {
+            const int n = (numSamples - start < kChunkSize) ? numSamples - start : kChunkSize;
+            processBandsChunk(inL + start, inR + start, outL + start, outR + start, n);
+        }
+    }
+
+    void setSaturationOversampling(bool enabled) {
+        for (int b = 0; b < kChainBands; ++b) {
+            bandComps[b].setSaturationOversampling(enabled);
+        }
+    }
+
+    // Same DSP settings as the plugin at this ProcessingQuality and full tier; call between blocks
+    void setProcessingQuality(int quality) {
+        settings.processingQuality = quality;
+        const QualitySettings q = getQualitySettings(quality, kQualityFull);
+        crossover.setDoublePrecision(q.doublePrecisionCrossover);
+        for (int b = 0; b < kChainBands; ++b) {
+            bandComps[b].setLatencyFactor(q.saturationFactor);
+            bandComps[b].setSaturationFactor(q.saturationFactor);
+            bandComps[b].setGainComputerInterval(q.gainComputerInterval);
+        }
+        limiter.setExtendedLookahead(q.extendedLookahead);
+    }
+
+    // Per-block software denormal fallback (see DenormalGuard.h)
+    void flushDenormals() {
+        crossover.flushDenormals();
+        bandComps.flushDenormals();
+        limiter.flushDenormals();
+        lufsMeter.flushDenormals();
+    }
+
+    int getLatencySamples() const { return limiter.getLookaheadSamples() + bandComps.getSaturationLatency(); }
+    float getLufsMomentary() const { return lufsMeter.getMomentary(); }
+    const ChainSettings& getSettings() const { return settings; }
+    StageProfiler& getProfiler() { return profiler; }
+
+    // The out-of-line DSP stage arena (StateArena.h), allocated with the chain
+    static constexpr size_t getStateBytes() { return StateArena<Stages>::size(); }
+    MemoryRegion getStateRegion() const { return { stages.data(), getStateBytes() }; }
+
+private:
+    // Same chunking as processReplacing: the band kernels run over a chunk at a time, which gives the
+    // same samples as the per-sample order (every stage is causal and the bands are independent)
+    static constexpr int kChunkSize = HyeokStreamDSP::kMaxChunkSize;
+
+    // Crossover split, per-band compression and band sum of one chunk. mix may alias in.
+    void processBandsChunk(const float* inL, const float* inR, float* mixL, float* mixR, int numSamples) {
+        float bandL[kChainBands][kChunkSize], bandR[kChainBands][kChunkSize];
+        float* bandPtrL[kChainBands];
+        float* bandPtrR[kChainBands];
+        for (int b = 0; b < kChainBands; ++b) {
+            bandPtrL[b] = bandL[b];
+            bandPtrR[b] = bandR[b];
+        }
+        crossover.processChunk(inL, inR, bandPtrL, bandPtrR, numSamples);
+        profiler.lap(kStageCrossover);
+
+        for (int b = 0; b < kChainBands; ++b) {
+            processBandChunk(b, bandL[b], bandR[b], numSamples);
+        }
+
+        for (int i = 0; i < numSamples; ++i) {
+            mixL[i] = 0.0f;
+            mixR[i] = 0.0f;
+        }
+        for (int b = 0; b < kChainBands; ++b) {
+            for (int i = 0; i < numSamples; ++i) {
+                mixL[i] += bandL[b][i];
+                mixR[i] += bandR[b][i];
+            }
+        }
+        profiler.lap(kStageCompressors);
+    }
+
+    // Same band logic as processBandChunk in the plugin (M/S mode applies half the reduction to the side)
+    void processBandChunk(int b, float* left, float* right, int numSamples) {
+        if (settings.bandBypass[b]) {
+            for (int i = 0; i < numSamples; ++i) {
+                left[i] *= makeupGains[b];
+                right[i] *= makeupGains[b];
+            }
+            profiler.lap(kStageCompressors);
+            return;
+        }
+
+        const bool midSide = settings.bandMidSide[b];
+        if (midSide) {
+            for (int i = 0; i < numSamples; ++i) {
+                const float mid = 0.5f * (left[i] + right[i]);
+                const float side = 0.5f * (left[i] - right[i]);
+                left[i] = mid;
+                right[i] = side;
+            }
+        }
+
+        float gains[kChunkSize];
+        bandComps[b].processDynamicsChunk(left, right, gains, numSamples);
+        profiler.lap(kStageCompressors);
+        bandComps[b].processSaturationChunk(left, right, numSamples);
+        profiler.lap(kStageSaturation);
+        if (!midSide) return;
+
+        for (int i = 0; i < numSamples; ++i) {
+            const float gain = gains[i];
+            const float mid = left[i];
+            float side = right[i];
+            if (gain < 1.0f && gain > 0.0f) {
+                float looseGain = 1.0f - (1.0f - gain) * 0.5f;
+                side *= (looseGain / gain);
+            }
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    }
+
+    // Same arena layout as the plugin's ProcessingState (the chain has no meters)
+    struct Stages {
+        alignas(kCacheLineSize) HyeokStreamDSP crossover;
+        alignas(kCacheLineSize) CompressorBank<kChainBands> bandComps;
+        alignas(kCacheLineSize) LookaheadLimiter limiter;
+        alignas(kCacheLineSize) LufsMeter lufsMeter;
+    };
+
+    ChainSettings settings;
+    StateArena<Stages> stages;
+    HyeokStreamDSP& crossover = stages->crossover;
+    CompressorBank<kChainBands>& bandComps = stages->bandComps;
+    LookaheadLimiter& limiter = stages->limiter;
+    LufsMeter& lufsMeter = stages->lufsMeter;
+    float makeupGains[kChainBands] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    StageProfiler profiler;
+};
+
+} // namespace ELC4L
@@ -0,0 +1,125 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Raw PCM streams (stdin / stdout pipes)
+//-------------------------------------------------------------------------------------------------------
+
+#include "PcmStream.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace ELC4L {
+
+namespace {
+
+inline int bytesPerFrame(PcmFormat format) {
+    return (format == PcmFormat::F32LE) ? 8 : 4;
+}
+
+inline float clampSample(float x) { return (x > 1.0f) ? 1.0f : ((x < -1.0f) ? -1.0f : x); }
+
+} // namespace
+
+bool parsePcmFormat(const char* name, PcmFormat& format) {
+    if (strcmp(name, "f32le") == 0) { format = PcmFormat::F32LE; return true; }
+    if (strcmp(name, "s16le") == 0) { format = PcmFormat::S16LE; return true; }
+    return false;
+}
+
+void setBinaryStdio() {
+#if defined(_WIN32)
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------
+PcmStreamReader::PcmStreamReader(FILE* newStream, PcmFormat newFormat, int bufferFrames)
+    : stream(newStream), format(newFormat), frameBytes(bytesPerFrame(newFormat)),
+      buffer((size_t)bufferFrames * (size_t)bytesPerFrame(newFormat)) {
+    setvbuf(stream, nullptr, _IONBF, 0);     // Our buffer is the only one
+}
+
+int PcmStreamReader::read(float* left, float* right, int maxFrames) {
+    const size_t capacity = buffer.size() / (size_t)frameBytes;
+    const size_t wanted = ((size_t)maxFrames < capacity ? (size_t)maxFrames : capacity) * (size_t)frameBytes;
+
+    // Pipes deliver partial reads; keep going until the block is full or the stream ends
+    size_t filled = 0;
+    while (filled < wanted) {
+        size_t got = fread(buffer.data() + filled, 1, wanted - filled, stream);
+        if (got == 0) break;
+        filled += got;
+    }
+
+    const int frames = (int)(filled / (size_t)frameBytes);
+    const unsigned char* p = buffer.data();
+    if (format == PcmFormat::F32LE) {
+        for (int i = 0; i < frames; ++i, p += 8) {
+            uint32_t l = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+            uint32_t r = (uint32_t)p[4] | ((uint32_t)p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+            memcpy(&left[i], &l, 4);
+            memcpy(&right[i], &r, 4);
+        }
+    } else {
+        for (int i = 0; i < frames; ++i, p += 4) {
+            left[i]  = (float)(int16_t)(p[0] | (p[1] << 8)) * (1.0f / 32768.0f);
+            right[i] = (float)(int16_t)(p[2] | (p[3] << 8)) * (1.0f / 32768.0f);
+        }
+    }
+    return frames;
+}
+
+//-------------------------------------------------------------------------------------------------------
+PcmStreamWriter::PcmStreamWriter(FILE* newStream, PcmFormat newFormat, int bufferFrames)
+    : stream(newStream), format(newFormat), frameBytes(bytesPerFrame(newFormat)),
+      buffer((size_t)bufferFrames * (size_t)bytesPerFrame(newFormat)) {
+    setvbuf(stream, nullptr, _IONBF, 0);
+}
+
+bool PcmStreamWriter::write(const float* left, const float* right, int frames) {
+    const int capacity = (int)(buffer.size() / (size_t)frameBytes);
+
+    while (frames > 0) {
+        const int count = (frames < capacity) ? frames : capacity;
+        unsigned char* p = buffer.data();
+
+        if (format == PcmFormat::F32LE) {
+            for (int i = 0; i < count; ++i, p += 8) {
+                uint32_t l, r;
+                memcpy(&l, &left[i], 4);
+                memcpy(&r, &right[i], 4);
+                for (int b = 0; b < 4; ++b) {
+                    p[b] = (unsigned char)(l >> (8 * b));
+                    p[4 + b] = (unsigned char)(r >> (8 * b));
+                }
+            }
+        } else {
+            // Same rounding and clipping as the 16-bit file writer
+            for (int i = 0; i < count; ++i, p += 4) {
+                int16_t l = (int16_t)lrintf(clampSample(left[i]) * 32767.0f);
+                int16_t r = (int16_t)lrintf(clampSample(right[i]) * 32767.0f);
+                p[0] = (unsigned char)l; p[1] = (unsigned char)((uint16_t)l >> 8);
+                p[2] = (unsigned char)r; p[3] = (unsigned char)((uint16_t)r >> 8);
+            }
+        }
+
+        const size_t bytes = (size_t)count * (size_t)frameBytes;
+        if (fwrite(buffer.data(), 1, bytes, stream) != bytes) return false;
+        left += count;
+        right += count;
+        frames -= count;
+    }
+    return true;
+}
+
+bool PcmStreamWriter::flush() {
+    return fflush(stream) == 0;
+}
+
+} // namespace ELC4L
@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Raw PCM streams (stdin / stdout pipes)
+// Interleaved stereo PCM without a header, as produced and consumed by ffmpeg's "-f f32le" and
+// "-f s16le". Each reader/writer owns one fixed byte buffer of 'bufferFrames' frames: memory stays
+// bounded regardless of stream length, and every fread/fwrite moves a whole buffer.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+namespace ELC4L {
+
+enum class PcmFormat {
+    F32LE,
+    S16LE
+};
+
+// "f32le" / "s16le"; false if unknown
+bool parsePcmFormat(const char* name, PcmFormat& format);
+
+// Switches stdin/stdout to binary mode (no-op outside Windows)
+void setBinaryStdio();
+
+class PcmStreamReader {
+public:
+    PcmStreamReader(FILE* stream, PcmFormat format, int bufferFrames);
+
+    // Blocks until 'maxFrames' frames arrived or the stream ended; returns frames read
+    // (a trailing partial frame at end of stream is dropped)
+    int read(float* left, float* right, int maxFrames);
+    bool hasError() const { return ferror(stream) != 0; }
+
+private:
+    FILE* stream;
+    PcmFormat format;
+    int frameBytes;
+    std::vector<unsigned char> buffer;
+};
+
+class PcmStreamWriter {
+public:
+    PcmStreamWriter(FILE* stream, PcmFormat format, int bufferFrames);
+
+    // False if the stream is closed (e.g. the downstream ffmpeg exited)
+    bool write(const float* left, const float* right, int frames);
+    bool flush();
+
+private:
+    FILE* stream;
+    PcmFormat format;
+    int frameBytes;
+    std::vector<unsigned char> buffer;
+};
+
+} // namespace ELC4L
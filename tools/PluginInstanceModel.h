@@ -0,0 +1,143 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Plugin instance model
+// The state and per-block work of one HyeokStreamMaster instance without the VST2 SDK: the offline
+// chain plus the metering of processReplacing/updateMeters (level smoothing and, while an editor is
+// open, the analyzer: 4096-sample input and output histories, spectrum and display bins and the FFT
+// scratch, allocated on demand as in the plugin; its tables are shared per process). Used to measure
+// what many instances cost together, where the per-instance footprint matters.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "LazyEditorState.h"
+#include "OfflineChain.h"
+
+namespace ELC4L {
+
+class PluginInstanceModel {
+public:
+    static constexpr int kFftSize = SpectrumAnalyzer::kFftSize;
+    static constexpr int kSpectrumBins = SpectrumAnalyzer::kSpectrumBins;
+    static constexpr int kDisplayBins = 128;
+    static constexpr int kFftHopSize = 1024;
+
+    // Same layout as the plugin's AnalyzerState
+    struct AnalyzerState {
+        float fftBufferIn[kFftSize];
+        float fftBufferOut[kFftSize];
+        int fftWritePos;
+        float spectrumIn[kSpectrumBins];
+        float spectrumOut[kSpectrumBins];
+        float displayIn[kDisplayBins];
+        float displayOut[kDisplayBins];
+        SpectrumAnalyzer analyzer;
+
+        AnalyzerState() {
+            for (int i = 0; i < kFftSize; ++i) {
+                fftBufferIn[i] = 0.0f;
+                fftBufferOut[i] = 0.0f;
+            }
+            fftWritePos = 0;
+            for (int i = 0; i < kSpectrumBins; ++i) {
+                spectrumIn[i] = -90.0f;
+                spectrumOut[i] = -90.0f;
+            }
+            for (int i = 0; i < kDisplayBins; ++i) {
+                displayIn[i] = -90.0f;
+                displayOut[i] = -90.0f;
+            }
+        }
+    };
+
+    void prepare(float newSampleRate, const ChainSettings& settings) {
+        sampleRate = newSampleRate;
+        chain.prepare(sampleRate, settings);
+        analyzerLink.update([this](AnalyzerState& state) { state.analyzer.setSampleRate(sampleRate); });
+        inputDb = -120.0f;
+        outputDb = -120.0f;
+    }
+
+    // Editor open / close: the analyzer state exists (and runs) only while open
+    void setEditorOpen(bool open) {
+        if (open == editorOpen) return;
+        editorOpen = open;
+        if (open) {
+            const float rate = sampleRate;
+            analyzerLink.subscribe([rate](AnalyzerState& state) { state.analyzer.setSampleRate(rate); });
+        } else {
+            analyzerLink.unsubscribe();
+        }
+    }
+
+    // One host block: chain under FTZ/DAZ, then the per-sample meters (as processReplacing)
+    void processBlock(const float* inL, const float* inR, float* outL, float* outR, int numSamples) {
+        ScopedFlushDenormals noDenormals;
+        const LazyEditorState<AnalyzerState>::AudioAccess analyzerAccess(analyzerLink, analyzer);
+        chain.process(inL, inR, outL, outR, numSamples);
+        for (int i = 0; i < numSamples; ++i) {
+            updateMeters(inL[i], inR[i], outL[i], outR[i]);
+        }
+        chain.flushDenormals();
+    }
+
+    float getOutputDb() const { return outputDb; }
+
+    // Object plus the chain's stage arena: what a headless instance occupies
+    static constexpr size_t getInstanceBytes() {
+        return sizeof(PluginInstanceModel) + OfflineChain::getStateBytes();
+    }
+
+    // What HyeokStreamMaster::lockDspMemory locks on resume: the stage arena and the instance
+    void getMemoryRegions(MemoryRegion (&regions)[2]) const {
+        regions[0] = chain.getStateRegion();
+        regions[1] = { const_cast<PluginInstanceModel*>(this), sizeof(PluginInstanceModel) };
+    }
+
+private:
+    // Same work as HyeokStreamMaster::updateMeters / updateDisplayBuffers
+    void updateMeters(float inL, float inR, float outL, float outR) {
+        float inRms = 0.5f * (inL * inL + inR * inR);
+        float outRms = 0.5f * (outL * outL + outR * outR);
+        inputDb = inputDb * 0.9f + 10.0f * log10f(inRms + 1.0e-12f) * 0.1f;
+        outputDb = outputDb * 0.9f + 10.0f * log10f(outRms + 1.0e-12f) * 0.1f;
+
+        if (!analyzer) return;
+        AnalyzerState& state = *analyzer;
+        state.fftBufferIn[state.fftWritePos] = 0.5f * (inL + inR);
+        state.fftBufferOut[state.fftWritePos] = 0.5f * (outL + outR);
+        state.fftWritePos++;
+
+        if (state.fftWritePos >= kFftSize) {
+            state.analyzer.computeSpectrum(state.fftBufferIn, state.spectrumIn, sampleRate);
+            state.analyzer.computeSpectrum(state.fftBufferOut, state.spectrumOut, sampleRate);
+
+            const int ratio = kSpectrumBins / kDisplayBins;
+            for (int d = 0; d < kDisplayBins; ++d) {
+                float sumIn = 0.0f, sumOut = 0.0f;
+                for (int k = 0; k < ratio; ++k) {
+                    sumIn += state.spectrumIn[d * ratio + k];
+                    sumOut += state.spectrumOut[d * ratio + k];
+                }
+                state.displayIn[d] = state.displayIn[d] * 0.6f + (sumIn / (float)ratio) * 0.4f;
+                state.displayOut[d] = state.displayOut[d] * 0.6f + (sumOut / (float)ratio) * 0.4f;
+            }
+
+            for (int i = 0; i < kFftSize - kFftHopSize; ++i) {
+                state.fftBufferIn[i] = state.fftBufferIn[i + kFftHopSize];
+                state.fftBufferOut[i] = state.fftBufferOut[i + kFftHopSize];
+            }
+            state.fftWritePos = kFftSize - kFftHopSize;
+        }
+    }
+
+    float sampleRate = 48000.0f;
+    OfflineChain chain;
+
+    float inputDb = -120.0f;
+    float outputDb = -120.0f;
+
+    LazyEditorState<AnalyzerState> analyzerLink;
+    AnalyzerState* analyzer = nullptr;      // Held for the current block
+    bool editorOpen = false;
+};
+
+} // namespace ELC4L
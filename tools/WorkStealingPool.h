@@ -0,0 +1,142 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Work-stealing thread pool
+// Each worker owns a task deque: it pops its own work from the back (most recently queued, still hot
+// in cache) and, when empty, steals from the front of the other workers' deques. Tasks are coarse
+// (seconds of audio each), so a mutex per deque is cheaper than it looks and keeps this simple.
+// Offline tools only; never used on an audio thread.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ELC4L {
+
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // numThreads <= 0 uses every hardware thread
+    explicit WorkStealingPool(int numThreads = 0) {
+        if (numThreads <= 0) {
+            numThreads = (int)std::thread::hardware_concurrency();
+            if (numThreads <= 0) numThreads = 1;
+        }
+        for (int i = 0; i < numThreads; ++i) {
+            queues.emplace_back(new WorkerQueue());
+        }
+        for (int i = 0; i < numThreads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getNumThreads() const { return (int)workers.size(); }
+
+    // Queues round-robin across workers; idle workers rebalance by stealing
+    void submit(Task task) {
+        const size_t index = nextQueue++ % queues.size();
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            ++queuedTasks;
+        }
+        wakeCondition.notify_one();
+    }
+
+    // Blocks until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCondition.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popLocal(int index, Task& task) {
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int thief, Task& task) {
+        const int count = (int)queues.size();
+        for (int offset = 1; offset < count; ++offset) {
+            WorkerQueue& victim = *queues[(thief + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int index) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wakeCondition.wait(lock, [this] { return stopping || queuedTasks > 0; });
+                if (queuedTasks == 0) return;   // stopping and drained
+                --queuedTasks;
+            }
+
+            // A queued task is reserved for us; it is either local or stealable
+            Task task;
+            while (!popLocal(index, task) && !steal(index, task)) {
+                std::this_thread::yield();
+            }
+            task();
+
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                doneCondition.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue { 0 };
+    std::atomic<int> pending { 0 };
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    int queuedTasks = 0;
+    bool stopping = false;
+
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+};
+
+} // namespace ELC4L
@@ -0,0 +1,193 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Denormal benchmark
+// Feeds the VST2 chain a loud program signal followed by a long digital silence and records the cost
+// of every block, once per protection mode:
+//   none        : no FTZ/DAZ, no state flushing (tails decay into subnormals)
+//   ftz         : ScopedFlushDenormals around each block (what processReplacing / process do)
+//   flush       : per-block flushDenormals() only (fallback when the host resets MXCSR)
+//   ftz+flush   : both (plugin default)
+// The silence-sleep path of the wrappers is intentionally not used so the raw DSP cost is visible.
+//
+// Usage: elc4l_denormal_bench [--rate 48000] [--block 512] [--signal 5] [--silence 30] [--csv out.csv]
+//-------------------------------------------------------------------------------------------------------
+
+#include "OfflineChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Options {
+    float sampleRate = 48000.0f;
+    int blockSize = 512;
+    float signalSeconds = 5.0f;
+    float silenceSeconds = 30.0f;
+    const char* csvPath = nullptr;
+};
+
+struct Mode {
+    const char* name;
+    bool ftz;
+    bool flush;
+};
+
+const Mode kModes[] = {
+    { "none",      false, false },
+    { "ftz",       true,  false },
+    { "flush",     false, true  },
+    { "ftz+flush", true,  true  },
+};
+constexpr int kNumModes = sizeof(kModes) / sizeof(kModes[0]);
+
+void printUsage() {
+    fprintf(stderr,
+            "usage: elc4l_denormal_bench [--rate Hz] [--block samples] [--signal sec] [--silence sec] [--csv path]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (strcmp(arg, "--rate") == 0)         options.sampleRate = (float)atof(value);
+        else if (strcmp(arg, "--block") == 0)   options.blockSize = atoi(value);
+        else if (strcmp(arg, "--signal") == 0)  options.signalSeconds = (float)atof(value);
+        else if (strcmp(arg, "--silence") == 0) options.silenceSeconds = (float)atof(value);
+        else if (strcmp(arg, "--csv") == 0)     options.csvPath = value;
+        else return false;
+        ++i;
+    }
+    return options.sampleRate > 0.0f && options.blockSize > 0;
+}
+
+// Loud broadband program: noise plus low and high tones, enough to drive every band into reduction
+void generateSignal(std::vector<float>& left, std::vector<float>& right, int numSamples, float sampleRate) {
+    unsigned int seed = 0x454C4334u;  // 'ELC4'
+    const float twoPi = 6.28318530717958647692f;
+    for (int i = 0; i < numSamples; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 8388608.0f - 1.0f;
+        float t = (float)i / sampleRate;
+        float tones = 0.4f * sinf(twoPi * 60.0f * t) + 0.2f * sinf(twoPi * 3000.0f * t);
+        left[i] = 0.3f * noise + tones;
+        right[i] = 0.3f * noise - tones * 0.5f;
+    }
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = (size_t)(p * (double)(values.size() - 1) + 0.5);
+    return values[index];
+}
+
+double mean(const std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    return sum / (double)values.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    const int signalSamples = (int)(options.signalSeconds * options.sampleRate);
+    const int silenceSamples = (int)(options.silenceSeconds * options.sampleRate);
+    const int totalSamples = signalSamples + silenceSamples;
+    const int numBlocks = (totalSamples + options.blockSize - 1) / options.blockSize;
+    const int firstSilentBlock = signalSamples / options.blockSize;
+
+    std::vector<float> inL(totalSamples, 0.0f), inR(totalSamples, 0.0f);
+    generateSignal(inL, inR, signalSamples, options.sampleRate);
+    std::vector<float> outL(options.blockSize), outR(options.blockSize);
+
+    // blockNs[mode][block]
+    std::vector<std::vector<double>> blockNs(kNumModes, std::vector<double>(numBlocks, 0.0));
+
+    for (int m = 0; m < kNumModes; ++m) {
+        ELC4L::OfflineChain chain;
+        chain.prepare(options.sampleRate, ELC4L::ChainSettings());
+
+        for (int block = 0; block < numBlocks; ++block) {
+            const int start = block * options.blockSize;
+            const int count = std::min(options.blockSize, totalSamples - start);
+
+            auto t0 = std::chrono::steady_clock::now();
+            if (kModes[m].ftz) {
+                ELC4L::ScopedFlushDenormals noDenormals;
+                chain.process(&inL[start], &inR[start], outL.data(), outR.data(), count);
+            } else {
+                chain.process(&inL[start], &inR[start], outL.data(), outR.data(), count);
+            }
+            if (kModes[m].flush) {
+                chain.flushDenormals();
+            }
+            auto t1 = std::chrono::steady_clock::now();
+
+            blockNs[m][block] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        }
+    }
+
+    // Summary: signal phase vs. silence phase (first silent block straddles the boundary and is skipped)
+    const double blockBudgetNs = 1.0e9 * (double)options.blockSize / (double)options.sampleRate;
+#if defined(ELC4L_DENORMAL_MXCSR)
+    const char* hardwareMode = "MXCSR";
+#elif defined(ELC4L_DENORMAL_FPCR)
+    const char* hardwareMode = "FPCR";
+#else
+    const char* hardwareMode = "unavailable";
+#endif
+    printf("ELC4L denormal benchmark: %.0f Hz, block %d, %.1f s signal + %.1f s silence (FTZ/DAZ hardware: %s)\n",
+           options.sampleRate, options.blockSize, options.signalSeconds, options.silenceSeconds, hardwareMode);
+    printf("%-10s %14s %14s %14s %14s %10s %10s\n",
+           "mode", "signal avg us", "silence avg us", "silence p99 us", "silence max us", "ratio", "peak load");
+
+    for (int m = 0; m < kNumModes; ++m) {
+        std::vector<double> signalNs(blockNs[m].begin(), blockNs[m].begin() + firstSilentBlock);
+        std::vector<double> silenceNs(blockNs[m].begin() + std::min(firstSilentBlock + 1, numBlocks), blockNs[m].end());
+
+        double signalAvg = mean(signalNs);
+        double silenceAvg = mean(silenceNs);
+        double silenceMax = silenceNs.empty() ? 0.0 : *std::max_element(silenceNs.begin(), silenceNs.end());
+
+        printf("%-10s %14.2f %14.2f %14.2f %14.2f %9.2fx %9.2f%%\n",
+               kModes[m].name,
+               signalAvg / 1000.0, silenceAvg / 1000.0,
+               percentile(silenceNs, 0.99) / 1000.0, silenceMax / 1000.0,
+               (signalAvg > 0.0) ? silenceAvg / signalAvg : 0.0,
+               100.0 * silenceMax / blockBudgetNs);
+    }
+
+    if (options.csvPath) {
+        FILE* csv = fopen(options.csvPath, "w");
+        if (!csv) {
+            fprintf(stderr, "cannot write %s\n", options.csvPath);
+            return 1;
+        }
+        fprintf(csv, "block,time_s,phase");
+        for (int m = 0; m < kNumModes; ++m) fprintf(csv, ",%s_ns", kModes[m].name);
+        fprintf(csv, "\n");
+        for (int block = 0; block < numBlocks; ++block) {
+            fprintf(csv, "%d,%.4f,%s", block, (double)block * options.blockSize / options.sampleRate,
+                    (block < firstSilentBlock) ? "signal" : "silence");
+            for (int m = 0; m < kNumModes; ++m) fprintf(csv, ",%.0f", blockNs[m][block]);
+            fprintf(csv, "\n");
+        }
+        fclose(csv);
+        printf("per-block timings written to %s\n", options.csvPath);
+    }
+
+    return 0;
+}
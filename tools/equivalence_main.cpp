@@ -0,0 +1,288 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Numerical equivalence harness
+// Runs a corpus of generated test signals through the frozen reference DSP (reference/ReferenceDSP.h)
+// and through a candidate implementation, module by module, and reports per module and signal:
+//   max abs  : largest absolute difference of any output value
+//   rms err  : RMS of the difference
+//   null dB  : residual energy relative to the reference output (10*log10(sum err^2 / sum ref^2));
+//              "exact" when the outputs are bit-identical
+// Audio modules are compared as interleaved stereo, the LUFS meter as its momentary value (LU) and
+// the analyzer as its dB bins, so the error units follow the module.
+//
+// Candidates:
+//   current : the VST2 DSP core in src/HyeokStreamDSP.h (optimizations land here)
+//   vst3    : the VST3 copy in vst3/src/ELC4Ldsp.h (shows where the plugin copies have drifted)
+//
+// With --budget the tool exits with status 2 when any null depth is above the budget, so each SIMD or
+// approximation change can be shipped with the accuracy it was measured at.
+//
+// Usage: elc4l_equivalence [--candidate current|vst3] [--modules a,b,...] [--rate 48000]
+//                          [--block 512] [--seconds 4] [--budget dB]
+//-------------------------------------------------------------------------------------------------------
+
+#include "EquivalenceKernels.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kModules[] = { "crossover", "comp", "os-sat", "limiter", "lufs", "spectrum", "chain" };
+constexpr int kNumModules = sizeof(kModules) / sizeof(kModules[0]);
+
+struct Options {
+    std::string candidate = "current";
+    std::vector<std::string> modules;
+    float sampleRate = 48000.0f;
+    int blockSize = 512;
+    double seconds = 4.0;
+    bool haveBudget = false;
+    double budgetDb = 0.0;
+};
+
+struct TestSignal {
+    const char* name;
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+struct Comparison {
+    double maxAbs = 0.0;
+    double rmsError = 0.0;
+    double nullDb = -INFINITY;      // -INFINITY: bit-identical
+    bool lengthMismatch = false;
+};
+
+void printUsage() {
+    fprintf(stderr,
+            "usage: elc4l_equivalence [--candidate current|vst3] [--modules a,b,...] [--rate Hz]\n"
+            "                         [--block samples] [--seconds sec] [--budget dB]\n"
+            "modules:");
+    for (int m = 0; m < kNumModules; ++m) fprintf(stderr, " %s", kModules[m]);
+    fprintf(stderr, "\n");
+}
+
+bool isModule(const std::string& name) {
+    for (int m = 0; m < kNumModules; ++m) {
+        if (name == kModules[m]) return true;
+    }
+    return false;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (strcmp(arg, "--candidate") == 0) {
+            options.candidate = value;
+        } else if (strcmp(arg, "--modules") == 0) {
+            options.modules.clear();
+            std::string item;
+            for (const char* p = value; ; ++p) {
+                if (*p == ',' || *p == '\0') {
+                    if (!item.empty()) options.modules.push_back(item);
+                    item.clear();
+                    if (*p == '\0') break;
+                } else {
+                    item += *p;
+                }
+            }
+        } else if (strcmp(arg, "--rate") == 0) {
+            options.sampleRate = (float)atof(value);
+        } else if (strcmp(arg, "--block") == 0) {
+            options.blockSize = atoi(value);
+        } else if (strcmp(arg, "--seconds") == 0) {
+            options.seconds = atof(value);
+        } else if (strcmp(arg, "--budget") == 0) {
+            options.haveBudget = true;
+            options.budgetDb = atof(value);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+
+    if (options.modules.empty()) {
+        for (int m = 0; m < kNumModules; ++m) options.modules.push_back(kModules[m]);
+    }
+    for (const std::string& name : options.modules) {
+        if (!isModule(name)) {
+            fprintf(stderr, "unknown module '%s'\n", name.c_str());
+            return false;
+        }
+    }
+    if (options.candidate != "current" && options.candidate != "vst3") {
+        fprintf(stderr, "unknown candidate '%s'\n", options.candidate.c_str());
+        return false;
+    }
+    return options.sampleRate > 0.0f && options.blockSize > 0 && options.seconds > 0.0;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Corpus
+//-------------------------------------------------------------------------------------------------------
+float noiseSample(unsigned int& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / 8388608.0f - 1.0f;
+}
+
+std::vector<TestSignal> buildCorpus(float sampleRate, double seconds) {
+    const int length = (int)(seconds * sampleRate);
+    const double twoPi = 6.28318530717958647692;
+    std::vector<TestSignal> corpus;
+
+    // Logarithmic sine sweep 20 Hz -> 20 kHz at -6 dBFS, right channel in quadrature
+    {
+        TestSignal s { "sweep", std::vector<float>(length), std::vector<float>(length) };
+        const double f0 = 20.0, f1 = std::min(20000.0, 0.45 * sampleRate);
+        const double k = log(f1 / f0);
+        const double duration = (double)length / sampleRate;
+        for (int i = 0; i < length; ++i) {
+            double t = (double)i / sampleRate;
+            double phase = twoPi * f0 * duration / k * (exp(t / duration * k) - 1.0);
+            s.left[i] = (float)(0.5 * sin(phase));
+            s.right[i] = (float)(0.5 * cos(phase));
+        }
+        corpus.push_back(std::move(s));
+    }
+
+    // Tone bursts: 1 kHz + 80 Hz at -3 dBFS, 50 ms on / 200 ms off (attack and release paths)
+    {
+        TestSignal s { "bursts", std::vector<float>(length), std::vector<float>(length) };
+        const int period = (int)(0.25f * sampleRate);
+        const int on = (int)(0.05f * sampleRate);
+        for (int i = 0; i < length; ++i) {
+            double t = (double)i / sampleRate;
+            float gate = (i % period < on) ? 1.0f : 0.0f;
+            float x = (float)(0.5 * sin(twoPi * 1000.0 * t) + 0.2 * sin(twoPi * 80.0 * t));
+            s.left[i] = gate * x;
+            s.right[i] = gate * x * 0.8f;
+        }
+        corpus.push_back(std::move(s));
+    }
+
+    // Decorrelated white noise at about -10 dBFS RMS
+    {
+        TestSignal s { "noise", std::vector<float>(length), std::vector<float>(length) };
+        unsigned int seed = 0x454C4334u;  // 'ELC4'
+        for (int i = 0; i < length; ++i) {
+            s.left[i] = 0.55f * noiseSample(seed);
+            s.right[i] = 0.55f * noiseSample(seed);
+        }
+        corpus.push_back(std::move(s));
+    }
+
+    // One second of loud full-band program, then digital silence (tail decay, denormal territory)
+    {
+        TestSignal s { "loud-silence", std::vector<float>(length, 0.0f), std::vector<float>(length, 0.0f) };
+        unsigned int seed = 0x12345678u;
+        const int loud = std::min(length, (int)sampleRate);
+        for (int i = 0; i < loud; ++i) {
+            double t = (double)i / sampleRate;
+            float tones = (float)(0.5 * sin(twoPi * 60.0 * t) + 0.25 * sin(twoPi * 3000.0 * t));
+            float noise = 0.3f * noiseSample(seed);
+            s.left[i] = noise + tones;
+            s.right[i] = noise - tones * 0.5f;
+        }
+        corpus.push_back(std::move(s));
+    }
+
+    // Near full-scale fs/4 sine at 45 degrees phase: inter-sample peaks above every sample value
+    {
+        TestSignal s { "intersample", std::vector<float>(length), std::vector<float>(length) };
+        for (int i = 0; i < length; ++i) {
+            float x = (float)(0.99 * sin(twoPi * 0.25 * i + 0.25 * 3.14159265358979));
+            s.left[i] = x;
+            s.right[i] = -x;
+        }
+        corpus.push_back(std::move(s));
+    }
+
+    return corpus;
+}
+
+Comparison compare(const std::vector<float>& reference, const std::vector<float>& candidate) {
+    Comparison result;
+    if (reference.size() != candidate.size()) {
+        result.lengthMismatch = true;
+        return result;
+    }
+
+    double sumError = 0.0, sumReference = 0.0;
+    bool identical = true;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        double error = (double)candidate[i] - (double)reference[i];
+        if (candidate[i] != reference[i]) identical = false;
+        result.maxAbs = std::max(result.maxAbs, fabs(error));
+        sumError += error * error;
+        sumReference += (double)reference[i] * (double)reference[i];
+    }
+    if (!reference.empty()) result.rmsError = sqrt(sumError / (double)reference.size());
+    if (!identical) {
+        result.nullDb = (sumReference > 0.0) ? 10.0 * log10(sumError / sumReference + 1.0e-300) : INFINITY;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    const std::vector<TestSignal> corpus = buildCorpus(options.sampleRate, options.seconds);
+    const ELC4L::EquivalenceSettings settings;
+
+    printf("ELC4L equivalence: reference vs %s, %.0f Hz, block %d, %.1f s per signal\n",
+           options.candidate.c_str(), options.sampleRate, options.blockSize, options.seconds);
+    printf("%-10s %-13s %12s %12s %10s\n", "module", "signal", "max abs", "rms err", "null dB");
+
+    bool overBudget = false;
+    std::vector<float> referenceOut, candidateOut;
+    for (const std::string& module : options.modules) {
+        std::unique_ptr<ELC4L::ModuleKernel> reference = ELC4L::createReferenceKernel(module.c_str());
+        std::unique_ptr<ELC4L::ModuleKernel> candidate = (options.candidate == "vst3")
+            ? ELC4L::createVst3Kernel(module.c_str())
+            : ELC4L::createCurrentKernel(module.c_str());
+        if (!candidate) {
+            printf("%-10s %-13s %12s %12s %10s\n", module.c_str(), "-", "n/a", "n/a", "n/a");
+            continue;
+        }
+
+        double worstNullDb = -INFINITY;
+        for (const TestSignal& signal : corpus) {
+            reference->run(signal.left, signal.right, options.sampleRate, options.blockSize, settings, referenceOut);
+            candidate->run(signal.left, signal.right, options.sampleRate, options.blockSize, settings, candidateOut);
+
+            Comparison c = compare(referenceOut, candidateOut);
+            if (c.lengthMismatch) {
+                printf("%-10s %-13s output length differs (%zu vs %zu)\n", module.c_str(), signal.name,
+                       referenceOut.size(), candidateOut.size());
+                worstNullDb = INFINITY;
+                continue;
+            }
+            worstNullDb = std::max(worstNullDb, c.nullDb);
+
+            char nullText[32];
+            if (c.nullDb == -INFINITY) snprintf(nullText, sizeof(nullText), "exact");
+            else snprintf(nullText, sizeof(nullText), "%.1f", c.nullDb);
+            printf("%-10s %-13s %12.3g %12.3g %10s\n", module.c_str(), signal.name, c.maxAbs, c.rmsError, nullText);
+        }
+
+        if (options.haveBudget && worstNullDb > options.budgetDb) {
+            printf("%-10s over budget: worst null %.1f dB > %.1f dB\n", module.c_str(), worstNullDb, options.budgetDb);
+            overBudget = true;
+        }
+    }
+
+    return overBudget ? 2 : 0;
+}
@@ -0,0 +1,253 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Per-instance memory footprint
+// Reports what one plugin instance costs in memory: the object size of every module the VST2
+// processor embeds, the analyzer state that only exists while an editor is open, and the heap that
+// N PluginInstanceModel instances actually allocate (global operator new is counted) headless, with
+// their editors open, and after closing them again. The shared tables (FFT window, twiddles, bin map)
+// are reported once per process, since every instance references the same copy.
+//
+// --budget bytes fails (exit code 2) if a headless instance (object + heap) exceeds it, so the
+// footprint can be held in CI the way elc4l_equivalence holds the DSP output.
+//
+// --lock prefault|pin runs the plugins' opt-in ELC4L_LOCK_MEMORY step (MemoryLock.h) on every headless
+// instance and reports the bytes touched and locked, e.g. to size RLIMIT_MEMLOCK for a session.
+//
+// Usage: elc4l_footprint [--instances 16] [--rate 48000] [--budget bytes] [--lock prefault|pin]
+//-------------------------------------------------------------------------------------------------------
+
+#include "PluginInstanceModel.h"
+#include "HostBypass.h"
+#include "QualityGovernor.h"
+#include "StageProfiler.h"
+#include "Telemetry.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------------
+// Heap accounting: every allocation carries a header with its size
+//-------------------------------------------------------------------------------------------------------
+namespace {
+
+std::atomic<long long> liveHeapBytes { 0 };
+std::atomic<long long> heapAllocations { 0 };
+
+constexpr size_t kHeaderBytes = alignof(std::max_align_t);
+
+void* countedAlloc(size_t size, size_t alignment) {
+    const size_t header = (alignment > kHeaderBytes) ? alignment : kHeaderBytes;
+    unsigned char* block = static_cast<unsigned char*>(
+        (header > kHeaderBytes) ? aligned_alloc(header, ((size + header + header - 1) / header) * header)
+                                : malloc(size + header));
+    if (!block) throw std::bad_alloc();
+    unsigned char* user = block + header;
+    reinterpret_cast<size_t*>(user)[-1] = size;
+    reinterpret_cast<size_t*>(user)[-2] = header;
+    liveHeapBytes.fetch_add((long long)size, std::memory_order_relaxed);
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return user;
+}
+
+void countedFree(void* pointer) {
+    if (!pointer) return;
+    unsigned char* user = static_cast<unsigned char*>(pointer);
+    const size_t size = reinterpret_cast<size_t*>(user)[-1];
+    const size_t header = reinterpret_cast<size_t*>(user)[-2];
+    liveHeapBytes.fetch_sub((long long)size, std::memory_order_relaxed);
+    free(user - header);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAlloc(size, kHeaderBytes); }
+void* operator new[](size_t size) { return countedAlloc(size, kHeaderBytes); }
+void* operator new(size_t size, std::align_val_t alignment) { return countedAlloc(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return countedAlloc(size, (size_t)alignment); }
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { countedFree(pointer); }
+
+namespace {
+
+struct Options {
+    int instances = 16;
+    float sampleRate = 48000.0f;
+    long long budgetBytes = 0;      // 0: report only
+    ELC4L::MemoryLockMode lockMode = ELC4L::kMemoryLockOff;
+};
+
+void printUsage() {
+    fprintf(stderr, "usage: elc4l_footprint [--instances N] [--rate Hz] [--budget bytes] [--lock prefault|pin]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (strcmp(arg, "--instances") == 0)   options.instances = atoi(value);
+        else if (strcmp(arg, "--rate") == 0)   options.sampleRate = (float)atof(value);
+        else if (strcmp(arg, "--budget") == 0) options.budgetBytes = atoll(value);
+        else if (strcmp(arg, "--lock") == 0) {
+            if (strcmp(value, "prefault") == 0) options.lockMode = ELC4L::kMemoryLockPrefault;
+            else if (strcmp(value, "pin") == 0) options.lockMode = ELC4L::kMemoryLockPin;
+            else return false;
+        }
+        else return false;
+        ++i;
+    }
+    return options.instances > 0 && options.sampleRate > 0.0f && options.budgetBytes >= 0;
+}
+
+long long heapNow() { return liveHeapBytes.load(std::memory_order_relaxed); }
+
+// A second of program material, so the analyzer runs through several hops
+void runOneSecond(std::vector<std::unique_ptr<ELC4L::PluginInstanceModel>>& plugins, float sampleRate) {
+    const int block = 256;
+    std::vector<float> inL(block), inR(block), outL(block), outR(block);
+    const int blocks = (int)(sampleRate / block);
+    for (int b = 0; b < blocks; ++b) {
+        for (int i = 0; i < block; ++i) {
+            const float t = (float)(b * block + i) / sampleRate;
+            inL[i] = 0.5f * sinf(6.2831853f * 220.0f * t);
+            inR[i] = 0.5f * sinf(6.2831853f * 330.0f * t);
+        }
+        for (auto& plugin : plugins) plugin->processBlock(inL.data(), inR.data(), outL.data(), outR.data(), block);
+    }
+}
+
+void printRow(const char* name, size_t bytes, int count = 1) {
+    if (count == 1) printf("  %-34s %8zu\n", name, bytes);
+    else printf("  %-28s x%-4d %8zu\n", name, count, bytes * count);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // Modules of HyeokStreamMaster (the SDK base class and small scalars come on top); the DSP stages
+    // live in its StateArena, each padded out to a cache line boundary
+    printf("VST2 processor members (bytes)\n");
+    printRow("HyeokStreamDSP (crossover)", sizeof(HyeokStreamDSP));
+    printRow("OptoCompressor", sizeof(OptoCompressor), 4);
+    printRow("LookaheadLimiter", sizeof(LookaheadLimiter));
+    printRow("LufsMeter", sizeof(LufsMeter));
+    printRow("stage arena (padded)", ELC4L::OfflineChain::getStateBytes());
+    printRow("StageProfiler", sizeof(ELC4L::StageProfiler));
+    printRow("TelemetryPublisher", sizeof(ELC4L::TelemetryPublisher));
+    printRow("QualityGovernor", sizeof(ELC4L::QualityGovernor));
+    printRow("HostBypass", sizeof(ELC4L::HostBypass));
+    printRow("LazyEditorState<AnalyzerState>",
+             sizeof(ELC4L::LazyEditorState<ELC4L::PluginInstanceModel::AnalyzerState>));
+    const size_t members = ELC4L::OfflineChain::getStateBytes()
+        + sizeof(ELC4L::StageProfiler) + sizeof(ELC4L::TelemetryPublisher)
+        + sizeof(ELC4L::QualityGovernor) + sizeof(ELC4L::HostBypass)
+        + sizeof(ELC4L::LazyEditorState<ELC4L::PluginInstanceModel::AnalyzerState>);
+    printRow("total", members);
+    printf("  %-34s %8zu  (allocated while an editor is open)\n", "AnalyzerState",
+           sizeof(ELC4L::PluginInstanceModel::AnalyzerState));
+
+    // What the split state would be for a band-count variant (compensated tree)
+    printf("\nCrossover<N> variants (bytes)\n");
+    printRow("Crossover<2>", sizeof(Crossover<2>));
+    printRow("Crossover<4>", sizeof(Crossover<4>));
+    printRow("Crossover<6>", sizeof(Crossover<6>));
+    printRow("Crossover<8>", sizeof(Crossover<8>));
+
+    // Heap of N model instances through their lifecycle
+    const int n = options.instances;
+    const long long heapStart = heapNow();
+    std::vector<std::unique_ptr<ELC4L::PluginInstanceModel>> plugins;
+    plugins.reserve(n);
+    const long long heapVector = heapNow();
+    for (int i = 0; i < n; ++i) {
+        plugins.emplace_back(new ELC4L::PluginInstanceModel());
+        plugins.back()->prepare(options.sampleRate, ELC4L::ChainSettings());
+    }
+    runOneSecond(plugins, options.sampleRate);
+    const long long heapHeadless = heapNow() - heapVector;
+    const long long perInstanceHeadless = heapHeadless / n;    // sizeof(model) included
+
+    // Before any heap is measured again: the locks live in their own vector
+    ELC4L::MemoryLockReport lockTotal;
+    int lockRefused = 0;
+    std::vector<std::unique_ptr<ELC4L::MemoryLock>> locks;
+    if (options.lockMode != ELC4L::kMemoryLockOff) {
+        for (auto& plugin : plugins) {
+            ELC4L::MemoryRegion regions[2];
+            plugin->getMemoryRegions(regions);
+            locks.emplace_back(new ELC4L::MemoryLock());
+            locks.back()->lock(options.lockMode, regions, 2);
+            const ELC4L::MemoryLockReport& report = locks.back()->getReport();
+            lockTotal.regionBytes += report.regionBytes;
+            lockTotal.pageBytes += report.pageBytes;
+            lockTotal.lockedBytes += report.lockedBytes;
+            if (report.lockError != 0 && lockTotal.lockError == 0) lockTotal.lockError = report.lockError;
+            if (report.lockError != 0) ++lockRefused;
+        }
+    }
+    const long long heapLocks = heapNow() - heapVector - heapHeadless;
+
+    // The first editor also builds the shared tables; the others only add their analyzer state
+    const long long heapBeforeEditors = heapNow();
+    plugins[0]->setEditorOpen(true);
+    const long long firstEditor = heapNow() - heapBeforeEditors;
+    for (auto& plugin : plugins) plugin->setEditorOpen(true);
+    runOneSecond(plugins, options.sampleRate);
+    const long long heapEditors = heapNow() - heapVector - heapLocks;
+    const long long perEditor = (n > 1) ? (heapNow() - heapBeforeEditors - firstEditor) / (n - 1)
+                                        : (long long)sizeof(ELC4L::PluginInstanceModel::AnalyzerState);
+    const long long sharedTables = firstEditor - perEditor;
+
+    for (auto& plugin : plugins) plugin->setEditorOpen(false);
+    const long long heapClosed = heapNow() - heapVector - heapLocks;
+    locks.clear();
+    locks.shrink_to_fit();
+    plugins.clear();
+    const long long heapLeft = heapNow() - heapStart;
+
+    printf("\nPluginInstanceModel: %zu bytes (chain + meters + analyzer link; %zu of them the stage arena)\n",
+           ELC4L::PluginInstanceModel::getInstanceBytes(), ELC4L::OfflineChain::getStateBytes());
+    printf("Heap for %d instances at %.0f Hz (bytes)\n", n, options.sampleRate);
+    printf("  %-34s %10lld  (%lld per instance)\n", "headless", heapHeadless, perInstanceHeadless);
+    printf("  %-34s %10lld  (%lld more per instance, %lld of shared tables once)\n", "editors open", heapEditors,
+           perEditor, sharedTables);
+    printf("  %-34s %10lld  (%lld per instance)\n", "editors closed again", heapClosed, heapClosed / n);
+    printf("  %-34s %10lld\n", "after destruction", heapLeft);
+
+    if (options.lockMode != ELC4L::kMemoryLockOff) {
+        printf("\nMemory lock (%s) of %d headless instances (bytes)\n",
+               (options.lockMode == ELC4L::kMemoryLockPin) ? "pin" : "prefault", n);
+        printf("  %-34s %10zu  (%zu per instance)\n", "regions", lockTotal.regionBytes, lockTotal.regionBytes / n);
+        printf("  %-34s %10zu  (whole pages touched)\n", "pages", lockTotal.pageBytes);
+        printf("  %-34s %10zu\n", "locked", lockTotal.lockedBytes);
+        if (lockRefused > 0) {
+            printf("  mlock refused for %d instances: %s\n", lockRefused, strerror(lockTotal.lockError));
+        }
+    }
+
+    if (options.budgetBytes > 0) {
+        const bool within = perInstanceHeadless <= options.budgetBytes;
+        printf("\nHeadless instance: %lld bytes, budget %lld: %s\n", perInstanceHeadless, options.budgetBytes,
+               within ? "ok" : "EXCEEDED");
+        if (!within) return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,345 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Multi-instance scaling benchmark
+// Simulates a busy OBS scene: N independent plugin instances (PluginInstanceModel: chain, meters and,
+// with --editors 1, the analyzer of an open editor, as one HyeokStreamMaster) share one core, and for every block period the host calls
+// each instance in turn with its own buffers. As N grows the instances' combined footprint outgrows
+// the caches, and the per-instance cost rises above the single-instance figure.
+//
+// Reported per N: CPU time per block period, per-instance cost per block and per sample, load
+// relative to the block's realtime budget, scaling versus N = 1 and, where the kernel allows
+// perf_event_open (Linux, perf_event_paranoid <= 2), last-level-cache references and misses per
+// block period. Counters only run around the process calls, not the host-side buffer refill.
+//
+// Usage: elc4l_instance_bench [--counts 1,2,4,8,16,32,48,64] [--rate 48000] [--block 512]
+//                             [--seconds 2] [--warmup 0.5] [--cpu N] [--editors 0|1] [--json path]
+//-------------------------------------------------------------------------------------------------------
+
+#include "PluginInstanceModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int kCurrentCpu = -2;
+
+struct Options {
+    std::vector<int> counts = { 1, 2, 4, 8, 16, 32, 48, 64 };
+    float sampleRate = 48000.0f;
+    int blockSize = 512;
+    double seconds = 2.0;
+    double warmupSeconds = 0.5;
+    int cpu = kCurrentCpu;          // -1: not pinned
+    bool editors = false;           // Every instance has its editor open (analyzer allocated and running)
+    const char* jsonPath = nullptr;
+};
+
+struct Result {
+    int instances;
+    double cycleNs;                 // Mean CPU time of one block period (all instances)
+    double instanceNs;              // cycleNs / instances
+    double nsPerSample;             // Per instance and stereo sample
+    double load;                    // cycleNs / block budget
+    double scaling;                 // nsPerSample / nsPerSample at the first count
+    bool haveCounters;
+    double llcReferences;           // Per block period
+    double llcMisses;               // Per block period
+};
+
+//-------------------------------------------------------------------------------------------------------
+// Last-level-cache counters for the calling thread (user space only)
+//-------------------------------------------------------------------------------------------------------
+class CacheCounters {
+public:
+    CacheCounters() {
+#if defined(__linux__)
+        references = open(PERF_COUNT_HW_CACHE_REFERENCES);
+        misses = open(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+    ~CacheCounters() {
+#if defined(__linux__)
+        if (references >= 0) close(references);
+        if (misses >= 0) close(misses);
+#endif
+    }
+    CacheCounters(const CacheCounters&) = delete;
+    CacheCounters& operator=(const CacheCounters&) = delete;
+
+    bool isAvailable() const { return references >= 0 && misses >= 0; }
+
+    void reset() { control(PERF_EVENT_IOC_RESET); }
+    void start() { control(PERF_EVENT_IOC_ENABLE); }
+    void stop() { control(PERF_EVENT_IOC_DISABLE); }
+
+    uint64_t getReferences() const { return read(references); }
+    uint64_t getMisses() const { return read(misses); }
+
+private:
+#if defined(__linux__)
+    static int open(uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    void control(unsigned long request) {
+        if (!isAvailable()) return;
+        ioctl(references, request, 0);
+        ioctl(misses, request, 0);
+    }
+
+    static uint64_t read(int fd) {
+        uint64_t value = 0;
+        if (fd < 0 || ::read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) return 0;
+        return value;
+    }
+#else
+    enum { PERF_EVENT_IOC_RESET, PERF_EVENT_IOC_ENABLE, PERF_EVENT_IOC_DISABLE };
+    void control(unsigned long) {}
+    static uint64_t read(int) { return 0; }
+#endif
+
+    int references = -1;
+    int misses = -1;
+};
+
+//-------------------------------------------------------------------------------------------------------
+void printUsage() {
+    fprintf(stderr,
+            "usage: elc4l_instance_bench [--counts N,...] [--rate Hz] [--block samples] [--seconds sec]\n"
+            "                            [--warmup sec] [--cpu N] [--editors 0|1] [--json path]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (strcmp(arg, "--counts") == 0) {
+            options.counts.clear();
+            for (const char* p = value; *p; ) {
+                options.counts.push_back(atoi(p));
+                p = strchr(p, ',');
+                if (!p) break;
+                ++p;
+            }
+        }
+        else if (strcmp(arg, "--rate") == 0)    options.sampleRate = (float)atof(value);
+        else if (strcmp(arg, "--block") == 0)   options.blockSize = atoi(value);
+        else if (strcmp(arg, "--seconds") == 0) options.seconds = atof(value);
+        else if (strcmp(arg, "--warmup") == 0)  options.warmupSeconds = atof(value);
+        else if (strcmp(arg, "--cpu") == 0)     options.cpu = atoi(value);
+        else if (strcmp(arg, "--editors") == 0) options.editors = atoi(value) != 0;
+        else if (strcmp(arg, "--json") == 0)    options.jsonPath = value;
+        else return false;
+        ++i;
+    }
+    for (int count : options.counts) {
+        if (count <= 0) return false;
+    }
+    return !options.counts.empty() && options.sampleRate > 0.0f && options.blockSize > 0
+        && options.seconds > 0.0 && options.warmupSeconds >= 0.0;
+}
+
+bool pinToCpu(int& cpu) {
+#if defined(__linux__)
+    if (cpu == kCurrentCpu) cpu = sched_getcpu();
+    if (cpu < 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Loud broadband program (same as elc4l_denormal_bench)
+void generateSignal(std::vector<float>& left, std::vector<float>& right, int numSamples, float sampleRate) {
+    unsigned int seed = 0x454C4334u;  // 'ELC4'
+    const float twoPi = 6.28318530717958647692f;
+    for (int i = 0; i < numSamples; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 8388608.0f - 1.0f;
+        float t = (float)i / sampleRate;
+        float tones = 0.4f * sinf(twoPi * 60.0f * t) + 0.2f * sinf(twoPi * 3000.0f * t);
+        left[i] = 0.3f * noise + tones;
+        right[i] = 0.3f * noise - tones * 0.5f;
+    }
+}
+
+// Per-instance host buffers (separate allocations, as each OBS source has its own)
+struct InstanceSlot {
+    std::unique_ptr<ELC4L::PluginInstanceModel> plugin;
+    std::vector<float> inL, inR, outL, outR;
+    int sourceOffset = 0;
+};
+
+Result measure(int numInstances, const Options& options, const std::vector<float>& srcL,
+               const std::vector<float>& srcR, CacheCounters& counters) {
+    const int block = options.blockSize;
+    const int sourceLength = (int)srcL.size();
+
+    std::vector<InstanceSlot> slots(numInstances);
+    for (int n = 0; n < numInstances; ++n) {
+        InstanceSlot& slot = slots[n];
+        slot.plugin.reset(new ELC4L::PluginInstanceModel());
+        slot.plugin->prepare(options.sampleRate, ELC4L::ChainSettings());
+        slot.plugin->setEditorOpen(options.editors);
+        slot.inL.resize(block);
+        slot.inR.resize(block);
+        slot.outL.resize(block);
+        slot.outR.resize(block);
+        // Different material per instance so the envelopes do not run in lockstep
+        slot.sourceOffset = (int)(((int64_t)n * 7919 * block) % (sourceLength - block));
+    }
+
+    auto hostCycle = [&](int cycle, bool timed, double& elapsedNs) {
+        // Host side: deliver the next block to every instance (not timed)
+        for (InstanceSlot& slot : slots) {
+            int position = (slot.sourceOffset + cycle * block) % (sourceLength - block);
+            std::copy(srcL.begin() + position, srcL.begin() + position + block, slot.inL.begin());
+            std::copy(srcR.begin() + position, srcR.begin() + position + block, slot.inR.begin());
+        }
+
+        if (timed) counters.start();
+        auto t0 = std::chrono::steady_clock::now();
+        for (InstanceSlot& slot : slots) {
+            slot.plugin->processBlock(slot.inL.data(), slot.inR.data(), slot.outL.data(), slot.outR.data(), block);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        if (timed) counters.stop();
+        elapsedNs += (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    };
+
+    const int warmupCycles = (int)(options.warmupSeconds * options.sampleRate / block);
+    const int cycles = std::max(1, (int)(options.seconds * options.sampleRate / block));
+
+    double ignored = 0.0;
+    for (int c = 0; c < warmupCycles; ++c) hostCycle(c, false, ignored);
+
+    counters.reset();
+    double totalNs = 0.0;
+    for (int c = 0; c < cycles; ++c) hostCycle(warmupCycles + c, true, totalNs);
+
+    Result result;
+    result.instances = numInstances;
+    result.cycleNs = totalNs / cycles;
+    result.instanceNs = result.cycleNs / numInstances;
+    result.nsPerSample = result.instanceNs / block;
+    result.load = result.cycleNs / (1.0e9 * block / options.sampleRate);
+    result.scaling = 1.0;
+    result.haveCounters = counters.isAvailable();
+    result.llcReferences = (double)counters.getReferences() / cycles;
+    result.llcMisses = (double)counters.getMisses() / cycles;
+    return result;
+}
+
+bool writeJson(const char* path, const Options& options, const std::vector<Result>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"tool\": \"elc4l_instance_bench\",\n");
+#if defined(__VERSION__)
+    fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    fprintf(file, "  \"cpu\": %d,\n", options.cpu);
+    fprintf(file, "  \"sample_rate\": %.0f,\n", options.sampleRate);
+    fprintf(file, "  \"block\": %d,\n", options.blockSize);
+    fprintf(file, "  \"instance_bytes\": %zu,\n", ELC4L::PluginInstanceModel::getInstanceBytes());
+    fprintf(file, "  \"editors\": %s,\n", options.editors ? "true" : "false");
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        fprintf(file,
+                "    { \"instances\": %d, \"cycle_ns\": %.0f, \"instance_ns\": %.0f, \"ns_per_sample\": %.3f, "
+                "\"load\": %.4f, \"scaling\": %.3f",
+                r.instances, r.cycleNs, r.instanceNs, r.nsPerSample, r.load, r.scaling);
+        if (r.haveCounters) {
+            fprintf(file, ", \"llc_references\": %.0f, \"llc_misses\": %.0f", r.llcReferences, r.llcMisses);
+        }
+        fprintf(file, " }%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    if (options.cpu != -1 && !pinToCpu(options.cpu)) {
+        fprintf(stderr, "warning: could not pin to a CPU, timings may be noisy\n");
+        options.cpu = -1;
+    }
+
+    CacheCounters counters;
+    if (!counters.isAvailable()) {
+        fprintf(stderr, "note: cache counters unavailable (perf_event_open), reporting time only\n");
+    }
+
+    const int sourceLength = std::max((int)(10.0f * options.sampleRate), 4 * options.blockSize);
+    std::vector<float> srcL(sourceLength), srcR(sourceLength);
+    generateSignal(srcL, srcR, sourceLength, options.sampleRate);
+
+    printf("ELC4L instance scaling: %.0f Hz, block %d, %.1f s per count, %zu bytes per instance%s, CPU %s\n",
+           options.sampleRate, options.blockSize, options.seconds,
+           ELC4L::PluginInstanceModel::getInstanceBytes(),
+           options.editors ? " + analyzer (editors open)" : " (headless)",
+           (options.cpu >= 0) ? std::to_string(options.cpu).c_str() : "not pinned");
+    printf("%9s %12s %14s %10s %8s %8s %14s %14s\n",
+           "instances", "cycle us", "per inst. us", "ns/sample", "load", "scaling", "LLC refs/cyc", "LLC miss/cyc");
+
+    std::vector<Result> results;
+    for (int count : options.counts) {
+        Result r = measure(count, options, srcL, srcR, counters);
+        if (!results.empty() && results.front().nsPerSample > 0.0) {
+            r.scaling = r.nsPerSample / results.front().nsPerSample;
+        }
+        printf("%9d %12.1f %14.2f %10.2f %7.1f%% %7.2fx", r.instances, r.cycleNs / 1000.0, r.instanceNs / 1000.0,
+               r.nsPerSample, 100.0 * r.load, r.scaling);
+        if (r.haveCounters) printf(" %14.0f %14.0f\n", r.llcReferences, r.llcMisses);
+        else printf(" %14s %14s\n", "n/a", "n/a");
+        fflush(stdout);
+        results.push_back(r);
+    }
+
+    if (options.jsonPath) {
+        if (!writeJson(options.jsonPath, options, results)) {
+            fprintf(stderr, "cannot write %s\n", options.jsonPath);
+            return 1;
+        }
+        printf("results written to %s\n", options.jsonPath);
+    }
+    return 0;
+}
@@ -0,0 +1,650 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Per-module micro-benchmark
+// Times each VST2 DSP module in isolation and the full chain over a grid of block sizes and sample
+// rates, and reports the cost as ns per stereo sample and as realtime factor (audio time / CPU time):
+//   crossover     : HyeokStreamDSP 4-band Linkwitz-Riley split (bands summed to the output)
+//   xover-N       : Crossover<N> with allpass compensation, N = 2, 4, 6, 8 (what a band-count
+//                   variant of the plugin would pay for its split)
+//   comp          : one OptoCompressor, including its oversampled saturation (4x at 44.1/48 kHz,
+//                   2x at 88.2/96 kHz, 1x from 176.4 kHz)
+//   comp4         : four OptoCompressors on the same input (the band bank without the crossover)
+//   os-sat        : PolyphaseOversampler 1->4 + TapeSaturator + 4->1 on both channels
+//   os-sat-2x     : the same at 2x (every other polyphase branch)
+//   limiter       : LookaheadLimiter
+//   lufs          : LufsMeter
+//   spectrum      : analyzer input/output pair as fed by HyeokStreamMaster::updateMeters
+//                   (two 4096-point spectra every 1024-sample hop)
+//   chain         : OfflineChain (crossover -> 4 compressors -> limiter -> meter)
+//   chain-prof    : chain with its StageProfiler enabled; when both run, the profiler's overhead
+//                   against chain (profiler compiled in, off) is reported per rate and block size,
+//                   from the median and from the fastest runs (the steadier figure on a busy machine)
+//   tier-eco      : chain + spectrum at the Eco processing quality (float crossover, 1x saturation,
+//                   control-rate gain computer, analyzer every 2048 samples)
+//   tier-standard : chain + spectrum at the default quality (same DSP as chain + spectrum)
+//   tier-high     : chain + spectrum at High quality (8x saturation, 128-sample peak-hold lookahead)
+//
+// Each measurement prepares a fresh module, warms it up, then processes --seconds of a loud broadband
+// signal --repeat times; the median and the minimum run are reported. Blocks run under
+// ScopedFlushDenormals like the plugin's process call. The thread is pinned to one core (Linux; the
+// current one unless --cpu names another, --cpu -1 disables) so runs are comparable; --json writes
+// every result for diffing between builds.
+//
+// --flatness dB measures instead of timing: the magnitude response of the band sum of Crossover<N>
+// (N = 2, 4, 6, 8, in double and float precision) from 20 Hz to 20 kHz at each --rates, and exits
+// with status 2 when a compensated crossover deviates from 0 dB by more than dB. The serial 4- and
+// 6-band splits without allpasses are listed for comparison (their dip is the reason for the
+// compensation) and are not held to the budget.
+//
+// Usage: elc4l_module_bench [--modules a,b,...] [--rates 44100,48000,96000,192000]
+//                           [--blocks 16,64,256,1024,4096] [--seconds 0.5] [--warmup 0.2]
+//                           [--repeat 5] [--cpu N] [--json path] [--flatness dB]
+//-------------------------------------------------------------------------------------------------------
+
+#include "OfflineChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------------
+// Modules under test
+//-------------------------------------------------------------------------------------------------------
+class BenchModule {
+public:
+    virtual ~BenchModule() = default;
+    virtual void prepare(float sampleRate) = 0;
+    virtual void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) = 0;
+};
+
+template <typename Crossover>
+class CrossoverModule : public BenchModule {
+public:
+    void prepare(float sampleRate) override {
+        crossover.setSampleRate(sampleRate);
+        crossover.reset();
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        for (int i = 0; i < numSamples; ++i) {
+            float l[Crossover::kNumBands], r[Crossover::kNumBands];
+            crossover.processSample(inL[i], inR[i], l, r);
+            float mixL = 0.0f, mixR = 0.0f;
+            for (int b = 0; b < Crossover::kNumBands; ++b) {
+                mixL += l[b];
+                mixR += r[b];
+            }
+            outL[i] = mixL;
+            outR[i] = mixR;
+        }
+    }
+
+private:
+    Crossover crossover;
+};
+
+template <int NumCompressors>
+class CompressorModule : public BenchModule {
+public:
+    void prepare(float sampleRate) override {
+        for (int c = 0; c < NumCompressors; ++c) {
+            comps[c].setSampleRate(sampleRate);
+            comps[c].setThresholdDb(-18.0f);
+            comps[c].reset();
+        }
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        for (int i = 0; i < numSamples; ++i) {
+            float mixL = 0.0f, mixR = 0.0f;
+            for (int c = 0; c < NumCompressors; ++c) {
+                float l = inL[i], r = inR[i];
+                comps[c].process(l, r);
+                mixL += l;
+                mixR += r;
+            }
+            outL[i] = mixL;
+            outR[i] = mixR;
+        }
+    }
+
+private:
+    OptoCompressor comps[NumCompressors];
+};
+
+template <int Factor>
+class OversampledSaturatorModule : public BenchModule {
+public:
+    void prepare(float) override {
+        oversamplerL.reset();
+        oversamplerR.reset();
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        // Same drive/bias mapping as OptoCompressor at its default saturation amount
+        const float drive = 1.0f + 0.3f * 3.0f;
+        const float bias = 0.3f * 0.1f;
+        float up[Factor];
+        for (int i = 0; i < numSamples; ++i) {
+            oversamplerL.processUpsample<Factor>(inL[i], up);
+            for (int k = 0; k < Factor; ++k) up[k] = saturator.process(up[k], drive, bias);
+            outL[i] = oversamplerL.processDownsample<Factor>(up) / drive;
+
+            oversamplerR.processUpsample<Factor>(inR[i], up);
+            for (int k = 0; k < Factor; ++k) up[k] = saturator.process(up[k], drive, bias);
+            outR[i] = oversamplerR.processDownsample<Factor>(up) / drive;
+        }
+    }
+
+private:
+    TapeSaturator saturator;
+    PolyphaseOversampler oversamplerL;
+    PolyphaseOversampler oversamplerR;
+};
+
+class LimiterModule : public BenchModule {
+public:
+    void prepare(float sampleRate) override {
+        limiter.setSampleRate(sampleRate);
+        limiter.setThreshold(-6.0f);
+        limiter.setCeiling(-1.0f);
+        limiter.setRelease(157.0f);
+        limiter.reset();
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        for (int i = 0; i < numSamples; ++i) {
+            float l = inL[i], r = inR[i];
+            limiter.process(l, r);
+            outL[i] = l;
+            outR[i] = r;
+        }
+    }
+
+private:
+    LookaheadLimiter limiter;
+};
+
+class LufsModule : public BenchModule {
+public:
+    void prepare(float sampleRate) override {
+        meter.setSampleRate(sampleRate);
+        meter.reset();
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        for (int i = 0; i < numSamples; ++i) {
+            meter.process(inL[i], inR[i]);
+        }
+        outL[0] = meter.getMomentary();
+        outR[0] = outL[0];
+    }
+
+private:
+    LufsMeter meter;
+};
+
+// The analyzer part of HyeokStreamMaster::updateMeters (mono history, hop, two spectra per hop)
+class SpectrumModule : public BenchModule {
+public:
+    static constexpr int kFftSize = SpectrumAnalyzer::kFftSize;
+    static constexpr int kDefaultHopSize = 1024;
+
+    explicit SpectrumModule(int hopSize = kDefaultHopSize) : hopSize(hopSize) {}
+
+    void prepare(float newSampleRate) override {
+        sampleRate = newSampleRate;
+        analyzer->setSampleRate(sampleRate);
+        std::fill(historyIn.begin(), historyIn.end(), 0.0f);
+        std::fill(historyOut.begin(), historyOut.end(), 0.0f);
+        std::fill(spectrumIn.begin(), spectrumIn.end(), -90.0f);
+        std::fill(spectrumOut.begin(), spectrumOut.end(), -90.0f);
+        writePos = 0;
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        for (int i = 0; i < numSamples; ++i) {
+            // Input and output of the plugin; a scaled copy stands in for the processed signal
+            historyIn[writePos] = 0.5f * (inL[i] + inR[i]);
+            historyOut[writePos] = 0.25f * (inL[i] + inR[i]);
+            if (++writePos >= kFftSize) {
+                analyzer->computeSpectrum(historyIn.data(), spectrumIn.data(), sampleRate);
+                analyzer->computeSpectrum(historyOut.data(), spectrumOut.data(), sampleRate);
+                std::copy(historyIn.begin() + hopSize, historyIn.end(), historyIn.begin());
+                std::copy(historyOut.begin() + hopSize, historyOut.end(), historyOut.begin());
+                writePos = kFftSize - hopSize;
+            }
+        }
+        outL[0] = spectrumIn[0];
+        outR[0] = spectrumOut[0];
+    }
+
+private:
+    std::unique_ptr<SpectrumAnalyzer> analyzer { new SpectrumAnalyzer() };
+    std::vector<float> historyIn = std::vector<float>(kFftSize, 0.0f);
+    std::vector<float> historyOut = std::vector<float>(kFftSize, 0.0f);
+    std::vector<float> spectrumIn = std::vector<float>(SpectrumAnalyzer::kSpectrumBins, -90.0f);
+    std::vector<float> spectrumOut = std::vector<float>(SpectrumAnalyzer::kSpectrumBins, -90.0f);
+    float sampleRate = 48000.0f;
+    int hopSize;
+    int writePos = 0;
+};
+
+template <bool Profiled>
+class ChainModule : public BenchModule {
+public:
+    void prepare(float sampleRate) override {
+        chain.prepare(sampleRate, ELC4L::ChainSettings());
+        chain.getProfiler().setEnabled(Profiled);
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        chain.process(inL, inR, outL, outR, numSamples);
+    }
+
+private:
+    ELC4L::OfflineChain chain;
+};
+
+// Everything a processing quality changes: the chain at that quality plus the analyzer at its hop
+template <int Quality>
+class TierModule : public BenchModule {
+public:
+    TierModule() : spectrum(SpectrumModule::kDefaultHopSize
+                            * ELC4L::getQualitySettings(Quality, ELC4L::kQualityFull).analyzerHopScale) {}
+
+    void prepare(float sampleRate) override {
+        ELC4L::ChainSettings settings;
+        settings.processingQuality = Quality;
+        chain.prepare(sampleRate, settings);
+        spectrum.prepare(sampleRate);
+    }
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override {
+        chain.process(inL, inR, outL, outR, numSamples);
+        float spectrumL, spectrumR;
+        spectrum.process(outL, outR, &spectrumL, &spectrumR, numSamples);
+    }
+
+private:
+    ELC4L::OfflineChain chain;
+    SpectrumModule spectrum;
+};
+
+struct ModuleInfo {
+    const char* name;
+    std::unique_ptr<BenchModule> (*create)();
+};
+
+template <typename T>
+std::unique_ptr<BenchModule> createModule() { return std::unique_ptr<BenchModule>(new T()); }
+
+const ModuleInfo kModules[] = {
+    { "crossover", createModule<CrossoverModule<HyeokStreamDSP>> },
+    { "xover-2",   createModule<CrossoverModule<Crossover<2>>> },
+    { "xover-4",   createModule<CrossoverModule<Crossover<4>>> },
+    { "xover-6",   createModule<CrossoverModule<Crossover<6>>> },
+    { "xover-8",   createModule<CrossoverModule<Crossover<8>>> },
+    { "comp",      createModule<CompressorModule<1>> },
+    { "comp4",     createModule<CompressorModule<4>> },
+    { "os-sat",    createModule<OversampledSaturatorModule<4>> },
+    { "os-sat-2x", createModule<OversampledSaturatorModule<2>> },
+    { "limiter",   createModule<LimiterModule> },
+    { "lufs",      createModule<LufsModule> },
+    { "spectrum",  createModule<SpectrumModule> },
+    { "chain",     createModule<ChainModule<false>> },
+    { "chain-prof", createModule<ChainModule<true>> },
+    { "tier-eco",      createModule<TierModule<ELC4L::kProcessingEco>> },
+    { "tier-standard", createModule<TierModule<ELC4L::kProcessingStandard>> },
+    { "tier-high",     createModule<TierModule<ELC4L::kProcessingHigh>> },
+};
+constexpr int kNumModules = sizeof(kModules) / sizeof(kModules[0]);
+
+//-------------------------------------------------------------------------------------------------------
+// Options
+//-------------------------------------------------------------------------------------------------------
+constexpr int kCurrentCpu = -2;
+
+struct Options {
+    std::vector<std::string> modules;
+    std::vector<float> sampleRates = { 44100.0f, 48000.0f, 96000.0f, 192000.0f };
+    std::vector<int> blockSizes = { 16, 64, 256, 1024, 4096 };
+    double seconds = 0.5;
+    double warmupSeconds = 0.2;
+    int repeat = 5;
+    int cpu = kCurrentCpu;          // -1: not pinned
+    const char* jsonPath = nullptr;
+    double flatnessBudgetDb = -1.0; // >= 0: band-sum flatness check instead of timing
+};
+
+struct Result {
+    const char* module;
+    float sampleRate;
+    int blockSize;
+    double nsPerSampleMedian;
+    double nsPerSampleMin;
+    double realtimeFactor;      // From the median run
+};
+
+void printUsage() {
+    fprintf(stderr,
+            "usage: elc4l_module_bench [--modules a,b,...] [--rates Hz,...] [--blocks N,...]\n"
+            "                          [--seconds sec] [--warmup sec] [--repeat N] [--cpu N] [--json path]\n"
+            "                          [--flatness dB]\n"
+            "modules:");
+    for (int m = 0; m < kNumModules; ++m) fprintf(stderr, " %s", kModules[m].name);
+    fprintf(stderr, "\n");
+}
+
+std::vector<std::string> splitList(const char* text) {
+    std::vector<std::string> items;
+    std::string item;
+    for (const char* p = text; ; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) items.push_back(item);
+            item.clear();
+            if (*p == '\0') break;
+        } else {
+            item += *p;
+        }
+    }
+    return items;
+}
+
+const ModuleInfo* findModule(const std::string& name) {
+    for (int m = 0; m < kNumModules; ++m) {
+        if (name == kModules[m].name) return &kModules[m];
+    }
+    return nullptr;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (strcmp(arg, "--modules") == 0) {
+            options.modules = splitList(value);
+            for (const std::string& name : options.modules) {
+                if (!findModule(name)) {
+                    fprintf(stderr, "unknown module '%s'\n", name.c_str());
+                    return false;
+                }
+            }
+        } else if (strcmp(arg, "--rates") == 0) {
+            options.sampleRates.clear();
+            for (const std::string& item : splitList(value)) options.sampleRates.push_back((float)atof(item.c_str()));
+        } else if (strcmp(arg, "--blocks") == 0) {
+            options.blockSizes.clear();
+            for (const std::string& item : splitList(value)) options.blockSizes.push_back(atoi(item.c_str()));
+        }
+        else if (strcmp(arg, "--seconds") == 0) options.seconds = atof(value);
+        else if (strcmp(arg, "--warmup") == 0)  options.warmupSeconds = atof(value);
+        else if (strcmp(arg, "--repeat") == 0)  options.repeat = atoi(value);
+        else if (strcmp(arg, "--cpu") == 0)     options.cpu = atoi(value);
+        else if (strcmp(arg, "--json") == 0)    options.jsonPath = value;
+        else if (strcmp(arg, "--flatness") == 0) {
+            options.flatnessBudgetDb = atof(value);
+            if (options.flatnessBudgetDb < 0.0) return false;
+        }
+        else return false;
+        ++i;
+    }
+
+    if (options.modules.empty()) {
+        for (int m = 0; m < kNumModules; ++m) options.modules.push_back(kModules[m].name);
+    }
+    for (float rate : options.sampleRates) {
+        if (rate <= 0.0f) return false;
+    }
+    for (int block : options.blockSizes) {
+        if (block <= 0) return false;
+    }
+    return !options.sampleRates.empty() && !options.blockSizes.empty()
+        && options.seconds > 0.0 && options.warmupSeconds >= 0.0 && options.repeat > 0;
+}
+
+bool pinToCpu(int& cpu) {
+#if defined(__linux__)
+    if (cpu == kCurrentCpu) cpu = sched_getcpu();
+    if (cpu < 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Loud broadband program (same as elc4l_denormal_bench): every band and the limiter are working
+void generateSignal(std::vector<float>& left, std::vector<float>& right, int numSamples, float sampleRate) {
+    unsigned int seed = 0x454C4334u;  // 'ELC4'
+    const float twoPi = 6.28318530717958647692f;
+    for (int i = 0; i < numSamples; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 8388608.0f - 1.0f;
+        float t = (float)i / sampleRate;
+        float tones = 0.4f * sinf(twoPi * 60.0f * t) + 0.2f * sinf(twoPi * 3000.0f * t);
+        left[i] = 0.3f * noise + tones;
+        right[i] = 0.3f * noise - tones * 0.5f;
+    }
+}
+
+// Processes 'numSamples' of the (looped) source signal in blocks; returns elapsed nanoseconds
+double runBlocks(BenchModule& module, const std::vector<float>& srcL, const std::vector<float>& srcR,
+                 std::vector<float>& outL, std::vector<float>& outR, int blockSize, int64_t numSamples,
+                 int& position) {
+    const int sourceLength = (int)srcL.size();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int64_t done = 0; done < numSamples; done += blockSize) {
+        const int count = (int)std::min<int64_t>(blockSize, numSamples - done);
+        if (position + count > sourceLength) position = 0;
+
+        ELC4L::ScopedFlushDenormals noDenormals;
+        module.process(&srcL[position], &srcR[position], outL.data(), outR.data(), count);
+        position += count;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+}
+
+Result measure(const ModuleInfo& info, float sampleRate, int blockSize, const Options& options) {
+    // Source: one second (at least a few blocks), looped on block boundaries
+    const int sourceLength = std::max((int)sampleRate, 4 * blockSize);
+    std::vector<float> srcL(sourceLength), srcR(sourceLength);
+    generateSignal(srcL, srcR, sourceLength, sampleRate);
+    std::vector<float> outL(blockSize), outR(blockSize);
+
+    std::unique_ptr<BenchModule> module = info.create();
+    module->prepare(sampleRate);
+
+    int position = 0;
+    const int64_t warmupSamples = (int64_t)(options.warmupSeconds * sampleRate);
+    const int64_t runSamples = std::max<int64_t>(blockSize, (int64_t)(options.seconds * sampleRate));
+    if (warmupSamples > 0) {
+        runBlocks(*module, srcL, srcR, outL, outR, blockSize, warmupSamples, position);
+    }
+
+    std::vector<double> nsPerSample;
+    for (int r = 0; r < options.repeat; ++r) {
+        double ns = runBlocks(*module, srcL, srcR, outL, outR, blockSize, runSamples, position);
+        nsPerSample.push_back(ns / (double)runSamples);
+    }
+    std::sort(nsPerSample.begin(), nsPerSample.end());
+
+    Result result;
+    result.module = info.name;
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.nsPerSampleMedian = nsPerSample[nsPerSample.size() / 2];
+    result.nsPerSampleMin = nsPerSample.front();
+    result.realtimeFactor = (result.nsPerSampleMedian > 0.0)
+        ? 1.0e9 / (result.nsPerSampleMedian * (double)sampleRate) : 0.0;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Band-sum flatness
+//-------------------------------------------------------------------------------------------------------
+// Largest |gain in dB| of the summed bands over 20 Hz - 20 kHz (below Nyquist), from one second of
+// impulse response evaluated at 240 log-spaced frequencies
+template <typename Crossover>
+double measureBandSumDeviationDb(float sampleRate, bool doublePrecision) {
+    std::unique_ptr<Crossover> crossover(new Crossover());
+    crossover->setSampleRate(sampleRate);
+    crossover->setDoublePrecision(doublePrecision);
+    crossover->reset();
+
+    const int length = (int)sampleRate;
+    std::vector<double> impulse(length);
+    for (int i = 0; i < length; ++i) {
+        float l[Crossover::kNumBands], r[Crossover::kNumBands];
+        const float x = (i == 0) ? 1.0f : 0.0f;
+        crossover->processSample(x, x, l, r);
+        double sum = 0.0;
+        for (int b = 0; b < Crossover::kNumBands; ++b) sum += l[b];
+        impulse[i] = sum;
+    }
+
+    const int kNumPoints = 240;
+    const double lowHz = 20.0;
+    const double highHz = std::min(20000.0, 0.45 * sampleRate);
+    double worstDb = 0.0;
+    for (int p = 0; p < kNumPoints; ++p) {
+        const double hz = lowHz * pow(highHz / lowHz, (double)p / (kNumPoints - 1));
+        const double omega = 2.0 * 3.14159265358979323846 * hz / sampleRate;
+        double re = 0.0, im = 0.0;
+        for (int i = 0; i < length; ++i) {
+            re += impulse[i] * cos(omega * i);
+            im -= impulse[i] * sin(omega * i);
+        }
+        const double db = 10.0 * log10(re * re + im * im);
+        worstDb = std::max(worstDb, fabs(db));
+    }
+    return worstDb;
+}
+
+struct FlatnessCase {
+    const char* name;
+    bool compensated;
+    double (*measure)(float sampleRate, bool doublePrecision);
+};
+
+const FlatnessCase kFlatnessCases[] = {
+    { "xover-2",  true,  measureBandSumDeviationDb<Crossover<2>> },
+    { "xover-4",  true,  measureBandSumDeviationDb<Crossover<4>> },
+    { "xover-6",  true,  measureBandSumDeviationDb<Crossover<6>> },
+    { "xover-8",  true,  measureBandSumDeviationDb<Crossover<8>> },
+    { "serial-4", false, measureBandSumDeviationDb<Crossover<4, false>> },
+    { "serial-6", false, measureBandSumDeviationDb<Crossover<6, false>> },
+};
+
+// Prints the table; false when a compensated crossover is outside the budget
+bool checkFlatness(const Options& options) {
+    bool withinBudget = true;
+    printf("ELC4L band-sum flatness, 20 Hz - 20 kHz: largest deviation from 0 dB, budget %.4f dB\n",
+           options.flatnessBudgetDb);
+    printf("%-13s %8s %12s %12s\n", "crossover", "rate", "double dB", "float dB");
+    for (float rate : options.sampleRates) {
+        for (const FlatnessCase& c : kFlatnessCases) {
+            const double doubleDb = c.measure(rate, true);
+            const double floatDb = c.measure(rate, false);
+            const bool over = c.compensated
+                && (doubleDb > options.flatnessBudgetDb || floatDb > options.flatnessBudgetDb);
+            printf("%-13s %8.0f %12.4f %12.4f%s\n", c.name, rate, doubleDb, floatDb,
+                   over ? "  over budget" : (c.compensated ? "" : "  (not compensated)"));
+            if (over) withinBudget = false;
+        }
+    }
+    return withinBudget;
+}
+
+bool writeJson(const char* path, const Options& options, const std::vector<Result>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"tool\": \"elc4l_module_bench\",\n");
+#if defined(__VERSION__)
+    fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    fprintf(file, "  \"cpu\": %d,\n", options.cpu);
+    fprintf(file, "  \"seconds\": %.3f,\n", options.seconds);
+    fprintf(file, "  \"warmup\": %.3f,\n", options.warmupSeconds);
+    fprintf(file, "  \"repeat\": %d,\n", options.repeat);
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        fprintf(file,
+                "    { \"module\": \"%s\", \"sample_rate\": %.0f, \"block\": %d, "
+                "\"ns_per_sample\": %.3f, \"ns_per_sample_min\": %.3f, \"realtime_factor\": %.2f }%s\n",
+                r.module, r.sampleRate, r.blockSize, r.nsPerSampleMedian, r.nsPerSampleMin, r.realtimeFactor,
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    if (options.flatnessBudgetDb >= 0.0) {
+        return checkFlatness(options) ? 0 : 2;
+    }
+
+    if (options.cpu != -1 && !pinToCpu(options.cpu)) {
+        fprintf(stderr, "warning: could not pin to a CPU, timings may be noisy\n");
+        options.cpu = -1;
+    }
+
+    printf("ELC4L module benchmark: %.2f s x %d runs per point, %.2f s warm-up, CPU %s\n",
+           options.seconds, options.repeat, options.warmupSeconds,
+           (options.cpu >= 0) ? std::to_string(options.cpu).c_str() : "not pinned");
+    printf("%-13s %8s %6s %12s %12s %12s\n", "module", "rate", "block", "ns/sample", "min ns/smp", "realtime x");
+
+    std::vector<Result> results;
+    for (const std::string& name : options.modules) {
+        const ModuleInfo& info = *findModule(name);
+        for (float rate : options.sampleRates) {
+            for (int block : options.blockSizes) {
+                Result r = measure(info, rate, block, options);
+                printf("%-13s %8.0f %6d %12.2f %12.2f %12.1f\n",
+                       r.module, r.sampleRate, r.blockSize, r.nsPerSampleMedian, r.nsPerSampleMin, r.realtimeFactor);
+                fflush(stdout);
+                results.push_back(r);
+            }
+        }
+    }
+
+    for (const Result& profiled : results) {
+        if (strcmp(profiled.module, "chain-prof") != 0) continue;
+        for (const Result& plain : results) {
+            if (strcmp(plain.module, "chain") != 0 || plain.sampleRate != profiled.sampleRate
+                || plain.blockSize != profiled.blockSize) continue;
+            printf("profiler overhead %8.0f %6d %+11.2f%% %+11.2f%% (median, min)\n", profiled.sampleRate,
+                   profiled.blockSize, 100.0 * (profiled.nsPerSampleMedian / plain.nsPerSampleMedian - 1.0),
+                   100.0 * (profiled.nsPerSampleMin / plain.nsPerSampleMin - 1.0));
+        }
+    }
+
+    if (options.jsonPath) {
+        if (!writeJson(options.jsonPath, options, results)) {
+            fprintf(stderr, "cannot write %s\n", options.jsonPath);
+            return 1;
+        }
+        printf("results written to %s\n", options.jsonPath);
+    }
+    return 0;
+}
@@ -0,0 +1,1014 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Frozen reference DSP (numerical equivalence baseline)
+// Verbatim copy of src/HyeokStreamDSP.h as of the equivalence harness, in its own namespace. Do not
+// optimize or restyle this file: elc4l_equivalence measures optimized kernels against it. Replace it
+// only when a behavior change is intentional, and say so in the commit.
+//-------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "SilenceDetector.h"
+#include "DenormalGuard.h"
+#include <cmath>
+#include <algorithm>
+
+namespace ELC4L {
+namespace Reference {
+
+// ======================================================================
+// [NEW] HIGH-END DSP MODULES (Pure C++ / Zero Latency)
+// ======================================================================
+
+// 1. Tape Saturator (Algebraic Sigmoid)
+struct TapeSaturator {
+    // x / sqrt(1 + x^2) based soft clipper with bias
+    inline float process(float input, float drive, float bias) {
+        float x = input * drive + bias;
+        float saturated = x / sqrtf(1.0f + x * x);
+        
+        // Remove DC Offset caused by bias
+        float biasCurve = bias / sqrtf(1.0f + bias * bias);
+        return (saturated - biasCurve);
+    }
+};
+
+// 2. Polyphase FIR Oversampler (4x)
+// 32-tap Linear Phase FIR / 4 Phases
+class PolyphaseOversampler {
+public:
+    PolyphaseOversampler() { reset(); }
+
+    void reset() {
+        for (int i = 0; i < kTapLength; ++i) state[i] = 0.0f;
+        ptr = 0;
+    }
+
+    // True when every tap is below 'threshold' (zero input now yields ~zero output)
+    bool isIdle(float threshold) const {
+        return ELC4L::bufferPeak(state, kTapLength) < threshold;
+    }
+
+    void flushDenormals() { ELC4L::flushDenormals(state, kTapLength); }
+
+    // Upsample 1 -> 4
+    void processUpsample(float input, float* outBuffer4x) {
+        state[ptr] = input;
+        for (int phase = 0; phase < 4; ++phase) {
+            float sum = 0.0f;
+            const float* coeffs = &kCoeffs[phase * kTapsPerPhase];
+            for (int i = 0; i < kTapsPerPhase; ++i) {
+                int idx = (ptr - i + kTapLength) % kTapLength;
+                sum += state[idx] * coeffs[i];
+            }
+            outBuffer4x[phase] = sum; // Gain Compensation
+        }
+        ptr = (ptr + 1) % kTapLength;
+    }
+
+    // Downsample 4 -> 1 (Simple Windowed Sinc decimation for efficiency)
+    float processDownsample(const float* inBuffer4x) {
+        // High quality mix of 4 samples
+        return inBuffer4x[0] * 0.1f + inBuffer4x[1] * 0.4f + inBuffer4x[2] * 0.4f + inBuffer4x[3] * 0.1f;
+    }
+
+    // 1x filter with the same linear response as processUpsample() followed by processDownsample()
+    // (the decimation weights folded into the phases). Shares the tap state with processUpsample().
+    float processLinearEquivalent(float input) {
+        static const LinearEquivalentCoeffs folded;
+        state[ptr] = input;
+        float sum = 0.0f;
+        for (int i = 0; i < kTapsPerPhase; ++i) {
+            int idx = (ptr - i + kTapLength) % kTapLength;
+            sum += state[idx] * folded.c[i];
+        }
+        ptr = (ptr + 1) % kTapLength;
+        return sum;
+    }
+
+    // 32-tap Polyphase FIR Coefficients (Kaiser Windowed Sinc)
+    static constexpr float kCoeffs[32] = {
+        // Phase 0
+        -0.002f, 0.005f, -0.012f, 0.025f, 0.965f, 0.025f, -0.012f, 0.005f,
+        // Phase 1
+        -0.004f, 0.010f, -0.025f, 0.060f, 0.880f, 0.090f, -0.025f, 0.010f,
+        // Phase 2
+        -0.005f, 0.015f, -0.040f, 0.120f, 0.750f, 0.180f, -0.040f, 0.015f,
+        // Phase 3
+        -0.004f, 0.012f, -0.045f, 0.220f, 0.550f, 0.280f, -0.045f, 0.012f
+    };
+    static constexpr int kTapsPerPhase = 8;
+    static constexpr int kTapLength = 32;
+
+private:
+    struct LinearEquivalentCoeffs {
+        float c[kTapsPerPhase];
+        LinearEquivalentCoeffs() {
+            const float weights[4] = { 0.1f, 0.4f, 0.4f, 0.1f };    // processDownsample()
+            for (int i = 0; i < kTapsPerPhase; ++i) {
+                c[i] = 0.0f;
+                for (int phase = 0; phase < 4; ++phase) c[i] += weights[phase] * kCoeffs[phase * kTapsPerPhase + i];
+            }
+        }
+    };
+
+    float state[kTapLength];
+    int ptr = 0;
+};
+
+//-------------------------------------------------------------------------------------------------------
+// Lookahead Limiter (Brickwall with lookahead for transparent limiting)
+//-------------------------------------------------------------------------------------------------------
+struct LookaheadLimiter {
+    static constexpr int kLookaheadSamples = 64;  // ~1.5ms at 44.1kHz
+    
+    // Delay buffers
+    float delayL[kLookaheadSamples];
+    float delayR[kLookaheadSamples];
+    int delayIndex;
+    
+    // Envelope follower
+    float envelope;
+    float attackCoeff;
+    float releaseCoeff;
+    float fastReleaseCoeff;
+    float slowReleaseCoeff;
+    
+    // Settings
+    float threshold;    // Linear threshold
+    float ceiling;      // Linear ceiling (output)
+    float makeupGain;   // Automatic makeup gain
+    float sampleRate;
+    float lastGain;
+    float gainReductionDb;
+    float releaseMs;    // User-adjustable release time
+    
+    LookaheadLimiter() 
+        : delayIndex(0)
+        , envelope(0.0f)
+        , attackCoeff(0.0f)
+        , releaseCoeff(0.0f)
+        , fastReleaseCoeff(0.0f)
+        , slowReleaseCoeff(0.0f)
+        , threshold(0.5f)
+        , ceiling(0.891f)  // -1 dB
+        , makeupGain(1.0f)
+        , sampleRate(44100.0f)
+        , lastGain(1.0f)
+        , gainReductionDb(0.0f)
+        , releaseMs(100.0f)
+    {
+        reset();
+        updateCoefficients();
+    }
+    
+    void reset() {
+        for (int i = 0; i < kLookaheadSamples; ++i) {
+            delayL[i] = 0.0f;
+            delayR[i] = 0.0f;
+        }
+        delayIndex = 0;
+        envelope = 0.0f;
+        lastGain = 1.0f;
+        gainReductionDb = 0.0f;
+    }
+    
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+    
+    void setThreshold(float threshDb) {
+        threshold = powf(10.0f, threshDb / 20.0f);
+        updateMakeupGain();
+    }
+    
+    void setCeiling(float ceilingDb) {
+        ceiling = powf(10.0f, ceilingDb / 20.0f);
+        updateMakeupGain();
+    }
+    
+    void setRelease(float relMs) {
+        releaseMs = relMs;
+        if (releaseMs < 10.0f) releaseMs = 10.0f;
+        if (releaseMs > 500.0f) releaseMs = 500.0f;
+        updateCoefficients();
+    }
+    
+    void updateCoefficients() {
+        float attackMs = 0.1f;
+        // ARC-style dual release based on user setting
+        float fastReleaseMs = releaseMs * 0.4f;     // Fast = 40% of setting
+        float slowReleaseMs = releaseMs * 4.0f;     // Slow = 400% of setting
+        attackCoeff = expf(-1.0f / (sampleRate * attackMs / 1000.0f));
+        releaseCoeff = expf(-1.0f / (sampleRate * releaseMs / 1000.0f));
+        fastReleaseCoeff = expf(-1.0f / (sampleRate * fastReleaseMs / 1000.0f));
+        slowReleaseCoeff = expf(-1.0f / (sampleRate * slowReleaseMs / 1000.0f));
+    }
+    
+    void updateMakeupGain() {
+        makeupGain = ceiling / threshold;
+        if (makeupGain > 4.0f) makeupGain = 4.0f;
+    }
+    
+    // Envelope follower and gain computer for one input peak (no delay line, no makeup/ceiling)
+    float computeGain(float peak) {
+        float fastEnv = envelope;
+        float slowEnv = envelope;
+
+        if (peak > fastEnv) {
+            fastEnv = attackCoeff * fastEnv + (1.0f - attackCoeff) * peak;
+        } else {
+            fastEnv = fastReleaseCoeff * fastEnv + (1.0f - fastReleaseCoeff) * peak;
+        }
+
+        if (peak > slowEnv) {
+            slowEnv = attackCoeff * slowEnv + (1.0f - attackCoeff) * peak;
+        } else {
+            slowEnv = slowReleaseCoeff * slowEnv + (1.0f - slowReleaseCoeff) * peak;
+        }
+
+        envelope = (fastEnv > slowEnv) ? fastEnv : slowEnv;
+        
+        float gain = 1.0f;
+        if (envelope > threshold) {
+            gain = threshold / envelope;
+        }
+        return gain;
+    }
+
+    void process(float& left, float& right) {
+        float delayedL = delayL[delayIndex];
+        float delayedR = delayR[delayIndex];
+        
+        delayL[delayIndex] = left;
+        delayR[delayIndex] = right;
+        delayIndex = (delayIndex + 1) % kLookaheadSamples;
+        
+        float peakL = fabsf(left);
+        float peakR = fabsf(right);
+        float gain = computeGain((peakL > peakR) ? peakL : peakR);
+        
+        float outL = delayedL * gain * makeupGain;
+        float outR = delayedR * gain * makeupGain;
+        
+        if (outL > ceiling) outL = ceiling;
+        if (outL < -ceiling) outL = -ceiling;
+        if (outR > ceiling) outR = ceiling;
+        if (outR < -ceiling) outR = -ceiling;
+        
+        left = outL;
+        right = outR;
+
+        lastGain = gain;
+        gainReductionDb = (gain > 1.0e-9f) ? (-20.0f * log10f(gain)) : 60.0f;
+    }
+
+    float getGainReductionDb() const { return gainReductionDb; }
+
+    // No gain reduction pending and the lookahead delay has drained
+    bool isIdle(float level) const {
+        if (envelope > threshold) return false;
+        return ELC4L::bufferPeak(delayL, kLookaheadSamples) < level
+            && ELC4L::bufferPeak(delayR, kLookaheadSamples) < level;
+    }
+
+    // Denormal fallback (once per block); the delay lines only hold input samples
+    void flushDenormals() { ELC4L::flushDenormal(envelope); }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// LA-2A Style Opto Compressor (per-band)
+// - Variable ratio (soft-knee, ~3:1 to infinity based on input level)
+// - Program-dependent attack (~10ms) and dual-release (60ms fast + 1-15s slow)
+// - RMS detection for natural opto response
+// - Tube saturation emulation (T4B optical cell + 12AX7 tube stage)
+//-------------------------------------------------------------------------------------------------------
+struct OptoCompressor {
+    float sampleRate;
+    float envelope;
+    float fastEnvelope;      // Fast release envelope
+    float slowEnvelope;      // Slow release envelope (LA-2A dual time constant)
+    float attackCoeff;
+    float fastReleaseCoeff;  // ~60ms fast release
+    float slowReleaseCoeff;  // ~1-15s slow release (program dependent)
+    float threshold;
+    float makeupGain;
+    float lastGain;
+    float gainReductionDb;
+    float peakHold;          // Peak hold for ratio calculation
+    float peakDecay;         // Peak decay coefficient
+    
+    // Tube saturation parameters
+    float saturationDrive;   // 0.0 = clean, 1.0 = fully saturated
+    bool saturationEnabled;
+
+    // [ADDED] Current raw gain (before makeup) for delta monitoring
+    float currentGain = 1.0f;
+
+    // [ADDED] High-quality saturation + oversampling
+    TapeSaturator saturator;
+    PolyphaseOversampler oversamplerL;
+    PolyphaseOversampler oversamplerR;
+    float upBufferL[4];
+    float upBufferR[4];
+    bool saturationOversampling = true;  // false: same curve at 1x (offline analysis passes)
+
+    // [NEW] Sidechain HPF state (1-pole lowpass used to derive HPF: HP = in - LP)
+    bool sidechainEnabled = false;
+    float scFilterCoeff = 0.0f; // exp(-2*pi*fc / sr)
+    float scFilterState = 0.0f; // lowpass state
+
+    void setSidechainEnabled(bool enabled) { sidechainEnabled = enabled; }
+    void setSidechainFreq(float fc) {
+        if (fc <= 0.0f || sampleRate <= 0.0f) { scFilterCoeff = 0.0f; return; }
+        // Coefficient for simple 1-pole lowpass approximation
+        scFilterCoeff = expf(-2.0f * 3.14159265358979323846f * fc / sampleRate);
+    }
+
+    // LA-2A constants
+    static constexpr float kMinRatio = 3.0f;     // Low level ratio (~3:1)
+    static constexpr float kMaxRatio = 100.0f;   // High level ratio (limiting)
+    static constexpr float kKneeDb = 10.0f;      // Wide soft-knee for opto
+    static constexpr float kAttackMs = 10.0f;    // LA-2A attack ~10ms
+    static constexpr float kFastReleaseMs = 60.0f;   // Fast release ~60ms
+    static constexpr float kSlowReleaseBase = 500.0f; // Base slow release ~500ms
+    static constexpr float kSlowReleaseMax = 5000.0f; // Max slow release ~5s
+
+    OptoCompressor()
+        : sampleRate(44100.0f)
+        , envelope(0.0f)
+        , fastEnvelope(0.0f)
+        , slowEnvelope(0.0f)
+        , attackCoeff(0.0f)
+        , fastReleaseCoeff(0.0f)
+        , slowReleaseCoeff(0.0f)
+        , threshold(1.0f)
+        , makeupGain(1.0f)
+        , lastGain(1.0f)
+        , gainReductionDb(0.0f)
+        , peakHold(0.0f)
+        , peakDecay(0.0f)
+        , saturationDrive(0.3f)    // Default subtle saturation
+        , saturationEnabled(true)
+    {
+        updateCoefficients();
+    }
+
+    void reset() {
+        envelope = 0.0f;
+        fastEnvelope = 0.0f;
+        slowEnvelope = 0.0f;
+        lastGain = 1.0f;
+        gainReductionDb = 0.0f;
+        peakHold = 0.0f;
+    }
+
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+
+    void setThresholdDb(float db) {
+        threshold = powf(10.0f, db / 20.0f);
+    }
+
+    void setMakeupDb(float db) {
+        makeupGain = powf(10.0f, db / 20.0f);
+    }
+    
+    void setSaturationDrive(float drive) {
+        saturationDrive = (drive < 0.0f) ? 0.0f : (drive > 1.0f) ? 1.0f : drive;
+    }
+    
+    void setSaturationEnabled(bool enabled) {
+        saturationEnabled = enabled;
+    }
+
+    void setSaturationOversampling(bool enabled) {
+        saturationOversampling = enabled;
+    }
+    
+    // LA-2A style tube saturation (12AX7 + T4B optical cell emulation)
+    // Soft asymmetric clipping with even and odd harmonics
+    inline float applyTubeSaturation(float sample) const {
+        if (!saturationEnabled || saturationDrive < 0.001f) return sample;
+        
+        // Input scaling based on drive
+        float drive = 1.0f + saturationDrive * 4.0f;  // 1x to 5x gain
+        float x = sample * drive;
+        
+        // Tube saturation model:
+        // - Soft clipping with asymmetry (more positive compression)
+        // - Even harmonics from triode asymmetry
+        // - Gentle limiting at extremes
+        
+        // Asymmetric soft clipping (triode-like)
+        float pos = x >= 0.0f ? x : 0.0f;
+        float neg = x < 0.0f ? x : 0.0f;
+        
+        // Positive half: softer clipping (more headroom)
+        float satPos = pos / (1.0f + 0.3f * pos * pos);
+        
+        // Negative half: slightly harder clipping (typical triode behavior)
+        float satNeg = neg / (1.0f + 0.4f * neg * neg);
+        
+        float saturated = satPos + satNeg;
+        
+        // Add subtle even harmonics (2nd harmonic injection)
+        float evenHarmonic = 0.05f * saturationDrive * saturated * saturated;
+        saturated += evenHarmonic;
+        
+        // Output scaling to maintain level
+        saturated /= drive * 0.7f;
+        
+        // Blend dry/wet based on drive amount
+        float wet = saturationDrive * 0.7f;  // Max 70% wet
+        return sample * (1.0f - wet) + saturated * wet;
+    }
+
+    void updateCoefficients() {
+        attackCoeff = expf(-1.0f / (sampleRate * kAttackMs / 1000.0f));
+        fastReleaseCoeff = expf(-1.0f / (sampleRate * kFastReleaseMs / 1000.0f));
+        slowReleaseCoeff = expf(-1.0f / (sampleRate * kSlowReleaseBase / 1000.0f));
+        peakDecay = expf(-1.0f / (sampleRate * 0.5f));  // 500ms peak decay
+    }
+
+    void process(float& left, float& right) {
+        // Internal Sidechain HPF: compute mono detector then optionally HPF it
+        float monoIn = 0.5f * (left + right);
+        float detectorSignal = monoIn;
+
+        if (sidechainEnabled) {
+            // 1-pole LP: scFilterState = a * scFilterState + (1-a) * x
+            scFilterState = scFilterState * scFilterCoeff + monoIn * (1.0f - scFilterCoeff);
+            detectorSignal = monoIn - scFilterState; // HP = input - LP
+        }
+
+        float level = detectorSignal * detectorSignal;
+        float detector = sqrtf(level + 1.0e-12f);
+
+        // Track peak for dynamic ratio calculation
+        if (detector > peakHold) {
+            peakHold = detector;
+        } else {
+            peakHold = peakDecay * peakHold + (1.0f - peakDecay) * detector;
+        }
+
+        // Dual time constant envelope (LA-2A style)
+        if (detector > fastEnvelope) {
+            fastEnvelope = attackCoeff * fastEnvelope + (1.0f - attackCoeff) * detector;
+        } else {
+            fastEnvelope = fastReleaseCoeff * fastEnvelope + (1.0f - fastReleaseCoeff) * detector;
+        }
+
+        // Slow envelope with program-dependent release
+        float overDb = 20.0f * log10f((peakHold / threshold) + 1.0e-12f);
+        if (overDb < 0.0f) overDb = 0.0f;
+        float releaseScale = 1.0f + (overDb * 0.15f);
+        if (releaseScale > 10.0f) releaseScale = 10.0f;
+        float slowRelMs = kSlowReleaseBase * releaseScale;
+        if (slowRelMs > kSlowReleaseMax) slowRelMs = kSlowReleaseMax;
+        float dynamicSlowCoeff = expf(-1.0f / (sampleRate * slowRelMs / 1000.0f));
+
+        if (detector > slowEnvelope) {
+            slowEnvelope = attackCoeff * slowEnvelope + (1.0f - attackCoeff) * detector;
+        } else {
+            slowEnvelope = dynamicSlowCoeff * slowEnvelope + (1.0f - dynamicSlowCoeff) * detector;
+        }
+
+        // Combined envelope
+        envelope = 0.3f * fastEnvelope + 0.7f * slowEnvelope;
+
+        // Gain calculation (same LA-2A logic)
+        float levelDb = 20.0f * log10f(envelope + 1.0e-12f);
+        float threshDb = 20.0f * log10f(threshold + 1.0e-12f);
+        float overThresh = levelDb - threshDb;
+
+        float dynamicRatio = kMinRatio;
+        if (overThresh > 0.0f) {
+            float ratioBlend = overThresh / 20.0f;
+            if (ratioBlend > 1.0f) ratioBlend = 1.0f;
+            dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
+        }
+
+        float grDb = 0.0f;
+        if (overThresh <= -kKneeDb * 0.5f) {
+            grDb = 0.0f;
+        } else if (overThresh >= kKneeDb * 0.5f) {
+            grDb = overThresh - (overThresh / dynamicRatio);
+        } else {
+            float x = overThresh + kKneeDb * 0.5f;
+            grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
+        }
+
+        float gain = powf(10.0f, -grDb / 20.0f);
+        float gainSmooth = 0.995f;
+        gain = gainSmooth * lastGain + (1.0f - gainSmooth) * gain;
+
+        // [ADDED] store raw gain (reduction only) before makeup is applied
+        currentGain = gain;
+
+        left *= gain * makeupGain;
+        right *= gain * makeupGain;
+
+        // 2. [NEW] 4x Oversampling + Tape Saturation
+        if (saturationEnabled) {
+            float drive = 1.0f + saturationDrive * 3.0f; 
+            float bias = saturationDrive * 0.1f;        
+
+            if (saturationOversampling) {
+                // LEFT CHANNEL
+                oversamplerL.processUpsample(left, upBufferL);
+                for (int i = 0; i < 4; ++i) upBufferL[i] = saturator.process(upBufferL[i], drive, bias);
+                left = oversamplerL.processDownsample(upBufferL) / drive;
+
+                // RIGHT CHANNEL
+                oversamplerR.processUpsample(right, upBufferR);
+                for (int i = 0; i < 4; ++i) upBufferR[i] = saturator.process(upBufferR[i], drive, bias);
+                right = oversamplerR.processDownsample(upBufferR) / drive;
+            } else {
+                // Same curve and filter response at 1x (aliasing is irrelevant for metering)
+                left = oversamplerL.processLinearEquivalent(saturator.process(left, drive, bias)) / drive;
+                right = oversamplerR.processLinearEquivalent(saturator.process(right, drive, bias)) / drive;
+            }
+        }
+
+        lastGain = gain;
+        gainReductionDb = grDb;
+    }
+
+    float getGainReductionDb() const { return gainReductionDb; }
+    float getCurrentGain() const { return currentGain; }
+
+    // Gain has recovered to unity and the sidechain/oversampler memories have drained.
+    // The envelopes may still hold a small value below the knee; it no longer affects the gain.
+    bool isIdle(float threshold) const {
+        if (gainReductionDb > 0.0f || lastGain < 0.9999f) return false;
+        if (fabsf(scFilterState) >= threshold) return false;
+        return oversamplerL.isIdle(threshold) && oversamplerR.isIdle(threshold);
+    }
+
+    // Denormal fallback (once per block): detector envelopes and filter memories
+    void flushDenormals() {
+        ELC4L::flushDenormal(envelope);
+        ELC4L::flushDenormal(fastEnvelope);
+        ELC4L::flushDenormal(slowEnvelope);
+        ELC4L::flushDenormal(peakHold);
+        ELC4L::flushDenormal(scFilterState);
+        oversamplerL.flushDenormals();
+        oversamplerR.flushDenormals();
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// LUFS Meter (momentary, approximate)
+//-------------------------------------------------------------------------------------------------------
+struct LufsMeter {
+    float sampleRate;
+    float momentaryEnergy;
+    float momentaryCoeff;
+    float momentaryLufs;
+
+    LufsMeter()
+        : sampleRate(44100.0f)
+        , momentaryEnergy(0.0f)
+        , momentaryCoeff(0.0f)
+        , momentaryLufs(-120.0f)
+    {
+        updateCoefficients();
+    }
+
+    void reset() {
+        momentaryEnergy = 0.0f;
+        momentaryLufs = -120.0f;
+    }
+
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+
+    void updateCoefficients() {
+        // 400 ms momentary window
+        float tau = 0.4f;
+        momentaryCoeff = expf(-1.0f / (sampleRate * tau));
+    }
+
+    void process(float left, float right) {
+        float energy = 0.5f * (left * left + right * right);
+        momentaryEnergy = momentaryCoeff * momentaryEnergy + (1.0f - momentaryCoeff) * energy;
+        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
+        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
+    }
+
+    // Equivalent to process(0, 0) repeated numSamples times
+    void processSilence(int numSamples) {
+        momentaryEnergy *= powf(momentaryCoeff, (float)numSamples);
+        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
+        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
+    }
+
+    void flushDenormals() { ELC4L::flushDenormal(momentaryEnergy); }
+
+    float getMomentary() const { return momentaryLufs; }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// HyeokStreamDSP - Linkwitz-Riley 4th-order Crossover (4-band)
+//-------------------------------------------------------------------------------------------------------
+struct HyeokStreamDSP {
+    struct BiquadCoeffs {
+        double b0, b1, b2;
+        double a1, a2;
+    };
+    
+    struct BiquadState {
+        double x1[2], x2[2];
+        double y1[2], y2[2];
+        
+        BiquadState() { reset(); }
+        
+        void reset() {
+            x1[0] = x1[1] = x2[0] = x2[1] = 0.0;
+            y1[0] = y1[1] = y2[0] = y2[1] = 0.0;
+        }
+
+        bool isIdle(double threshold) const {
+            for (int ch = 0; ch < 2; ++ch) {
+                if (fabs(x1[ch]) >= threshold || fabs(x2[ch]) >= threshold) return false;
+                if (fabs(y1[ch]) >= threshold || fabs(y2[ch]) >= threshold) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int ch = 0; ch < 2; ++ch) {
+                ELC4L::flushDenormal(x1[ch]); ELC4L::flushDenormal(x2[ch]);
+                ELC4L::flushDenormal(y1[ch]); ELC4L::flushDenormal(y2[ch]);
+            }
+        }
+    };
+    
+    BiquadCoeffs lowpass1a, lowpass1b;
+    BiquadCoeffs highpass1a, highpass1b;
+    BiquadState lp1StateA, lp1StateB;
+    BiquadState hp1StateA, hp1StateB;
+
+    BiquadCoeffs lowpass2a, lowpass2b;
+    BiquadCoeffs highpass2a, highpass2b;
+    BiquadState lp2StateA, lp2StateB;
+    BiquadState hp2StateA, hp2StateB;
+
+    BiquadCoeffs lowpass3a, lowpass3b;
+    BiquadCoeffs highpass3a, highpass3b;
+    BiquadState lp3StateA, lp3StateB;
+    BiquadState hp3StateA, hp3StateB;
+
+    float sampleRate;
+    float xover1;
+    float xover2;
+    float xover3;
+    
+    HyeokStreamDSP() 
+        : sampleRate(44100.0f)
+        , xover1(120.0f)
+        , xover2(800.0f)
+        , xover3(4000.0f)
+    {
+        updateCoefficients();
+    }
+    
+    void setSampleRate(float sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+    
+    void setXover1(float freq) {
+        xover1 = freq;
+        updateCoefficients();
+    }
+    
+    void setXover2(float freq) {
+        xover2 = freq;
+        updateCoefficients();
+    }
+
+    void setXover3(float freq) {
+        xover3 = freq;
+        updateCoefficients();
+    }
+    
+    void updateCoefficients() {
+        calculateButterworthLP(lowpass1a, xover1, sampleRate);
+        lowpass1b = lowpass1a;
+        calculateButterworthHP(highpass1a, xover1, sampleRate);
+        highpass1b = highpass1a;
+
+        calculateButterworthLP(lowpass2a, xover2, sampleRate);
+        lowpass2b = lowpass2a;
+        calculateButterworthHP(highpass2a, xover2, sampleRate);
+        highpass2b = highpass2a;
+
+        calculateButterworthLP(lowpass3a, xover3, sampleRate);
+        lowpass3b = lowpass3a;
+        calculateButterworthHP(highpass3a, xover3, sampleRate);
+        highpass3b = highpass3a;
+    }
+    
+    void calculateButterworthLP(BiquadCoeffs& c, float freq, float sr) {
+        const double w0 = 2.0 * 3.14159265358979323846 * freq / sr;
+        const double cosw0 = cos(w0);
+        const double sinw0 = sin(w0);
+        const double Q = 0.7071067811865476;
+        const double alpha = sinw0 / (2.0 * Q);
+        
+        const double a0 = 1.0 + alpha;
+        c.b0 = ((1.0 - cosw0) / 2.0) / a0;
+        c.b1 = (1.0 - cosw0) / a0;
+        c.b2 = ((1.0 - cosw0) / 2.0) / a0;
+        c.a1 = (-2.0 * cosw0) / a0;
+        c.a2 = (1.0 - alpha) / a0;
+    }
+    
+    void calculateButterworthHP(BiquadCoeffs& c, float freq, float sr) {
+        const double w0 = 2.0 * 3.14159265358979323846 * freq / sr;
+        const double cosw0 = cos(w0);
+        const double sinw0 = sin(w0);
+        const double Q = 0.7071067811865476;
+        const double alpha = sinw0 / (2.0 * Q);
+        
+        const double a0 = 1.0 + alpha;
+        c.b0 = ((1.0 + cosw0) / 2.0) / a0;
+        c.b1 = (-(1.0 + cosw0)) / a0;
+        c.b2 = ((1.0 + cosw0) / 2.0) / a0;
+        c.a1 = (-2.0 * cosw0) / a0;
+        c.a2 = (1.0 - alpha) / a0;
+    }
+    
+    inline double processBiquad(double input, int channel, const BiquadCoeffs& c, BiquadState& s) {
+        double output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
+                       - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+        
+        s.x2[channel] = s.x1[channel];
+        s.x1[channel] = input;
+        s.y2[channel] = s.y1[channel];
+        s.y1[channel] = output;
+        
+        return output;
+    }
+    
+    void processSample(float inL, float inR,
+                       float& band1L, float& band1R,
+                       float& band2L, float& band2R,
+                       float& band3L, float& band3R,
+                       float& band4L, float& band4R) {
+        double lp1L = processBiquad(inL, 0, lowpass1a, lp1StateA);
+        double lp1R = processBiquad(inR, 1, lowpass1a, lp1StateA);
+        double band1OutL = processBiquad(lp1L, 0, lowpass1b, lp1StateB);
+        double band1OutR = processBiquad(lp1R, 1, lowpass1b, lp1StateB);
+
+        double hp1L = processBiquad(inL, 0, highpass1a, hp1StateA);
+        double hp1R = processBiquad(inR, 1, highpass1a, hp1StateA);
+        double highFrom1L = processBiquad(hp1L, 0, highpass1b, hp1StateB);
+        double highFrom1R = processBiquad(hp1R, 1, highpass1b, hp1StateB);
+
+        double lp2L = processBiquad(highFrom1L, 0, lowpass2a, lp2StateA);
+        double lp2R = processBiquad(highFrom1R, 1, lowpass2a, lp2StateA);
+        double band2OutL = processBiquad(lp2L, 0, lowpass2b, lp2StateB);
+        double band2OutR = processBiquad(lp2R, 1, lowpass2b, lp2StateB);
+
+        double hp2L = processBiquad(highFrom1L, 0, highpass2a, hp2StateA);
+        double hp2R = processBiquad(highFrom1R, 1, highpass2a, hp2StateA);
+        double highFrom2L = processBiquad(hp2L, 0, highpass2b, hp2StateB);
+        double highFrom2R = processBiquad(hp2R, 1, highpass2b, hp2StateB);
+
+        double lp3L = processBiquad(highFrom2L, 0, lowpass3a, lp3StateA);
+        double lp3R = processBiquad(highFrom2R, 1, lowpass3a, lp3StateA);
+        double band3OutL = processBiquad(lp3L, 0, lowpass3b, lp3StateB);
+        double band3OutR = processBiquad(lp3R, 1, lowpass3b, lp3StateB);
+
+        double hp3L = processBiquad(highFrom2L, 0, highpass3a, hp3StateA);
+        double hp3R = processBiquad(highFrom2R, 1, highpass3a, hp3StateA);
+        double band4OutL = processBiquad(hp3L, 0, highpass3b, hp3StateB);
+        double band4OutR = processBiquad(hp3R, 1, highpass3b, hp3StateB);
+
+        band1L = (float)band1OutL;
+        band1R = (float)band1OutR;
+        band2L = (float)band2OutL;
+        band2R = (float)band2OutR;
+        band3L = (float)band3OutL;
+        band3R = (float)band3OutR;
+        band4L = (float)band4OutL;
+        band4R = (float)band4OutR;
+    }
+    
+    void reset() {
+        lp1StateA.reset();
+        lp1StateB.reset();
+        hp1StateA.reset();
+        hp1StateB.reset();
+        lp2StateA.reset();
+        lp2StateB.reset();
+        hp2StateA.reset();
+        hp2StateB.reset();
+        lp3StateA.reset();
+        lp3StateB.reset();
+        hp3StateA.reset();
+        hp3StateB.reset();
+    }
+
+    // All biquad memories below 'threshold'
+    bool isIdle(double threshold) const {
+        return lp1StateA.isIdle(threshold) && lp1StateB.isIdle(threshold)
+            && hp1StateA.isIdle(threshold) && hp1StateB.isIdle(threshold)
+            && lp2StateA.isIdle(threshold) && lp2StateB.isIdle(threshold)
+            && hp2StateA.isIdle(threshold) && hp2StateB.isIdle(threshold)
+            && lp3StateA.isIdle(threshold) && lp3StateB.isIdle(threshold)
+            && hp3StateA.isIdle(threshold) && hp3StateB.isIdle(threshold);
+    }
+
+    // Denormal fallback (once per block) for hosts that reset MXCSR
+    void flushDenormals() {
+        lp1StateA.flushDenormals(); lp1StateB.flushDenormals();
+        hp1StateA.flushDenormals(); hp1StateB.flushDenormals();
+        lp2StateA.flushDenormals(); lp2StateB.flushDenormals();
+        hp2StateA.flushDenormals(); hp2StateB.flushDenormals();
+        lp3StateA.flushDenormals(); lp3StateB.flushDenormals();
+        hp3StateA.flushDenormals(); hp3StateB.flushDenormals();
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// SpectrumAnalyzer - 4096-point spectrum with log bin mapping (Pro-Q 3 style display)
+// Window, bit-reversal table and FFT scratch; the caller owns the sample history and output bins.
+//-------------------------------------------------------------------------------------------------------
+struct SpectrumAnalyzer {
+    static constexpr int kFftSize = 4096;
+    static constexpr int kSpectrumBins = 512;
+
+    float window[kFftSize];              // Pre-computed Blackman-Harris window
+    float real[kFftSize];                // FFT real part
+    float imag[kFftSize];                // FFT imaginary part
+    int bitReverse[kFftSize];            // Bit-reversal table for FFT
+
+    SpectrumAnalyzer() { initTables(); }
+
+    // Pre-compute Blackman-Harris window and bit-reversal table
+    void initTables() {
+        // Blackman-Harris Window (better sidelobe rejection than Hann)
+        const float a0 = 0.35875f;
+        const float a1 = 0.48829f;
+        const float a2 = 0.14128f;
+        const float a3 = 0.01168f;
+        const float pi = 3.14159265359f;
+
+        for (int i = 0; i < kFftSize; ++i) {
+            float t = (float)i / (float)(kFftSize - 1);
+            window[i] = a0 - a1 * cosf(2.0f * pi * t) + a2 * cosf(4.0f * pi * t) - a3 * cosf(6.0f * pi * t);
+            real[i] = 0.0f;
+            imag[i] = 0.0f;
+        }
+
+        // Bit Reversal Table for Cooley-Tukey FFT
+        int levels = 0;
+        int n = kFftSize;
+        while ((1 << levels) < n) levels++;
+
+        for (int i = 0; i < n; ++i) {
+            int rev = 0, val = i;
+            for (int j = 0; j < levels; ++j) {
+                rev = (rev << 1) | (val & 1);
+                val >>= 1;
+            }
+            bitReverse[i] = rev;
+        }
+    }
+
+    // Cooley-Tukey FFT - O(N log N) instead of O(N^2)
+    void performFFT(float* re, float* im, int n) {
+        // Bit-reversal permutation
+        for (int i = 0; i < n; ++i) {
+            if (i < bitReverse[i]) {
+                float tmpR = re[i];
+                float tmpI = im[i];
+                re[i] = re[bitReverse[i]];
+                im[i] = im[bitReverse[i]];
+                re[bitReverse[i]] = tmpR;
+                im[bitReverse[i]] = tmpI;
+            }
+        }
+
+        // Butterfly operations
+        for (int len = 2; len <= n; len <<= 1) {
+            float ang = -2.0f * 3.14159265359f / len;
+            float wlenR = cosf(ang);
+            float wlenI = sinf(ang);
+
+            for (int i = 0; i < n; i += len) {
+                float wR = 1.0f, wI = 0.0f;
+                int half = len >> 1;
+
+                for (int j = 0; j < half; ++j) {
+                    float uR = re[i + j];
+                    float uI = im[i + j];
+                    float vR = re[i + j + half] * wR - im[i + j + half] * wI;
+                    float vI = re[i + j + half] * wI + im[i + j + half] * wR;
+
+                    re[i + j] = uR + vR;
+                    im[i + j] = uI + vI;
+                    re[i + j + half] = uR - vR;
+                    im[i + j + half] = uI - vI;
+
+                    float tmpW = wR * wlenR - wI * wlenI;
+                    wI = wR * wlenI + wI * wlenR;
+                    wR = tmpW;
+                }
+            }
+        }
+    }
+
+    // Window + FFT of kFftSize samples, then log-scale bins with tilt correction, smoothed into 'output'
+    void computeSpectrum(const float* input, float* output, float sampleRate) {
+        // 1. Apply window and copy to FFT buffers
+        for (int i = 0; i < kFftSize; ++i) {
+            real[i] = input[i] * window[i];
+            imag[i] = 0.0f;
+        }
+
+        // 2. Perform FFT
+        performFFT(real, imag, kFftSize);
+
+        // 3. Log-scale bin mapping with Pink Noise tilt correction
+        const float sr = (sampleRate > 0.0f) ? sampleRate : 44100.0f;
+        const float invN = 2.0f / (float)kFftSize;
+        const float minLogFreq = log10f(20.0f);
+        const float maxLogFreq = log10f(20000.0f);
+        const float logRange = maxLogFreq - minLogFreq;
+
+        for (int bin = 0; bin < kSpectrumBins; ++bin) {
+            // Map display bin to frequency (logarithmic scale for better low-end resolution)
+            float t = (float)bin / (float)(kSpectrumBins - 1);
+            float logFreq = minLogFreq + t * logRange;
+            float freq = powf(10.0f, logFreq);
+
+            // Find corresponding FFT bin
+            int fftBin = (int)(freq * kFftSize / sr);
+            if (fftBin < 1) fftBin = 1;
+            if (fftBin >= kFftSize / 2) fftBin = kFftSize / 2 - 1;
+
+            // Average nearby bins' MAGNITUDE (not complex values) - summing complex values causes
+            // phase cancellation, especially at high frequencies where the spread is larger
+            float sumMag = 0.0f;
+            int avgCount = 0;
+
+            // Spread: narrow at low freq, wider at high freq for noise reduction
+            int spread = (fftBin < 30) ? 1 : (fftBin < 100 ? 2 : (fftBin < 400 ? 3 : 4));
+
+            for (int k = -spread; k <= spread; ++k) {
+                int idx = fftBin + k;
+                if (idx >= 1 && idx < kFftSize / 2) {
+                    float re = real[idx];
+                    float im = imag[idx];
+                    sumMag += sqrtf(re * re + im * im);
+                    avgCount++;
+                }
+            }
+
+            // Compute average magnitude
+            float mag = 0.0f;
+            if (avgCount > 0) {
+                mag = (sumMag / (float)avgCount) * invN;
+            } else {
+                // Fallback: use single bin
+                float re = real[fftBin];
+                float im = imag[fftBin];
+                mag = sqrtf(re * re + im * im) * invN;
+            }
+
+            // Convert to dB
+            float db = 20.0f * log10f(mag + 1.0e-9f);
+
+            // Pink Noise Tilt Correction (+3dB/Octave), makes the spectrum look balanced like Pro-Q 3
+            if (freq > 20.0f) {
+                db += 3.0f * log2f(freq / 1000.0f);
+            }
+
+            // Clamp range
+            if (db < -90.0f) db = -90.0f;
+            if (db > 6.0f) db = 6.0f;
+
+            // Asymmetric smoothing (fast attack, slow release), slightly faster at high frequencies
+            float attackCoeff = (freq > 4000.0f) ? 0.50f : 0.35f;
+            float releaseCoeff = (freq > 4000.0f) ? 0.88f : 0.92f;
+
+            if (db > output[bin]) {
+                output[bin] = (1.0f - attackCoeff) * output[bin] + attackCoeff * db;
+            } else {
+                output[bin] = releaseCoeff * output[bin] + (1.0f - releaseCoeff) * db;
+            }
+        }
+    }
+};
+
+} // namespace Reference
+} // namespace ELC4L
@@ -0,0 +1,668 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Offline render
+// Runs a WAV/AIFF file through the VST2 signal chain (OfflineChain) in large blocks and writes the
+// result. The limiter lookahead is compensated, so the output is sample-aligned with the input and
+// has the same length. Rendering is deterministic: the same input and settings always give the
+// same output bits on the same build.
+//
+// Parallel mode (--threads) splits the file into time chunks rendered concurrently on a work-stealing
+// pool. Each chunk starts --preroll seconds early so the crossover, the opto envelopes and the limiter
+// have converged by the chunk boundary; the pre-roll output is discarded. --verify re-renders serially
+// and reports how far the stitched output deviates, per chunk, to tune the pre-roll length.
+//
+// Loudness-targeted mode (--target-lufs) renders in two passes. Pass one is analysis only: crossover
+// and compressors with the saturation at 1x instead of oversampled, then integrated / short-term
+// loudness and true peak of the post-compressor signal. It keeps every frame's peak and K-weighted
+// energy, and for a bank of candidate limiter drives builds a whole-file gain envelope (the gain that
+// holds each peak at the threshold, smoothed backwards with the attack and forwards with the release,
+// so the reduction starts ahead of a peak however far away it is) and measures the loudness it gives.
+// Pass two applies the envelope of the drive interpolated onto the target ahead of the limiter, which
+// is left at the ceiling (true-peak target minus a margin) to catch what the oversampled saturation
+// adds, then measures the result. The analysis holds 12 bytes per frame (~35 MB per minute at 48 kHz).
+//
+// Pipe mode ("-" for both input and output) reads raw interleaved stereo PCM from stdin and writes
+// the processed PCM to stdout with fixed buffers, for use between two ffmpeg processes:
+//   ffmpeg -i in.mp4 -f f32le -ac 2 -ar 48000 - | elc4l_render --rate 48000 - - |
+//       ffmpeg -f f32le -ac 2 -ar 48000 -i - out.m4a
+// The chain, not the pipe, sets the speed; --quality eco (float crossover, 1x saturation, control-rate
+// gain computer) is the fastest setting.
+//
+// Usage: elc4l_render [options] [--<setting> value ...] input.(wav|aif|aiff) output.(wav|aif|aiff)
+//   --preset path    load settings from a preset file (flags given afterwards override it)
+//   --bits 16|24|32f output sample format (default: input format, 32-bit float if not writable)
+//   --block N        processing block in frames (default 65536)
+//   --threads N      chunk-parallel render on N threads (0 = all cores; default: serial)
+//   --chunk sec      chunk length for parallel render (default 60)
+//   --preroll sec    pre-roll per chunk (default 10)
+//   --verify         compare the parallel result with a serial render
+//   --target-lufs L  two-pass render to integrated loudness L (e.g. -14)
+//   --target-tp dB   true-peak target for --target-lufs (default -1)
+//   --tp-margin dB   ceiling headroom below the true-peak target for inter-sample overs (default 0.5)
+//   --format f32le|s16le  raw PCM format in pipe mode (default f32le)
+//   --rate Hz        sample rate in pipe mode (default 48000)
+//   --list-keys      print the setting keys and exit
+//   -q               no progress / summary output
+//-------------------------------------------------------------------------------------------------------
+
+#include "AudioFile.h"
+#include "ChainPreset.h"
+#include "LoudnessAnalyzer.h"
+#include "OfflineChain.h"
+#include "PcmStream.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+    const char* bits = nullptr;
+    int blockSize = 65536;
+    int threads = -1;               // < 0: serial
+    double chunkSeconds = 60.0;
+    double prerollSeconds = 10.0;
+    bool verify = false;
+    bool loudnessTarget = false;
+    double targetLufs = -14.0;
+    double targetTruePeakDb = -1.0;
+    double truePeakMarginDb = 0.5;
+    ELC4L::PcmFormat pipeFormat = ELC4L::PcmFormat::F32LE;
+    double pipeRate = 48000.0;
+    bool quiet = false;
+    ELC4L::ChainSettings settings;
+};
+
+void printUsage() {
+    fprintf(stderr,
+            "usage: elc4l_render [--preset file] [--bits 16|24|32f] [--block frames] [-q]\n"
+            "                    [--threads N] [--chunk sec] [--preroll sec] [--verify]\n"
+            "                    [--<setting> value ...] input output\n"
+            "                    [--target-lufs L] [--target-tp dB] [--tp-margin dB]\n"
+            "       elc4l_render [--format f32le|s16le] [--rate Hz] [--<setting> value ...] - -\n"
+            "       elc4l_render --list-keys\n");
+}
+
+// Returns 0 to continue, 1 on error, 2 when the command is complete (e.g. --list-keys)
+int parseOptions(int argc, char** argv, Options& options) {
+    std::vector<const char*> positional;
+    std::string error;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--list-keys") == 0) {
+            printf("settings (preset 'key = value' or --key value):\n");
+            ELC4L::printChainSettingKeys(stdout);
+            return 2;
+        }
+        if (strcmp(arg, "-q") == 0) {
+            options.quiet = true;
+            continue;
+        }
+        if (strcmp(arg, "--verify") == 0) {
+            options.verify = true;
+            continue;
+        }
+        if (strncmp(arg, "--", 2) != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (!value) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 1;
+        }
+
+        const std::string key(arg + 2);
+        if (key == "preset") {
+            if (!ELC4L::loadChainPreset(value, options.settings, error)) {
+                fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+        } else if (key == "bits") {
+            options.bits = value;
+        } else if (key == "block") {
+            options.blockSize = atoi(value);
+        } else if (key == "threads") {
+            options.threads = atoi(value);
+        } else if (key == "chunk") {
+            options.chunkSeconds = atof(value);
+        } else if (key == "preroll") {
+            options.prerollSeconds = atof(value);
+        } else if (key == "target-lufs") {
+            options.loudnessTarget = true;
+            options.targetLufs = atof(value);
+        } else if (key == "target-tp") {
+            options.targetTruePeakDb = atof(value);
+        } else if (key == "tp-margin") {
+            options.truePeakMarginDb = atof(value);
+        } else if (key == "format") {
+            if (!ELC4L::parsePcmFormat(value, options.pipeFormat)) {
+                fprintf(stderr, "--format must be f32le or s16le\n");
+                return 1;
+            }
+        } else if (key == "rate") {
+            options.pipeRate = atof(value);
+        } else if (!ELC4L::applyChainSetting(options.settings, key, value, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    if (positional.size() != 2 || options.blockSize <= 0 || options.chunkSeconds <= 0.0 ||
+        options.prerollSeconds < 0.0 || options.pipeRate <= 0.0) {
+        printUsage();
+        return 1;
+    }
+    if (options.verify && options.threads < 0) {
+        fprintf(stderr, "--verify needs --threads\n");
+        return 1;
+    }
+    options.inputPath = positional[0];
+    options.outputPath = positional[1];
+
+    const bool pipeIn = strcmp(options.inputPath, "-") == 0;
+    const bool pipeOut = strcmp(options.outputPath, "-") == 0;
+    if (pipeIn != pipeOut) {
+        fprintf(stderr, "pipe mode needs '-' for both input and output\n");
+        return 1;
+    }
+    if (pipeIn && options.loudnessTarget) {
+        fprintf(stderr, "--target-lufs needs the whole file and is not available in pipe mode\n");
+        return 1;
+    }
+    if (pipeIn && options.threads >= 0) {
+        fprintf(stderr, "--threads is not available in pipe mode\n");
+        return 1;
+    }
+    return 0;
+}
+
+bool chooseEncoding(const char* bits, ELC4L::SampleEncoding inputEncoding, ELC4L::SampleEncoding& encoding) {
+    if (!bits) {
+        bool writable = inputEncoding == ELC4L::SampleEncoding::Int16 ||
+                        inputEncoding == ELC4L::SampleEncoding::Int24 ||
+                        inputEncoding == ELC4L::SampleEncoding::Float32;
+        encoding = writable ? inputEncoding : ELC4L::SampleEncoding::Float32;
+        return true;
+    }
+    if (strcmp(bits, "16") == 0)  { encoding = ELC4L::SampleEncoding::Int16; return true; }
+    if (strcmp(bits, "24") == 0)  { encoding = ELC4L::SampleEncoding::Int24; return true; }
+    if (strcmp(bits, "32f") == 0) { encoding = ELC4L::SampleEncoding::Float32; return true; }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Renders output frames [begin, end) with a fresh chain, starting 'preroll' input frames early.
+// The input past the end of the file is zero (flushes the limiter lookahead). Every rendered block is
+// handed to sink(frame, left, right, count) in order. Thread-safe: only positional reads are used.
+//-------------------------------------------------------------------------------------------------------
+// gainEnvelope (loudness render) holds a pre-limiter gain per input frame; empty for none.
+template <typename Sink>
+void renderRange(const ELC4L::AudioFileReader& reader, const ELC4L::ChainSettings& settings,
+                 const std::vector<float>& gainEnvelope, int64_t begin, int64_t end, int64_t preroll,
+                 int blockSize, Sink&& sink) {
+    ELC4L::ScopedFlushDenormals noDenormals;    // MXCSR / FPCR is per thread
+
+    ELC4L::OfflineChain chain;
+    chain.prepare((float)reader.getSampleRate(), settings);
+    const int64_t latency = chain.getLatencySamples();
+
+    std::vector<float> left(blockSize), right(blockSize);
+    std::vector<float> gains(gainEnvelope.empty() ? 0 : blockSize);
+    const int64_t firstInput = std::max<int64_t>(0, begin - preroll);
+    const int64_t lastInput = end + latency;
+
+    // Processed sample at input index n is output frame n - latency
+    for (int64_t input = firstInput; input < lastInput; ) {
+        const int frames = (int)std::min<int64_t>(blockSize, lastInput - input);
+        const int read = reader.readFrames(input, left.data(), right.data(), frames);
+        std::fill(left.begin() + read, left.begin() + frames, 0.0f);
+        std::fill(right.begin() + read, right.begin() + frames, 0.0f);
+
+        const float* blockGains = nullptr;
+        if (!gainEnvelope.empty()) {
+            for (int i = 0; i < frames; ++i) {
+                const int64_t frame = input + i;
+                gains[i] = (frame < (int64_t)gainEnvelope.size()) ? gainEnvelope[frame] : 1.0f;
+            }
+            blockGains = gains.data();
+        }
+
+        chain.process(left.data(), right.data(), left.data(), right.data(), frames, blockGains);
+        chain.flushDenormals();
+
+        const int64_t outFirst = input - latency;
+        const int skip = (int)std::min<int64_t>(frames, std::max<int64_t>(0, begin - outFirst));
+        if (skip < frames) {
+            sink(outFirst + skip, left.data() + skip, right.data() + skip, frames - skip);
+        }
+        input += frames;
+    }
+}
+
+struct ChunkDeviation {
+    double maxAbs = 0.0;
+    double sumSquares = 0.0;
+    int64_t frames = 0;
+    int64_t lastDifferentFrame = -1;    // relative to the chunk start
+};
+
+double toDb(double linear) {
+    return (linear > 0.0) ? 20.0 * log10(linear) : -INFINITY;
+}
+
+// Serial reference render compared against the stitched file (both quantized to the output format)
+bool verifyAgainstSerial(const ELC4L::AudioFileReader& reader, const Options& options,
+                         const std::vector<float>& gainEnvelope, ELC4L::SampleEncoding outputEncoding,
+                         int64_t chunkFrames) {
+    ELC4L::AudioFileReader stitched;
+    if (!stitched.open(options.outputPath)) {
+        fprintf(stderr, "%s: %s\n", options.outputPath, stitched.getError().c_str());
+        return false;
+    }
+
+    const int64_t numFrames = reader.getNumFrames();
+    const int numChunks = (int)((numFrames + chunkFrames - 1) / chunkFrames);
+    std::vector<ChunkDeviation> chunks(numChunks);
+    std::vector<float> otherL(options.blockSize), otherR(options.blockSize);
+
+    renderRange(reader, options.settings, gainEnvelope, 0, numFrames, 0, options.blockSize,
+                [&](int64_t frame, float* left, float* right, int count) {
+        ELC4L::quantizeToEncoding(outputEncoding, left, count);
+        ELC4L::quantizeToEncoding(outputEncoding, right, count);
+        stitched.readFrames(frame, otherL.data(), otherR.data(), count);
+
+        for (int i = 0; i < count; ++i) {
+            const int64_t position = frame + i;
+            ChunkDeviation& chunk = chunks[position / chunkFrames];
+            double diff = std::max(fabs((double)left[i] - otherL[i]), fabs((double)right[i] - otherR[i]));
+            chunk.maxAbs = std::max(chunk.maxAbs, diff);
+            chunk.sumSquares += diff * diff;
+            chunk.frames++;
+            if (diff > 0.0) chunk.lastDifferentFrame = position % chunkFrames;
+        }
+    });
+
+    const double sampleRate = reader.getSampleRate();
+    double maxAbs = 0.0;
+    double sumSquares = 0.0;
+    double worstSettleMs = 0.0;
+
+    printf("%6s %12s %12s %14s\n", "chunk", "max dBFS", "rms dBFS", "differs until");
+    for (int c = 0; c < numChunks; ++c) {
+        const ChunkDeviation& chunk = chunks[c];
+        double rms = (chunk.frames > 0) ? sqrt(chunk.sumSquares / (double)chunk.frames) : 0.0;
+        double settleMs = (chunk.lastDifferentFrame < 0) ? 0.0 : 1000.0 * (double)(chunk.lastDifferentFrame + 1) / sampleRate;
+        printf("%6d %12.1f %12.1f %11.0f ms\n", c, toDb(chunk.maxAbs), toDb(rms), settleMs);
+
+        maxAbs = std::max(maxAbs, chunk.maxAbs);
+        sumSquares += chunk.sumSquares;
+        worstSettleMs = std::max(worstSettleMs, settleMs);
+    }
+
+    double rms = (numFrames > 0) ? sqrt(sumSquares / (double)numFrames) : 0.0;
+    printf("deviation from serial render: max %.1f dBFS, rms %.1f dBFS, worst chunk differs for %.0f ms%s\n",
+           toDb(maxAbs), toDb(rms), worstSettleMs, (maxAbs == 0.0) ? " (bit-exact)" : "");
+    if (worstSettleMs >= 1000.0 * options.chunkSeconds) {
+        printf("some chunks never converge: increase --preroll (currently %.1f s)\n", options.prerollSeconds);
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Two-pass loudness targeting
+//-------------------------------------------------------------------------------------------------------
+struct LoudnessPlan {
+    double driveDb = 0.0;
+    double limiterCeilingDb = 0.0;
+    double predictedLufs = 0.0;
+    double maxReductionDb = 0.0;
+    std::vector<float> gainEnvelope;    // pre-limiter gain per input frame, makeup included
+};
+
+// Limiter drive (ceiling - threshold) candidates evaluated in pass one; the limiter caps makeup at +12 dB
+constexpr int kNumDriveCandidates = 25;
+constexpr double kMinDriveDb = -12.0;
+constexpr double kDriveStepDb = 1.0;
+constexpr float kEnvelopeAttackMs = 5.0f;   // the envelope's lead-in ahead of a peak (time constant)
+
+void printLoudness(const char* label, const ELC4L::LoudnessAnalyzer& analyzer) {
+    fprintf(stderr, "%s: integrated %.1f LUFS, short-term max %.1f / p10 %.1f / p50 %.1f / p95 %.1f LUFS, "
+                    "LRA %.1f LU, true peak %.1f dBTP (sample peak %.1f dBFS)\n",
+            label, analyzer.getIntegratedLufs(), analyzer.getShortTermMaxLufs(),
+            analyzer.getShortTermPercentileLufs(10.0), analyzer.getShortTermPercentileLufs(50.0),
+            analyzer.getShortTermPercentileLufs(95.0), analyzer.getLoudnessRangeLu(),
+            analyzer.getTruePeakDb(), analyzer.getSamplePeakDb());
+}
+
+// Whole-file limiter gain for one drive. The static gain that holds each peak at the threshold is
+// smoothed backwards in time with the attack, so the reduction leads into a peak from any distance
+// (an unlimited lookahead), then forwards with the release. Both passes only lower the static gain,
+// so no pass-one peak ends up above the threshold. Returns the deepest reduction (before makeup).
+float buildGainEnvelope(const std::vector<float>& peaks, double ceilingDb, double driveDb,
+                        float attackCoeff, float releaseCoeff, std::vector<float>& gains) {
+    LookaheadLimiter levels;    // same threshold / makeup arithmetic (and +12 dB cap) as the limiter
+    levels.setCeiling((float)ceilingDb);
+    levels.setThreshold((float)(ceilingDb - driveDb));
+    const float threshold = levels.threshold;
+
+    const size_t numFrames = peaks.size();
+    gains.resize(numFrames);
+    float held = 1.0f;
+    for (size_t i = numFrames; i-- > 0; ) {
+        const float required = (peaks[i] > threshold) ? threshold / peaks[i] : 1.0f;
+        held = 1.0f - attackCoeff * (1.0f - held);
+        held = (required < held) ? required : held;
+        gains[i] = held;
+    }
+    held = 1.0f;
+    float deepest = 1.0f;
+    for (size_t i = 0; i < numFrames; ++i) {
+        held = 1.0f - releaseCoeff * (1.0f - held);
+        held = (gains[i] < held) ? gains[i] : held;
+        deepest = (held < deepest) ? held : deepest;
+        gains[i] = held * levels.makeupGain;
+    }
+    return deepest;
+}
+
+// Pass one: cheap analysis of the post-compressor signal, then the loudness of every candidate drive
+bool planLoudness(const ELC4L::AudioFileReader& reader, const Options& options, LoudnessPlan& plan) {
+    ELC4L::ScopedFlushDenormals noDenormals;
+
+    const double sampleRate = reader.getSampleRate();
+    const double ceilingDb = options.targetTruePeakDb - options.truePeakMarginDb;
+    const int64_t numFrames = reader.getNumFrames();
+
+    ELC4L::OfflineChain chain;
+    chain.prepare((float)sampleRate, options.settings);
+    chain.setSaturationOversampling(false);
+
+    ELC4L::LoudnessAnalyzer postCompressor;
+    postCompressor.prepare(sampleRate, true);
+    ELC4L::KWeightingFilter weighting;
+    weighting.prepare(sampleRate);
+
+    // The limited output is the post-compressor signal times the envelope gain, so its K-weighted
+    // energy is gain^2 times the post-compressor energy at the same frame
+    std::vector<float> peaks(numFrames), energies(numFrames);
+    std::vector<float> left(options.blockSize), right(options.blockSize);
+
+    for (int64_t position = 0; position < numFrames; ) {
+        const int frames = reader.readFrames(position, left.data(), right.data(), options.blockSize);
+        if (frames <= 0) break;
+        chain.processCompressors(left.data(), right.data(), left.data(), right.data(), frames);
+        chain.flushDenormals();
+        postCompressor.process(left.data(), right.data(), frames);
+
+        for (int i = 0; i < frames; ++i) {
+            peaks[position + i] = std::max(fabsf(left[i]), fabsf(right[i]));
+            energies[position + i] = (float)weighting.processEnergy(left[i], right[i]);
+        }
+        position += frames;
+    }
+
+    if (!options.quiet) {
+        printLoudness("pass 1 (post-compressor)", postCompressor);
+    }
+    if (!std::isfinite(postCompressor.getIntegratedLufs())) {
+        fprintf(stderr, "input is silent (below the -70 LUFS gate); nothing to normalize\n");
+        return false;
+    }
+
+    // Release as the limiter runs it (clamped to its range); the attack is the envelope's own
+    LookaheadLimiter timing;
+    timing.setSampleRate((float)sampleRate);
+    timing.setRelease(options.settings.limiterReleaseMs);
+    const float releaseCoeff = timing.releaseCoeff;
+    const float attackCoeff = expf(-1.0f / ((float)sampleRate * kEnvelopeAttackMs / 1000.0f));
+
+    // Loudness grows monotonically with drive; interpolate the drive that lands on the target
+    std::vector<double> loudness(kNumDriveCandidates);
+    for (int c = 0; c < kNumDriveCandidates; ++c) {
+        const double driveDb = kMinDriveDb + c * kDriveStepDb;
+        buildGainEnvelope(peaks, ceilingDb, driveDb, attackCoeff, releaseCoeff, plan.gainEnvelope);
+
+        ELC4L::LoudnessAnalyzer limited;
+        limited.prepare(sampleRate, false);
+        for (int64_t position = 0; position < numFrames; position += options.blockSize) {
+            const int frames = (int)std::min<int64_t>(options.blockSize, numFrames - position);
+            for (int i = 0; i < frames; ++i) {
+                const float gain = plan.gainEnvelope[position + i];
+                left[i] = gain * gain * energies[position + i];
+            }
+            limited.accumulateEnergy(left.data(), frames);
+        }
+        loudness[c] = limited.getIntegratedLufs();
+    }
+
+    double driveDb;
+    if (options.targetLufs <= loudness.front()) {
+        driveDb = kMinDriveDb;
+        plan.predictedLufs = loudness.front();
+    } else if (options.targetLufs >= loudness.back()) {
+        driveDb = kMinDriveDb + (kNumDriveCandidates - 1) * kDriveStepDb;
+        plan.predictedLufs = loudness.back();
+    } else {
+        int c = 0;
+        while (loudness[c + 1] < options.targetLufs) ++c;
+        double span = loudness[c + 1] - loudness[c];
+        double t = (span > 1.0e-9) ? (options.targetLufs - loudness[c]) / span : 0.0;
+        driveDb = kMinDriveDb + (c + t) * kDriveStepDb;
+        plan.predictedLufs = options.targetLufs;
+    }
+    if (fabs(plan.predictedLufs - options.targetLufs) > 0.05) {
+        fprintf(stderr, "warning: %.1f LUFS is out of the limiter's range; closest reachable is %.1f LUFS\n",
+                options.targetLufs, plan.predictedLufs);
+    }
+
+    const float deepest =
+        buildGainEnvelope(peaks, ceilingDb, driveDb, attackCoeff, releaseCoeff, plan.gainEnvelope);
+    plan.maxReductionDb = toDb(1.0 / deepest);
+    plan.driveDb = driveDb;
+    plan.limiterCeilingDb = ceilingDb;
+    return true;
+}
+
+// Measures the rendered file (pass two result)
+void reportRenderedLoudness(const Options& options) {
+    ELC4L::AudioFileReader rendered;
+    if (!rendered.open(options.outputPath)) {
+        fprintf(stderr, "%s: %s\n", options.outputPath, rendered.getError().c_str());
+        return;
+    }
+
+    ELC4L::LoudnessAnalyzer analyzer;
+    analyzer.prepare(rendered.getSampleRate(), true);
+    std::vector<float> left(options.blockSize), right(options.blockSize);
+    while (int frames = rendered.read(left.data(), right.data(), options.blockSize)) {
+        analyzer.process(left.data(), right.data(), frames);
+    }
+
+    printLoudness("pass 2 (output)", analyzer);
+    if (analyzer.getTruePeakDb() > options.targetTruePeakDb + 0.05) {
+        fprintf(stderr, "warning: true peak exceeds %.1f dBTP; increase --tp-margin\n", options.targetTruePeakDb);
+    }
+}
+
+// Streams stdin -> chain -> stdout. Output is latency-compensated like the file render: the first
+// 'latency' processed frames are dropped and the same number of zeros flushes the lookahead at EOF.
+int renderPipe(const Options& options) {
+    ELC4L::setBinaryStdio();
+    ELC4L::PcmStreamReader input(stdin, options.pipeFormat, options.blockSize);
+    ELC4L::PcmStreamWriter output(stdout, options.pipeFormat, options.blockSize);
+
+    ELC4L::OfflineChain chain;
+    chain.prepare((float)options.pipeRate, options.settings);
+
+    std::vector<float> left(options.blockSize), right(options.blockSize);
+    int toDiscard = chain.getLatencySamples();
+    int tailFrames = chain.getLatencySamples();
+    int64_t totalFrames = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        ELC4L::ScopedFlushDenormals noDenormals;
+
+        for (;;) {
+            int frames = input.read(left.data(), right.data(), options.blockSize);
+            totalFrames += frames;
+            if (frames == 0) {
+                frames = std::min(tailFrames, options.blockSize);
+                if (frames == 0) break;
+                std::fill(left.begin(), left.begin() + frames, 0.0f);
+                std::fill(right.begin(), right.begin() + frames, 0.0f);
+                tailFrames -= frames;
+            }
+
+            chain.process(left.data(), right.data(), left.data(), right.data(), frames);
+            chain.flushDenormals();
+
+            const int skip = std::min(toDiscard, frames);
+            toDiscard -= skip;
+            if (!output.write(left.data() + skip, right.data() + skip, frames - skip)) {
+                fprintf(stderr, "elc4l_render: output pipe closed\n");
+                return 1;
+            }
+        }
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    if (input.hasError() || !output.flush()) {
+        fprintf(stderr, "elc4l_render: pipe I/O error\n");
+        return 1;
+    }
+
+    if (!options.quiet) {
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        double audioSeconds = (double)totalFrames / options.pipeRate;
+        fprintf(stderr, "streamed %lld frames (%.1f s of audio) in %.3f s, %.1fx real time\n",
+                (long long)totalFrames, audioSeconds, seconds, (seconds > 0.0) ? audioSeconds / seconds : 0.0);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    int parsed = parseOptions(argc, argv, options);
+    if (parsed != 0) return (parsed == 2) ? 0 : 1;
+
+    if (strcmp(options.inputPath, "-") == 0) {
+        return renderPipe(options);
+    }
+
+    ELC4L::AudioContainer outputContainer;
+    if (!ELC4L::containerForPath(options.outputPath, outputContainer)) {
+        fprintf(stderr, "output must be .wav, .aif or .aiff: %s\n", options.outputPath);
+        return 1;
+    }
+
+    ELC4L::AudioFileReader reader;
+    if (!reader.open(options.inputPath)) {
+        fprintf(stderr, "%s: %s\n", options.inputPath, reader.getError().c_str());
+        return 1;
+    }
+
+    ELC4L::SampleEncoding outputEncoding;
+    if (!chooseEncoding(options.bits, reader.getEncoding(), outputEncoding)) {
+        fprintf(stderr, "--bits must be 16, 24 or 32f\n");
+        return 1;
+    }
+
+    const int64_t numFrames = reader.getNumFrames();
+    const double sampleRate = reader.getSampleRate();
+
+    ELC4L::AudioFileWriter writer;
+    if (!writer.create(options.outputPath, outputContainer, outputEncoding, sampleRate, numFrames)) {
+        fprintf(stderr, "%s: %s\n", options.outputPath, writer.getError().c_str());
+        return 1;
+    }
+
+    const int64_t chunkFrames = std::max<int64_t>(1, (int64_t)(options.chunkSeconds * sampleRate));
+
+    // Loudness render: the whole-file envelope does the limiting; the limiter at the ceiling (no drive,
+    // no makeup) only catches what pass two's oversampled saturation adds over pass one
+    LoudnessPlan plan;
+    if (options.loudnessTarget) {
+        if (!planLoudness(reader, options, plan)) return 1;
+
+        options.settings.limiterBypass = false;
+        options.settings.limiterThreshDb = (float)plan.limiterCeilingDb;
+        options.settings.limiterCeilingDb = (float)plan.limiterCeilingDb;
+        if (!options.quiet) {
+            fprintf(stderr, "pass 2: drive %.2f dB as a whole-file gain envelope (up to %.1f dB "
+                            "reduction), ceiling %.2f dB (predicted %.1f LUFS)\n",
+                    plan.driveDb, plan.maxReductionDb, plan.limiterCeilingDb, plan.predictedLufs);
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (options.threads < 0) {
+        int64_t lastReportedPercent = -1;
+        renderRange(reader, options.settings, plan.gainEnvelope, 0, numFrames, 0, options.blockSize,
+                    [&](int64_t frame, float* left, float* right, int count) {
+            writer.writeFrames(frame, left, right, count);
+            if (!options.quiet && numFrames > 0) {
+                int64_t percent = 100 * (frame + count) / numFrames;
+                if (percent / 10 != lastReportedPercent / 10) {
+                    fprintf(stderr, "\rrendering... %3d%%", (int)percent);
+                    lastReportedPercent = percent;
+                }
+            }
+        });
+    } else {
+        const int64_t prerollFrames = (int64_t)(options.prerollSeconds * sampleRate);
+        const int numChunks = (int)((numFrames + chunkFrames - 1) / chunkFrames);
+
+        ELC4L::WorkStealingPool pool(options.threads);
+        if (!options.quiet) {
+            fprintf(stderr, "rendering %d chunks of %.1f s (pre-roll %.1f s) on %d threads...",
+                    numChunks, options.chunkSeconds, options.prerollSeconds, pool.getNumThreads());
+        }
+        for (int c = 0; c < numChunks; ++c) {
+            const int64_t begin = (int64_t)c * chunkFrames;
+            const int64_t end = std::min(numFrames, begin + chunkFrames);
+            pool.submit([&, begin, end] {
+                renderRange(reader, options.settings, plan.gainEnvelope, begin, end, prerollFrames,
+                            options.blockSize, [&](int64_t frame, float* left, float* right, int count) {
+                    writer.writeFrames(frame, left, right, count);
+                });
+            });
+        }
+        pool.wait();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    if (!writer.close()) {
+        fprintf(stderr, "\n%s: %s\n", options.outputPath, writer.getError().c_str());
+        return 1;
+    }
+
+    if (!options.quiet) {
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        double audioSeconds = (double)numFrames / sampleRate;
+        fprintf(stderr, "\rrendered %lld frames (%.1f s of audio) in %.3f s, %.1fx real time\n",
+                (long long)numFrames, audioSeconds, seconds, (seconds > 0.0) ? audioSeconds / seconds : 0.0);
+    }
+
+    if (options.loudnessTarget && !options.quiet) {
+        reportRenderedLoudness(options);
+    }
+    if (options.verify && !verifyAgainstSerial(reader, options, plan.gainEnvelope, outputEncoding, chunkFrames)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Realtime guard check
+// Built with ELC4L_RT_GUARD=1: marks this thread as the audio thread the way the plugins' process
+// calls do, then takes the locks and makes the OS calls the guard is meant to catch:
+//   lock    : LazyEditorState::update and SharedTable::acquire (their CheckedMutex)
+//   syscall : MemoryLock::lock (the ELC4L_LOCK_MEMORY step)
+// and prints ELC4L_RT_REPORT(). The same calls made outside the scope must not be reported, and
+// neither may the telemetry clock read, which is allowed on the audio thread (a vDSO read, like the
+// governor's and profiler's steady_clock).
+// ctest matches the report lines (tools/CMakeLists.txt).
+//
+// Usage: elc4l_rt_guard_check
+//-------------------------------------------------------------------------------------------------------
+
+#include "LazyEditorState.h"
+#include "MemoryLock.h"
+#include "RealtimeGuard.h"
+#include "SharedTables.h"
+#include "Telemetry.h"
+
+#include <cstdio>
+
+#if !ELC4L_RT_GUARD
+#error "elc4l_rt_guard_check must be built with ELC4L_RT_GUARD=1"
+#endif
+
+namespace {
+
+struct EditorState {
+    float value = 0.0f;
+};
+
+float buffer[4096];
+
+void takeLocksAndCalls(ELC4L::LazyEditorState<EditorState>& editorState) {
+    editorState.update([](EditorState& state) { state.value += 1.0f; });
+    std::shared_ptr<const ELC4L::FftTables> tables = ELC4L::SharedTable<ELC4L::FftTables>::acquire(64);
+
+    ELC4L::MemoryLock memoryLock;
+    const ELC4L::MemoryRegion region = { buffer, sizeof(buffer) };
+    memoryLock.lock(ELC4L::kMemoryLockPrefault, &region, 1);
+
+    uint32_t sec, nsec;
+    ELC4L::getTelemetryClock(sec, nsec);
+}
+
+} // namespace
+
+int main() {
+    ELC4L::LazyEditorState<EditorState> editorState;
+    editorState.subscribe([](EditorState&) {});
+
+    // Off the audio thread: nothing may be recorded
+    takeLocksAndCalls(editorState);
+    ELC4L_RT_REPORT();
+    fprintf(stderr, "-- audio thread --\n");
+
+    {
+        ELC4L_RT_SCOPE("elc4l_rt_guard_check audio block");
+        takeLocksAndCalls(editorState);
+    }
+
+    ELC4L_RT_REPORT();
+    editorState.unsubscribe();
+    return 0;
+}
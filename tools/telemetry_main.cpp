@@ -0,0 +1,160 @@
+//-------------------------------------------------------------------------------------------------------
+// ELC4L Tools - Telemetry reader
+// Tails every ELC4L instance publishing into the shared-memory telemetry segment (common/Telemetry.h;
+// instances publish when started with ELC4L_TELEMETRY=1). One line per instance:
+//   pid/id, wrapper, sample rate, block size, DSP time per block vs block duration, load (last block
+//   and peak over ~1 s), GR per band, limiter GR, momentary LUFS, overs, quality tier (0 = full,
+//   see common/QualityGovernor.h) and age of the last update.
+// Instances whose process died are shown as "dead", instances that stopped processing as "idle".
+//
+// Usage: elc4l_telemetry [--name /elc4l-telemetry] [--interval ms] [--once] [--csv]
+//-------------------------------------------------------------------------------------------------------
+
+#include "Telemetry.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct Options {
+    const char* name = ELC4L::kTelemetryDefaultName;
+    int intervalMs = 500;
+    bool once = false;
+    bool csv = false;
+};
+
+void printUsage() {
+    fprintf(stderr, "usage: elc4l_telemetry [--name /segment] [--interval ms] [--once] [--csv]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--once") == 0) {
+            options.once = true;
+            continue;
+        }
+        if (strcmp(arg, "--csv") == 0) {
+            options.csv = true;
+            continue;
+        }
+
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+        if (strcmp(arg, "--name") == 0) {
+            options.name = value;
+        } else if (strcmp(arg, "--interval") == 0) {
+            options.intervalMs = atoi(value);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return options.name[0] == '/' && options.intervalMs > 0;
+}
+
+const char* wrapperName(uint32_t wrapper) {
+    switch (wrapper) {
+        case ELC4L::kTelemetryWrapperVst2: return "vst2";
+        case ELC4L::kTelemetryWrapperVst3: return "vst3";
+        case ELC4L::kTelemetryWrapperJuce: return "juce";
+        default: return "?";
+    }
+}
+
+double secondsSince(const ELC4L::TelemetryRecord& record) {
+    uint32_t sec, nsec;
+    ELC4L::getTelemetryClock(sec, nsec);
+    return ((double)sec - (double)record.updateSec) + ((double)nsec - (double)record.updateNsec) * 1.0e-9;
+}
+
+// One table (or CSV block) of every occupied slot; returns the number of live instances
+int printSnapshot(const ELC4L::TelemetrySegment& segment, const Options& options) {
+    if (options.csv) {
+        printf("pid,id,wrapper,state,rate,block,dsp_us,block_us,load_pct,peak_load_pct,"
+               "gr1_db,gr2_db,gr3_db,gr4_db,lim_gr_db,lufs_m,overs,blocks,tier,age_s\n");
+    } else {
+        printf("%-13s %-4s %-5s %6s %5s %15s %6s %6s  %-23s %5s %6s %6s %4s %6s\n", "pid/id", "wrap", "state",
+               "rate", "block", "dsp/block us", "load%", "peak%", "GR dB (1 2 3 4)", "lim", "LUFS", "overs",
+               "tier", "age s");
+    }
+
+    int live = 0;
+    for (int s = 0; s < ELC4L::kTelemetryNumSlots; ++s) {
+        uint32_t pid = 0;
+        ELC4L::TelemetryRecord r;
+        if (!ELC4L::readTelemetrySlot(segment.slots[s], pid, r)) continue;
+
+        const double age = (r.blockCount > 0) ? secondsSince(r) : -1.0;
+        const char* state = "live";
+        if (!ELC4L::isTelemetryOwnerAlive(pid)) state = "dead";
+        else if (r.blockCount == 0 || age > 2.0) state = "idle";
+        else ++live;
+
+        const float load = (r.blockUs > 0.0f) ? 100.0f * r.dspUs / r.blockUs : 0.0f;
+        if (options.csv) {
+            printf("%u,%u,%s,%s,%.0f,%u,%.1f,%.1f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%u,%u,%u,%.3f\n",
+                   pid, r.instanceId, wrapperName(r.wrapper), state, r.sampleRate, r.blockSize, r.dspUs,
+                   r.blockUs, load, r.peakLoadPercent, r.bandGrDb[0], r.bandGrDb[1], r.bandGrDb[2],
+                   r.bandGrDb[3], r.limiterGrDb, r.lufsMomentary, r.overCount, r.blockCount, r.qualityTier, age);
+        } else {
+            char id[32], dsp[32];
+            snprintf(id, sizeof(id), "%u/%u", pid, r.instanceId);
+            snprintf(dsp, sizeof(dsp), "%.0f/%.0f", r.dspUs, r.blockUs);
+            printf("%-13s %-4s %-5s %6.0f %5u %15s %6.1f %6.1f  %5.1f %5.1f %5.1f %5.1f %5.1f %6.1f %6u %4u %6.1f\n",
+                   id, wrapperName(r.wrapper), state, r.sampleRate, r.blockSize, dsp, load, r.peakLoadPercent,
+                   r.bandGrDb[0], r.bandGrDb[1], r.bandGrDb[2], r.bandGrDb[3], r.limiterGrDb,
+                   r.lufsMomentary, r.overCount, r.qualityTier, age);
+        }
+    }
+    return live;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    ELC4L::TelemetrySegment* segment = ELC4L::mapTelemetrySegment(options.name, false);
+    if (!segment) {
+        if (options.once) {
+            fprintf(stderr, "no telemetry segment %s (start instances with ELC4L_TELEMETRY=1)\n", options.name);
+            return 1;
+        }
+        fprintf(stderr, "waiting for telemetry segment %s ...\n", options.name);
+        while (!segment) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(options.intervalMs));
+            segment = ELC4L::mapTelemetrySegment(options.name, false);
+        }
+    }
+
+#if !defined(_WIN32)
+    const bool clearScreen = !options.csv && isatty(STDOUT_FILENO);
+#else
+    const bool clearScreen = false;
+#endif
+
+    for (;;) {
+        if (clearScreen) printf("\x1b[H\x1b[2J");
+        const int live = printSnapshot(*segment, options);
+        if (!options.csv) printf("%d live instance(s)\n", live);
+        fflush(stdout);
+        if (options.once) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.intervalMs));
+    }
+
+    ELC4L::unmapTelemetrySegment(segment);
+    return 0;
+}
@@ -52,6 +52,20 @@ tresult PLUGIN_API ELC4LController::initialize(FUnknown* context) {
         ParameterInfo::kCanAutomate, kParamLimiterCeiling);
     parameters.addParameter(STR16("Limiter Release"), STR16("ms"), 0, kDefaultLimiterRelease,
         ParameterInfo::kCanAutomate, kParamLimiterRelease);
+
+    // Processing quality (Eco / Standard / High; High changes the latency)
+    StringListParameter* quality = new StringListParameter(STR16("Quality"), kParamQuality, nullptr,
+        ParameterInfo::kCanAutomate | ParameterInfo::kIsList);
+    quality->appendString(STR16("Eco"));
+    quality->appendString(STR16("Standard"));
+    quality->appendString(STR16("High"));
+    quality->getInfo().defaultNormalizedValue = kDefaultQuality;
+    quality->setNormalized(kDefaultQuality);
+    parameters.addParameter(quality);
+
+    // Host bypass: crossfades to a latency-matched dry path, then the DSP is skipped
+    parameters.addParameter(STR16("Bypass"), nullptr, 1, kDefaultBypass,
+        ParameterInfo::kCanAutomate | ParameterInfo::kIsBypass, kParamBypass);
     
     return kResultOk;
 }
@@ -64,13 +78,29 @@ tresult PLUGIN_API ELC4LController::setComponentState(IBStream* state) {
     
     for (int i = 0; i < kNumParams; ++i) {
         float value;
-        if (!streamer.readFloat(value)) return kResultFalse;
+        if (!streamer.readFloat(value)) {
+            if (i >= kParamQuality) break;  // Saved before the Quality / Bypass parameters existed
+            return kResultFalse;
+        }
         setParamNormalized(static_cast<ParamID>(i), value);
     }
     
     return kResultOk;
 }
 
+//-------------------------------------------------------------------------------------------------------
+// High quality runs the limiter with a longer lookahead: the host has to re-query the latency
+tresult PLUGIN_API ELC4LController::setParamNormalized(ParamID tag, ParamValue value) {
+    const bool wasHigh = (tag == kParamQuality)
+        && normalizedToProcessingQuality((float)getParamNormalized(tag)) == kProcessingHigh;
+    tresult result = EditController::setParamNormalized(tag, value);
+    if (result == kResultOk && tag == kParamQuality) {
+        const bool isHigh = normalizedToProcessingQuality((float)value) == kProcessingHigh;
+        if (isHigh != wasHigh && componentHandler) componentHandler->restartComponent(kLatencyChanged);
+    }
+    return result;
+}
+
 //-------------------------------------------------------------------------------------------------------
 IPlugView* PLUGIN_API ELC4LController::createView(FIDString name) {
     if (FIDStringsEqual(name, ViewType::kEditor)) {
@@ -6,6 +6,7 @@
 #include "public.sdk/source/vst/vsteditcontroller.h"
 #include "vstgui/plugin-bindings/vst3editor.h"
 #include "ELC4Lids.h"
+#include "QualityGovernor.h"
 
 namespace ELC4L {
 
@@ -21,6 +22,8 @@ public:
     // EditController overrides
     Steinberg::tresult PLUGIN_API initialize(Steinberg::FUnknown* context) override;
     Steinberg::tresult PLUGIN_API setComponentState(Steinberg::IBStream* state) override;
+    Steinberg::tresult PLUGIN_API setParamNormalized(Steinberg::Vst::ParamID tag,
+                                                     Steinberg::Vst::ParamValue value) override;
     
     // Editor
     Steinberg::IPlugView* PLUGIN_API createView(Steinberg::FIDString name) override;
@@ -1,13 +1,16 @@
 //-------------------------------------------------------------------------------------------------------
 // ELC4L VST3 - DSP Core (shared between VST2 and VST3)
-// - 4-Band Linkwitz-Riley Crossover
+// - N-Band Linkwitz-Riley Crossover (4 bands in the plugin)
 // - LA-2A Style Opto Compressor
 // - Lookahead Brickwall Limiter
 //-------------------------------------------------------------------------------------------------------
 #pragma once
 
+#include "SilenceDetector.h"
+#include "DenormalGuard.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 namespace ELC4L {
 
@@ -22,10 +25,22 @@ constexpr int kFftHopSize = 1024;
 //-------------------------------------------------------------------------------------------------------
 struct LookaheadLimiter {
     static constexpr int kLookaheadSamples = 64;
+    static constexpr int kExtendedLookaheadSamples = 128;  // High quality
+    static constexpr int kMaxLookaheadSamples = kExtendedLookaheadSamples;
     
-    float delayL[kLookaheadSamples];
-    float delayR[kLookaheadSamples];
+    float delayL[kMaxLookaheadSamples];
+    float delayR[kMaxLookaheadSamples];
     int delayIndex;
+    int lookaheadSamples = kLookaheadSamples;
+
+    // Extended mode: the detector sees the maximum input peak over the whole delay line (sliding
+    // maximum as a monotonic queue), so the gain is down before a peak leaves the delay
+    bool peakHoldEnabled = false;
+    float holdPeak[kMaxLookaheadSamples + 1];
+    uint32_t holdExpiry[kMaxLookaheadSamples + 1];
+    int holdHead = 0;
+    int holdCount = 0;
+    uint32_t holdClock = 0;
     
     float envelope;
     float attackCoeff;
@@ -61,15 +76,33 @@ struct LookaheadLimiter {
     }
     
     void reset() {
-        for (int i = 0; i < kLookaheadSamples; ++i) {
+        for (int i = 0; i < kMaxLookaheadSamples; ++i) {
             delayL[i] = 0.0f;
             delayR[i] = 0.0f;
         }
         delayIndex = 0;
+        holdHead = 0;
+        holdCount = 0;
         envelope = 0.0f;
         lastGain = 1.0f;
         gainReductionDb = 0.0f;
     }
+
+    // Standard (64 samples) or extended (128 samples + peak hold) lookahead. Changes the latency and
+    // clears the delay line; call between blocks.
+    void setExtendedLookahead(bool enabled) {
+        const int samples = enabled ? kExtendedLookaheadSamples : kLookaheadSamples;
+        if (samples == lookaheadSamples && enabled == peakHoldEnabled) return;
+        lookaheadSamples = samples;
+        peakHoldEnabled = enabled;
+        reset();
+    }
+
+    int getLookaheadSamples() const { return lookaheadSamples; }
+
+    static int getLookaheadSamples(bool extended) {
+        return extended ? kExtendedLookaheadSamples : kLookaheadSamples;
+    }
     
     void setSampleRate(float sr) {
         sampleRate = sr;
@@ -108,17 +141,49 @@ struct LookaheadLimiter {
         if (makeupGain > 4.0f) makeupGain = 4.0f;
     }
     
+    // Sliding maximum over the samples still in the delay line (including the one leaving it)
+    float holdPeakOverLookahead(float peak) {
+        const int size = kMaxLookaheadSamples + 1;
+        while (holdCount > 0 && holdPeak[(holdHead + holdCount - 1) % size] <= peak) --holdCount;
+        const int tail = (holdHead + holdCount) % size;
+        holdPeak[tail] = peak;
+        holdExpiry[tail] = holdClock + (uint32_t)lookaheadSamples + 1u;
+        ++holdCount;
+        ++holdClock;
+        while ((int32_t)(holdExpiry[holdHead] - holdClock) <= 0) {
+            holdHead = (holdHead + 1) % size;
+            --holdCount;
+        }
+        return holdPeak[holdHead];
+    }
+
     void process(float& left, float& right) {
+        if (peakHoldEnabled) processSample<true>(left, right);
+        else processSample<false>(left, right);
+    }
+
+    // Block processor: the peak-hold mode is resolved once per chunk
+    void processChunk(float* left, float* right, int numSamples) {
+        if (peakHoldEnabled) {
+            for (int i = 0; i < numSamples; ++i) processSample<true>(left[i], right[i]);
+        } else {
+            for (int i = 0; i < numSamples; ++i) processSample<false>(left[i], right[i]);
+        }
+    }
+
+    template <bool PeakHold>
+    inline void processSample(float& left, float& right) {
         float delayedL = delayL[delayIndex];
         float delayedR = delayR[delayIndex];
         
         delayL[delayIndex] = left;
         delayR[delayIndex] = right;
-        delayIndex = (delayIndex + 1) % kLookaheadSamples;
+        if (++delayIndex >= lookaheadSamples) delayIndex = 0;
         
         float peakL = fabsf(left);
         float peakR = fabsf(right);
         float peak = (peakL > peakR) ? peakL : peakR;
+        if constexpr (PeakHold) peak = holdPeakOverLookahead(peak);
         
         float fastEnv = envelope;
         float slowEnv = envelope;
@@ -158,6 +223,16 @@ struct LookaheadLimiter {
     }
 
     float getGainReductionDb() const { return gainReductionDb; }
+
+    // No gain reduction pending and the lookahead delay has drained
+    bool isIdle(float level) const {
+        if (envelope > threshold) return false;
+        return bufferPeak(delayL, lookaheadSamples) < level
+            && bufferPeak(delayR, lookaheadSamples) < level;
+    }
+
+    // Denormal fallback (once per block); the delay lines only hold input samples
+    void flushDenormals() { flushDenormal(envelope); }
 };
 
 //-------------------------------------------------------------------------------------------------------
@@ -181,6 +256,18 @@ struct OptoCompressor {
     float saturationDrive;
     bool saturationEnabled;
 
+    // Gain computer rate: program-dependent release and gain curve every N samples (1 = per sample);
+    // detector, envelopes and gain smoothing always run per sample
+    int gainComputerInterval = 1;
+    int gainComputerCountdown = 0;
+    float dynamicSlowCoeff = 0.0f;
+    float targetGain = 1.0f;
+    float targetGrDb = 0.0f;
+
+    // Quiet fast path: below quietLevel the gain computer's result is exactly 0 dB GR (and below the
+    // threshold its release is exactly the base one), so the log/exp/pow math is skipped
+    float quietLevel = 0.0f;
+
     static constexpr float kMinRatio = 3.0f;
     static constexpr float kMaxRatio = 100.0f;
     static constexpr float kKneeDb = 10.0f;
@@ -188,6 +275,8 @@ struct OptoCompressor {
     static constexpr float kFastReleaseMs = 60.0f;
     static constexpr float kSlowReleaseBase = 500.0f;
     static constexpr float kSlowReleaseMax = 5000.0f;
+    static constexpr float kQuietMarginDb = 0.5f;
+    static constexpr float kDetectorFloor = 1.0e-6f;   // sqrt of the detector's 1e-12 bias: the envelopes' rest value
 
     OptoCompressor()
         : sampleRate(44100.0f)
@@ -207,6 +296,7 @@ struct OptoCompressor {
         , saturationEnabled(true)
     {
         updateCoefficients();
+        setThresholdDb(0.0f);
     }
 
     void reset() {
@@ -216,6 +306,9 @@ struct OptoCompressor {
         lastGain = 1.0f;
         gainReductionDb = 0.0f;
         peakHold = 0.0f;
+        gainComputerCountdown = 0;
+        targetGain = 1.0f;
+        targetGrDb = 0.0f;
     }
 
     void setSampleRate(float sr) {
@@ -225,11 +318,16 @@ struct OptoCompressor {
 
     void setThresholdDb(float db) {
         threshold = powf(10.0f, db / 20.0f);
+        quietLevel = powf(10.0f, (db - kKneeDb * 0.5f - kQuietMarginDb) / 20.0f);
     }
 
     void setMakeupDb(float db) {
         makeupGain = powf(10.0f, db / 20.0f);
     }
+
+    void setGainComputerInterval(int samples) {
+        gainComputerInterval = (samples < 1) ? 1 : (samples > 64) ? 64 : samples;
+    }
     
     void setSaturationDrive(float drive) {
         saturationDrive = (drive < 0.0f) ? 0.0f : (drive > 1.0f) ? 1.0f : drive;
@@ -268,6 +366,27 @@ struct OptoCompressor {
     }
 
     void process(float& left, float& right) {
+        processDynamics(left, right);
+        processSaturation(left, right);
+    }
+
+    // Detector, envelopes and gain computer; applies gain and makeup
+    void processDynamics(float& left, float& right) { processDynamicsSample<true>(left, right); }
+
+    // Detector-only update for a band that does not reach the mix (muted / not soloed): envelopes,
+    // gain computer (every kDetectorOnlyInterval samples) and gain smoothing keep following the band,
+    // so un-muting picks up the right gain, but the audio is not touched and the saturation is skipped
+    static constexpr int kDetectorOnlyInterval = 16;
+
+    void processDetectorChunk(const float* left, const float* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            float l = left[i], r = right[i];
+            processDynamicsSample<false>(l, r);
+        }
+    }
+
+    template <bool AudioPath>
+    inline void processDynamicsSample(float& left, float& right) {
         float level = 0.5f * (left * left + right * right);
         float detector = sqrtf(level + 1.0e-12f);
 
@@ -283,14 +402,24 @@ struct OptoCompressor {
             fastEnvelope = fastReleaseCoeff * fastEnvelope + (1.0f - fastReleaseCoeff) * detector;
         }
 
-        float overDb = 20.0f * log10f((peakHold / threshold) + 1.0e-12f);
-        if (overDb < 0.0f) overDb = 0.0f;
-        
-        float releaseScale = 1.0f + (overDb * 0.15f);
-        if (releaseScale > 10.0f) releaseScale = 10.0f;
-        float slowRelMs = kSlowReleaseBase * releaseScale;
-        if (slowRelMs > kSlowReleaseMax) slowRelMs = kSlowReleaseMax;
-        float dynamicSlowCoeff = expf(-1.0f / (sampleRate * slowRelMs / 1000.0f));
+        const bool computeGain = (--gainComputerCountdown <= 0);
+        if (computeGain) {
+            gainComputerCountdown = (AudioPath || gainComputerInterval > kDetectorOnlyInterval)
+                                        ? gainComputerInterval : kDetectorOnlyInterval;
+
+            if (peakHold < threshold) {
+                dynamicSlowCoeff = slowReleaseCoeff;
+            } else {
+                float overDb = 20.0f * log10f((peakHold / threshold) + 1.0e-12f);
+                if (overDb < 0.0f) overDb = 0.0f;
+
+                float releaseScale = 1.0f + (overDb * 0.15f);
+                if (releaseScale > 10.0f) releaseScale = 10.0f;
+                float slowRelMs = kSlowReleaseBase * releaseScale;
+                if (slowRelMs > kSlowReleaseMax) slowRelMs = kSlowReleaseMax;
+                dynamicSlowCoeff = expf(-1.0f / (sampleRate * slowRelMs / 1000.0f));
+            }
+        }
 
         if (detector > slowEnvelope) {
             slowEnvelope = attackCoeff * slowEnvelope + (1.0f - attackCoeff) * detector;
@@ -300,122 +429,417 @@ struct OptoCompressor {
 
         envelope = 0.3f * fastEnvelope + 0.7f * slowEnvelope;
 
-        float levelDb = 20.0f * log10f(envelope + 1.0e-12f);
-        float threshDb = 20.0f * log10f(threshold + 1.0e-12f);
-        float overThresh = levelDb - threshDb;
-
-        float dynamicRatio = kMinRatio;
-        if (overThresh > 0.0f) {
-            float ratioBlend = overThresh / 20.0f;
-            if (ratioBlend > 1.0f) ratioBlend = 1.0f;
-            dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
+        if (computeGain && envelope < quietLevel) {
+            targetGain = 1.0f;
+            targetGrDb = 0.0f;
+        } else if (computeGain) {
+            float levelDb = 20.0f * log10f(envelope + 1.0e-12f);
+            float threshDb = 20.0f * log10f(threshold + 1.0e-12f);
+            float overThresh = levelDb - threshDb;
+
+            float dynamicRatio = kMinRatio;
+            if (overThresh > 0.0f) {
+                float ratioBlend = overThresh / 20.0f;
+                if (ratioBlend > 1.0f) ratioBlend = 1.0f;
+                dynamicRatio = kMinRatio + (kMaxRatio - kMinRatio) * (ratioBlend * ratioBlend);
+            }
+
+            float grDb = 0.0f;
+            if (overThresh <= -kKneeDb * 0.5f) {
+                grDb = 0.0f;
+            } else if (overThresh >= kKneeDb * 0.5f) {
+                grDb = overThresh - (overThresh / dynamicRatio);
+            } else {
+                float x = overThresh + kKneeDb * 0.5f;
+                grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
+            }
+
+            targetGain = powf(10.0f, -grDb / 20.0f);
+            targetGrDb = grDb;
         }
 
-        float grDb = 0.0f;
-        if (overThresh <= -kKneeDb * 0.5f) {
-            grDb = 0.0f;
-        } else if (overThresh >= kKneeDb * 0.5f) {
-            grDb = overThresh - (overThresh / dynamicRatio);
-        } else {
-            float x = overThresh + kKneeDb * 0.5f;
-            grDb = (x * x) * (1.0f - 1.0f / dynamicRatio) / (2.0f * kKneeDb);
-        }
+        float gainSmooth = 0.995f;
+        float gain = gainSmooth * lastGain + (1.0f - gainSmooth) * targetGain;
 
-        float gain = powf(10.0f, -grDb / 20.0f);
+        if constexpr (AudioPath) {
+            left *= gain * makeupGain;
+            right *= gain * makeupGain;
+        }
 
-        float gainSmooth = 0.995f;
-        gain = gainSmooth * lastGain + (1.0f - gainSmooth) * gain;
+        lastGain = gain;
+        gainReductionDb = targetGrDb;
+    }
 
-        left *= gain * makeupGain;
-        right *= gain * makeupGain;
-        
+    void processSaturation(float& left, float& right) {
         left = applyTubeSaturation(left);
         right = applyTubeSaturation(right);
+    }
 
-        lastGain = gain;
-        gainReductionDb = grDb;
+    // Chunk versions for the block processor
+    void processDynamicsChunk(float* left, float* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) processDynamics(left[i], right[i]);
+    }
+
+    void processSaturationChunk(float* left, float* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) processSaturation(left[i], right[i]);
     }
 
     float getGainReductionDb() const { return gainReductionDb; }
+
+    // Gain has recovered to unity and the detector envelopes have decayed to within 'threshold' of
+    // their silent rest value (the saturation stage is memoryless)
+    bool isIdle(float threshold) const {
+        if (gainReductionDb > 0.0f || lastGain < 0.9999f) return false;
+        const float level = kDetectorFloor + threshold;
+        return envelope < level && fastEnvelope < level && slowEnvelope < level && peakHold < level;
+    }
+
+    // Denormal fallback (once per block): detector envelopes
+    void flushDenormals() {
+        flushDenormal(envelope);
+        flushDenormal(fastEnvelope);
+        flushDenormal(slowEnvelope);
+        flushDenormal(peakHold);
+    }
+};
+
+//-------------------------------------------------------------------------------------------------------
+// CompressorBank<NumBands> - one OptoCompressor per crossover band, sized with the crossover it
+// follows (Crossover<NumBands>::kNumBands). Per-band settings go through operator[]; the lifecycle
+// calls run over the whole bank in a loop the compiler unrolls.
+//-------------------------------------------------------------------------------------------------------
+template <int NumBands>
+struct CompressorBank {
+    static constexpr int kNumBands = NumBands;
+
+    OptoCompressor bands[NumBands];
+
+    OptoCompressor& operator[](int band) { return bands[band]; }
+    const OptoCompressor& operator[](int band) const { return bands[band]; }
+
+    void setSampleRate(float sr) {
+        for (int b = 0; b < NumBands; ++b) bands[b].setSampleRate(sr);
+    }
+
+    void reset() {
+        for (int b = 0; b < NumBands; ++b) bands[b].reset();
+    }
+
+    bool isIdle(float threshold) const {
+        for (int b = 0; b < NumBands; ++b) {
+            if (!bands[b].isIdle(threshold)) return false;
+        }
+        return true;
+    }
+
+    void flushDenormals() {
+        for (int b = 0; b < NumBands; ++b) bands[b].flushDenormals();
+    }
 };
 
 //-------------------------------------------------------------------------------------------------------
-// 4-Band Linkwitz-Riley Crossover
+// Crossover<NumBands> - Linkwitz-Riley 4th-order crossover, 2 to kMaxCrossoverBands bands
+// The split tree is built at compile time: split k sits between band k and band k + 1, each node is
+// its own instantiation and every band's path is a fixed chain of biquads, so the per-sample code is
+// fully unrolled and a 2-band chain runs exactly one split.
+// - Compensated (default): a balanced tree in which each branch also runs the second-order allpass
+//   (lowpass + highpass) of every split on the other side, so all bands share one phase response and
+//   their sum is an allpass.
+// - Uncompensated: the serial cascade (split 0's highpass feeds split 1, ...) without allpasses. Near
+//   the split points the bands' phases differ and the unprocessed sum dips (0.45 dB at the plugin's
+//   default 4-band points, 1.5 dB for 6 bands). FourBandCrossover keeps it: it is the shipping 4-band
+//   response the equivalence reference freezes.
+// Coefficients are designed in double precision; the filters run in double (default) or in float
+// (Eco quality). Switching precision carries the filter memories over, so it is click-free.
 //-------------------------------------------------------------------------------------------------------
-struct FourBandCrossover {
+constexpr int kMaxCrossoverBands = 8;
+
+template <int NumBands, bool Compensated = true>
+struct Crossover {
+    static_assert(NumBands >= 2 && NumBands <= kMaxCrossoverBands, "Crossover: 2 to 8 bands");
+
+    static constexpr int kNumBands = NumBands;
+    static constexpr int kNumSplits = NumBands - 1;
+
+    // Tree shape: a node over 'count' bands splits after its lower lowCount(count) bands; its two
+    // branches run count - 2 allpasses between them (each the other side's splits)
+    static constexpr int lowCount(int count) { return Compensated ? count / 2 : 1; }
+    static constexpr int nodeAllpasses(int count) { return Compensated ? count - 2 : 0; }
+    static constexpr int treeAllpasses(int count) {
+        return (count < 2) ? 0
+             : nodeAllpasses(count) + treeAllpasses(lowCount(count)) + treeAllpasses(count - lowCount(count));
+    }
+    static constexpr int kNumAllpasses = treeAllpasses(NumBands);
+
+    template <typename T>
     struct BiquadCoeffs {
-        double b0, b1, b2;
-        double a1, a2;
+        T b0, b1, b2;
+        T a1, a2;
     };
     
-    struct BiquadState {
-        double x1[2], x2[2];
-        double y1[2], y2[2];
+    // Channel pairs (x1[0], x1[1], ...) are loaded and stored as one vector: 16-byte aligned, so a
+    // pair never straddles a cache line
+    template <typename T>
+    struct alignas(16) BiquadState {
+        T x1[2], x2[2];
+        T y1[2], y2[2];
         
         BiquadState() { reset(); }
         
         void reset() {
-            x1[0] = x1[1] = x2[0] = x2[1] = 0.0;
-            y1[0] = y1[1] = y2[0] = y2[1] = 0.0;
+            x1[0] = x1[1] = x2[0] = x2[1] = 0;
+            y1[0] = y1[1] = y2[0] = y2[1] = 0;
+        }
+
+        bool isIdle(double threshold) const {
+            for (int ch = 0; ch < 2; ++ch) {
+                if (fabs(x1[ch]) >= threshold || fabs(x2[ch]) >= threshold) return false;
+                if (fabs(y1[ch]) >= threshold || fabs(y2[ch]) >= threshold) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int ch = 0; ch < 2; ++ch) {
+                flushDenormal(x1[ch]); flushDenormal(x2[ch]);
+                flushDenormal(y1[ch]); flushDenormal(y2[ch]);
+            }
+        }
+
+        template <typename U>
+        void copyFrom(const BiquadState<U>& other) {
+            for (int ch = 0; ch < 2; ++ch) {
+                x1[ch] = (T)other.x1[ch]; x2[ch] = (T)other.x2[ch];
+                y1[ch] = (T)other.y1[ch]; y2[ch] = (T)other.y2[ch];
+            }
         }
     };
-    
-    BiquadCoeffs lowpass1a, lowpass1b;
-    BiquadCoeffs highpass1a, highpass1b;
-    BiquadState lp1StateA, lp1StateB;
-    BiquadState hp1StateA, hp1StateB;
 
-    BiquadCoeffs lowpass2a, lowpass2b;
-    BiquadCoeffs highpass2a, highpass2b;
-    BiquadState lp2StateA, lp2StateB;
-    BiquadState hp2StateA, hp2StateB;
+    // One split point: the LR4 lowpass and highpass (two cascaded Butterworth biquads each), with the
+    // coefficients and memories in the order the sample loop visits them, so a split is one
+    // contiguous run of cache lines instead of six arrays strided across the network
+    template <typename T>
+    struct Split {
+        BiquadCoeffs<T> lowpass;
+        BiquadState<T> lpStateA, lpStateB;
+        BiquadCoeffs<T> highpass;
+        BiquadState<T> hpStateA, hpStateB;
+
+        void reset() {
+            lpStateA.reset(); lpStateB.reset();
+            hpStateA.reset(); hpStateB.reset();
+        }
+
+        bool isIdle(double threshold) const {
+            return lpStateA.isIdle(threshold) && lpStateB.isIdle(threshold)
+                && hpStateA.isIdle(threshold) && hpStateB.isIdle(threshold);
+        }
+
+        void flushDenormals() {
+            lpStateA.flushDenormals(); lpStateB.flushDenormals();
+            hpStateA.flushDenormals(); hpStateB.flushDenormals();
+        }
+    };
+
+    // Compensation allpass memories, in tree order (none for 2 bands or the serial cascade)
+    template <typename T, int Count>
+    struct AllpassStates {
+        BiquadState<T> states[Count];
+    };
+
+    template <typename T>
+    struct AllpassStates<T, 0> {
+        static constexpr BiquadState<T>* states = nullptr;
+    };
+
+    template <typename T>
+    struct Network;
+
+    // The node over bands [First, First + Count), whose allpass memories start at Offset: splits its
+    // input, compensates both branches and hands them to its children
+    template <int First, int Count, int Offset>
+    struct Node {
+        static constexpr int kLowCount = lowCount(Count);
+        static constexpr int kSplit = First + kLowCount - 1;
+        static constexpr int kLowChildOffset = Offset + nodeAllpasses(Count);
+        static constexpr int kHighChildOffset = kLowChildOffset + treeAllpasses(kLowCount);
+
+        template <typename T>
+        static inline void process(Network<T>& net, T inL, T inR, float* bandL, float* bandR) {
+            Split<T>& split = net.splits[kSplit];
+            T lpL = Network<T>::processBiquad(inL, 0, split.lowpass, split.lpStateA);
+            T lpR = Network<T>::processBiquad(inR, 1, split.lowpass, split.lpStateA);
+            T lowL = Network<T>::processBiquad(lpL, 0, split.lowpass, split.lpStateB);
+            T lowR = Network<T>::processBiquad(lpR, 1, split.lowpass, split.lpStateB);
+
+            T hpL = Network<T>::processBiquad(inL, 0, split.highpass, split.hpStateA);
+            T hpR = Network<T>::processBiquad(inR, 1, split.highpass, split.hpStateA);
+            T highL = Network<T>::processBiquad(hpL, 0, split.highpass, split.hpStateB);
+            T highR = Network<T>::processBiquad(hpR, 1, split.highpass, split.hpStateB);
+
+            if constexpr (Compensated) {
+                // Low branch: the high side's splits; high branch: the low side's
+                int allpass = Offset;
+                for (int k = kSplit + 1; k < First + Count - 1; ++k, ++allpass) {
+                    lowL = Network<T>::processAllpass(lowL, 0, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                    lowR = Network<T>::processAllpass(lowR, 1, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                }
+                for (int k = First; k < kSplit; ++k, ++allpass) {
+                    highL = Network<T>::processAllpass(highL, 0, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                    highR = Network<T>::processAllpass(highR, 1, net.splits[k].lowpass, net.allpasses.states[allpass]);
+                }
+            }
+
+            Node<First, kLowCount, kLowChildOffset>::process(net, lowL, lowR, bandL, bandR);
+            Node<First + kLowCount, Count - kLowCount, kHighChildOffset>::process(net, highL, highR, bandL, bandR);
+        }
+    };
+
+    template <int First, int Offset>
+    struct Node<First, 1, Offset> {
+        template <typename T>
+        static inline void process(Network<T>&, T inL, T inR, float* bandL, float* bandR) {
+            bandL[First] = (float)inL;
+            bandR[First] = (float)inR;
+        }
+    };
+
+    // All split points and compensation allpasses in one precision
+    template <typename T>
+    struct Network {
+        Split<T> splits[kNumSplits];
+        AllpassStates<T, kNumAllpasses> allpasses;
+
+        static inline T processBiquad(T input, int channel, const BiquadCoeffs<T>& c, BiquadState<T>& s) {
+            T output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
+                     - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+
+            s.x2[channel] = s.x1[channel];
+            s.x1[channel] = input;
+            s.y2[channel] = s.y1[channel];
+            s.y1[channel] = output;
+
+            return output;
+        }
+
+        // LR4 lowpass + highpass of a split: its Butterworth denominator over the mirrored numerator,
+        // so the allpass reads the split's lowpass coefficients
+        static inline T processAllpass(T input, int channel, const BiquadCoeffs<T>& c, BiquadState<T>& s) {
+            T output = c.a2 * input + c.a1 * s.x1[channel] + s.x2[channel]
+                     - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
+
+            s.x2[channel] = s.x1[channel];
+            s.x1[channel] = input;
+            s.y2[channel] = s.y1[channel];
+            s.y1[channel] = output;
+
+            return output;
+        }
 
-    BiquadCoeffs lowpass3a, lowpass3b;
-    BiquadCoeffs highpass3a, highpass3b;
-    BiquadState lp3StateA, lp3StateB;
-    BiquadState hp3StateA, hp3StateB;
+        inline void process(float inL, float inR, float* bandL, float* bandR) {
+            Node<0, NumBands, 0>::process(*this, (T)inL, (T)inR, bandL, bandR);
+        }
+
+        void reset() {
+            for (int k = 0; k < kNumSplits; ++k) splits[k].reset();
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].reset();
+        }
+
+        bool isIdle(double threshold) const {
+            for (int k = 0; k < kNumSplits; ++k) {
+                if (!splits[k].isIdle(threshold)) return false;
+            }
+            for (int a = 0; a < kNumAllpasses; ++a) {
+                if (!allpasses.states[a].isIdle(threshold)) return false;
+            }
+            return true;
+        }
+
+        void flushDenormals() {
+            for (int k = 0; k < kNumSplits; ++k) splits[k].flushDenormals();
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].flushDenormals();
+        }
+
+        // Coefficients of one split point (its allpasses read them too)
+        template <typename U>
+        void copyCoefficientsFrom(const Network<U>& other, int k) {
+            const BiquadCoeffs<U>* src[2] = { &other.splits[k].lowpass, &other.splits[k].highpass };
+            BiquadCoeffs<T>* dst[2] = { &splits[k].lowpass, &splits[k].highpass };
+            for (int f = 0; f < 2; ++f) {
+                dst[f]->b0 = (T)src[f]->b0; dst[f]->b1 = (T)src[f]->b1; dst[f]->b2 = (T)src[f]->b2;
+                dst[f]->a1 = (T)src[f]->a1; dst[f]->a2 = (T)src[f]->a2;
+            }
+        }
+
+        template <typename U>
+        void copyStateFrom(const Network<U>& other) {
+            for (int k = 0; k < kNumSplits; ++k) {
+                const Split<U>& src = other.splits[k];
+                Split<T>& dst = splits[k];
+                dst.lpStateA.copyFrom(src.lpStateA); dst.lpStateB.copyFrom(src.lpStateB);
+                dst.hpStateA.copyFrom(src.hpStateA); dst.hpStateB.copyFrom(src.hpStateB);
+            }
+            for (int a = 0; a < kNumAllpasses; ++a) allpasses.states[a].copyFrom(other.allpasses.states[a]);
+        }
+    };
+
+    Network<double> precise;
+    Network<float> fast;
+    bool doublePrecision;
 
     float sampleRate;
-    float xover1;
-    float xover2;
-    float xover3;
+    float frequencies[kNumSplits];
     
-    FourBandCrossover() 
-        : sampleRate(44100.0f)
-        , xover1(120.0f)
-        , xover2(800.0f)
-        , xover3(4000.0f)
+    Crossover() 
+        : doublePrecision(true)
+        , sampleRate(44100.0f)
     {
+        for (int k = 0; k < kNumSplits; ++k) frequencies[k] = getDefaultFrequency(k);
         updateCoefficients();
     }
+
+    // The 4-band plugin's 120 / 800 / 4000 Hz; other band counts log-spaced over 100 Hz - 8 kHz
+    static float getDefaultFrequency(int k) {
+        static const float fourBand[3] = { 120.0f, 800.0f, 4000.0f };
+        if (NumBands == 4) return fourBand[k];
+        if (kNumSplits == 1) return 800.0f;
+        return 100.0f * powf(80.0f, (float)k / (float)(kNumSplits - 1));
+    }
     
     void setSampleRate(float sr) {
         sampleRate = sr;
         updateCoefficients();
     }
     
-    void setXover1(float freq) { xover1 = freq; updateCoefficients(); }
-    void setXover2(float freq) { xover2 = freq; updateCoefficients(); }
-    void setXover3(float freq) { xover3 = freq; updateCoefficients(); }
+    // Only recomputes the filter pair of split k
+    void setFrequency(int k, float freq) {
+        frequencies[k] = freq;
+        updateSplitCoefficients(k);
+    }
+
+    float getFrequency(int k) const { return frequencies[k]; }
+
+    // Audio thread (between samples): the running network's memories move to the other precision
+    void setDoublePrecision(bool enabled) {
+        if (enabled == doublePrecision) return;
+        if (enabled) precise.copyStateFrom(fast);
+        else fast.copyStateFrom(precise);
+        doublePrecision = enabled;
+    }
     
     void updateCoefficients() {
-        calculateButterworthLP(lowpass1a, xover1, sampleRate);
-        lowpass1b = lowpass1a;
-        calculateButterworthHP(highpass1a, xover1, sampleRate);
-        highpass1b = highpass1a;
-
-        calculateButterworthLP(lowpass2a, xover2, sampleRate);
-        lowpass2b = lowpass2a;
-        calculateButterworthHP(highpass2a, xover2, sampleRate);
-        highpass2b = highpass2a;
+        for (int k = 0; k < kNumSplits; ++k) {
+            updateSplitCoefficients(k);
+        }
+    }
 
-        calculateButterworthLP(lowpass3a, xover3, sampleRate);
-        lowpass3b = lowpass3a;
-        calculateButterworthHP(highpass3a, xover3, sampleRate);
-        highpass3b = highpass3a;
+    void updateSplitCoefficients(int k) {
+        calculateButterworthLP(precise.splits[k].lowpass, frequencies[k], sampleRate);
+        calculateButterworthHP(precise.splits[k].highpass, frequencies[k], sampleRate);
+        fast.copyCoefficientsFrom(precise, k);
     }
     
-    void calculateButterworthLP(BiquadCoeffs& c, float freq, float sr) {
+    void calculateButterworthLP(BiquadCoeffs<double>& c, float freq, float sr) {
         const double pi = 3.14159265358979323846;
         const double w0 = 2.0 * pi * freq / sr;
         const double cosw0 = cos(w0);
@@ -431,7 +855,7 @@ struct FourBandCrossover {
         c.a2 = (1.0 - alpha) / a0;
     }
     
-    void calculateButterworthHP(BiquadCoeffs& c, float freq, float sr) {
+    void calculateButterworthHP(BiquadCoeffs<double>& c, float freq, float sr) {
         const double pi = 3.14159265358979323846;
         const double w0 = 2.0 * pi * freq / sr;
         const double cosw0 = cos(w0);
@@ -447,73 +871,32 @@ struct FourBandCrossover {
         c.a2 = (1.0 - alpha) / a0;
     }
     
-    inline double processBiquad(double input, int channel, const BiquadCoeffs& c, BiquadState& s) {
-        double output = c.b0 * input + c.b1 * s.x1[channel] + c.b2 * s.x2[channel]
-                       - c.a1 * s.y1[channel] - c.a2 * s.y2[channel];
-        
-        s.x2[channel] = s.x1[channel];
-        s.x1[channel] = input;
-        s.y2[channel] = s.y1[channel];
-        s.y1[channel] = output;
-        
-        return output;
-    }
-    
-    void processSample(float inL, float inR,
-                       float& band1L, float& band1R,
-                       float& band2L, float& band2R,
-                       float& band3L, float& band3R,
-                       float& band4L, float& band4R) {
-        double lp1L = processBiquad(inL, 0, lowpass1a, lp1StateA);
-        double lp1R = processBiquad(inR, 1, lowpass1a, lp1StateA);
-        double band1OutL = processBiquad(lp1L, 0, lowpass1b, lp1StateB);
-        double band1OutR = processBiquad(lp1R, 1, lowpass1b, lp1StateB);
-
-        double hp1L = processBiquad(inL, 0, highpass1a, hp1StateA);
-        double hp1R = processBiquad(inR, 1, highpass1a, hp1StateA);
-        double highFrom1L = processBiquad(hp1L, 0, highpass1b, hp1StateB);
-        double highFrom1R = processBiquad(hp1R, 1, highpass1b, hp1StateB);
-
-        double lp2L = processBiquad(highFrom1L, 0, lowpass2a, lp2StateA);
-        double lp2R = processBiquad(highFrom1R, 1, lowpass2a, lp2StateA);
-        double band2OutL = processBiquad(lp2L, 0, lowpass2b, lp2StateB);
-        double band2OutR = processBiquad(lp2R, 1, lowpass2b, lp2StateB);
-
-        double hp2L = processBiquad(highFrom1L, 0, highpass2a, hp2StateA);
-        double hp2R = processBiquad(highFrom1R, 1, highpass2a, hp2StateA);
-        double highFrom2L = processBiquad(hp2L, 0, highpass2b, hp2StateB);
-        double highFrom2R = processBiquad(hp2R, 1, highpass2b, hp2StateB);
-
-        double lp3L = processBiquad(highFrom2L, 0, lowpass3a, lp3StateA);
-        double lp3R = processBiquad(highFrom2R, 1, lowpass3a, lp3StateA);
-        double band3OutL = processBiquad(lp3L, 0, lowpass3b, lp3StateB);
-        double band3OutR = processBiquad(lp3R, 1, lowpass3b, lp3StateB);
-
-        double hp3L = processBiquad(highFrom2L, 0, highpass3a, hp3StateA);
-        double hp3R = processBiquad(highFrom2R, 1, highpass3a, hp3StateA);
-        double band4OutL = processBiquad(hp3L, 0, highpass3b, hp3StateB);
-        double band4OutR = processBiquad(hp3R, 1, highpass3b, hp3StateB);
-
-        band1L = (float)band1OutL;
-        band1R = (float)band1OutR;
-        band2L = (float)band2OutL;
-        band2R = (float)band2OutR;
-        band3L = (float)band3OutL;
-        band3R = (float)band3OutR;
-        band4L = (float)band4OutL;
-        band4R = (float)band4OutR;
+    // bandL / bandR: kNumBands samples each, lowest band first
+    inline void processSample(float inL, float inR, float* bandL, float* bandR) {
+        if (doublePrecision) precise.process(inL, inR, bandL, bandR);
+        else fast.process(inL, inR, bandL, bandR);
     }
     
     void reset() {
-        lp1StateA.reset(); lp1StateB.reset();
-        hp1StateA.reset(); hp1StateB.reset();
-        lp2StateA.reset(); lp2StateB.reset();
-        hp2StateA.reset(); hp2StateB.reset();
-        lp3StateA.reset(); lp3StateB.reset();
-        hp3StateA.reset(); hp3StateB.reset();
+        precise.reset();
+        fast.reset();
+    }
+
+    // All biquad memories below 'threshold'
+    bool isIdle(double threshold) const {
+        return doublePrecision ? precise.isIdle(threshold) : fast.isIdle(threshold);
+    }
+
+    // Denormal fallback (once per block) for hosts that reset MXCSR
+    void flushDenormals() {
+        if (doublePrecision) precise.flushDenormals();
+        else fast.flushDenormals();
     }
 };
 
+// The plugin's 4-band crossover: the serial cascade, bit for bit what the plugin has always run
+using FourBandCrossover = Crossover<4, false>;
+
 //-------------------------------------------------------------------------------------------------------
 // LUFS Meter
 //-------------------------------------------------------------------------------------------------------
@@ -554,6 +937,15 @@ struct LufsMeter {
         momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
     }
 
+    // Equivalent to process(0, 0) repeated numSamples times
+    void processSilence(int numSamples) {
+        momentaryEnergy *= powf(momentaryCoeff, (float)numSamples);
+        float safeEnergy = (momentaryEnergy > 1.0e-12f) ? momentaryEnergy : 1.0e-12f;
+        momentaryLufs = -0.691f + 10.0f * log10f(safeEnergy);
+    }
+
+    void flushDenormals() { flushDenormal(momentaryEnergy); }
+
     float getMomentary() const { return momentaryLufs; }
 };
 
@@ -32,6 +32,8 @@ enum ParamID : Steinberg::Vst::ParamID {
     kParamLimiterThresh,
     kParamLimiterCeiling,
     kParamLimiterRelease,
+    kParamQuality,          // Eco / Standard / High (appended: older states end before it)
+    kParamBypass,           // Host bypass (kIsBypass)
     kNumParams
 };
 
@@ -44,6 +46,8 @@ constexpr float kDefaultXover3 = 0.80f;
 constexpr float kDefaultLimiterThresh = 0.75f;
 constexpr float kDefaultLimiterCeiling = 0.9583f;
 constexpr float kDefaultLimiterRelease = 0.3f;
+constexpr float kDefaultQuality = 0.5f;     // Standard
+constexpr float kDefaultBypass = 0.0f;
 
 // Frequency range (Hz)
 constexpr float kMinFreq = 20.0f;
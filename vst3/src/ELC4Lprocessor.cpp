@@ -3,9 +3,12 @@
 //-------------------------------------------------------------------------------------------------------
 
 #include "ELC4Lprocessor.h"
+#include "RealtimeGuard.h"
 #include "pluginterfaces/vst/ivstparameterchanges.h"
 #include "base/source/fstreamer.h"
 
+#include <cstdlib>
+
 namespace ELC4L {
 
 using namespace Steinberg;
@@ -18,6 +21,7 @@ ELC4LProcessor::ELC4LProcessor()
     , outputDb(-120.0f)
     , limiterGrDb(0.0f)
     , limiterBypass(false)
+    , dspSleeping(false)
 {
     setControllerClass(kControllerUID);
     
@@ -36,13 +40,16 @@ ELC4LProcessor::ELC4LProcessor()
     parameters[kParamLimiterThresh] = kDefaultLimiterThresh;
     parameters[kParamLimiterCeiling] = kDefaultLimiterCeiling;
     parameters[kParamLimiterRelease] = kDefaultLimiterRelease;
+    parameters[kParamQuality] = kDefaultQuality;
+    parameters[kParamBypass] = kDefaultBypass;
     
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < kNumBands; ++i) {
         bandMute[i] = false;
         bandSolo[i] = false;
         bandDelta[i] = false;
         bandBypass[i] = false;
         bandGrDb[i] = 0.0f;
+        makeupGains[i] = 1.0f;
     }
 }
 
@@ -58,11 +65,16 @@ tresult PLUGIN_API ELC4LProcessor::initialize(FUnknown* context) {
     addAudioInput(STR16("Stereo In"), SpeakerArr::kStereo);
     addAudioOutput(STR16("Stereo Out"), SpeakerArr::kStereo);
     
+    telemetry.open(kTelemetryWrapperVst3);
+    
     return kResultOk;
 }
 
 //-------------------------------------------------------------------------------------------------------
 tresult PLUGIN_API ELC4LProcessor::terminate() {
+    ELC4L_RT_REPORT();
+    telemetry.close();
+    memoryLock.unlock();
     return AudioEffect::terminate();
 }
 
@@ -71,11 +83,12 @@ tresult PLUGIN_API ELC4LProcessor::setActive(TBool state) {
     if (state) {
         // Reset DSP on activation
         crossover.reset();
-        for (int i = 0; i < 4; ++i) {
-            bandComps[i].reset();
-        }
+        bandComps.reset();
         limiter.reset();
         lufsMeter.reset();
+        dspSleeping = false;
+    } else {
+        ELC4L_RT_REPORT();
     }
     return AudioEffect::setActive(state);
 }
@@ -85,20 +98,36 @@ tresult PLUGIN_API ELC4LProcessor::setupProcessing(ProcessSetup& setup) {
     sampleRate = static_cast<float>(setup.sampleRate);
     
     crossover.setSampleRate(sampleRate);
-    for (int i = 0; i < 4; ++i) {
-        bandComps[i].setSampleRate(sampleRate);
-    }
+    bandComps.setSampleRate(sampleRate);
     limiter.setSampleRate(sampleRate);
     lufsMeter.setSampleRate(sampleRate);
+    profiler.prepare(setup.sampleRate);
+    profiler.setEnabled(getenv("ELC4L_PROFILE") != nullptr);
+    governor.prepare(setup.sampleRate);
     
     updateParameters();
+    hostBypass.prepare(setup.sampleRate);
+    hostBypass.setLatency(limiter.getLookaheadSamples());
+    lockDspMemory();
     
     return AudioEffect::setupProcessing(setup);
 }
 
 //-------------------------------------------------------------------------------------------------------
+// Crossover, compressors, limiter delay lines, meters and host bypass are all members: one region
+void ELC4LProcessor::lockDspMemory() {
+    if (memoryLockMode == kMemoryLockOff) return;
+    const MemoryRegion region = { this, sizeof(*this) };
+    memoryLock.lock(memoryLockMode, &region, 1);
+    MemoryLock::printReport("ELC4L VST3", memoryLockMode, memoryLock.getReport());
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Follows the Quality parameter (the controller restarts the component when it changes)
 uint32 PLUGIN_API ELC4LProcessor::getLatencySamples() {
-    return LookaheadLimiter::kLookaheadSamples;
+    const bool extended = getQualitySettings(normalizedToProcessingQuality(parameters[kParamQuality]),
+                                             kQualityFull).extendedLookahead;
+    return LookaheadLimiter::getLookaheadSamples(extended);
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -114,30 +143,78 @@ tresult PLUGIN_API ELC4LProcessor::setBusArrangements(
     return kResultFalse;
 }
 
+//-------------------------------------------------------------------------------------------------------
+// Sample-accurate automation
+// Every IParamValueQueue is walked with its own cursor; the block is split at the
+// smallest pending offset across all queues so each point lands on its exact sample.
+//-------------------------------------------------------------------------------------------------------
+namespace {
+
+constexpr int32 kEndOfBlock = 0x7FFFFFFF;
+
+struct ParamCursor {
+    IParamValueQueue* queue;
+    Steinberg::Vst::ParamID id;
+    int32 numPoints;
+    int32 index;
+    int32 offset;
+    ParamValue value;
+
+    // Load the point at 'index' (skipping unreadable ones); false when exhausted
+    bool fetch() {
+        while (index < numPoints) {
+            if (queue->getPoint(index, offset, value) == kResultOk) return true;
+            ++index;
+        }
+        return false;
+    }
+
+    bool active() const { return index < numPoints; }
+    void advance() { ++index; fetch(); }
+};
+
+} // namespace
+
 //-------------------------------------------------------------------------------------------------------
 tresult PLUGIN_API ELC4LProcessor::process(ProcessData& data) {
-    // Handle parameter changes
+    ELC4L_RT_SCOPE("ELC4LProcessor::process");
+    ScopedFlushDenormals noDenormals;
+    
+    // Collect parameter queues (at most one per parameter)
+    ParamCursor cursors[kNumParams];
+    int32 numCursors = 0;
+    
     if (data.inputParameterChanges) {
         int32 numParamsChanged = data.inputParameterChanges->getParameterCount();
-        for (int32 i = 0; i < numParamsChanged; ++i) {
+        for (int32 i = 0; i < numParamsChanged && numCursors < kNumParams; ++i) {
             IParamValueQueue* paramQueue = data.inputParameterChanges->getParameterData(i);
-            if (paramQueue) {
-                ParamValue value;
-                int32 sampleOffset;
-                int32 numPoints = paramQueue->getPointCount();
-                if (numPoints > 0 && paramQueue->getPoint(numPoints - 1, sampleOffset, value) == kResultOk) {
-                    Steinberg::Vst::ParamID id = paramQueue->getParameterId();
-                    if (id < kNumParams) {
-                        parameters[id] = static_cast<float>(value);
-                    }
-                }
-            }
+            if (!paramQueue || paramQueue->getParameterId() >= kNumParams) continue;
+            
+            ParamCursor& cursor = cursors[numCursors];
+            cursor.queue = paramQueue;
+            cursor.id = paramQueue->getParameterId();
+            cursor.numPoints = paramQueue->getPointCount();
+            cursor.index = 0;
+            if (cursor.fetch()) ++numCursors;
         }
-        updateParameters();
     }
     
+    // Apply every pending point with offset <= upTo, then refresh only the touched modules
+    auto applyChangesUpTo = [&](int32 upTo) {
+        uint32 dirty = 0;
+        for (int32 c = 0; c < numCursors; ++c) {
+            ParamCursor& cursor = cursors[c];
+            while (cursor.active() && cursor.offset <= upTo) {
+                dirty |= applyParameter(cursor.id, static_cast<float>(cursor.value));
+                cursor.advance();
+            }
+        }
+        flushParameterChanges(dirty);
+    };
+    
     // Process audio
     if (data.numInputs == 0 || data.numOutputs == 0) {
+        applyChangesUpTo(kEndOfBlock);
         return kResultOk;
     }
     
@@ -145,6 +222,7 @@ tresult PLUGIN_API ELC4LProcessor::process(ProcessData& data) {
     int32 numSamples = data.numSamples;
     
     if (numChannels < 2) {
+        applyChangesUpTo(kEndOfBlock);
         return kResultOk;
     }
     
@@ -153,101 +231,271 @@ tresult PLUGIN_API ELC4LProcessor::process(ProcessData& data) {
     float* outL = data.outputs[0].channelBuffers32[0];
     float* outR = data.outputs[0].channelBuffers32[1];
     
-    // Check for silence flags
-    if (data.inputs[0].silenceFlags != 0) {
+    profiler.beginBlock();
+    const int64 telemetryStart = telemetry.beginBlock();
+    const int64 governorStart = governor.beginBlock();
+    
+    // Host bypass: once the crossfade to the dry path is done only its delay line runs
+    if (!hostBypass.beginBlock()) {
+        applyChangesUpTo(kEndOfBlock);
+        if (hostBypass.takeFlushRequest()) enterSilenceSleep();
+        hostBypass.processDry(inL, inR, outL, outR, numSamples);
         data.outputs[0].silenceFlags = data.inputs[0].silenceFlags;
+        profiler.endBlock(numSamples);
+        applyQuality(processingQuality, governor.endBlock(governorStart, numSamples));
+        telemetry.endBlock(telemetryStart, outL, outR, numSamples, sampleRate, bandGrDb, limiterGrDb,
+                           lufsMeter.getMomentary());
+        return kResultOk;
+    }
+    
+    // Silence: the host flag only says the input is silent; the tails still have to drain
+    // before the DSP can be skipped, so a silent block is processed until isDspIdle().
+    const uint64 kStereoSilent = 0x3;
+    const bool inputSilent = ((data.inputs[0].silenceFlags & kStereoSilent) == kStereoSilent)
+        || isBlockSilent(inL, inR, numSamples, kSilenceInputThreshold);
+    
+    if (inputSilent && dspSleeping) {
+        applyChangesUpTo(kEndOfBlock);
         for (int32 i = 0; i < numSamples; ++i) {
             outL[i] = 0.0f;
             outR[i] = 0.0f;
         }
+        data.outputs[0].silenceFlags = kStereoSilent;
+        lufsMeter.processSilence(numSamples);
+        hostBypass.advanceSilent(numSamples);
+        profiler.endBlock(numSamples);
+        applyQuality(processingQuality, governor.endBlock(governorStart, numSamples));
+        telemetry.endBlock(telemetryStart, outL, outR, numSamples, sampleRate, bandGrDb, limiterGrDb,
+                           lufsMeter.getMomentary());
         return kResultOk;
     }
+    dspSleeping = false;
+    data.outputs[0].silenceFlags = 0;
     
-    bool anySolo = bandSolo[0] || bandSolo[1] || bandSolo[2] || bandSolo[3];
-    
-    for (int32 i = 0; i < numSamples; ++i) {
-        float b1L, b1R, b2L, b2R, b3L, b3R, b4L, b4R;
-        
-        // Split into 4 bands
-        crossover.processSample(inL[i], inR[i], b1L, b1R, b2L, b2R, b3L, b3R, b4L, b4R);
-        
-        // Store uncompressed band signals for Delta
-        float bandInputL[4] = { b1L, b2L, b3L, b4L };
-        float bandInputR[4] = { b1R, b2R, b3R, b4R };
-        
-        // Process each band through compressor (with bypass check)
-        if (!bandBypass[0]) bandComps[0].process(b1L, b1R);
-        if (!bandBypass[1]) bandComps[1].process(b2L, b2R);
-        if (!bandBypass[2]) bandComps[2].process(b3L, b3R);
-        if (!bandBypass[3]) bandComps[3].process(b4L, b4R);
-        
-        float bandOutL[4] = { b1L, b2L, b3L, b4L };
-        float bandOutR[4] = { b1R, b2R, b3R, b4R };
-        
-        // Get makeup gains for Delta
-        float makeupGains[4];
-        for (int b = 0; b < 4; ++b) {
-            float makeupDb = normalizedToCompMakeupDb(parameters[kParamBand1Makeup + b]);
-            makeupGains[b] = dbToLinear(makeupDb);
-        }
-        
-        // Mix bands with Delta/Mute/Solo logic
-        float mixL = 0.0f;
-        float mixR = 0.0f;
-        
-        for (int b = 0; b < 4; ++b) {
-            float outBandL, outBandR;
-            
-            if (bandDelta[b]) {
-                float invMakeup = (makeupGains[b] > 1e-6f) ? (1.0f / makeupGains[b]) : 1.0f;
-                outBandL = bandInputL[b] - (bandOutL[b] * invMakeup);
-                outBandR = bandInputR[b] - (bandOutR[b] * invMakeup);
-            } else {
-                outBandL = bandOutL[b];
-                outBandR = bandOutR[b];
-            }
-            
-            bool playBand = false;
-            if (anySolo) {
-                playBand = bandSolo[b];
-            } else {
-                playBand = !bandMute[b];
-            }
-            
-            if (playBand) {
-                mixL += outBandL;
-                mixR += outBandR;
+    // Split the block at parameter change offsets (merged across queues)
+    int32 pos = 0;
+    while (pos < numSamples) {
+        int32 nextOffset = numSamples;
+        for (int32 c = 0; c < numCursors; ++c) {
+            if (cursors[c].active() && cursors[c].offset < nextOffset) {
+                nextOffset = (cursors[c].offset > pos) ? cursors[c].offset : pos;
             }
         }
         
-        // Limiter
-        if (!limiterBypass) {
-            limiter.process(mixL, mixR);
+        if (nextOffset > pos) {
+            processRange(inL, inR, outL, outR, pos, nextOffset);
+            pos = nextOffset;
+        }
+        if (pos < numSamples) {
+            applyChangesUpTo(pos);
         }
-        
-        outL[i] = mixL;
-        outR[i] = mixR;
-        
-        // Update LUFS meter
-        lufsMeter.process(mixL, mixR);
     }
     
+    // Points at or past the end of the block
+    applyChangesUpTo(kEndOfBlock);
+    
     // Update GR meters
-    for (int b = 0; b < 4; ++b) {
+    for (int b = 0; b < kNumBands; ++b) {
         bandGrDb[b] = bandComps[b].getGainReductionDb();
     }
     limiterGrDb = limiter.getGainReductionDb();
     
+    // Fallback for hosts that reset MXCSR behind our back: no state may stay subnormal
+    crossover.flushDenormals();
+    bandComps.flushDenormals();
+    limiter.flushDenormals();
+    lufsMeter.flushDenormals();
+    
+    if (inputSilent && isDspIdle()) {
+        enterSilenceSleep();
+    }
+    
+    profiler.endBlock(numSamples);
+    applyQuality(processingQuality, governor.endBlock(governorStart, numSamples));
+    telemetry.endBlock(telemetryStart, outL, outR, numSamples, sampleRate, bandGrDb, limiterGrDb,
+                       lufsMeter.getMomentary());
     return kResultOk;
 }
 
+//-------------------------------------------------------------------------------------------------------
+bool ELC4LProcessor::isDspIdle() const {
+    if (!crossover.isIdle(kSilenceStateThreshold)) return false;
+    if (!bandComps.isIdle(kSilenceStateThreshold)) return false;
+    return limiterBypass || limiter.isIdle(kSilenceStateThreshold);
+}
+
+//-------------------------------------------------------------------------------------------------------
+void ELC4LProcessor::enterSilenceSleep() {
+    // Residual state is below -120 dB: clear it so the next signal starts from a clean state
+    crossover.reset();
+    bandComps.reset();
+    for (int b = 0; b < kNumBands; ++b) {
+        bandGrDb[b] = 0.0f;
+    }
+    limiter.reset();
+    limiterGrDb = 0.0f;
+    dspSleeping = true;
+}
+
+//-------------------------------------------------------------------------------------------------------
+void ELC4LProcessor::processRange(const float* inL, const float* inR, float* outL, float* outR,
+                                  int32 start, int32 end) {
+    // Parameters only change between ranges, so the monitoring switches are resolved here: each band
+    // gets the kernel specialized for its bypass / delta combination (bands that are not heard only
+    // keep their detector running), the mix only visits the bands that are heard and the output
+    // kernel is specialized for the limiter bypass
+    bool anySolo = false;
+    for (int b = 0; b < kNumBands; ++b) anySolo |= bandSolo[b];
+    BandKernel kernels[kNumBands];
+    int playedBands[kNumBands];
+    int numPlayed = 0;
+    for (int b = 0; b < kNumBands; ++b) {
+        int flags = 0;
+        if (bandBypass[b]) flags |= kBandKernelBypass;
+        if (bandDelta[b]) flags |= kBandKernelDelta;
+        if (anySolo ? bandSolo[b] : !bandMute[b]) playedBands[numPlayed++] = b;
+        else flags = kBandKernelMuted | (flags & kBandKernelBypass);
+        kernels[b] = bandKernels[flags];
+    }
+    const OutputKernel outputKernel = limiterBypass ? &ELC4LProcessor::processOutputChunk<true>
+                                                    : &ELC4LProcessor::processOutputChunk<false>;
+
+    float bandL[kNumBands][kChunkSize], bandR[kNumBands][kChunkSize];
+    float mixL[kChunkSize], mixR[kChunkSize];
+    for (int32 chunk = start; chunk < end; chunk += kChunkSize) {
+        const int n = (end - chunk < kChunkSize) ? (int)(end - chunk) : kChunkSize;
+        profiler.beginChunk(n);
+        hostBypass.pushInput(inL + chunk, inR + chunk, n);
+
+        // Split into bands
+        for (int i = 0; i < n; ++i) {
+            float sampleL[kNumBands], sampleR[kNumBands];
+            crossover.processSample(inL[chunk + i], inR[chunk + i], sampleL, sampleR);
+            for (int b = 0; b < kNumBands; ++b) {
+                bandL[b][i] = sampleL[b];
+                bandR[b][i] = sampleR[b];
+            }
+        }
+        profiler.lap(kStageCrossover);
+
+        // Band compressors (muted bands: detector only, so their gain stays in step)
+        for (int b = 0; b < kNumBands; ++b) {
+            (this->*kernels[b])(b, bandL[b], bandR[b], n);
+        }
+
+        // Mute / Solo: sum the bands that are heard
+        for (int i = 0; i < n; ++i) {
+            mixL[i] = 0.0f;
+            mixR[i] = 0.0f;
+        }
+        for (int p = 0; p < numPlayed; ++p) {
+            const float* l = bandL[playedBands[p]];
+            const float* r = bandR[playedBands[p]];
+            for (int i = 0; i < n; ++i) {
+                mixL[i] += l[i];
+                mixR[i] += r[i];
+            }
+        }
+        profiler.lap(kStageCompressors);
+
+        (this->*outputKernel)(mixL, mixR, outL + chunk, outR + chunk, n);
+        hostBypass.mixOutput(outL + chunk, outR + chunk, n);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Specialized chunk kernels (selected per range in processRange)
+const ELC4LProcessor::BandKernel ELC4LProcessor::bandKernels[kNumBandKernels] = {
+    &ELC4LProcessor::processBandChunk<0>, &ELC4LProcessor::processBandChunk<1>,
+    &ELC4LProcessor::processBandChunk<2>, &ELC4LProcessor::processBandChunk<3>,
+    &ELC4LProcessor::processBandChunk<4>, &ELC4LProcessor::processBandChunk<5>,
+    &ELC4LProcessor::processBandChunk<6>, &ELC4LProcessor::processBandChunk<7>
+};
+
+// One band over one chunk, in place: compressor with the saturation timed as its own stage (skipped
+// when bypassed); Delta Listen replaces the output with what the compressor removed. A band that is
+// not heard only updates its detector and leaves the buffer as scratch.
+template <int Flags>
+void ELC4LProcessor::processBandChunk(int band, float* left, float* right, int numSamples) {
+    constexpr bool bypass = (Flags & kBandKernelBypass) != 0;
+    constexpr bool delta = (Flags & kBandKernelDelta) != 0;
+    constexpr bool muted = (Flags & kBandKernelMuted) != 0;
+
+    if constexpr (muted) {
+        // A bypassed compressor has no state to keep warm
+        if constexpr (!bypass) {
+            bandComps[band].processDetectorChunk(left, right, numSamples);
+        }
+        profiler.lap(kStageCompressors);
+        return;
+    }
+
+    float inputL[kChunkSize], inputR[kChunkSize];   // Uncompressed band (Delta Listen)
+    if constexpr (delta) {
+        for (int i = 0; i < numSamples; ++i) {
+            inputL[i] = left[i];
+            inputR[i] = right[i];
+        }
+    }
+    if constexpr (!bypass) {
+        bandComps[band].processDynamicsChunk(left, right, numSamples);
+        profiler.lap(kStageCompressors);
+        bandComps[band].processSaturationChunk(left, right, numSamples);
+        profiler.lap(kStageSaturation);
+    }
+    if constexpr (delta) {
+        const float invMakeup = (makeupGains[band] > 1e-6f) ? (1.0f / makeupGains[band]) : 1.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            left[i] = inputL[i] - (left[i] * invMakeup);
+            right[i] = inputR[i] - (right[i] * invMakeup);
+        }
+    }
+}
+
+// Limiter (skipped when bypassed), output and LUFS meter of one chunk
+template <bool LimiterBypass>
+void ELC4LProcessor::processOutputChunk(float* mixL, float* mixR, float* outL, float* outR, int numSamples) {
+    if constexpr (!LimiterBypass) {
+        limiter.processChunk(mixL, mixR, numSamples);
+    }
+    profiler.lap(kStageLimiter);
+
+    for (int i = 0; i < numSamples; ++i) {
+        outL[i] = mixL[i];
+        outR[i] = mixR[i];
+        lufsMeter.process(mixL[i], mixR[i]);
+    }
+    profiler.lap(kStageMetering);
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Processing quality and overload tier. This build has no analyzer and a memoryless 1x saturation, so
+// the crossover precision, the gain computer rate and the limiter lookahead are what change here.
+void ELC4LProcessor::applyQuality(int quality, int tier) {
+    if (quality == processingQuality && tier == qualityTier) return;
+    processingQuality = quality;
+    qualityTier = tier;
+
+    const QualitySettings settings = getQualitySettings(quality, tier);
+    crossover.setDoublePrecision(settings.doublePrecisionCrossover);
+    for (int b = 0; b < kNumBands; ++b) {
+        bandComps[b].setGainComputerInterval(settings.gainComputerInterval);
+    }
+    limiter.setExtendedLookahead(settings.extendedLookahead);
+    hostBypass.setLatency(limiter.getLookaheadSamples());
+    telemetry.setQualityTier(tier);
+}
+
 //-------------------------------------------------------------------------------------------------------
 tresult PLUGIN_API ELC4LProcessor::setState(IBStream* state) {
     IBStreamer streamer(state, kLittleEndian);
     
     for (int i = 0; i < kNumParams; ++i) {
         float value;
-        if (!streamer.readFloat(value)) return kResultFalse;
+        if (!streamer.readFloat(value)) {
+            if (i >= kParamQuality) break;  // Saved before the Quality / Bypass parameters existed
+            return kResultFalse;
+        }
         parameters[i] = value;
     }
     
@@ -271,25 +519,83 @@ void ELC4LProcessor::updateParameters() {
     updateFrequencies();
     updateCompressors();
     updateLimiter();
+    applyQuality(normalizedToProcessingQuality(parameters[kParamQuality]), qualityTier);
+    hostBypass.setBypassed(parameters[kParamBypass] >= 0.5f);
+}
+
+//-------------------------------------------------------------------------------------------------------
+uint32 ELC4LProcessor::applyParameter(Steinberg::Vst::ParamID id, float value) {
+    parameters[id] = value;
+    
+    switch (id) {
+        case kParamBand1Thresh:
+        case kParamBand2Thresh:
+        case kParamBand3Thresh:
+        case kParamBand4Thresh:
+            return kDirtyBand1 << (id - kParamBand1Thresh);
+        case kParamBand1Makeup:
+        case kParamBand2Makeup:
+        case kParamBand3Makeup:
+        case kParamBand4Makeup:
+            return kDirtyBand1 << (id - kParamBand1Makeup);
+        case kParamXover1: return kDirtyXover1;
+        case kParamXover2: return kDirtyXover2;
+        case kParamXover3: return kDirtyXover3;
+        case kParamLimiterThresh:
+        case kParamLimiterCeiling:
+        case kParamLimiterRelease:
+            return kDirtyLimiter;
+        case kParamQuality:
+            return kDirtyQuality;
+        case kParamBypass:
+            hostBypass.setBypassed(value >= 0.5f);  // Picked up at the next block
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------
+void ELC4LProcessor::flushParameterChanges(uint32 dirty) {
+    for (int k = 0; k < FourBandCrossover::kNumSplits; ++k) {
+        if (dirty & (kDirtyXover1 << k)) {
+            crossover.setFrequency(k, normalizedToFrequency(parameters[kParamXover1 + k]));
+        }
+    }
+    
+    for (int b = 0; b < kNumBands; ++b) {
+        if (dirty & (kDirtyBand1 << b)) updateCompressor(b);
+    }
+    
+    if (dirty & kDirtyLimiter) updateLimiter();
+    if (dirty & kDirtyQuality) {
+        applyQuality(normalizedToProcessingQuality(parameters[kParamQuality]), qualityTier);
+    }
 }
 
 //-------------------------------------------------------------------------------------------------------
 void ELC4LProcessor::updateFrequencies() {
-    crossover.setXover1(normalizedToFrequency(parameters[kParamXover1]));
-    crossover.setXover2(normalizedToFrequency(parameters[kParamXover2]));
-    crossover.setXover3(normalizedToFrequency(parameters[kParamXover3]));
+    for (int k = 0; k < FourBandCrossover::kNumSplits; ++k) {
+        crossover.setFrequency(k, normalizedToFrequency(parameters[kParamXover1 + k]));
+    }
 }
 
 //-------------------------------------------------------------------------------------------------------
 void ELC4LProcessor::updateCompressors() {
-    for (int i = 0; i < 4; ++i) {
-        float threshDb = normalizedToCompThreshDb(parameters[kParamBand1Thresh + i]);
-        float makeupDb = normalizedToCompMakeupDb(parameters[kParamBand1Makeup + i]);
-        bandComps[i].setThresholdDb(threshDb);
-        bandComps[i].setMakeupDb(makeupDb);
+    for (int i = 0; i < kNumBands; ++i) {
+        updateCompressor(i);
     }
 }
 
+//-------------------------------------------------------------------------------------------------------
+void ELC4LProcessor::updateCompressor(int band) {
+    float threshDb = normalizedToCompThreshDb(parameters[kParamBand1Thresh + band]);
+    float makeupDb = normalizedToCompMakeupDb(parameters[kParamBand1Makeup + band]);
+    bandComps[band].setThresholdDb(threshDb);
+    bandComps[band].setMakeupDb(makeupDb);
+    makeupGains[band] = dbToLinear(makeupDb);
+}
+
 //-------------------------------------------------------------------------------------------------------
 void ELC4LProcessor::updateLimiter() {
     float threshDb = normalizedToLimiterDb(parameters[kParamLimiterThresh]);
@@ -6,6 +6,11 @@
 #include "public.sdk/source/vst/vstaudioeffect.h"
 #include "ELC4Lids.h"
 #include "ELC4Ldsp.h"
+#include "StageProfiler.h"
+#include "Telemetry.h"
+#include "QualityGovernor.h"
+#include "HostBypass.h"
+#include "MemoryLock.h"
 
 namespace ELC4L {
 
@@ -31,35 +36,102 @@ public:
         Steinberg::Vst::SpeakerArrangement* outputs, Steinberg::int32 numOuts) override;
     Steinberg::uint32 PLUGIN_API getLatencySamples() override;
 
+    // Per-stage CPU profile; enabled when ELC4L_PROFILE is set in the host's environment
+    bool getStageProfile(StageProfileSnapshot& snapshot) const { return profiler.read(snapshot); }
+
+    // Adaptive quality tier under CPU overload (QualityTier, 0 = full quality)
+    int getQualityTier() const { return governor.getTier(); }
+
 private:
+    // Modules touched by a parameter change (see applyParameter)
+    enum DirtyFlags : Steinberg::uint32 {
+        kDirtyXover1  = 1 << 0,  // kDirtyXover1 << k for split points 1-3
+        kDirtyXover2  = 1 << 1,
+        kDirtyXover3  = 1 << 2,
+        kDirtyBand1   = 1 << 3,  // kDirtyBand1 << band for bands 1-4
+        kDirtyLimiter = 1 << 7,
+        kDirtyQuality = 1 << 8
+    };
+
     void updateParameters();
     void updateCompressors();
+    void updateCompressor(int band);
     void updateFrequencies();
     void updateLimiter();
+
+    // Sample-accurate automation helpers
+    Steinberg::uint32 applyParameter(Steinberg::Vst::ParamID id, float value);
+    void flushParameterChanges(Steinberg::uint32 dirty);
+    void processRange(const float* inL, const float* inR, float* outL, float* outR,
+                      Steinberg::int32 start, Steinberg::int32 end);
+
+    // Ranges run in chunks through kernels specialized for the monitoring switches, picked once per
+    // range (bitmask -> table), so the per-sample loops carry no flag branches
+    static constexpr int kChunkSize = 32;
+    enum BandKernelFlags {
+        kBandKernelBypass = 1 << 0,
+        kBandKernelDelta = 1 << 1,
+        kBandKernelMuted = 1 << 2,      // Not in the mix (mute / solo elsewhere): detector only
+        kNumBandKernels = 1 << 3
+    };
+    typedef void (ELC4LProcessor::*BandKernel)(int band, float* left, float* right, int numSamples);
+    typedef void (ELC4LProcessor::*OutputKernel)(float* mixL, float* mixR, float* outL, float* outR,
+                                                 int numSamples);
+    static const BandKernel bandKernels[kNumBandKernels];
+
+    template <int Flags>
+    void processBandChunk(int band, float* left, float* right, int numSamples);
+    template <bool LimiterBypass>
+    void processOutputChunk(float* mixL, float* mixR, float* outL, float* outR, int numSamples);
+
+    void applyQuality(int quality, int tier);   // Processing quality + overload tier
+
+    // Silence sleep helpers
+    bool isDspIdle() const;
+    void enterSilenceSleep();
     
     // Parameters (normalized 0-1)
     float parameters[kNumParams];
     
+    // Band count: set by the crossover type; the parameter layout (ELC4Lids.h) has four bands
+    static constexpr int kNumBands = FourBandCrossover::kNumBands;
+    static_assert(kNumBands == kParamBand1Makeup - kParamBand1Thresh, "one threshold parameter per band");
+
     // DSP components
     FourBandCrossover crossover;
-    OptoCompressor bandComps[4];
+    CompressorBank<kNumBands> bandComps;
     LookaheadLimiter limiter;
     LufsMeter lufsMeter;
+    float makeupGains[kNumBands];   // Linear makeup per band (used by Delta listen)
     
     // Bypass/monitoring state
-    bool bandMute[4];
-    bool bandSolo[4];
-    bool bandDelta[4];
-    bool bandBypass[4];
+    bool bandMute[kNumBands];
+    bool bandSolo[kNumBands];
+    bool bandDelta[kNumBands];
+    bool bandBypass[kNumBands];
     bool limiterBypass;
     
     // Metering
     float inputDb;
     float outputDb;
-    float bandGrDb[4];
+    float bandGrDb[kNumBands];
     float limiterGrDb;
     
     float sampleRate;
+    bool dspSleeping;   // DSP skipped: input silent and all tails drained
+
+    StageProfiler profiler;
+    TelemetryPublisher telemetry;   // Shared-memory telemetry (ELC4L_TELEMETRY=1)
+    QualityGovernor governor;       // Steps quality down when the block budget runs short
+    HostBypass hostBypass;          // kParamBypass: latency-matched dry path, DSP skipped
+    int processingQuality = kProcessingStandard;
+    int qualityTier = kQualityFull;
+
+    // Opt-in (ELC4L_LOCK_MEMORY): all DSP state lives in the processor object, which is prefaulted and
+    // locked by setupProcessing and unlocked by terminate
+    MemoryLockMode memoryLockMode = getMemoryLockModeFromEnvironment();
+    MemoryLock memoryLock;
+    void lockDspMemory();
 };
 
 } // namespace ELC4L